@@ -0,0 +1,242 @@
+#include "clients.h"
+
+#include <proto/exec.h>
+
+#include <stdint.h>
+#include <string.h>
+
+#define INITIAL_SIZE 16
+#define INITIAL_ARCHIVE 16
+
+// Removed keys leave a tombstone so that the probe sequences of the other keys
+// stay intact. A tombstone slot can be reused by a later add.
+static const char tombstone;
+
+#define TOMBSTONE ((const void *)&tombstone)
+
+static size_t hash_key(const void* const key, const size_t size)
+{
+    // Interfaces and contexts are at least 16-byte aligned, skip the zero bits
+    return (size_t)(((uintptr_t)key >> 4) * 2654435761UL) & (size - 1);
+}
+
+static BOOL is_live(const void* const key)
+{
+    return key != NULL && key != TOMBSTONE;
+}
+
+static ClientSlots* allocate_slots(const size_t size)
+{
+    ClientSlots* slots = IExec->AllocVecTags(sizeof(ClientSlots) + size * sizeof(ClientSlot),
+        AVT_Type, MEMF_SHARED,
+        AVT_ClearValue, 0,
+        TAG_DONE);
+
+    if (slots) {
+        slots->size = size;
+    }
+
+    return slots;
+}
+
+static ClientSlot* find_slot(ClientSlots* const slots, const void* const key)
+{
+    size_t i = hash_key(key, slots->size);
+
+    for (size_t probe = 0; probe < slots->size; probe++) {
+        ClientSlot* const slot = &slots->slots[i];
+
+        if (slot->key == key) {
+            return slot;
+        }
+
+        if (slot->key == NULL) {
+            break;
+        }
+
+        i = (i + 1) & (slots->size - 1);
+    }
+
+    return NULL;
+}
+
+// Tombstone or empty slot for a new key
+static ClientSlot* free_slot(ClientSlots* const slots, const void* const key)
+{
+    size_t i = hash_key(key, slots->size);
+
+    while (is_live(slots->slots[i].key)) {
+        i = (i + 1) & (slots->size - 1);
+    }
+
+    return &slots->slots[i];
+}
+
+// Rehashes the live keys into a new array, which drops the tombstones too
+static BOOL grow(ClientTable* const table)
+{
+    size_t size = INITIAL_SIZE;
+
+    while (size < (table->count + 1) * 4) {
+        size *= 2;
+    }
+
+    ClientSlots* const slots = allocate_slots(size);
+
+    if (!slots) {
+        return FALSE;
+    }
+
+    ClientSlots* const old = table->slots;
+
+    if (old) {
+        for (size_t i = 0; i < old->size; i++) {
+            if (is_live(old->slots[i].key)) {
+                *free_slot(slots, old->slots[i].key) = old->slots[i];
+            }
+        }
+    }
+
+    slots->retired = old;
+    table->used = table->count;
+
+    __atomic_store_n(&table->slots, slots, __ATOMIC_RELEASE);
+
+    return TRUE;
+}
+
+static BOOL archive_summary(ClientTable* const table, void* const summary)
+{
+    if (table->archiveCount == table->archiveCapacity) {
+        const size_t capacity = table->archiveCapacity ? table->archiveCapacity * 2 : INITIAL_ARCHIVE;
+
+        void** archive = IExec->AllocVecTags(capacity * sizeof(void *), AVT_Type, MEMF_SHARED, TAG_DONE);
+
+        if (!archive) {
+            return FALSE;
+        }
+
+        if (table->archive) {
+            memcpy(archive, table->archive, table->archiveCount * sizeof(void *));
+            IExec->FreeVec(table->archive);
+        }
+
+        table->archive = archive;
+        table->archiveCapacity = capacity;
+    }
+
+    table->archive[table->archiveCount++] = summary;
+
+    return TRUE;
+}
+
+void* client_table_find(const ClientTable* const table, const void* const key)
+{
+    const ClientSlots* const slots = __atomic_load_n(&table->slots, __ATOMIC_ACQUIRE);
+
+    if (!slots) {
+        return NULL;
+    }
+
+    size_t i = hash_key(key, slots->size);
+
+    for (size_t probe = 0; probe < slots->size; probe++) {
+        const ClientSlot* const slot = &slots->slots[i];
+        const void* const slotKey = __atomic_load_n(&slot->key, __ATOMIC_ACQUIRE);
+
+        if (slotKey == key) {
+            return __atomic_load_n(&slot->client, __ATOMIC_RELAXED);
+        }
+
+        if (slotKey == NULL) {
+            break;
+        }
+
+        i = (i + 1) & (slots->size - 1);
+    }
+
+    return NULL;
+}
+
+ULONG client_table_add(ClientTable* const table, const void* const key, void* const client)
+{
+    if (table->slots) {
+        ClientSlot* const slot = find_slot(table->slots, key);
+
+        if (slot) {
+            // Stale entry of a reused address
+            __atomic_store_n(&slot->client, client, __ATOMIC_RELEASE);
+            return ++table->nextId;
+        }
+    }
+
+    // Keep at least half of the slots empty, so that probes stay short
+    if (!table->slots || (table->used + 1) * 2 > table->slots->size) {
+        if (!grow(table)) {
+            return 0;
+        }
+    }
+
+    ClientSlot* const slot = free_slot(table->slots, key);
+
+    if (slot->key == NULL) {
+        table->used++;
+    }
+
+    table->count++;
+
+    // Client first, readers that see the key must see its client
+    __atomic_store_n(&slot->client, client, __ATOMIC_RELAXED);
+    __atomic_store_n(&slot->key, key, __ATOMIC_RELEASE);
+
+    return ++table->nextId;
+}
+
+BOOL client_table_remove(ClientTable* const table, const void* const key, void* const summary)
+{
+    ClientSlot* const slot = table->slots ? find_slot(table->slots, key) : NULL;
+
+    if (slot) {
+        __atomic_store_n(&slot->key, TOMBSTONE, __ATOMIC_RELEASE);
+        table->count--;
+    }
+
+    return summary && archive_summary(table, summary);
+}
+
+void* client_table_next(const ClientTable* const table, size_t* const position)
+{
+    const ClientSlots* const slots = table->slots;
+
+    if (slots) {
+        while (*position < slots->size) {
+            const ClientSlot* const slot = &slots->slots[(*position)++];
+
+            if (is_live(slot->key)) {
+                return slot->client;
+            }
+        }
+    }
+
+    return NULL;
+}
+
+size_t client_table_count(const ClientTable* const table)
+{
+    return table->count;
+}
+
+void client_table_free(ClientTable* const table)
+{
+    ClientSlots* slots = table->slots;
+
+    while (slots) {
+        ClientSlots* const retired = slots->retired;
+        IExec->FreeVec(slots);
+        slots = retired;
+    }
+
+    IExec->FreeVec(table->archive);
+
+    memset(table, 0, sizeof(*table));
+}
@@ -0,0 +1,54 @@
+#ifndef CLIENTS_H
+#define CLIENTS_H
+
+#include <exec/types.h>
+
+// Registry of the patched clients of a module. It maps a patched interface or
+// context to its client data. Writers hold the module mutex, wrappers look up
+// without locking: one hash and usually one probe.
+//
+// The slot array grows when needed. A replaced array is kept until
+// client_table_free, because a wrapper may still be probing it. Removed
+// clients leave a summary in the archive so that they can be reported at exit.
+
+typedef struct ClientSlot {
+    const void* key;
+    void* client;
+} ClientSlot;
+
+typedef struct ClientSlots {
+    size_t size; // Power of two
+    struct ClientSlots* retired; // Previous, smaller arrays
+    ClientSlot slots[];
+} ClientSlots;
+
+typedef struct ClientTable {
+    ClientSlots* slots;
+    size_t count; // Live keys
+    size_t used; // Live keys and tombstones
+    ULONG nextId;
+
+    void** archive; // Summaries of removed clients, oldest first
+    size_t archiveCount;
+    size_t archiveCapacity;
+} ClientTable;
+
+void* client_table_find(const ClientTable* const table, const void* const key);
+
+// Returns the id of the new client, starting from 1, or 0 when out of memory.
+// Callers remove a client whose key is still registered first, otherwise it's replaced.
+ULONG client_table_add(ClientTable* const table, const void* const key, void* const client);
+
+// Removes the key and archives the summary. The caller owns the client. Returns
+// FALSE when the archive couldn't grow, then the caller still owns the summary too.
+BOOL client_table_remove(ClientTable* const table, const void* const key, void* const summary);
+
+// Iterates the live clients, position starts from 0. Needs the module mutex.
+void* client_table_next(const ClientTable* const table, size_t* const position);
+
+size_t client_table_count(const ClientTable* const table);
+
+// Frees the slot arrays and the archive, but not the clients or the summaries
+void client_table_free(ClientTable* const table);
+
+#endif
@@ -6,10 +6,16 @@
 #define NAME_LEN 64
 #define TAG_BUFFER_LEN 1024
 
-#define MAX_CLIENTS 5
-
 void find_process_name2(struct Node * node, char * destination);
 
+// Wrappers log through traceLine, it needs the traced flag set by GET_CONTEXT
+#define traceLine(...) \
+do { \
+    if (traced && logEnabled()) { \
+        logLineFunction(__VA_ARGS__); \
+    } \
+} while (0)
+
 #define GENERATE_PATCH(type,func,prefix,ctxtype) \
 static void patch_##func(BOOL patching, struct ctxtype * ctx) \
 { \
@@ -33,26 +39,33 @@ static void patch_##func(BOOL patching, struct ctxtype * ctx) \
     } \
 } \
 
-#define GENERATE_FILTERED_PATCH(type,func,prefix,ctxtype) \
+// id is the function enum. When patching, the function follows the module's
+// compiled patchFilter bitset and is patched or restored only when its state
+// in ctx->patched differs. The old pointer is kept after a filter reload
+// restores it, because the application may still be inside the wrapper.
+#define GENERATE_FILTERED_PATCH(type,func,prefix,ctxtype,id) \
 static void patch_##func(BOOL patching, struct ctxtype * ctx) \
 { \
+    const BOOL wanted = patching && filter_test(patchFilter, id); \
+    \
+    if (wanted == filter_test(ctx->patched, id)) { \
+        return; \
+    } \
+    \
     IExec->Forbid(); \
-    if (patching) { \
-        if (match(#func)) { \
-            ctx->old_##func = (const void *)IExec->SetMethod((struct Interface *)ctx->interface, offsetof(struct type, func), prefix##_##func); \
-        } \
+    if (wanted) { \
+        ctx->old_##func = (const void *)IExec->SetMethod((struct Interface *)ctx->interface, offsetof(struct type, func), prefix##_##func); \
     } else { \
-        if (ctx->old_##func) { \
-            IExec->SetMethod((struct Interface *)ctx->interface, offsetof(struct type, func), ctx->old_##func); \
+        IExec->SetMethod((struct Interface *)ctx->interface, offsetof(struct type, func), ctx->old_##func); \
+        if (!patching) { \
             ctx->old_##func = NULL; \
         } \
     } \
+    filter_set(ctx->patched, id, wanted); \
     IExec->Permit(); \
     \
-    if (patching) { \
-        if (ctx->old_##func) { \
-            logDebug("Patched " #func " %p with %p", ctx->old_##func, prefix##_##func); \
-        } \
+    if (wanted) { \
+        logDebug("Patched " #func " %p with %p", ctx->old_##func, prefix##_##func); \
     } else { \
         logDebug("Restored " #func); \
     } \
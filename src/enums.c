@@ -0,0 +1,33 @@
+#include "enums.h"
+
+int enum_table_sorted(const EnumTable* table)
+{
+    for (size_t i = 1; i < table->count; i++) {
+        if (table->names[i - 1].value >= table->names[i].value) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+const char* enum_table_find(const EnumTable* table, const uint32_t value)
+{
+    const EnumName* base = table->names;
+    size_t count = table->count;
+
+    if (count == 0) {
+        return NULL;
+    }
+
+    // Halve the range without an early exit, the loop branch is the only
+    // one that isn't a conditional move
+    while (count > 1) {
+        const size_t half = count / 2;
+
+        base = (base[half].value <= value) ? base + half : base;
+        count -= half;
+    }
+
+    return base->value == value ? base->name : NULL;
+}
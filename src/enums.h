@@ -0,0 +1,31 @@
+#ifndef ENUMS_H
+#define ENUMS_H
+
+// Enum value to name tables, sorted by value and searched with a binary search.
+// This file has no AmigaOS dependencies so that the same tables can be used
+// by decoders on other hosts. Tables are generated from X(name, value) lists
+// that are kept in value order, see ogles2_enums.h.
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct EnumName {
+    uint32_t value;
+    const char* name;
+} EnumName;
+
+typedef struct EnumTable {
+    const EnumName* names;
+    size_t count;
+} EnumTable;
+
+#define ENUM_ENTRY(name, value) { (uint32_t)(value), #name },
+#define ENUM_TABLE(array) { array, sizeof(array) / sizeof(array[0]) }
+
+// Nonzero when the values are strictly increasing, as the lookup needs
+int enum_table_sorted(const EnumTable* table);
+
+// Returns NULL when the value is not in the table
+const char* enum_table_find(const EnumTable* table, const uint32_t value);
+
+#endif
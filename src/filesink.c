@@ -0,0 +1,332 @@
+#include "filesink.h"
+#include "timer.h"
+
+#include <proto/exec.h>
+#include <proto/dos.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#define SINK_BUFFER_SIZE (512 * 1024)
+#define FLUSH_INTERVAL_MS 500 // A partly filled buffer is written after this, in case the machine hangs
+
+typedef struct SinkBuffer {
+    char* data;
+    size_t used;
+    size_t lines;
+} SinkBuffer;
+
+typedef struct SinkStatistics {
+    uint64 lines;
+    uint64 bytes;
+    uint64 waits; // How many times a caller had to wait for the writer
+    uint64 waitTicks;
+    uint64 writeTicks; // Time spent inside DOS Write()
+    uint64 writeErrors;
+    uint64 droppedLines; // Lines in the buffers that failed to write
+    uint64 startTicks;
+} SinkStatistics;
+
+static BPTR file;
+static APTR mutex;
+static SinkBuffer buffers[2];
+static SinkBuffer* active; // Filled by traced tasks
+static SinkBuffer* pending; // Being written by the writer process
+static SinkStatistics stats;
+
+static struct Process* writerProcess;
+static volatile BOOL writerRunning;
+
+// Set by filesink_close(). Late callers drop their lines instead of waiting
+// for buffers that are about to be freed. users counts callers inside
+// filesink_write() so that close knows when the mutex can go.
+static uint32 closing;
+static uint32 users;
+static uint32 closedLines;
+
+static void write_buffer(SinkBuffer* buffer)
+{
+    if (buffer->used) {
+        const uint64 start = timer_get_ticks();
+        const BOOL failed = IDOS->Write(file, buffer->data, (int32)buffer->used) != (int32)buffer->used;
+        const uint64 duration = timer_get_ticks() - start;
+
+        IExec->MutexObtain(mutex);
+
+        if (failed) {
+            stats.writeErrors++;
+            stats.droppedLines += buffer->lines;
+        }
+
+        stats.writeTicks += duration;
+
+        IExec->MutexRelease(mutex);
+
+        buffer->used = 0;
+        buffer->lines = 0;
+    }
+}
+
+// Returns TRUE when a buffer was written. When flush is set, the active
+// buffer is swapped out first if it has any lines.
+static BOOL write_pending(const BOOL flush)
+{
+    IExec->MutexObtain(mutex);
+
+    if (flush && !pending && active->used) {
+        pending = active;
+        active = (active == &buffers[0]) ? &buffers[1] : &buffers[0];
+    }
+
+    SinkBuffer* buffer = pending;
+
+    IExec->MutexRelease(mutex);
+
+    if (buffer) {
+        write_buffer(buffer);
+
+        IExec->MutexObtain(mutex);
+        pending = NULL;
+        IExec->MutexRelease(mutex);
+    }
+
+    return buffer != NULL;
+}
+
+// Polls every tick for a full buffer, and writes a partly filled one once
+// nothing was written for FLUSH_INTERVAL_MS
+static void writer_process(void)
+{
+    const uint64 interval = timer_get_frequency() * FLUSH_INTERVAL_MS / 1000;
+    uint64 lastWrite = timer_get_ticks();
+    BOOL quit = FALSE;
+
+    while (!quit) {
+        quit = (IExec->SetSignal(0L, SIGBREAKF_CTRL_C) & SIGBREAKF_CTRL_C) != 0;
+
+        const uint64 now = timer_get_ticks();
+
+        if (write_pending(now - lastWrite > interval)) {
+            lastWrite = now;
+        }
+
+        if (!quit) {
+            IDOS->Delay(1);
+        }
+    }
+
+    writerRunning = FALSE;
+}
+
+BOOL filesink_open(const char* const name)
+{
+    memset(&stats, 0, sizeof(stats));
+
+    closing = 0;
+    users = 0;
+    closedLines = 0;
+
+    file = IDOS->Open(name, MODE_NEWFILE);
+
+    if (!file) {
+        printf("Failed to open output file '%s'\n", name);
+        return FALSE;
+    }
+
+    mutex = IExec->AllocSysObject(ASOT_MUTEX, TAG_DONE);
+
+    for (int i = 0; i < 2; i++) {
+        buffers[i].data = IExec->AllocVecTags(SINK_BUFFER_SIZE, AVT_Type, MEMF_SHARED, TAG_DONE);
+        buffers[i].used = 0;
+        buffers[i].lines = 0;
+    }
+
+    if (!mutex || !buffers[0].data || !buffers[1].data) {
+        puts("Failed to allocate output buffers");
+        filesink_close();
+        return FALSE;
+    }
+
+    active = &buffers[0];
+    pending = NULL;
+
+    writerRunning = TRUE;
+
+    writerProcess = IDOS->CreateNewProcTags(
+        NP_Entry, writer_process,
+        NP_Name, "glSnoop file writer",
+        NP_Priority, 0,
+        NP_Child, TRUE,
+        TAG_DONE);
+
+    if (!writerProcess) {
+        puts("Failed to create file writer process");
+        writerRunning = FALSE;
+        filesink_close();
+        return FALSE;
+    }
+
+    stats.startTicks = timer_get_ticks();
+
+    return TRUE;
+}
+
+static void print_statistics(void)
+{
+    const double seconds = timer_ticks_to_s(timer_get_ticks() - stats.startTicks);
+    const double writeSeconds = timer_ticks_to_s(stats.writeTicks);
+    const double megabytes = (double)stats.bytes / (1024.0 * 1024.0);
+
+    printf("Output file: %llu lines, %llu bytes in %.3f seconds (%.0f lines/s, %.3f MB/s)\n",
+        stats.lines, stats.bytes, seconds,
+        seconds > 0.0 ? (double)stats.lines / seconds : 0.0,
+        seconds > 0.0 ? megabytes / seconds : 0.0);
+
+    printf("Output file: writer busy %.3f seconds (%.3f MB/s), %llu write errors\n",
+        writeSeconds, writeSeconds > 0.0 ? megabytes / writeSeconds : 0.0, stats.writeErrors);
+
+    printf("Output file: callers waited for a free buffer %llu times, %.3f ms in total\n",
+        stats.waits, timer_ticks_to_ms(stats.waitTicks));
+
+    if (closedLines) {
+        printf("Output file: %lu lines dropped while closing\n", closedLines);
+    }
+}
+
+void filesink_close(void)
+{
+    if (mutex) {
+        IExec->MutexObtain(mutex);
+        __atomic_store_n(&closing, 1, __ATOMIC_SEQ_CST);
+        IExec->MutexRelease(mutex);
+
+        // Callers stuck in the back-pressure loop notice the flag and leave
+        while (__atomic_load_n(&users, __ATOMIC_SEQ_CST)) {
+            IDOS->Delay(1);
+        }
+    }
+
+    if (writerProcess) {
+        IExec->Signal((struct Task *)writerProcess, SIGBREAKF_CTRL_C);
+
+        while (writerRunning) {
+            IDOS->Delay(1);
+        }
+
+        writerProcess = NULL;
+
+        if (pending) {
+            write_buffer(pending);
+        }
+
+        write_buffer(active);
+
+        print_statistics();
+    }
+
+    for (int i = 0; i < 2; i++) {
+        if (buffers[i].data) {
+            IExec->FreeVec(buffers[i].data);
+            buffers[i].data = NULL;
+        }
+    }
+
+    active = NULL;
+    pending = NULL;
+
+    if (mutex) {
+        IExec->FreeSysObject(ASOT_MUTEX, mutex);
+        mutex = NULL;
+    }
+
+    if (file) {
+        IDOS->Close(file);
+        file = ZERO;
+    }
+}
+
+void filesink_counters(SinkCounters * counters)
+{
+    IExec->MutexObtain(mutex);
+
+    counters->written = stats.lines;
+    counters->dropped = stats.droppedLines;
+    counters->bytes = stats.bytes;
+    counters->blockedTicks = stats.waitTicks;
+
+    IExec->MutexRelease(mutex);
+}
+
+BOOL filesink_enabled(void)
+{
+    return writerProcess != NULL;
+}
+
+void filesink_write(const char* const prefix, const char* const text)
+{
+    const size_t prefixLen = strlen(prefix);
+    size_t textLen = strlen(text);
+
+    if (prefixLen + textLen + 1 > SINK_BUFFER_SIZE) {
+        textLen = SINK_BUFFER_SIZE - prefixLen - 1;
+    }
+
+    const size_t len = prefixLen + textLen + 1;
+
+    __atomic_add_fetch(&users, 1, __ATOMIC_SEQ_CST);
+
+    if (__atomic_load_n(&closing, __ATOMIC_SEQ_CST)) {
+        __atomic_add_fetch(&closedLines, 1, __ATOMIC_RELAXED);
+        __atomic_sub_fetch(&users, 1, __ATOMIC_RELEASE);
+        return;
+    }
+
+    IExec->MutexObtain(mutex);
+
+    uint64 waitStart = 0;
+
+    while (active->used + len > SINK_BUFFER_SIZE) {
+        if (closing) {
+            IExec->MutexRelease(mutex);
+            __atomic_add_fetch(&closedLines, 1, __ATOMIC_RELAXED);
+            __atomic_sub_fetch(&users, 1, __ATOMIC_RELEASE);
+            return;
+        }
+
+        if (!pending) {
+            // The writer picks it up on its next tick
+            pending = active;
+            active = (active == &buffers[0]) ? &buffers[1] : &buffers[0];
+        } else {
+            // Back-pressure: both buffers are full, wait for the writer
+            if (!waitStart) {
+                waitStart = timer_get_ticks();
+                stats.waits++;
+            }
+
+            IExec->MutexRelease(mutex);
+            IDOS->Delay(1);
+            IExec->MutexObtain(mutex);
+        }
+    }
+
+    if (waitStart) {
+        stats.waitTicks += timer_get_ticks() - waitStart;
+    }
+
+    char* ptr = active->data + active->used;
+
+    memcpy(ptr, prefix, prefixLen);
+    memcpy(ptr + prefixLen, text, textLen);
+    ptr[prefixLen + textLen] = '\n';
+
+    active->used += len;
+    active->lines++;
+
+    stats.lines++;
+    stats.bytes += len;
+
+    IExec->MutexRelease(mutex);
+
+    __atomic_sub_fetch(&users, 1, __ATOMIC_RELEASE);
+}
@@ -0,0 +1,19 @@
+#ifndef FILESINK_H
+#define FILESINK_H
+
+#include "sinks.h"
+
+#include <exec/types.h>
+
+// Double-buffered log output to a DOS file. A writer process flushes one
+// buffer while traced tasks fill the other.
+
+BOOL filesink_open(const char* const name);
+void filesink_close(void);
+BOOL filesink_enabled(void);
+void filesink_counters(SinkCounters * counters);
+
+// Append prefix, text and a line feed
+void filesink_write(const char* const prefix, const char* const text);
+
+#endif
@@ -1,55 +1,393 @@
 #include "filter.h"
 #include "logger.h"
+#include "common.h"
+
+#include <proto/exec.h>
+#include <proto/dos.h>
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <ctype.h>
 
 #define MAX_FILTER 300
+#define MAX_PATTERNS 64
+#define FILTER_TABLE_SIZE 1024 // Power of two, keeps the table sparse
+#define FILTER_LINE_LEN 256
+#define MAX_PREDICATES 64
+
+typedef struct FilterEntry {
+    char* name;
+    BOOL negate;
+} FilterEntry;
+
+// Argument condition as written in the file, for example "glTexImage2D width>=1024"
+typedef struct FilterPredicate {
+    char* function;
+    char* argument;
+    PredicateOp op;
+    BOOL integer; // FALSE when the value has a fraction or an exponent
+    int32_t value;
+    float floatValue;
+} FilterPredicate;
+
+typedef struct FilterGroup {
+    const char* name;
+    FilterCategory category;
+} FilterGroup;
+
+static const FilterGroup groups[] = {
+    { "draw", Category_Draw },
+    { "state", Category_State },
+    { "query", Category_Query },
+    { "upload", Category_Upload },
+    { "shader", Category_Shader }
+};
+
+typedef struct FilterRules {
+    FilterEntry filters[FILTER_TABLE_SIZE]; // Exact names. Open addressing, indexed by name hash
+    FilterEntry patterns[MAX_PATTERNS]; // Wildcards
+    size_t count;
+    size_t patternCount;
+    size_t positiveCount; // When zero, everything not negated matches
+    uint8 groups; // Categories
+    uint8 negatedGroups;
+    FilterPredicate predicates[MAX_PREDICATES];
+    size_t predicateCount;
+    const char* fileName; // Owned by the caller of load_filters
+} FilterRules;
+
+static FilterRules sets[FilterSet_Count];
+static char* taskPattern; // Parsed AmigaDOS pattern
+static const char* const setNames[FilterSet_Count] = { "profile", "trace" };
+
+static uint32 hash_name(const char* name)
+{
+    uint32 hash = 2166136261UL; // FNV-1a
+
+    while (*name) {
+        hash ^= (UBYTE)*name++;
+        hash *= 16777619UL;
+    }
+
+    return hash;
+}
+
+// Returns the slot of the name, or the empty slot where it would be added
+static FilterEntry* find_slot(FilterRules* const rules, const char* const name)
+{
+    size_t i = hash_name(name) & (FILTER_TABLE_SIZE - 1);
+
+    while (rules->filters[i].name && strcmp(rules->filters[i].name, name) != 0) {
+        i = (i + 1) & (FILTER_TABLE_SIZE - 1);
+    }
 
-static char* filters[MAX_FILTER];
-static size_t count;
+    return &rules->filters[i];
+}
 
-static void add_filter(const char* const name)
+// '*' matches any sequence of characters, '?' matches one character
+static BOOL glob_match(const char* pattern, const char* name)
+{
+    const char* star = NULL;
+    const char* retry = NULL;
+
+    while (*name) {
+        if (*pattern == '*') {
+            star = pattern++;
+            retry = name;
+        } else if (*pattern == '?' || *pattern == *name) {
+            pattern++;
+            name++;
+        } else if (star) {
+            pattern = star + 1;
+            name = ++retry;
+        } else {
+            return FALSE;
+        }
+    }
+
+    while (*pattern == '*') {
+        pattern++;
+    }
+
+    return *pattern == '\0';
+}
+
+static void add_pattern(FilterRules* const rules, const char* const pattern, const BOOL negate)
+{
+    if (rules->patternCount < MAX_PATTERNS) {
+        rules->patterns[rules->patternCount].name = strdup(pattern);
+        rules->patterns[rules->patternCount].negate = negate;
+        logLine("Filter pattern[%lu] '%s%s' added", (ULONG)rules->patternCount, negate ? "!" : "", pattern);
+        rules->patternCount++;
+
+        if (!negate) {
+            rules->positiveCount++;
+        }
+    } else {
+        printf("Too many filter patterns, '%s' ignored\n", pattern);
+    }
+}
+
+static BOOL add_group(FilterRules* const rules, const char* const name, const BOOL negate)
+{
+    for (size_t i = 0; i < sizeof(groups) / sizeof(groups[0]); i++) {
+        if (strcmp(groups[i].name, name) == 0) {
+            if (negate) {
+                rules->negatedGroups |= (uint8)groups[i].category;
+            } else {
+                rules->groups |= (uint8)groups[i].category;
+                rules->positiveCount++;
+            }
+
+            logLine("Filter group '%s@%s' added", negate ? "!" : "", name);
+            return TRUE;
+        }
+    }
+
+    printf("Unknown filter group '@%s'\n", name);
+    return FALSE;
+}
+
+static BOOL add_filter(FilterRules* const rules, const char* name)
 {
     if (!name) {
         logLine("%s: NULL pointer\n", __func__);
-        return;
+        return FALSE;
+    }
+
+    const BOOL negate = *name == '!';
+
+    if (negate) {
+        name++;
+    }
+
+    if (*name == '@') {
+        return add_group(rules, name + 1, negate);
+    }
+
+    if (strpbrk(name, "*?")) {
+        add_pattern(rules, name, negate);
+        return TRUE;
     }
 
     if (strlen(name) > 0) {
-        if (count < MAX_FILTER) {
-            if (filters[count] == NULL) {
-                filters[count] = strdup(name);
-                logLine("Filter[%u] '%s' added", count, filters[count]);
-                count++;
+        if (rules->count < MAX_FILTER) {
+            FilterEntry* slot = find_slot(rules, name);
+
+            if (slot->name == NULL) {
+                slot->name = strdup(name);
+                slot->negate = negate;
+                logLine("Filter[%u] '%s%s' added", (unsigned)rules->count, negate ? "!" : "", slot->name);
+                rules->count++;
+
+                if (!negate) {
+                    rules->positiveCount++;
+                }
+            } else if (negate && !slot->negate) {
+                // Negation wins over an earlier listing of the same name
+                slot->negate = TRUE;
+                rules->positiveCount--;
             }
         }
     }
+
+    return TRUE;
 }
 
-static void strip(char* const buffer)
+static const struct {
+    const char* text;
+    PredicateOp op;
+} predicateOps[] = {
+    // Two character operators first
+    { "==", PredicateOp_Equal },
+    { "!=", PredicateOp_NotEqual },
+    { "<=", PredicateOp_LessEqual },
+    { ">=", PredicateOp_GreaterEqual },
+    { "=", PredicateOp_Equal },
+    { "<", PredicateOp_Less },
+    { ">", PredicateOp_Greater }
+};
+
+// Parses "argument<op>value" following a function name on the same line
+static BOOL add_predicate(FilterRules* const rules, const char* const function, char* const text)
+{
+    if (!function) {
+        printf("Filter condition '%s' must follow a function name\n", text);
+        return FALSE;
+    }
+
+    const size_t argumentLen = strcspn(text, "<>=!");
+    const char* ptr = text + argumentLen;
+
+    size_t i;
+    for (i = 0; i < sizeof(predicateOps) / sizeof(predicateOps[0]); i++) {
+        if (strncmp(ptr, predicateOps[i].text, strlen(predicateOps[i].text)) == 0) {
+            ptr += strlen(predicateOps[i].text);
+            break;
+        }
+    }
+
+    // The argument type is known only when the condition is compiled, so keep both forms
+    char* end = NULL;
+    const long long parsed = strtoll(ptr, &end, 0);
+    const BOOL integer = end != ptr && !*end;
+
+    if (!integer) {
+        end = NULL;
+    }
+
+    const float floatValue = integer ? (float)parsed : strtof(ptr, &end);
+
+    if (argumentLen == 0 || i == sizeof(predicateOps) / sizeof(predicateOps[0]) || end == ptr || *end) {
+        printf("Invalid filter condition '%s' for %s\n", text, function);
+        return FALSE;
+    }
+
+    // Arguments are 32-bit words, unsigned constants like 0xFFFFFFFF are allowed
+    if (integer && (parsed < INT32_MIN || parsed > (long long)UINT32_MAX)) {
+        printf("Filter condition '%s' for %s: the value doesn't fit in 32 bits\n", text, function);
+        return FALSE;
+    }
+
+    const int32_t value = (int32_t)(uint32_t)parsed;
+
+    if (rules->predicateCount >= MAX_PREDICATES) {
+        printf("Too many filter conditions, '%s' ignored\n", text);
+        return TRUE;
+    }
+
+    if (rules == &sets[FilterSet_Profile] && rules->predicateCount == 0) {
+        printf("Note: conditions in the profile filter file only limit logging, all calls are profiled\n");
+    }
+
+    FilterPredicate* const predicate = &rules->predicates[rules->predicateCount++];
+
+    text[argumentLen] = '\0';
+
+    predicate->function = strdup(function);
+    predicate->argument = strdup(text);
+    predicate->op = predicateOps[i].op;
+    predicate->integer = integer;
+    predicate->value = value;
+    predicate->floatValue = floatValue;
+
+    logLine("Filter condition %s: %s %s %s added", function, text, predicateOps[i].text, ptr);
+
+    return TRUE;
+}
+
+// Removes comments and splits the line into whitespace separated entries.
+// Entries with a comparison are conditions of the function name before them.
+static BOOL parse_line(FilterRules* const rules, char* const buffer)
 {
     if (!buffer) {
         logLine("%s: NULL pointer\n", __func__);
-        return;
+        return FALSE;
     }
 
-    size_t i;
-    for (i = 0; i < strlen(buffer); i++) {
-        switch (buffer[i]) {
-            case ' ':
-            case '\n':
-            case '#':
-            case ';':
-                buffer[i] = 0;
-                break;
+    buffer[strcspn(buffer, "#;")] = '\0';
+
+    BOOL result = TRUE;
+    char* ptr = buffer;
+    const char* function = NULL;
+
+    while (*ptr) {
+        while (*ptr && isspace((unsigned char)*ptr)) {
+            ptr++;
+        }
+
+        char* const start = ptr;
+
+        while (*ptr && !isspace((unsigned char)*ptr)) {
+            ptr++;
+        }
+
+        if (*ptr) {
+            *ptr++ = '\0';
+        }
+
+        if (!*start) {
+            continue;
+        }
+
+        if (*start != '!' && strpbrk(start, "<>=")) {
+            if (!add_predicate(rules, function, start)) {
+                result = FALSE;
+            }
+            continue;
+        }
+
+        // Only exact names can have conditions
+        function = strpbrk(start, "!@*?") ? NULL : start;
+
+        if (!add_filter(rules, start)) {
+            result = FALSE;
         }
     }
+
+    return result;
 }
 
-BOOL load_filters(const char* const fileName)
+static BOOL read_filters(FilterRules* const rules, FILE* const file)
 {
+    BOOL result = TRUE;
+    char buffer[FILTER_LINE_LEN];
+
+    while (fgets(buffer, sizeof(buffer), file) != NULL) {
+        const size_t len = strlen(buffer);
+
+        if (len > 0 && buffer[len - 1] != '\n' && !feof(file)) {
+            // Only long comments are expected here, skip the rest of the line
+            int c;
+            while ((c = fgetc(file)) != EOF && c != '\n') {
+            }
+        }
+
+        if (!parse_line(rules, buffer)) {
+            result = FALSE;
+        }
+    }
+
+    fclose(file);
+    return result;
+}
+
+static void free_rules(FilterRules* const rules)
+{
+    size_t i;
+    for (i = 0; i < FILTER_TABLE_SIZE; i++) {
+        free(rules->filters[i].name);
+        rules->filters[i].name = NULL;
+        rules->filters[i].negate = FALSE;
+    }
+
+    for (i = 0; i < rules->patternCount; i++) {
+        free(rules->patterns[i].name);
+        rules->patterns[i].name = NULL;
+    }
+
+    for (i = 0; i < rules->predicateCount; i++) {
+        free(rules->predicates[i].function);
+        free(rules->predicates[i].argument);
+        rules->predicates[i].function = NULL;
+        rules->predicates[i].argument = NULL;
+    }
+
+    rules->count = 0;
+    rules->patternCount = 0;
+    rules->positiveCount = 0;
+    rules->groups = 0;
+    rules->negatedGroups = 0;
+    rules->predicateCount = 0;
+}
+
+BOOL load_filters(const FilterSet set, const char* const fileName)
+{
+    FilterRules* const rules = &sets[set];
+
+    rules->fileName = fileName;
+
     if (!fileName) {
         // No problem, we don't filter, then
         return TRUE;
@@ -58,38 +396,122 @@ BOOL load_filters(const char* const fileName)
     FILE* file = fopen(fileName, "r");
 
     if (!file) {
-        printf("Failed to open filter file '%s'\n", fileName);
+        printf("Failed to open %s filter file '%s'\n", setNames[set], fileName);
         return FALSE;
     }
 
-    char buffer[64];
-    while (!feof(file)) {
-        if (fgets(buffer, sizeof(buffer), file) != NULL) {
-            strip(buffer);
-            add_filter(buffer);
+    return read_filters(rules, file);
+}
+
+BOOL filter_file_loaded(void)
+{
+    for (int set = 0; set < FilterSet_Count; set++) {
+        if (sets[set].fileName) {
+            return TRUE;
         }
     }
 
-    fclose(file);
-    return TRUE;
+    return FALSE;
 }
 
-BOOL match(const char* const name)
+BOOL reload_filters(void)
 {
-    if (!name) {
-        logLine("%s: NULL pointer\n", __func__);
+    BOOL result = FALSE;
+
+    for (int set = 0; set < FilterSet_Count; set++) {
+        FilterRules* const rules = &sets[set];
+
+        if (!rules->fileName) {
+            continue;
+        }
+
+        FILE* file = fopen(rules->fileName, "r");
+
+        if (!file) {
+            logAlways("Failed to open %s filter file '%s', keeping the current filter", setNames[set], rules->fileName);
+            continue;
+        }
+
+        logAlways("Reloading %s filter file '%s'", setNames[set], rules->fileName);
+
+        free_rules(rules);
+
+        // Errors are reported, but the entries read are still applied
+        read_filters(rules, file);
+
+        result = TRUE;
+    }
+
+    if (!filter_file_loaded()) {
+        logAlways("No filter file to reload");
+    }
+
+    return result;
+}
+
+static BOOL match(FilterRules* const rules, const char* const name, const uint8 category)
+{
+    const FilterEntry* entry = find_slot(rules, name);
+
+    if ((entry->name && entry->negate) || (rules->negatedGroups & category)) {
         return FALSE;
     }
 
-    if (count == 0) {
-        // No filters in use
-        return TRUE;
+    BOOL result = (rules->positiveCount == 0) || (entry->name != NULL) || (rules->groups & category);
+
+    for (size_t i = 0; i < rules->patternCount; i++) {
+        if (glob_match(rules->patterns[i].name, name)) {
+            if (rules->patterns[i].negate) {
+                return FALSE;
+            }
+
+            result = TRUE;
+        }
     }
 
-    size_t i;
-    for (i = 0; i < count; i++) {
-        if (filters[i] && (strcmp(name, filters[i]) == 0)) {
-            //logLine("Match '%s' vs '%s'", name, filters[i]);
+    return result;
+}
+
+void filter_compile(const FilterSet set, uint32* const bits, const FilterTable* const table)
+{
+    // Each word is built aside and stored once, so wrappers reading the set
+    // during a reload see either the old or the new bits, never a cleared word
+    size_t enabled = 0;
+
+    for (size_t word = 0; word < FILTER_WORDS(table->count); word++) {
+        uint32 value = 0;
+
+        for (size_t id = word * 32; id < table->count && id < (word + 1) * 32; id++) {
+            if (match(&sets[set], table->names[id], table->categories[id])) {
+                value |= (uint32)1 << (id % 32);
+                enabled++;
+            }
+        }
+
+        __atomic_store_n(&bits[word], value, __ATOMIC_RELEASE);
+    }
+
+    logDebug("Filter compiled: %lu of %lu functions in %s set", (ULONG)enabled, (ULONG)table->count, setNames[set]);
+}
+
+// Scalar floating point parameter like "GLfloat red" or "const double depth"
+static BOOL is_float_parameter(const char* const start, const char* const name)
+{
+    static const char* const types[] = { "GLfloat", "GLclampf", "float", "double" };
+
+    const char* type = start + strspn(start, " ");
+
+    if (strncmp(type, "const ", 6) == 0) {
+        type += 6;
+    }
+
+    const size_t len = (size_t)(name - type);
+
+    for (size_t i = 0; i < sizeof(types) / sizeof(types[0]); i++) {
+        const size_t typeLen = strlen(types[i]);
+
+        // Pointers and arrays are not floats
+        if (len > typeLen && strncmp(type, types[i], typeLen) == 0 && strspn(type + typeLen, " ") == len - typeLen) {
             return TRUE;
         }
     }
@@ -97,14 +519,175 @@ BOOL match(const char* const name)
     return FALSE;
 }
 
-void free_filters(void)
+// Returns the argument index of the parameter in a signature like
+// "(struct OGLES2IFace *Self, GLenum mode, GLint first)", or -1. The first
+// parameter is the interface or context, it's not an argument word.
+static int find_argument(const char* signature, const char* const argument, BOOL* const isFloat)
 {
-    size_t i;
-    for (i = 0; i < count; i++) {
-        free(filters[i]);
-        filters[i] = NULL;
+    const size_t len = strlen(argument);
+    int index = -1;
+
+    while (*signature && *signature != ')') {
+        // Parameter name is the last identifier before ',', '[' or ')'
+        const char* const end = signature + strcspn(signature, ",[)");
+        const char* start = end;
+
+        while (start > signature && (isalnum((unsigned char)start[-1]) || start[-1] == '_')) {
+            start--;
+        }
+
+        if (index >= 0 && (size_t)(end - start) == len && strncmp(start, argument, len) == 0) {
+            *isFloat = *end != '[' && is_float_parameter(signature + (*signature == '('), start);
+            return index;
+        }
+
+        signature = end + strcspn(end, ",)");
+        if (*signature == ',') {
+            signature++;
+        }
+
+        index++;
+    }
+
+    return -1;
+}
+
+static void compile_predicate(Predicate* const predicate, const FilterPredicate* const source, const char* const signature)
+{
+    BOOL isFloat = FALSE;
+    const int arg = find_argument(signature, source->argument, &isFloat);
+
+    if (arg < 0) {
+        logAlways("Filter condition ignored: %s has no argument '%s'", source->function, source->argument);
+        return;
+    }
+
+    if (!isFloat && !source->integer) {
+        logAlways("Filter condition ignored: %s argument '%s' is an integer, the value is not", source->function,
+            source->argument);
+        return;
+    }
+
+    if (predicate->count >= MAX_PREDICATE_TERMS) {
+        logAlways("Filter condition ignored: too many conditions for %s", source->function);
+        return;
+    }
+
+    PredicateTerm* const term = &predicate->terms[predicate->count++];
+
+    term->arg = (uint8)arg;
+    term->op = (uint8)source->op;
+    term->isFloat = (uint8)isFloat;
+
+    if (isFloat) {
+        term->value.f = source->floatValue;
+    } else {
+        term->value.i = source->value;
+    }
+}
+
+void filter_compile_predicates(PredicateSet** const set, const FilterTable* const table)
+{
+    const size_t size = sizeof(PredicateSet) + table->count * sizeof(Predicate);
+
+    PredicateSet* const compiled = IExec->AllocVecTags(size, AVT_Type, MEMF_SHARED, AVT_ClearValue, 0, TAG_DONE);
+
+    if (!compiled) {
+        logAlways("Cannot allocate memory for filter conditions, keeping the current ones");
+        return;
+    }
+
+    size_t conditional = 0;
+
+    for (size_t id = 0; id < table->count; id++) {
+        for (int fileSet = 0; fileSet < FilterSet_Count; fileSet++) {
+            const FilterRules* const rules = &sets[fileSet];
+
+            for (size_t i = 0; i < rules->predicateCount; i++) {
+                if (strcmp(rules->predicates[i].function, table->names[id]) == 0) {
+                    compile_predicate(&compiled->predicates[id], &rules->predicates[i], table->signatures[id]);
+                }
+            }
+        }
+
+        if (compiled->predicates[id].count) {
+            conditional++;
+        }
+    }
+
+    logDebug("Filter conditions compiled: %lu of %lu functions", (ULONG)conditional, (ULONG)table->count);
+
+    PredicateSet* const current = *set;
+
+    // Nothing to replace, or the same conditions
+    if ((!current && !conditional) ||
+        (current && memcmp(current->predicates, compiled->predicates, table->count * sizeof(Predicate)) == 0)) {
+        IExec->FreeVec(compiled);
+        return;
     }
 
-    count = 0;
+    // The replaced set stays readable for the wrappers that loaded it
+    compiled->retired = current;
+    __atomic_store_n(set, compiled, __ATOMIC_RELEASE);
 }
 
+void filter_free_predicates(PredicateSet** const set)
+{
+    PredicateSet* current = *set;
+
+    *set = NULL;
+
+    while (current) {
+        PredicateSet* const retired = current->retired;
+        IExec->FreeVec(current);
+        current = retired;
+    }
+}
+
+size_t filter_count(const uint32* const bits, const size_t functionCount)
+{
+    size_t result = 0;
+
+    for (size_t id = 0; id < functionCount; id++) {
+        if (filter_test(bits, id)) {
+            result++;
+        }
+    }
+
+    return result;
+}
+
+BOOL set_task_filter(const char* const pattern)
+{
+    if (!pattern) {
+        return TRUE;
+    }
+
+    const size_t size = strlen(pattern) * 2 + 2;
+
+    taskPattern = malloc(size);
+
+    if (!taskPattern || IDOS->ParsePatternNoCase(pattern, taskPattern, (int32)size) < 0) {
+        printf("Invalid TASK pattern '%s'\n", pattern);
+        free(taskPattern);
+        taskPattern = NULL;
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+BOOL task_filter_match(const char* const name)
+{
+    return !taskPattern || IDOS->MatchPatternNoCase(taskPattern, (STRPTR)name);
+}
+
+void free_filters(void)
+{
+    for (int set = 0; set < FilterSet_Count; set++) {
+        free_rules(&sets[set]);
+    }
+
+    free(taskPattern);
+    taskPattern = NULL;
+}
@@ -1,10 +1,160 @@
 #ifndef FILTER_H
 #define FILTER_H
 
+#include "trace.h"
+
 #include <exec/types.h>
 
-BOOL load_filters(const char* const fileName);
-BOOL match(const char* const name);
+#include <stddef.h>
+
+// Filters are compiled into one bit per function id, so patching only tests a bit
+#define FILTER_WORDS(count) (((count) + 31) / 32)
+
+// Function categories, selected in filter files with groups like @draw
+typedef enum FilterCategory {
+    Category_None = 0,
+    Category_Draw = 1 << 0,
+    Category_State = 1 << 1,
+    Category_Query = 1 << 2,
+    Category_Upload = 1 << 3,
+    Category_Shader = 1 << 4
+} FilterCategory;
+
+// Per function id tables of a library, generated from its function list
+typedef struct FilterTable {
+    size_t count;
+    const char* const* names; // Library names, for example "glDrawArrays"
+    const uint8* categories;
+    const char* const* signatures; // Parameter lists, the first one is the interface or context
+} FilterTable;
+
+#define MAX_PREDICATE_TERMS 4
+
+typedef enum PredicateOp {
+    PredicateOp_Equal,
+    PredicateOp_NotEqual,
+    PredicateOp_Less,
+    PredicateOp_LessEqual,
+    PredicateOp_Greater,
+    PredicateOp_GreaterEqual
+} PredicateOp;
+
+typedef struct PredicateTerm {
+    uint8 arg; // Index into the argument words
+    uint8 op;
+    uint8 isFloat; // GLfloat, float and double parameters are compared as floats
+    union {
+        int32_t i;
+        float f;
+    } value;
+} PredicateTerm;
+
+// Argument conditions of one function, all terms must be true
+typedef struct Predicate {
+    uint32 count;
+    PredicateTerm terms[MAX_PREDICATE_TERMS];
+} Predicate;
+
+// Compiled conditions of a library, indexed by function id. Wrappers read the
+// set without locking, so a reload compiles a new one and publishes it with one
+// pointer store. Replaced sets are kept until filter_free_predicates, because
+// a wrapper may still be reading one.
+typedef struct PredicateSet {
+    struct PredicateSet* retired; // Previous sets
+    Predicate predicates[];
+} PredicateSet;
+
+// Patched functions are profiled, and traced only if they are in the trace set too
+typedef enum FilterSet {
+    FilterSet_Profile,
+    FilterSet_Trace,
+    FilterSet_Count // KEEP LAST
+} FilterSet;
+
+BOOL load_filters(const FilterSet set, const char* const fileName);
+// Reads the filter files again. A filter is kept if its file can't be opened.
+BOOL reload_filters(void);
+BOOL filter_file_loaded(void);
+void filter_compile(const FilterSet set, uint32* const bits, const FilterTable* const table);
+// Compiles the argument conditions of both files and publishes them in *set,
+// which stays NULL until there are any. Conditions only decide what is logged
+// and recorded, profiling counts every call.
+void filter_compile_predicates(PredicateSet** const set, const FilterTable* const table);
+void filter_free_predicates(PredicateSet** const set);
+// Tasks are matched by the name built by find_process_name2, for example "#?quake#?"
+BOOL set_task_filter(const char* const pattern);
+BOOL task_filter_match(const char* const name);
+
+size_t filter_count(const uint32* const bits, const size_t functionCount);
 void free_filters(void);
 
+static inline BOOL filter_test(const uint32* const bits, const size_t id)
+{
+    return ((bits[id / 32] >> (id % 32)) & 1) != 0;
+}
+
+static inline void filter_set(uint32* const bits, const size_t id, const BOOL value)
+{
+    if (value) {
+        bits[id / 32] |= (uint32)1 << (id % 32);
+    } else {
+        bits[id / 32] &= ~((uint32)1 << (id % 32));
+    }
+}
+
+// Arguments are compared as signed 32-bit words, or as floats for floating point parameters.
+// A NaN argument only matches !=.
+static inline BOOL predicate_match(const Predicate* const predicate, const uint32_t* const args)
+{
+    for (uint32 i = 0; i < predicate->count; i++) {
+        const PredicateTerm* const term = &predicate->terms[i];
+
+        BOOL result;
+
+        if (term->isFloat) {
+            union { uint32_t u; float f; } arg;
+            arg.u = args[term->arg];
+
+            switch (term->op) {
+                case PredicateOp_Equal: result = arg.f == term->value.f; break;
+                case PredicateOp_NotEqual: result = arg.f != term->value.f; break;
+                case PredicateOp_Less: result = arg.f < term->value.f; break;
+                case PredicateOp_LessEqual: result = arg.f <= term->value.f; break;
+                case PredicateOp_Greater: result = arg.f > term->value.f; break;
+                default: result = arg.f >= term->value.f; break;
+            }
+        } else {
+            const int32_t arg = (int32_t)args[term->arg];
+
+            switch (term->op) {
+                case PredicateOp_Equal: result = arg == term->value.i; break;
+                case PredicateOp_NotEqual: result = arg != term->value.i; break;
+                case PredicateOp_Less: result = arg < term->value.i; break;
+                case PredicateOp_LessEqual: result = arg <= term->value.i; break;
+                case PredicateOp_Greater: result = arg > term->value.i; break;
+                default: result = arg >= term->value.i; break;
+            }
+        }
+
+        if (!result) {
+            return FALSE;
+        }
+    }
+
+    return TRUE;
+}
+
+// Conditions of the function in the published set, NULL when it has none
+static inline const Predicate* predicate_find(PredicateSet* const* const set, const size_t id)
+{
+    const PredicateSet* const current = __atomic_load_n(set, __ATOMIC_ACQUIRE);
+
+    return (current && current->predicates[id].count) ? &current->predicates[id] : NULL;
+}
+
+// Packs the arguments only when the function has conditions. The leading zero keeps
+// the array valid for functions without parameters.
+#define PREDICATE_MATCH(predicate, ...) \
+    (!(predicate) || predicate_match(predicate, (const uint32_t[]){ 0, TRACE_WORDS(__VA_ARGS__) } + 1))
+
 #endif
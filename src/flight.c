@@ -0,0 +1,351 @@
+#include "flight.h"
+#include "common.h"
+#include "logger.h"
+#include "timer.h"
+
+#include <proto/exec.h>
+#include <proto/dos.h>
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+
+#define FLIGHT_CAPACITY 32768 // Records per client, must be a power of two
+#define MAX_FLIGHT_FRAMES 256
+#define FLIGHT_COOLDOWN_SECONDS 2 // Minimum time between dumps
+#define FLIGHT_NAME_LEN 256
+
+struct FlightClient
+{
+    struct FlightClient* next;
+    TraceHistory history;
+    TraceNameFunc mapFunction;
+    char name[NAME_LEN];
+
+    uint32_t frameStart[MAX_FLIGHT_FRAMES]; // History positions at frame boundaries
+    uint32_t frameCount;
+    uint64 lastFrameTicks;
+    uint32_t skipped; // Records not kept while a dump was being written
+};
+
+static struct FlightClient* clients; // List of the open clients
+static APTR mutex;
+
+static struct Process* dumpProcess;
+static volatile BOOL dumpRunning;
+
+static char filePrefix[FLIGHT_NAME_LEN];
+static ULONG framesToKeep;
+static uint64 hitchTicks;
+
+static uint32_t triggerPending;
+static char triggerReason[128];
+static ULONG dumpCount;
+static uint64 lastDumpTicks;
+static SinkCounters closedCounters; // Totals of the clients already closed
+
+static void add_counters(SinkCounters * counters, const struct FlightClient* const client)
+{
+    counters->written += client->history.head;
+    counters->dropped += client->skipped;
+    counters->bytes += client->history.head * sizeof(TraceRecord);
+}
+
+static void write_line(BPTR file, const char* text)
+{
+    IDOS->Write(file, text, (int32)strlen(text));
+    IDOS->Write(file, "\n", 1);
+}
+
+static ULONG dump_client(BPTR file, struct FlightClient* client)
+{
+    char buffer[256];
+
+    const uint32_t head = trace_history_freeze(&client->history);
+    const uint32_t frameCount = client->frameCount;
+
+    uint32_t first = trace_history_oldest(&client->history, head);
+    uint32_t frame = frameCount > framesToKeep ? frameCount - (uint32_t)framesToKeep : 0;
+
+    // Start from the oldest frame wanted, if it's still in the history
+    if (frameCount > frame) {
+        const uint32_t position = client->frameStart[frame % MAX_FLIGHT_FRAMES];
+
+        if ((int32_t)(position - first) > 0) {
+            first = position;
+        }
+    }
+
+    snprintf(buffer, sizeof(buffer), "--- %s: %lu records, last %lu frames ---", client->name,
+        (ULONG)(head - first), (ULONG)(frameCount - frame));
+    write_line(file, buffer);
+
+    for (uint32_t position = first; position != head; position++) {
+        while (frame < frameCount && (int32_t)(client->frameStart[frame % MAX_FLIGHT_FRAMES] - position) <= 0) {
+            if (client->frameStart[frame % MAX_FLIGHT_FRAMES] == position) {
+                snprintf(buffer, sizeof(buffer), "--- %s: frame %lu ---", client->name, (ULONG)frame);
+                write_line(file, buffer);
+            }
+            frame++;
+        }
+
+        const TraceRecord* record = trace_history_at(&client->history, position);
+
+        trace_format(record, client->name, client->mapFunction(record->function),
+            timer_get_elapsed_seconds_at(record->ticks), buffer, sizeof(buffer));
+
+        write_line(file, buffer);
+    }
+
+    trace_history_thaw(&client->history);
+
+    return (ULONG)(head - first);
+}
+
+static void dump(void)
+{
+    const uint64 now = timer_get_ticks();
+
+    if (lastDumpTicks && timer_ticks_to_s(now - lastDumpTicks) < FLIGHT_COOLDOWN_SECONDS) {
+        return;
+    }
+
+    lastDumpTicks = now;
+
+    char name[FLIGHT_NAME_LEN + 16];
+    snprintf(name, sizeof(name), "%s.%lu", filePrefix, ++dumpCount);
+
+    BPTR file = IDOS->Open(name, MODE_NEWFILE);
+
+    if (!file) {
+        logAlways("Flight recorder: failed to open '%s'", name);
+        return;
+    }
+
+    char header[256];
+    snprintf(header, sizeof(header), "glSnoop flight recorder dump #%lu at %.6f s: %s", dumpCount,
+        timer_get_elapsed_seconds_at(now), triggerReason);
+    write_line(file, header);
+
+    ULONG records = 0;
+
+    IExec->MutexObtain(mutex);
+
+    for (struct FlightClient* client = clients; client; client = client->next) {
+        records += dump_client(file, client);
+    }
+
+    IExec->MutexRelease(mutex);
+
+    IDOS->Close(file);
+
+    logAlways("Flight recorder: %lu records written to '%s' (%s)", records, name, triggerReason);
+}
+
+static void dump_process(void)
+{
+    BOOL quit = FALSE;
+
+    while (!quit) {
+        const uint32 signals = IExec->Wait(SIGBREAKF_CTRL_C | SIGBREAKF_CTRL_F);
+
+        quit = (signals & SIGBREAKF_CTRL_C) != 0;
+
+        if (__atomic_load_n(&triggerPending, __ATOMIC_ACQUIRE)) {
+            dump();
+            __atomic_store_n(&triggerPending, 0, __ATOMIC_RELEASE);
+        }
+    }
+
+    dumpRunning = FALSE;
+}
+
+BOOL flight_init(const char* const prefix, const ULONG frames, const ULONG hitchTimeMs)
+{
+    snprintf(filePrefix, sizeof(filePrefix), "%s", prefix);
+
+    framesToKeep = frames ? frames : 1;
+    if (framesToKeep > MAX_FLIGHT_FRAMES - 1) {
+        framesToKeep = MAX_FLIGHT_FRAMES - 1;
+    }
+
+    hitchTicks = (uint64)hitchTimeMs * timer_get_frequency() / 1000;
+
+    mutex = IExec->AllocSysObject(ASOT_MUTEX, TAG_DONE);
+
+    if (!mutex) {
+        puts("Failed to allocate flight recorder mutex");
+        return FALSE;
+    }
+
+    dumpRunning = TRUE;
+
+    dumpProcess = IDOS->CreateNewProcTags(
+        NP_Entry, dump_process,
+        NP_Name, "glSnoop flight recorder",
+        NP_Priority, -1,
+        NP_Child, TRUE,
+        TAG_DONE);
+
+    if (!dumpProcess) {
+        puts("Failed to create flight recorder process");
+        dumpRunning = FALSE;
+        flight_quit();
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+void flight_quit(void)
+{
+    if (dumpProcess) {
+        IExec->Signal((struct Task *)dumpProcess, SIGBREAKF_CTRL_C);
+
+        while (dumpRunning) {
+            IDOS->Delay(1);
+        }
+
+        dumpProcess = NULL;
+    }
+
+    if (mutex) {
+        IExec->MutexObtain(mutex);
+
+        while (clients) {
+            struct FlightClient* const client = clients;
+            clients = client->next;
+
+            IExec->FreeVec(client);
+        }
+
+        IExec->MutexRelease(mutex);
+
+        IExec->FreeSysObject(ASOT_MUTEX, mutex);
+        mutex = NULL;
+    }
+}
+
+BOOL flight_enabled(void)
+{
+    return dumpProcess != NULL;
+}
+
+struct FlightClient* flight_open(const char* const name, TraceNameFunc mapFunction)
+{
+    if (!dumpProcess) {
+        return NULL;
+    }
+
+    const size_t historySize = FLIGHT_CAPACITY * sizeof(TraceRecord);
+
+    struct FlightClient* client = IExec->AllocVecTags(sizeof(struct FlightClient) + historySize,
+        AVT_Type, MEMF_SHARED,
+        AVT_ClearValue, 0,
+        TAG_DONE);
+
+    if (!client) {
+        logAlways("Cannot allocate memory for flight recorder");
+        return NULL;
+    }
+
+    trace_history_init(&client->history, client + 1, FLIGHT_CAPACITY);
+    client->mapFunction = mapFunction;
+    snprintf(client->name, sizeof(client->name), "%s", name);
+
+    IExec->MutexObtain(mutex);
+
+    client->next = clients;
+    clients = client;
+
+    IExec->MutexRelease(mutex);
+
+    logDebug("%s: flight recorder history %lu bytes", name, (ULONG)historySize);
+
+    return client;
+}
+
+void flight_close(struct FlightClient* client)
+{
+    if (!client || !mutex) {
+        return;
+    }
+
+    IExec->MutexObtain(mutex);
+
+    add_counters(&closedCounters, client);
+
+    for (struct FlightClient** link = &clients; *link; link = &(*link)->next) {
+        if (*link == client) {
+            *link = client->next;
+            break;
+        }
+    }
+
+    IExec->MutexRelease(mutex);
+
+    IExec->FreeVec(client);
+}
+
+void flight_write(struct FlightClient* client, const uint64 ticks, const struct Task* const task,
+    const TraceModule module, const uint16 function, const uint32_t* const args, const size_t argCount)
+{
+    TraceRecord* record = trace_history_next(&client->history);
+
+    if (record) {
+        record->ticks = ticks;
+        record->task = trace_word_pointer(task);
+        record->function = function;
+        record->module = (uint8_t)module;
+        record->argCount = (uint8_t)argCount;
+
+        memcpy(record->args, args, argCount * sizeof(uint32_t));
+
+        trace_history_publish(&client->history);
+    } else {
+        client->skipped++;
+    }
+}
+
+void flight_counters(SinkCounters * counters)
+{
+    *counters = closedCounters;
+
+    if (mutex) {
+        IExec->MutexObtain(mutex);
+
+        for (struct FlightClient* client = clients; client; client = client->next) {
+            add_counters(counters, client);
+        }
+
+        IExec->MutexRelease(mutex);
+    }
+}
+
+void flight_frame(struct FlightClient* client)
+{
+    const uint64 now = timer_get_ticks();
+
+    client->frameStart[client->frameCount % MAX_FLIGHT_FRAMES] = client->history.head;
+    __atomic_add_fetch(&client->frameCount, 1, __ATOMIC_RELEASE);
+
+    if (hitchTicks && client->lastFrameTicks && now - client->lastFrameTicks > hitchTicks) {
+        flight_trigger("%s: frame time %.3f ms", client->name, timer_ticks_to_ms(now - client->lastFrameTicks));
+    }
+
+    client->lastFrameTicks = now;
+}
+
+void flight_trigger(const char* fmt, ...)
+{
+    if (!dumpProcess || __atomic_exchange_n(&triggerPending, 1, __ATOMIC_ACQ_REL)) {
+        return;
+    }
+
+    va_list ap;
+    va_start(ap, fmt);
+    vsnprintf(triggerReason, sizeof(triggerReason), fmt, ap);
+    va_end(ap);
+
+    IExec->Signal((struct Task *)dumpProcess, SIGBREAKF_CTRL_F);
+}
@@ -0,0 +1,33 @@
+#ifndef FLIGHT_H
+#define FLIGHT_H
+
+#include "trace.h"
+#include "sinks.h"
+
+#include <exec/types.h>
+
+// Flight recorder: the latest calls of each context are kept in memory and
+// written into a file only when a trigger fires.
+
+struct Task;
+struct FlightClient;
+
+BOOL flight_init(const char* const filePrefix, const ULONG frames, const ULONG hitchTimeMs);
+void flight_quit(void);
+BOOL flight_enabled(void);
+
+struct FlightClient* flight_open(const char* const name, TraceNameFunc mapFunction);
+void flight_close(struct FlightClient* client);
+
+void flight_write(struct FlightClient* client, const uint64 ticks, const struct Task* const task,
+    const TraceModule module, const uint16 function, const uint32_t* const args, const size_t argCount);
+
+void flight_counters(SinkCounters * counters);
+
+// Marks a frame boundary and checks the frame time threshold
+void flight_frame(struct FlightClient* client);
+
+// Requests a dump. Ignored while a previous request is being handled.
+void flight_trigger(const char* fmt, ...) __attribute__ ((format (printf, 1, 2)));
+
+#endif
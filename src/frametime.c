@@ -0,0 +1,142 @@
+#include "frametime.h"
+#include "logger.h"
+#include "timer.h"
+
+#include <proto/exec.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+void frametime_reset(FrameTimes* frames)
+{
+    memset(frames, 0, sizeof(*frames));
+
+    frames->limit60 = timer_get_frequency() / 60;
+    frames->limit30 = timer_get_frequency() / 30;
+}
+
+void frametime_add(FrameTimes* frames, const uint64 now)
+{
+    const uint64 boundaries = frames->boundaries;
+
+    frames->ring[boundaries & (FRAME_RING_CAPACITY - 1)] = now;
+    frames->boundaries = boundaries + 1;
+
+    // The first boundary only starts the first frame
+    if (boundaries == 0) {
+        return;
+    }
+
+    const uint64 ticks = now - frames->ring[(boundaries - 1) & (FRAME_RING_CAPACITY - 1)];
+
+    histogram_add(&frames->histogram, ticks);
+
+    if (ticks > frames->limit60) {
+        frames->over60++;
+
+        if (ticks > frames->limit30) {
+            frames->over30++;
+        }
+    }
+
+    if (ticks > frames->longest[FRAME_LONGEST - 1].ticks) {
+        int i = FRAME_LONGEST - 1;
+
+        for (; i > 0 && ticks > frames->longest[i - 1].ticks; i--) {
+            frames->longest[i] = frames->longest[i - 1];
+        }
+
+        frames->longest[i].ticks = ticks;
+        frames->longest[i].end = now;
+    }
+}
+
+static int descending(const void* first, const void* second)
+{
+    const uint64 a = *(const uint64 *)first;
+    const uint64 b = *(const uint64 *)second;
+
+    if (a > b) return -1;
+    if (a < b) return 1;
+
+    return 0;
+}
+
+// Frame rate over the slowest fraction of the frames
+static double low(const uint64* const sorted, const size_t count, const double fraction)
+{
+    size_t slowest = (size_t)((double)count * fraction);
+
+    if (slowest < 1) {
+        slowest = 1;
+    }
+
+    uint64 ticks = 0;
+
+    for (size_t i = 0; i < slowest; i++) {
+        ticks += sorted[i];
+    }
+
+    return ticks ? (double)slowest / timer_ticks_to_s(ticks) : 0.0;
+}
+
+// The lows are exact over the frames still in the ring
+static void lows(const FrameTimes* const frames)
+{
+    const uint64 boundaries = frames->boundaries;
+    const size_t count = (size_t)(boundaries > FRAME_RING_CAPACITY ? FRAME_RING_CAPACITY : boundaries) - 1;
+
+    uint64* sorted = IExec->AllocVecTags(count * sizeof(uint64), TAG_DONE);
+
+    if (!sorted) {
+        logAlways("  Cannot allocate memory for frame time lows");
+        return;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        const uint64 position = boundaries - 1 - i;
+
+        sorted[i] = frames->ring[position & (FRAME_RING_CAPACITY - 1)] -
+            frames->ring[(position - 1) & (FRAME_RING_CAPACITY - 1)];
+    }
+
+    qsort(sorted, count, sizeof(uint64), descending);
+
+    logAlways("  1%% low %.1f fps, 0.1%% low %.1f fps (last %lu frames)",
+        low(sorted, count, 0.01), low(sorted, count, 0.001), (ULONG)count);
+
+    IExec->FreeVec(sorted);
+}
+
+void frametime_summary(const FrameTimes* const frames, const char* const source)
+{
+    const Histogram* const histogram = &frames->histogram;
+
+    if (histogram->count == 0) {
+        logAlways("  Frame times (%s): not enough frames", source);
+        return;
+    }
+
+    const double count = (double)histogram->count;
+
+    logAlways("  Frame times (%s): %llu frames. p50 %.3f ms, p90 %.3f ms, p99 %.3f ms, p99.9 %.3f ms, max %.3f ms",
+        source, (uint64)histogram->count,
+        timer_ticks_to_ms(histogram_percentile(histogram, 50.0)),
+        timer_ticks_to_ms(histogram_percentile(histogram, 90.0)),
+        timer_ticks_to_ms(histogram_percentile(histogram, 99.0)),
+        timer_ticks_to_ms(histogram_percentile(histogram, 99.9)),
+        timer_ticks_to_ms(histogram->max));
+
+    lows(frames);
+
+    logAlways("  Frames over 16.7 ms %llu (%.2f %%), over 33.3 ms %llu (%.2f %%)",
+        frames->over60, (double)frames->over60 * 100.0 / count,
+        frames->over30, (double)frames->over30 * 100.0 / count);
+
+    logAlways("  Longest frames:");
+
+    for (int i = 0; i < FRAME_LONGEST && frames->longest[i].ticks; i++) {
+        logAlways("    %.3f ms, ended at %.6f s", timer_ticks_to_ms(frames->longest[i].ticks),
+            timer_get_elapsed_seconds_at(frames->longest[i].end));
+    }
+}
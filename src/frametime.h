@@ -0,0 +1,38 @@
+#ifndef FRAMETIME_H
+#define FRAMETIME_H
+
+#include "histogram.h"
+
+#include <exec/types.h>
+
+// Frame-time series of a context. Frame boundaries (aglSwapBuffers, or
+// W3DN_Submit for pure Nova clients) are stored into a preallocated ring of
+// timestamps, frame times go into a histogram and the longest frames are kept
+// with their timestamps. Adding a frame doesn't allocate.
+
+#define FRAME_RING_CAPACITY 4096 // Latest frame timestamps, must be a power of two
+#define FRAME_LONGEST 5
+
+typedef struct FrameRecord {
+    uint64 ticks; // Frame time
+    uint64 end; // EClock value at the frame boundary
+} FrameRecord;
+
+typedef struct FrameTimes {
+    uint64 ring[FRAME_RING_CAPACITY]; // EClock values of the latest frame boundaries
+    uint64 boundaries; // Frame boundaries seen, one more than the frames measured
+    uint64 limit60; // Ticks of a 60 Hz frame, 16.7 ms
+    uint64 limit30; // Ticks of a 30 Hz frame, 33.3 ms
+    uint64 over60; // Frames longer than limit60
+    uint64 over30; // Frames longer than limit30
+    FrameRecord longest[FRAME_LONGEST]; // In descending order
+    Histogram histogram;
+} FrameTimes;
+
+void frametime_reset(FrameTimes* frames);
+void frametime_add(FrameTimes* frames, const uint64 now);
+
+// Logs the percentiles, lows, slow frame counts and the longest frames
+void frametime_summary(const FrameTimes* const frames, const char* const source);
+
+#endif
@@ -1,5 +1,8 @@
 #include "gui.h"
 #include "logger.h"
+#include "flight.h"
+#include "filter.h"
+#include "sinks.h"
 #include "ogles2_module.h"
 #include "warp3dnova_module.h"
 #include "timer.h"
@@ -24,17 +27,22 @@ enum EObject {
     OID_TracingLayout,
     OID_Trace,
     OID_Pause,
+    OID_Dump,
+    OID_Reload,
     OID_ProfilingLayout,
     OID_StartProfiling,
     OID_FinishProfiling,
     OID_Ogles2Errors,
     OID_NovaErrors,
+    OID_SinkStatus,
     OID_Count // KEEP LAST
 };
 
 enum EGadget {
     GID_Trace,
     GID_Pause,
+    GID_Dump,
+    GID_Reload,
     GID_StartProfiling,
     GID_FinishProfiling
 };
@@ -193,6 +201,20 @@ static Object* create_gui(LONG profiling)
                     GA_Disabled, profiling ? TRUE : FALSE,
                     GA_HintInfo, "Disable function tracing to serial port",
                     TAG_DONE),
+                LAYOUT_AddChild, objects[OID_Dump] = IIntuition->NewObject(ButtonClass, NULL,
+                    GA_Text, "_Dump",
+                    GA_ID, GID_Dump,
+                    GA_RelVerify, TRUE,
+                    GA_Disabled, flight_enabled() ? FALSE : TRUE,
+                    GA_HintInfo, "Write the flight recorder history into a file",
+                    TAG_DONE),
+                LAYOUT_AddChild, objects[OID_Reload] = IIntuition->NewObject(ButtonClass, NULL,
+                    GA_Text, "_Reload filter",
+                    GA_ID, GID_Reload,
+                    GA_RelVerify, TRUE,
+                    GA_Disabled, filter_file_loaded() ? FALSE : TRUE,
+                    GA_HintInfo, "Read the filter file again and update the patches of running applications",
+                    TAG_DONE),
                 TAG_DONE), // horizontal layout.gadget
 
             LAYOUT_AddChild, objects[OID_ProfilingLayout] = IIntuition->NewObject(LayoutClass, NULL,
@@ -243,6 +265,12 @@ static Object* create_gui(LONG profiling)
                     BUTTON_BevelStyle, BVS_NONE,
                     BUTTON_Transparent, TRUE,
                     TAG_DONE),
+                LAYOUT_AddChild, objects[OID_SinkStatus] = IIntuition->NewObject(ButtonClass, NULL,
+                    GA_ReadOnly, TRUE,
+                    GA_Text, sinks_string(),
+                    BUTTON_BevelStyle, BVS_NONE,
+                    BUTTON_Transparent, TRUE,
+                    TAG_DONE),
                 TAG_DONE), // vertical layout.gadget
 
             TAG_DONE), // vertical layout.gadget
@@ -268,9 +296,11 @@ static void refresh_errors(void)
 {
     IIntuition->SetAttrs(objects[OID_Ogles2Errors], GA_Text, ogles2_errors_string(), TAG_DONE);
     IIntuition->SetAttrs(objects[OID_NovaErrors], GA_Text, warp3dnova_errors_string(), TAG_DONE);
+    IIntuition->SetAttrs(objects[OID_SinkStatus], GA_Text, sinks_string(), TAG_DONE);
 
     refresh_object(objects[OID_Ogles2Errors]);
     refresh_object(objects[OID_NovaErrors]);
+    refresh_object(objects[OID_SinkStatus]);
 }
 
 static void trace(void)
@@ -319,6 +349,16 @@ static void finish_profiling(void)
 
     warp3dnova_finish_profiling();
     ogles2_finish_profiling();
+
+    sinks_report();
+}
+
+static void reload_filter(void)
+{
+    if (reload_filters()) {
+        ogles2_reload_filter();
+        warp3dnova_reload_filter();
+    }
 }
 
 static void handle_gadgets(int id)
@@ -332,6 +372,12 @@ static void handle_gadgets(int id)
         case GID_Pause:
             pause();
             break;
+        case GID_Dump:
+            flight_trigger("GUI");
+            break;
+        case GID_Reload:
+            reload_filter();
+            break;
         case GID_StartProfiling:
             start_profiling();
             break;
@@ -379,13 +425,21 @@ static void handle_events(void)
     BOOL running = TRUE;
 
     while (running) {
-        uint32 wait = IExec->Wait(signal | SIGBREAKF_CTRL_C | timerSignal);
+        uint32 wait = IExec->Wait(signal | SIGBREAKF_CTRL_C | SIGBREAKF_CTRL_D | SIGBREAKF_CTRL_F | timerSignal);
 
         if (wait & SIGBREAKF_CTRL_C) {
             puts("*** Break ***");
             running = FALSE;
         }
 
+        if (wait & SIGBREAKF_CTRL_D) {
+            reload_filter();
+        }
+
+        if (wait & SIGBREAKF_CTRL_F) {
+            flight_trigger("Control-F");
+        }
+
         if (wait & signal) {
             uint32 result;
             int16 code = 0;
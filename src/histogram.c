@@ -0,0 +1,46 @@
+#include "histogram.h"
+
+#include <string.h>
+
+void histogram_reset(Histogram* histogram)
+{
+    memset(histogram, 0, sizeof(*histogram));
+}
+
+static uint64_t bucket_highest(const unsigned bucket)
+{
+    if (bucket < HISTOGRAM_SUB_COUNT) {
+        return bucket;
+    }
+
+    const unsigned shift = bucket / HISTOGRAM_SUB_COUNT - 1;
+    const uint64_t lowest = (uint64_t)(HISTOGRAM_SUB_COUNT + bucket % HISTOGRAM_SUB_COUNT) << shift;
+
+    return lowest + ((uint64_t)1 << shift) - 1;
+}
+
+uint64_t histogram_percentile(const Histogram* histogram, const double percentile)
+{
+    if (histogram->count == 0) {
+        return 0;
+    }
+
+    uint64_t target = (uint64_t)((double)histogram->count * percentile / 100.0 + 0.5);
+
+    if (target < 1) {
+        target = 1;
+    }
+
+    uint64_t seen = 0;
+
+    for (unsigned bucket = 0; bucket < HISTOGRAM_BUCKETS; bucket++) {
+        seen += histogram->buckets[bucket];
+
+        if (seen >= target) {
+            const uint64_t highest = bucket_highest(bucket);
+            return highest < histogram->max ? highest : histogram->max;
+        }
+    }
+
+    return histogram->max;
+}
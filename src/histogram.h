@@ -0,0 +1,53 @@
+#ifndef HISTOGRAM_H
+#define HISTOGRAM_H
+
+// Log-bucketed latency histogram (HDR style). Every power of two range is split
+// into HISTOGRAM_SUB_COUNT linear buckets, so a recorded value is known within
+// 1/HISTOGRAM_SUB_COUNT. Fixed size, adding a value doesn't allocate. This file
+// has no AmigaOS dependencies so that it can be tested on other hosts.
+
+#include <stdint.h>
+
+#define HISTOGRAM_SUB_BITS 3
+#define HISTOGRAM_SUB_COUNT (1 << HISTOGRAM_SUB_BITS)
+#define HISTOGRAM_MAX_BITS 32 // Larger values go into the last bucket, max stays exact
+#define HISTOGRAM_BUCKETS ((HISTOGRAM_MAX_BITS - HISTOGRAM_SUB_BITS + 1) * HISTOGRAM_SUB_COUNT)
+
+typedef struct Histogram {
+    uint64_t count;
+    uint64_t max;
+    uint32_t buckets[HISTOGRAM_BUCKETS];
+} Histogram;
+
+static inline unsigned histogram_bucket(const uint64_t value)
+{
+    if (value < HISTOGRAM_SUB_COUNT) {
+        return (unsigned)value;
+    }
+
+    if (value >> HISTOGRAM_MAX_BITS) {
+        return HISTOGRAM_BUCKETS - 1;
+    }
+
+    const unsigned msb = 63 - (unsigned)__builtin_clzll(value);
+
+    return (msb - HISTOGRAM_SUB_BITS + 1) * HISTOGRAM_SUB_COUNT +
+        (unsigned)((value >> (msb - HISTOGRAM_SUB_BITS)) & (HISTOGRAM_SUB_COUNT - 1));
+}
+
+static inline void histogram_add(Histogram* histogram, const uint64_t value)
+{
+    histogram->buckets[histogram_bucket(value)]++;
+    histogram->count++;
+
+    if (value > histogram->max) {
+        histogram->max = value;
+    }
+}
+
+void histogram_reset(Histogram* histogram);
+
+// Highest value of the bucket where the percentile (0-100) falls, at most max
+uint64_t histogram_percentile(const Histogram* histogram, const double percentile);
+
+#endif
@@ -1,43 +1,639 @@
 #include "logger.h"
 #include "timer.h"
+#include "trace.h"
+#include "filesink.h"
+#include "sinks.h"
 
 #include <proto/exec.h>
+#include <proto/dos.h>
 
 #include <stdio.h>
 #include <stdarg.h>
+#include <string.h>
 
-static BOOL paused = FALSE;
+#define DEFERRED_MAX_ARGS 16
+#define DEFERRED_TEXT_SIZE 512 // Space for copied %s arguments
+#define DEFERRED_MAX_SPEC 32
+#define DEFERRED_CAPACITY 2048 // Lines, must be a power of two
+#define DEFERRED_DELAY_TICKS 2 // 1/25 second
+#define DEFERRED_NULL_STRING (~0ULL)
+#define RAW_TICKS_DIGITS 12
+#define LINE_BUFFER_SIZE (16 * 1024)
+#define LINE_BUFFER_COUNT 8 // Tasks that can format lines at the same time without waiting
+#define ALL_LINE_BUFFERS ((1U << LINE_BUFFER_COUNT) - 1)
+#define SERIAL_BUFFER_SIZE (4 * 1024) // Sashimi has 4k buffer
+#define REPEAT_SLOTS 16 // Tasks with their own run-length state
+#define REPEAT_TEXT_SIZE 256 // Longer lines are not compressed
+
+volatile BOOL logPaused = FALSE;
 static BOOL verbose = FALSE;
+static BOOL rawTimestamps = FALSE;
 
-static void logLineImpl(const char * fmt, va_list ap)
+typedef enum ArgLength {
+    ArgLength_Int,
+    ArgLength_Long,
+    ArgLength_LongLong,
+    ArgLength_Size
+} ArgLength;
+
+typedef struct FormatSpec {
+    const char* start; // '%'
+    const char* end; // One past the conversion character
+    ArgLength length;
+    char conversion; // 0 when not supported by deferred formatting
+} FormatSpec;
+
+typedef union DeferredArg {
+    unsigned long long u; // Integers, and offset into text for strings
+    double d;
+    const void* p;
+} DeferredArg;
+
+// Format string pointer and raw arguments, formatted later by the log task.
+// Format strings are literals inside glSnoop so the pointers stay valid.
+typedef struct DeferredLine {
+    uint64 ticks;
+    const struct Task* task;
+    const char* fmt;
+    uint32 argCount;
+    uint32 textUsed;
+    DeferredArg args[DEFERRED_MAX_ARGS];
+    char text[DEFERRED_TEXT_SIZE];
+} DeferredLine;
+
+_Static_assert(sizeof(DeferredLine) <= LINE_BUFFER_SIZE, "DeferredLine must fit into a line buffer");
+
+static TraceRing deferredRing;
+static APTR deferredMemory;
+static APTR deferredMutex;
+static struct Process* deferredProcess;
+static volatile BOOL deferredRunning;
+static uint32 deferredClosing; // Set by stop_deferred_log(), lines are formatted immediately
+static uint32 deferredUsers; // Callers queueing a line
+
+// Run-length state of one task. Lines of different tasks interleave, so
+// each task is compared against its own previous line.
+typedef struct RepeatState {
+    const struct Task* task;
+    uint64 hash;
+    uint64 ticks; // Last time the line was seen
+    ULONG count;
+    char text[REPEAT_TEXT_SIZE];
+} RepeatState;
+
+static APTR compressMutex;
+static RepeatState repeats[REPEAT_SLOTS]; // Protected by compressMutex
+
+static APTR counterMutex; // Also keeps serial output of different tasks apart and protects serialBuffer
+static char serialBuffer[SERIAL_BUFFER_SIZE];
+
+// Lines are formatted into glSnoop-owned buffers instead of the stack of the
+// traced task, which may be small. When all buffers are in use, callers take
+// turns with the spare buffer.
+static char* lineBuffers;
+static uint32 freeLineBuffers; // One bit per buffer
+static uint32 logClosing; // Set by quit_log(), no more buffers are handed out
+static uint32 logUsers; // Callers inside logLineImpl()
+static APTR spareMutex;
+static char spareBuffer[LINE_BUFFER_SIZE] __attribute__((aligned(8)));
+static SinkCounters serialCounters;
+static SinkCounters formatterCounters;
+
+static void lock_counters(void)
+{
+    if (counterMutex) {
+        IExec->MutexObtain(counterMutex);
+    }
+}
+
+static void unlock_counters(void)
+{
+    if (counterMutex) {
+        IExec->MutexRelease(counterMutex);
+    }
+}
+
+static void count(SinkCounters * counters, const uint64 written, const uint64 dropped, const uint64 bytes,
+    const uint64 blockedTicks)
 {
-    char buffer[16 * 1024];
-    char* ptr = buffer;
+    lock_counters();
 
-    const int len = vsnprintf(buffer, sizeof(buffer), fmt, ap);
-    const double time = timer_get_elapsed_seconds();
+    counters->written += written;
+    counters->dropped += dropped;
+    counters->bytes += bytes;
+    counters->blockedTicks += blockedTicks;
+
+    unlock_counters();
+}
+
+// Line without timestamp
+static void writeText(const char * text)
+{
+    if (filesink_enabled()) {
+        filesink_write("", text);
+    } else {
+        lock_counters();
+
+        const uint64 start = timer_get_ticks();
+
+        IExec->DebugPrintF("%s\n", text);
+
+        serialCounters.written++;
+        serialCounters.bytes += strlen(text) + 1;
+        serialCounters.blockedTicks += timer_get_ticks() - start;
+
+        unlock_counters();
+    }
+}
+
+// "[0000001A2B3C] " without going through printf and floating point
+static void formatRawTicks(char * buffer, const uint64 ticks)
+{
+    static const char* const digits = "0123456789ABCDEF";
+
+    const uint64 delta = ticks - timer_get_start_ticks();
+
+    buffer[0] = '[';
+
+    for (int i = 0; i < RAW_TICKS_DIGITS; i++) {
+        buffer[RAW_TICKS_DIGITS - i] = digits[(delta >> (4 * i)) & 0xF];
+    }
+
+    buffer[RAW_TICKS_DIGITS + 1] = ']';
+    buffer[RAW_TICKS_DIGITS + 2] = ' ';
+    buffer[RAW_TICKS_DIGITS + 3] = '\0';
+}
+
+static void outputLine(const uint64 ticks, const char * text)
+{
+    char prefix[32];
+
+    if (rawTimestamps) {
+        formatRawTicks(prefix, ticks);
+    } else {
+        snprintf(prefix, sizeof(prefix), "[%.6f] ", timer_get_elapsed_seconds_at(ticks));
+    }
+
+    if (filesink_enabled()) {
+        filesink_write(prefix, text);
+        return;
+    }
+
+    const char* ptr = text;
+
+    lock_counters();
+
+    const uint64 start = timer_get_ticks();
 
     while (TRUE) {
-        char serialBuffer[4 * 1024]; // Sashimi has 4k buffer
-        const size_t wantedToWrite = (size_t)snprintf(serialBuffer, sizeof(serialBuffer), "[%.6f] %s\n", time, ptr);
+        const size_t wantedToWrite = (size_t)snprintf(serialBuffer, sizeof(serialBuffer), "%s%s\n", prefix, ptr);
 
         IExec->DebugPrintF("%s", serialBuffer);
 
         if (wantedToWrite < sizeof(serialBuffer)) {
+            serialCounters.bytes += wantedToWrite;
+            break;
+        }
+
+        serialCounters.bytes += sizeof(serialBuffer) - 1;
+        ptr += sizeof(serialBuffer) - 1 - strlen(prefix);
+    }
+
+    serialCounters.written++;
+    serialCounters.blockedTicks += timer_get_ticks() - start;
+
+    unlock_counters();
+}
+
+static uint64 hashText(const char * text)
+{
+    uint64 hash = 14695981039346656037ULL; // FNV-1a
+
+    while (*text) {
+        hash ^= (UBYTE)*text++;
+        hash *= 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+static void outputRepeats(RepeatState* state)
+{
+    if (state->count) {
+        char message[64];
+        snprintf(message, sizeof(message), "task %p: previous line repeated x%lu", state->task, state->count);
+        outputLine(state->ticks, message);
+        state->count = 0;
+    }
+}
+
+// Counts of tasks that went quiet are written after a second, so that
+// they don't wait for the next line of the same task. now is the current
+// EClock, deferred lines carry older timestamps than the slots may have.
+static void outputStaleRepeats(const uint64 now)
+{
+    const uint64 limit = timer_get_frequency();
+
+    for (int i = 0; i < REPEAT_SLOTS; i++) {
+        if (repeats[i].count && now > repeats[i].ticks && now - repeats[i].ticks > limit) {
+            outputRepeats(&repeats[i]);
+        }
+    }
+}
+
+static RepeatState* findRepeatState(const struct Task* const task)
+{
+    RepeatState* oldest = &repeats[0];
+
+    for (int i = 0; i < REPEAT_SLOTS; i++) {
+        if (repeats[i].task == task) {
+            return &repeats[i];
+        }
+
+        if (oldest->task && (!repeats[i].task || repeats[i].ticks < oldest->ticks)) {
+            oldest = &repeats[i];
+        }
+    }
+
+    // Reuse a free or the least recently used slot
+    outputRepeats(oldest);
+
+    oldest->task = task;
+    oldest->hash = 0;
+    oldest->text[0] = '\0';
+
+    return oldest;
+}
+
+static void writeLine(const struct Task* const task, const uint64 ticks, const char * text)
+{
+    if (!compressMutex) {
+        outputLine(ticks, text);
+        return;
+    }
+
+    // Run-length compression: a line identical to the previous one of the same task is only counted.
+    // The hash is a quick check, the stored text confirms the match.
+    const uint64 hash = hashText(text);
+    const size_t len = strlen(text);
+
+    IExec->MutexObtain(compressMutex);
+
+    outputStaleRepeats(timer_get_ticks());
+
+    RepeatState* state = findRepeatState(task);
+
+    if (hash == state->hash && len < REPEAT_TEXT_SIZE && strcmp(state->text, text) == 0) {
+        state->count++;
+        state->ticks = ticks;
+    } else {
+        outputRepeats(state);
+        outputLine(ticks, text);
+
+        state->ticks = ticks;
+
+        if (len < REPEAT_TEXT_SIZE) {
+            state->hash = hash;
+            memcpy(state->text, text, len + 1);
+        } else {
+            state->hash = 0;
+            state->text[0] = '\0';
+        }
+    }
+
+    IExec->MutexRelease(compressMutex);
+}
+
+static const char* next_spec(const char* p, FormatSpec* spec)
+{
+    p = strchr(p, '%');
+
+    if (!p) {
+        return NULL;
+    }
+
+    spec->start = p++;
+    spec->length = ArgLength_Int;
+
+    if (*p == '%') {
+        spec->conversion = '%';
+        spec->end = p + 1;
+        return spec->end;
+    }
+
+    p += strspn(p, "-+ #0");
+    p += strspn(p, "0123456789");
+
+    if (*p == '.') {
+        p++;
+        p += strspn(p, "0123456789");
+    }
+
+    if (*p == 'h') {
+        p++;
+        if (*p == 'h') {
+            p++;
+        }
+    } else if (*p == 'l') {
+        p++;
+        spec->length = ArgLength_Long;
+        if (*p == 'l') {
+            p++;
+            spec->length = ArgLength_LongLong;
+        }
+    } else if (*p == 'z') {
+        p++;
+        spec->length = ArgLength_Size;
+    }
+
+    // Width or precision from arguments ('*') is not supported
+    spec->conversion = (*p && strchr("diucxXopsfFeEgGaA", *p)) ? *p : 0;
+    spec->end = *p ? p + 1 : p;
+
+    return spec->end;
+}
+
+static unsigned long long read_integer(va_list* ap, const ArgLength length)
+{
+    switch (length) {
+        case ArgLength_Long: return va_arg(*ap, unsigned long);
+        case ArgLength_LongLong: return va_arg(*ap, unsigned long long);
+        case ArgLength_Size: return va_arg(*ap, size_t);
+        default: return va_arg(*ap, unsigned);
+    }
+}
+
+// Store the raw arguments. Returns FALSE if the line has to be formatted immediately.
+static BOOL capture_line(DeferredLine* line, const char * fmt, va_list* ap)
+{
+    const char* p = fmt;
+    FormatSpec spec;
+
+    line->fmt = fmt;
+    line->argCount = 0;
+    line->textUsed = 0;
+
+    while ((p = next_spec(p, &spec))) {
+        if (spec.conversion == '%') {
+            continue;
+        }
+
+        if (!spec.conversion || line->argCount == DEFERRED_MAX_ARGS || spec.end - spec.start >= DEFERRED_MAX_SPEC) {
+            return FALSE;
+        }
+
+        DeferredArg* arg = &line->args[line->argCount++];
+
+        switch (spec.conversion) {
+            case 'p':
+                arg->p = va_arg(*ap, const void*);
+                break;
+            case 's': {
+                const char* str = va_arg(*ap, const char*);
+
+                if (str) {
+                    const size_t size = strlen(str) + 1;
+
+                    if (size > DEFERRED_TEXT_SIZE - line->textUsed) {
+                        return FALSE;
+                    }
+
+                    memcpy(line->text + line->textUsed, str, size);
+                    arg->u = line->textUsed;
+                    line->textUsed += (uint32)size;
+                } else {
+                    arg->u = DEFERRED_NULL_STRING;
+                }
+                break;
+            }
+            case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+                arg->d = va_arg(*ap, double);
+                break;
+            default:
+                arg->u = read_integer(ap, spec.length);
+                break;
+        }
+    }
+
+    return TRUE;
+}
+
+static int format_arg(char* buffer, const size_t size, const char* spec, const FormatSpec* info,
+    const DeferredArg* arg, const char* text)
+{
+    switch (info->conversion) {
+        case 'p':
+            return snprintf(buffer, size, spec, arg->p);
+        case 's':
+            return snprintf(buffer, size, spec, arg->u == DEFERRED_NULL_STRING ? NULL : text + arg->u);
+        case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+            return snprintf(buffer, size, spec, arg->d);
+        case 'd': case 'i': case 'c':
+            switch (info->length) {
+                case ArgLength_Long: return snprintf(buffer, size, spec, (long)arg->u);
+                case ArgLength_LongLong: return snprintf(buffer, size, spec, (long long)arg->u);
+                case ArgLength_Size: return snprintf(buffer, size, spec, (size_t)arg->u);
+                default: return snprintf(buffer, size, spec, (int)arg->u);
+            }
+        default:
+            switch (info->length) {
+                case ArgLength_Long: return snprintf(buffer, size, spec, (unsigned long)arg->u);
+                case ArgLength_LongLong: return snprintf(buffer, size, spec, arg->u);
+                case ArgLength_Size: return snprintf(buffer, size, spec, (size_t)arg->u);
+                default: return snprintf(buffer, size, spec, (unsigned)arg->u);
+            }
+    }
+}
+
+// Replay the format string one conversion at a time
+static void format_line(const DeferredLine* line, char* buffer, const size_t size)
+{
+    const char* p = line->fmt;
+    size_t len = 0;
+    uint32 arg = 0;
+    FormatSpec spec;
+
+    buffer[0] = '\0';
+
+    while (len < size - 1) {
+        const char* next = next_spec(p, &spec);
+        const size_t literal = next ? (size_t)(spec.start - p) : strlen(p);
+        const size_t copy = literal < size - 1 - len ? literal : size - 1 - len;
+
+        memcpy(buffer + len, p, copy);
+        len += copy;
+        buffer[len] = '\0';
+
+        if (!next || len >= size - 1) {
             break;
         }
 
-        ptr += sizeof(serialBuffer) - 1;
+        if (spec.conversion == '%') {
+            buffer[len++] = '%';
+            buffer[len] = '\0';
+        } else {
+            char specBuffer[DEFERRED_MAX_SPEC];
+            const size_t specLen = (size_t)(spec.end - spec.start);
+
+            memcpy(specBuffer, spec.start, specLen);
+            specBuffer[specLen] = '\0';
+
+            const int written = format_arg(buffer + len, size - len, specBuffer, &spec, &line->args[arg++], line->text);
+
+            if (written > 0) {
+                len += (size_t)written < size - len ? (size_t)written : size - 1 - len;
+            }
+        }
+
+        p = next;
+    }
+}
+
+static void flush_deferred(void)
+{
+    static char buffer[LINE_BUFFER_SIZE]; // Protected by deferredMutex
+
+    IExec->MutexObtain(deferredMutex);
+
+    const DeferredLine* line;
+
+    while ((line = trace_ring_peek(&deferredRing))) {
+        format_line(line, buffer, sizeof(buffer));
+
+        const uint64 ticks = line->ticks;
+        const struct Task* const task = line->task;
+
+        trace_ring_release(&deferredRing);
+
+        writeLine(task, ticks, buffer);
+        count(&formatterCounters, 1, 0, 0, 0);
+    }
+
+    IExec->MutexRelease(deferredMutex);
+}
+
+static BOOL defer_line(DeferredLine* line, const char * fmt, va_list ap)
+{
+    va_list copy;
+
+    line->ticks = timer_get_ticks();
+    line->task = IExec->FindTask(NULL);
+
+    va_copy(copy, ap);
+    const BOOL captured = capture_line(line, fmt, &copy);
+    va_end(copy);
+
+    const size_t size = offsetof(DeferredLine, text) + line->textUsed;
+
+    if (captured && trace_ring_push(&deferredRing, line, size)) {
+        return TRUE;
+    }
+
+    const uint64 start = timer_get_ticks();
+
+    // Either the queue is full and we wait until the log task catches up, or the
+    // line is formatted immediately and the lines queued earlier must go first
+    flush_deferred();
+
+    const BOOL queued = captured && trace_ring_push(&deferredRing, line, size);
+
+    count(&formatterCounters, 0, 0, 0, timer_get_ticks() - start);
+
+    return queued;
+}
+
+// Returns NULL when logging is shut down
+static char* acquire_line_buffer(void)
+{
+    if (__atomic_load_n(&logClosing, __ATOMIC_SEQ_CST) || !spareMutex) {
+        return NULL;
+    }
+
+    uint32 mask = __atomic_load_n(&freeLineBuffers, __ATOMIC_RELAXED);
+
+    while (mask) {
+        const uint32 bit = mask & (~mask + 1);
+
+        if (__atomic_compare_exchange_n(&freeLineBuffers, &mask, mask & ~bit, FALSE, __ATOMIC_ACQUIRE,
+            __ATOMIC_RELAXED)) {
+            return lineBuffers + (size_t)__builtin_ctz((unsigned)bit) * LINE_BUFFER_SIZE;
+        }
+    }
+
+    IExec->MutexObtain(spareMutex);
+
+    return spareBuffer;
+}
+
+static void release_line_buffer(char* buffer)
+{
+    if (buffer == spareBuffer) {
+        IExec->MutexRelease(spareMutex);
+    } else {
+        const uint32 index = (uint32)((size_t)(buffer - lineBuffers) / LINE_BUFFER_SIZE);
+        __atomic_or_fetch(&freeLineBuffers, 1U << index, __ATOMIC_RELEASE);
     }
+}
+
+// The deferred ring and mutex stay valid until the caller leaves
+static BOOL enter_deferred(void)
+{
+    __atomic_add_fetch(&deferredUsers, 1, __ATOMIC_SEQ_CST);
 
-    if (len >= (int)sizeof(buffer)) {
-        IExec->DebugPrintF("*** Line truncated: %d bytes buffer needed ***\n", len);
+    if (!__atomic_load_n(&deferredClosing, __ATOMIC_SEQ_CST) && deferredProcess) {
+        return TRUE;
     }
+
+    __atomic_sub_fetch(&deferredUsers, 1, __ATOMIC_RELEASE);
+
+    return FALSE;
 }
 
-void logLine(const char * fmt, ...)
+static void writeFormatted(char* buffer, const char * fmt, va_list ap)
 {
-    if (!paused) {
+    // Deferred lines are captured in the same buffer before queueing
+    if (enter_deferred()) {
+        const BOOL queued = defer_line((DeferredLine *)buffer, fmt, ap);
+
+        __atomic_sub_fetch(&deferredUsers, 1, __ATOMIC_RELEASE);
+
+        if (queued) {
+            release_line_buffer(buffer);
+            return;
+        }
+    }
+
+    const int len = vsnprintf(buffer, LINE_BUFFER_SIZE, fmt, ap);
+
+    writeLine(IExec->FindTask(NULL), timer_get_ticks(), buffer);
+
+    release_line_buffer(buffer);
+
+    count(&formatterCounters, 1, len >= LINE_BUFFER_SIZE ? 1 : 0, 0, 0);
+
+    if (len >= LINE_BUFFER_SIZE) {
+        char message[64];
+        snprintf(message, sizeof(message), "*** Line truncated: %d bytes buffer needed ***", len);
+        writeText(message);
+    }
+}
+
+static void logLineImpl(const char * fmt, va_list ap)
+{
+    __atomic_add_fetch(&logUsers, 1, __ATOMIC_SEQ_CST);
+
+    char* buffer = acquire_line_buffer();
+
+    if (buffer) {
+        writeFormatted(buffer, fmt, ap);
+    }
+
+    __atomic_sub_fetch(&logUsers, 1, __ATOMIC_RELEASE);
+}
+
+void logLineFunction(const char * fmt, ...)
+{
+    if (!logPaused) {
         va_list ap;
         va_start(ap, fmt);
 
@@ -69,18 +665,241 @@ void logDebug(const char * fmt, ...)
     }
 }
 
+// Write an already formatted line, for example from the binary trace drain
+void logText(const char * text)
+{
+    writeText(text);
+}
+
 void pause_log(void)
 {
-    if (!paused) {
-        paused = TRUE;
-        IExec->DebugPrintF("glSnoop: tracing paused\n");
+    if (!logPaused) {
+        logPaused = TRUE;
+        writeText("glSnoop: tracing paused");
     }
 }
 
 void resume_log(void)
 {
-    if (paused) {
-        IExec->DebugPrintF("glSnoop: tracing resumed\n");
-        paused = FALSE;
+    if (logPaused) {
+        writeText("glSnoop: tracing resumed");
+        logPaused = FALSE;
+    }
+}
+
+static void flush_stale_repeats(void)
+{
+    if (compressMutex) {
+        IExec->MutexObtain(compressMutex);
+        outputStaleRepeats(timer_get_ticks());
+        IExec->MutexRelease(compressMutex);
+    }
+}
+
+static void deferred_log_process(void)
+{
+    while (!(IExec->SetSignal(0L, SIGBREAKF_CTRL_C) & SIGBREAKF_CTRL_C)) {
+        flush_deferred();
+        flush_stale_repeats();
+        IDOS->Delay(DEFERRED_DELAY_TICKS);
+    }
+
+    deferredRunning = FALSE;
+}
+
+BOOL start_deferred_log(void)
+{
+    const size_t size = trace_ring_memory_size(sizeof(DeferredLine), DEFERRED_CAPACITY);
+
+    deferredMemory = IExec->AllocVecTags(size, AVT_Type, MEMF_SHARED, TAG_DONE);
+    deferredMutex = IExec->AllocSysObject(ASOT_MUTEX, TAG_DONE);
+
+    if (!deferredMemory || !deferredMutex) {
+        puts("Failed to allocate deferred log buffer");
+        stop_deferred_log();
+        return FALSE;
+    }
+
+    trace_ring_init(&deferredRing, deferredMemory, sizeof(DeferredLine), DEFERRED_CAPACITY);
+
+    __atomic_store_n(&deferredClosing, 0, __ATOMIC_RELEASE);
+    deferredRunning = TRUE;
+
+    deferredProcess = IDOS->CreateNewProcTags(
+        NP_Entry, deferred_log_process,
+        NP_Name, "glSnoop log formatter",
+        NP_Priority, -1,
+        NP_Child, TRUE,
+        TAG_DONE);
+
+    if (!deferredProcess) {
+        puts("Failed to create log formatter process");
+        deferredRunning = FALSE;
+        stop_deferred_log();
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+void stop_deferred_log(void)
+{
+    // Patched tasks may be queueing lines. Turn them to immediate formatting
+    // and wait until the ones already inside have left.
+    __atomic_store_n(&deferredClosing, 1, __ATOMIC_SEQ_CST);
+
+    while (__atomic_load_n(&deferredUsers, __ATOMIC_SEQ_CST)) {
+        IDOS->Delay(1);
+    }
+
+    if (deferredProcess) {
+        IExec->Signal((struct Task *)deferredProcess, SIGBREAKF_CTRL_C);
+
+        while (deferredRunning) {
+            IDOS->Delay(1);
+        }
+
+        // Lines are formatted immediately from now on
+        deferredProcess = NULL;
+
+        flush_deferred();
+    }
+
+    if (deferredMutex) {
+        IExec->FreeSysObject(ASOT_MUTEX, deferredMutex);
+        deferredMutex = NULL;
+    }
+
+    if (deferredMemory) {
+        IExec->FreeVec(deferredMemory);
+        deferredMemory = NULL;
     }
 }
+
+BOOL start_log_compression(void)
+{
+    compressMutex = IExec->AllocSysObject(ASOT_MUTEX, TAG_DONE);
+
+    if (!compressMutex) {
+        puts("Failed to allocate log compression mutex");
+        return FALSE;
+    }
+
+    memset(repeats, 0, sizeof(repeats));
+
+    return TRUE;
+}
+
+void log_forget_task(const struct Task* const task)
+{
+    if (compressMutex) {
+        IExec->MutexObtain(compressMutex);
+
+        for (int i = 0; i < REPEAT_SLOTS; i++) {
+            if (repeats[i].task == task) {
+                outputRepeats(&repeats[i]);
+                repeats[i].task = NULL;
+            }
+        }
+
+        IExec->MutexRelease(compressMutex);
+    }
+}
+
+void stop_log_compression(void)
+{
+    if (compressMutex) {
+        APTR temp = compressMutex;
+
+        IExec->MutexObtain(temp);
+
+        for (int i = 0; i < REPEAT_SLOTS; i++) {
+            outputRepeats(&repeats[i]);
+        }
+
+        compressMutex = NULL;
+        IExec->MutexRelease(temp);
+
+        IExec->FreeSysObject(ASOT_MUTEX, temp);
+    }
+}
+
+// Timestamps are written as hexadecimal EClock ticks since glSnoop start.
+// The header line gives the frequency for converting them into seconds.
+void use_raw_timestamps(void)
+{
+    char header[128];
+
+    snprintf(header, sizeof(header), "glSnoop: raw timestamps, EClock frequency %lu ticks/s, start 0x%llX",
+        timer_get_frequency(), timer_get_start_ticks());
+
+    writeText(header);
+
+    rawTimestamps = TRUE;
+}
+
+BOOL init_log(void)
+{
+    counterMutex = IExec->AllocSysObject(ASOT_MUTEX, TAG_DONE);
+    spareMutex = IExec->AllocSysObject(ASOT_MUTEX, TAG_DONE);
+
+    lineBuffers = IExec->AllocVecTags(LINE_BUFFER_COUNT * LINE_BUFFER_SIZE,
+        AVT_Type, MEMF_SHARED,
+        TAG_DONE);
+
+    __atomic_store_n(&logClosing, 0, __ATOMIC_RELEASE);
+
+    if (lineBuffers) {
+        __atomic_store_n(&freeLineBuffers, ALL_LINE_BUFFERS, __ATOMIC_RELEASE);
+    }
+
+    if (!counterMutex || !spareMutex || !lineBuffers) {
+        quit_log();
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+void quit_log(void)
+{
+    // Refuse new lines, then wait until the callers still formatting one
+    // have returned their buffers
+    __atomic_store_n(&logClosing, 1, __ATOMIC_SEQ_CST);
+
+    while (__atomic_load_n(&logUsers, __ATOMIC_SEQ_CST) ||
+        (lineBuffers && __atomic_load_n(&freeLineBuffers, __ATOMIC_ACQUIRE) != ALL_LINE_BUFFERS)) {
+        IDOS->Delay(1);
+    }
+
+    __atomic_store_n(&freeLineBuffers, 0, __ATOMIC_RELEASE);
+
+    if (lineBuffers) {
+        IExec->FreeVec(lineBuffers);
+        lineBuffers = NULL;
+    }
+
+    if (spareMutex) {
+        IExec->FreeSysObject(ASOT_MUTEX, spareMutex);
+        spareMutex = NULL;
+    }
+
+    if (counterMutex) {
+        IExec->FreeSysObject(ASOT_MUTEX, counterMutex);
+        counterMutex = NULL;
+    }
+}
+
+void log_serial_counters(SinkCounters * counters)
+{
+    lock_counters();
+    *counters = serialCounters;
+    unlock_counters();
+}
+
+void log_formatter_counters(SinkCounters * counters)
+{
+    lock_counters();
+    *counters = formatterCounters;
+    unlock_counters();
+}
@@ -1,12 +1,55 @@
 #ifndef LOGGER_H
 #define LOGGER_H
 
-void logLine(const char * fmt, ...) __attribute__ ((format (printf, 1, 2)));
+#include "sinks.h"
+
+#include <exec/types.h>
+
+struct Task;
+
+extern volatile BOOL logPaused;
+
+static inline BOOL logEnabled(void)
+{
+    return !logPaused;
+}
+
+// Checks the state before the arguments are evaluated, so that decoder
+// functions are not called at all when tracing is paused
+#define logLine(...) \
+do { \
+    if (logEnabled()) { \
+        logLineFunction(__VA_ARGS__); \
+    } \
+} while (0)
+
+void logLineFunction(const char * fmt, ...) __attribute__ ((format (printf, 1, 2)));
 void logAlways(const char * fmt, ...) __attribute__ ((format (printf, 1, 2)));
 void logDebug(const char * fmt, ...) __attribute__ ((format (printf, 1, 2)));
+void logText(const char * text);
+
+BOOL init_log(void);
+void quit_log(void);
 
 void pause_log(void);
 void resume_log(void);
 
+// Format log lines in a background process instead of the calling task
+BOOL start_deferred_log(void);
+void stop_deferred_log(void);
+
+// Identical consecutive lines of a task are written once, followed by a repeat count
+BOOL start_log_compression(void);
+void stop_log_compression(void);
+
+// Write the pending repeat count of a task that is going away
+void log_forget_task(const struct Task* const task);
+
+void use_raw_timestamps(void);
+
+// Formatter counts formatted lines, truncated lines and time callers waited for the deferred queue
+void log_formatter_counters(SinkCounters * counters);
+void log_serial_counters(SinkCounters * counters);
+
 #endif
 
@@ -3,7 +3,13 @@
 #include "logger.h"
 #include "gui.h"
 #include "filter.h"
+#include "recorder.h"
+#include "filesink.h"
+#include "flight.h"
+#include "snapshot.h"
+#include "sinks.h"
 #include "timer.h"
+#include "profiling.h"
 #include "version.h"
 
 #include <proto/exec.h>
@@ -22,12 +28,32 @@ struct Params {
     LONG *startTime;
     LONG *duration;
     char *filter;
+    LONG binary;
+    LONG deferred;
+    char *output;
+    LONG frameSummary;
+    LONG compress;
+    LONG rawTime;
+    char *flight;
+    LONG *flightFrames;
+    LONG *hitchTime;
+    LONG reload;
+    char *traceFilter;
+    char *task;
+    LONG *interval;
 };
 
 static const char* const version __attribute__((used)) = "$VER: " VERSION_STRING DATE_STRING "\0";
 static const char* const portName = "glSnoop port";
 static char* filterFile;
-static struct Params params = { 0, 0, 0, 0, NULL, NULL, NULL };
+static char* traceFilterFile;
+static char* taskPattern;
+static char* outputFile;
+static char* flightFile;
+static ULONG flightFrames = 30;
+static ULONG hitchTime;
+static ULONG interval;
+static struct Params params = { 0, 0, 0, 0, NULL, NULL, NULL, 0, 0, NULL, 0, 0, 0, NULL, NULL, NULL, 0, NULL, NULL, NULL };
 
 static struct MsgPort* port;
 
@@ -43,6 +69,12 @@ static BOOL already_running(void)
 {
     IExec->Forbid();
     struct MsgPort* p = IExec->FindPort(portName);
+
+    if (p && params.reload) {
+        // Control-D makes the running instance reload its filter file
+        IExec->Signal(p->mp_SigTask, SIGBREAKF_CTRL_D);
+    }
+
     IExec->Permit();
 
     return p != NULL;
@@ -105,7 +137,7 @@ static BOOL parse_args(void)
 {
     const char* const enabled = "enabled";
     const char* const disabled = "disabled";
-    const char* const pattern = "OGLES2/S,NOVA/S,GUI/S,PROFILE/S,STARTTIME/N,DURATION/N,FILTER/K";
+    const char* const pattern = "OGLES2/S,NOVA/S,GUI/S,PROFILE/S,STARTTIME/N,DURATION/N,FILTER=PROFILEFILTER/K,BINARY/S,DEFER/S,FILE=OUTPUT/K,FRAMESUMMARY/S,COMPRESS/S,RAWTIME/S,FLIGHT/K,FLIGHTFRAMES/N,HITCHTIME/N,RELOAD/S,TRACEFILTER/K,TASK/K,INTERVAL/N";
 
     // how-to handle both tooltypes and args?
 
@@ -116,6 +148,34 @@ static BOOL parse_args(void)
             filterFile = strdup(params.filter);
         }
 
+        if (params.traceFilter) {
+            traceFilterFile = strdup(params.traceFilter);
+        }
+
+        if (params.task) {
+            taskPattern = strdup(params.task);
+        }
+
+        if (params.output) {
+            outputFile = strdup(params.output);
+        }
+
+        if (params.flight) {
+            flightFile = strdup(params.flight);
+        }
+
+        if (params.flightFrames) {
+            flightFrames = (ULONG)*params.flightFrames;
+        }
+
+        if (params.hitchTime) {
+            hitchTime = (ULONG)*params.hitchTime;
+        }
+
+        if (params.interval) {
+            interval = (ULONG)*params.interval;
+        }
+
         if (params.startTime) {
             startTime = (ULONG)*params.startTime;
         }
@@ -137,9 +197,23 @@ static BOOL parse_args(void)
     printf("  WARP3DNOVA module: [%s]\n", params.nova ? enabled : disabled);
     printf("  GUI: [%s]\n", params.gui ? enabled : disabled);
     printf("  Tracing mode: [%s]\n", params.profiling ? disabled : enabled);
+    printf("  Binary trace: [%s]\n", params.binary ? enabled : disabled);
+    printf("  Deferred formatting: [%s]\n", params.deferred ? enabled : disabled);
+    printf("  Frame summary: [%s]\n", params.frameSummary ? enabled : disabled);
+    printf("  Repeat compression: [%s]\n", params.compress ? enabled : disabled);
+    printf("  Raw timestamps: [%s]\n", params.rawTime ? enabled : disabled);
+    printf("  Flight recorder file name: [%s]\n", flightFile ? flightFile : disabled);
+    if (flightFile) {
+        printf("  Flight recorder frames: [%lu]\n", flightFrames);
+        printf("  Flight recorder frame time trigger: [%lu] ms %s\n", hitchTime, !hitchTime ? "- disabled" : "");
+    }
     printf("  Filter file name: [%s]\n", filterFile ? filterFile : disabled);
+    printf("  Trace filter file name: [%s]\n", traceFilterFile ? traceFilterFile : disabled);
+    printf("  Task pattern: [%s]\n", taskPattern ? taskPattern : "all tasks");
+    printf("  Output file name: [%s]\n", outputFile ? outputFile : "serial");
     printf("  Start time: [%lu] seconds %s\n", startTime, !startTime ? "- immediate" : "");
     printf("  Duration: [%lu] seconds %s\n", duration, !duration ? "- unlimited" : "");
+    printf("  Interval snapshots: [%lu] seconds %s\n", interval, !interval ? "- disabled" : "");
     puts("---------------------");
 
     return TRUE;
@@ -148,11 +222,11 @@ static BOOL parse_args(void)
 static void install_patches(void)
 {
     if (params.ogles2) {
-        ogles2_install_patches();
+        ogles2_install_patches(params.frameSummary);
     }
 
     if (params.nova) {
-        warp3dnova_install_patches(startTime, duration);
+        warp3dnova_install_patches(startTime, duration, params.frameSummary);
     }
 }
 
@@ -219,11 +293,33 @@ static void waitForEndTimer()
     }
 }
 
+static void reload_filter(void)
+{
+    if (reload_filters()) {
+        ogles2_reload_filter();
+        warp3dnova_reload_filter();
+    }
+}
+
 static void waitForSignal()
 {
     if (running) {
         const uint32 sigMask = 1L << mainSig;
-        const uint32 wait = IExec->Wait(sigMask | SIGBREAKF_CTRL_C);
+        uint32 wait;
+
+        // Control-D reloads the filter file and Control-F requests a flight recorder dump, then keep waiting
+        while (!((wait = IExec->Wait(sigMask | SIGBREAKF_CTRL_C | SIGBREAKF_CTRL_D | SIGBREAKF_CTRL_F)) &
+            (sigMask | SIGBREAKF_CTRL_C))) {
+            if (wait & SIGBREAKF_CTRL_D) {
+                puts("Filter reload requested");
+                reload_filter();
+            }
+
+            if (wait & SIGBREAKF_CTRL_F) {
+                puts("Flight recorder dump requested");
+                flight_trigger("Control-F");
+            }
+        }
 
         if (wait & sigMask) {
             puts("Start signal received");
@@ -272,6 +368,11 @@ static void run(void)
 
 int main(int argc __attribute__((unused)), char* argv[] __attribute__((unused)))
 {
+    if (!init_log()) {
+        puts("Failed to initialize logging");
+        goto out;
+    }
+
     if (!timer_init(&timer)) {
         goto out;
     }
@@ -283,10 +384,18 @@ int main(int argc __attribute__((unused)), char* argv[] __attribute__((unused)))
     }
 
     if (already_running()) {
-        puts("glSnoop is already running");
+        puts(params.reload ? "Filter reload requested from the running glSnoop" : "glSnoop is already running");
         goto out;
     }
 
+    if (outputFile && !filesink_open(outputFile)) {
+        goto out;
+    }
+
+    if (params.rawTime) {
+        use_raw_timestamps();
+    }
+
     mainTask = IExec->FindTask(NULL);
 
     if (startTime || duration) {
@@ -303,23 +412,68 @@ int main(int argc __attribute__((unused)), char* argv[] __attribute__((unused)))
 
     create_port();
 
-    if (!load_filters(filterFile)) {
+    if (!load_filters(FilterSet_Profile, filterFile) || !load_filters(FilterSet_Trace, traceFilterFile)) {
         goto out;
     }
 
+    if (!set_task_filter(taskPattern)) {
+        goto out;
+    }
+
+    if (params.compress && !start_log_compression()) {
+        goto out;
+    }
+
+    if (params.binary && !recorder_init(params.compress)) {
+        goto out;
+    }
+
+    if (params.deferred && !start_deferred_log()) {
+        goto out;
+    }
+
+    if (flightFile && !flight_init(flightFile, flightFrames, hitchTime)) {
+        goto out;
+    }
+
+    profiling_calibrate();
+
     install_patches();
 
+    if (interval && !snapshot_init(interval)) {
+        remove_patches();
+        goto out;
+    }
+
     if (params.profiling) {
         puts("Profiling mode - disabling most serial logging...");
         pause_log();
+    } else if (params.frameSummary) {
+        puts("Frame summary mode - logging one line per frame...");
+        pause_log();
+    } else if (params.binary) {
+        puts("Binary trace mode - calls are recorded and converted to text in the background...");
+        pause_log();
     }
 
     puts("System patched. Press Control-C to quit...");
 
+    if (flightFile) {
+        puts("Press Control-F to dump the flight recorder");
+    }
+
+    if (filterFile || traceFilterFile) {
+        puts("Press Control-D or run 'glSnoop RELOAD' to reload the filter files");
+    }
+
     run();
 
+    snapshot_quit();
+
     remove_patches();
 
+    sinks_report();
+
     puts("Patches removed. glSnoop terminating");
 
 out:
@@ -330,8 +484,17 @@ out:
 
     remove_port();
 
+    snapshot_quit();
+    recorder_quit();
+    flight_quit();
+    stop_deferred_log();
+    stop_log_compression();
+
     free_filters();
     free(filterFile);
+    free(traceFilterFile);
+    free(taskPattern);
+    free(flightFile);
 
     if (startTime || duration) {
         timer_stop(&triggerTimer);
@@ -340,7 +503,12 @@ out:
 
     logLine("glSnoop exiting");
 
+    filesink_close();
+    free(outputFile);
+
     timer_quit(&timer);
 
+    quit_log();
+
     return 0;
 }
@@ -0,0 +1,206 @@
+#include "nesting.h"
+#include "logger.h"
+
+#include <proto/exec.h>
+
+#include <stdint.h>
+
+#define NESTING_TASKS 64 // Must be a power of two
+#define NESTING_DEPTH 4
+
+typedef struct NestingStack {
+    const struct Task* task; // Written once by the owner task, released by nesting_forget or nesting_leave
+    uint32 depth;
+    BOOL transient; // Claimed through a context of another task
+    NestingFrame frames[NESTING_DEPTH];
+} NestingStack;
+
+// Same open addressing scheme as the client registry: a released slot becomes
+// a tombstone so that the probe sequences of the other tasks stay intact.
+static NestingStack stacks[NESTING_TASKS];
+static const char tombstone;
+static uint32 tasksOverflowed; // Logged once
+static uint32 depthOverflowed; // Logged once
+
+#define TOMBSTONE ((const struct Task *)&tombstone)
+
+static size_t hash_task(const struct Task* const task)
+{
+    return (size_t)(((uintptr_t)task >> 4) * 2654435761UL) & (NESTING_TASKS - 1);
+}
+
+static NestingStack* find_stack(const struct Task* const task)
+{
+    size_t i = hash_task(task);
+
+    for (size_t probe = 0; probe < NESTING_TASKS; probe++) {
+        NestingStack* const stack = &stacks[i];
+        const struct Task* const owner = __atomic_load_n(&stack->task, __ATOMIC_ACQUIRE);
+
+        if (owner == task) {
+            return stack;
+        }
+
+        if (owner == NULL) {
+            break;
+        }
+
+        i = (i + 1) & (NESTING_TASKS - 1);
+    }
+
+    return NULL;
+}
+
+// Only the task itself claims a slot for its key, so the key can't be
+// inserted twice. Other tasks may race for the same free slot.
+static NestingStack* claim_stack(const struct Task* const task, const BOOL transient)
+{
+    size_t i = hash_task(task);
+
+    for (size_t probe = 0; probe < NESTING_TASKS; probe++) {
+        NestingStack* const stack = &stacks[i];
+        const struct Task* owner = __atomic_load_n(&stack->task, __ATOMIC_ACQUIRE);
+
+        if ((owner == NULL || owner == TOMBSTONE) &&
+            __atomic_compare_exchange_n(&stack->task, &owner, task, FALSE, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            stack->depth = 0;
+            stack->transient = transient;
+            return stack;
+        }
+
+        i = (i + 1) & (NESTING_TASKS - 1);
+    }
+
+    return NULL;
+}
+
+// The cached stack is valid as long as the task still owns it. Transient
+// stacks aren't cached, the context keeps the stack of its own task.
+static NestingStack* cached_stack(const struct Task* const task, struct NestingStack** const cache)
+{
+    NestingStack* stack = *cache;
+
+    if (stack && __atomic_load_n(&stack->task, __ATOMIC_ACQUIRE) == task) {
+        return stack;
+    }
+
+    stack = find_stack(task);
+
+    if (stack && !stack->transient) {
+        *cache = stack;
+    }
+
+    return stack;
+}
+
+NestingFrame* nesting_enter(const struct Task* const task, const struct Task* const owner,
+    struct NestingStack** const cache, NestingChildren* const children)
+{
+    NestingStack* stack = cached_stack(task, cache);
+
+    if (!stack) {
+        const BOOL transient = task != owner;
+
+        stack = claim_stack(task, transient);
+
+        if (!stack) {
+            if (!__atomic_exchange_n(&tasksOverflowed, 1, __ATOMIC_RELAXED)) {
+                logAlways("glSnoop: more than %d tasks use OGLES2, Nova time is not subtracted for the rest",
+                    NESTING_TASKS);
+            }
+            return NULL;
+        }
+
+        if (!transient) {
+            *cache = stack;
+        }
+    }
+
+    if (stack->depth >= NESTING_DEPTH) {
+        if (!__atomic_exchange_n(&depthOverflowed, 1, __ATOMIC_RELAXED)) {
+            logAlways("glSnoop: OGLES2 calls nested deeper than %d, Nova time is not subtracted for the inner ones",
+                NESTING_DEPTH);
+        }
+        return NULL;
+    }
+
+    NestingFrame* const frame = &stack->frames[stack->depth++];
+
+    frame->stack = stack;
+    frame->childTicks = 0;
+    frame->tracerTicks = 0;
+    frame->children = children;
+
+    return frame;
+}
+
+void nesting_leave(NestingFrame* const frame)
+{
+    NestingStack* const stack = frame->stack;
+
+    if (--stack->depth == 0 && stack->transient) {
+        __atomic_store_n(&stack->task, TOMBSTONE, __ATOMIC_RELEASE);
+    }
+}
+
+static void credit(NestingChildren* const children, const uint16 function, const uint64 ticks)
+{
+    for (int i = 0; i < NESTING_CHILDREN; i++) {
+        NestingChild* const child = &children->children[i];
+
+        if (child->calls == 0) {
+            child->function = function;
+        }
+
+        if (child->function == function) {
+            child->ticks += ticks;
+            child->calls++;
+            return;
+        }
+    }
+
+    children->otherTicks += ticks;
+    children->otherCalls++;
+}
+
+void nesting_child(const struct Task* const task, struct NestingStack** const cache, const uint16 function,
+    const uint64 ticks, const uint64 tracerTicks)
+{
+    NestingStack* const stack = cached_stack(task, cache);
+
+    if (stack && stack->depth) {
+        NestingFrame* const frame = &stack->frames[stack->depth - 1];
+
+        frame->childTicks += ticks;
+        frame->tracerTicks += tracerTicks;
+        credit(frame->children, function, ticks);
+    }
+}
+
+void nesting_forget(const struct Task* const task)
+{
+    NestingStack* const stack = find_stack(task);
+
+    if (stack) {
+        __atomic_store_n(&stack->task, TOMBSTONE, __ATOMIC_RELEASE);
+    }
+}
+
+size_t nesting_sorted(const NestingChildren* const children, NestingChild sorted[NESTING_CHILDREN])
+{
+    size_t count = 0;
+
+    // Insertion sort, there are only a few entries
+    for (int i = 0; i < NESTING_CHILDREN && children->children[i].calls; i++) {
+        const NestingChild child = children->children[i];
+        size_t j = count++;
+
+        for (; j > 0 && sorted[j - 1].ticks < child.ticks; j--) {
+            sorted[j] = sorted[j - 1];
+        }
+
+        sorted[j] = child;
+    }
+
+    return count;
+}
@@ -0,0 +1,57 @@
+#ifndef NESTING_H
+#define NESTING_H
+
+#include <exec/types.h>
+
+// Per-task stack of the OGLES2 calls in progress. Warp3D Nova wrappers credit
+// their duration to the innermost OGLES2 call of the same task, so that the
+// OGLES2 summary can tell ogles2.library's own time from the time spent in Nova.
+
+#define NESTING_CHILDREN 6 // Nova functions tracked per OGLES2 function, the rest are "other"
+
+struct Task;
+
+typedef struct NestingChild {
+    uint64 ticks;
+    uint32 calls; // 0 marks a free entry
+    uint16 function;
+} NestingChild;
+
+typedef struct NestingChildren {
+    NestingChild children[NESTING_CHILDREN];
+    uint64 otherTicks;
+    uint32 otherCalls;
+} NestingChildren;
+
+struct NestingStack;
+
+typedef struct NestingFrame {
+    struct NestingStack* stack;
+    uint64 childTicks; // Nova time inside the call so far
+    uint64 tracerTicks; // Time spent recording the Nova calls
+    NestingChildren* children;
+} NestingFrame;
+
+// Stacks are keyed on the calling task, not on the task of the context, since
+// an application may share its context with other tasks. The callers pass a
+// per-context cache of the stack so that a call usually needs no hash probe.
+
+// Pushes a frame for the calling task. A task other than the owner of the
+// context gets a transient stack that is released when its last frame is
+// popped. Returns NULL when the stack is full or there is no free task slot,
+// then the Nova time isn't subtracted.
+NestingFrame* nesting_enter(const struct Task* const task, const struct Task* const owner,
+    struct NestingStack** const cache, NestingChildren* const children);
+void nesting_leave(NestingFrame* const frame);
+
+// Credits a Nova call to the innermost OGLES2 call of the task, if any
+void nesting_child(const struct Task* const task, struct NestingStack** const cache, const uint16 function,
+    const uint64 ticks, const uint64 tracerTicks);
+
+// Releases the stack of a task, when its OGLES2 interface is dropped
+void nesting_forget(const struct Task* const task);
+
+// Copies the children in descending time order, returns their count
+size_t nesting_sorted(const NestingChildren* const children, NestingChild sorted[NESTING_CHILDREN]);
+
+#endif
@@ -0,0 +1,17 @@
+#include "ogles2_enums.h"
+
+static const EnumName valueNames[] = {
+    OGLES2_VALUE_NAMES(ENUM_ENTRY)
+};
+
+static const EnumName capabilityNames[] = {
+    OGLES2_CAPABILITY_NAMES(ENUM_ENTRY)
+};
+
+static const EnumName primitiveNames[] = {
+    OGLES2_PRIMITIVE_NAMES(ENUM_ENTRY)
+};
+
+const EnumTable ogles2ValueTable = ENUM_TABLE(valueNames);
+const EnumTable ogles2CapabilityTable = ENUM_TABLE(capabilityNames);
+const EnumTable ogles2PrimitiveTable = ENUM_TABLE(primitiveNames);
@@ -0,0 +1,313 @@
+#ifndef OGLES2_ENUMS_H
+#define OGLES2_ENUMS_H
+
+#include "enums.h"
+
+// GLenum names decoded by the OGLES2 wrappers: X(name, value)
+//
+// The values are spelled out so that a decoder on another host doesn't need
+// the GLES2 headers. ogles2_module.c checks them against the headers at
+// compile time. Keep each list sorted by value, without aliases:
+// enum_table_find needs strictly increasing values, and "make test" checks it.
+//
+// Names sharing a value with a listed one are left out, for example GL_NONE
+// (GL_ZERO) and GL_BLEND_EQUATION (GL_BLEND_EQUATION_RGB). Also missing:
+// GL_FRAMEBUFFER_INCOMPLETE_FORMATS (not in the GLES2 headers),
+// GL_SAMPLER_2D_RECT_SHADOW and GL_TEXTURE_FILTER_CONTROL_EXT (no texture env).
+
+#define OGLES2_VALUE_NAMES(X) \
+    X(GL_ZERO, 0x0000) \
+    X(GL_ONE, 0x0001) \
+    X(GL_NEVER, 0x0200) \
+    X(GL_LESS, 0x0201) \
+    X(GL_EQUAL, 0x0202) \
+    X(GL_LEQUAL, 0x0203) \
+    X(GL_GREATER, 0x0204) \
+    X(GL_NOTEQUAL, 0x0205) \
+    X(GL_GEQUAL, 0x0206) \
+    X(GL_ALWAYS, 0x0207) \
+    X(GL_SRC_COLOR, 0x0300) \
+    X(GL_ONE_MINUS_SRC_COLOR, 0x0301) \
+    X(GL_SRC_ALPHA, 0x0302) \
+    X(GL_ONE_MINUS_SRC_ALPHA, 0x0303) \
+    X(GL_DST_ALPHA, 0x0304) \
+    X(GL_ONE_MINUS_DST_ALPHA, 0x0305) \
+    X(GL_DST_COLOR, 0x0306) \
+    X(GL_ONE_MINUS_DST_COLOR, 0x0307) \
+    X(GL_SRC_ALPHA_SATURATE, 0x0308) \
+    X(GL_FRONT, 0x0404) \
+    X(GL_BACK, 0x0405) \
+    X(GL_FRONT_AND_BACK, 0x0408) \
+    X(GL_CW, 0x0900) \
+    X(GL_CCW, 0x0901) \
+    X(GL_CULL_FACE_MODE, 0x0B45) \
+    X(GL_FRONT_FACE, 0x0B46) \
+    X(GL_DEPTH_RANGE, 0x0B70) \
+    X(GL_DEPTH_WRITEMASK, 0x0B72) \
+    X(GL_DEPTH_CLEAR_VALUE, 0x0B73) \
+    X(GL_DEPTH_FUNC, 0x0B74) \
+    X(GL_STENCIL_CLEAR_VALUE, 0x0B91) \
+    X(GL_STENCIL_FUNC, 0x0B92) \
+    X(GL_STENCIL_VALUE_MASK, 0x0B93) \
+    X(GL_STENCIL_FAIL, 0x0B94) \
+    X(GL_STENCIL_PASS_DEPTH_FAIL, 0x0B95) \
+    X(GL_STENCIL_REF, 0x0B97) \
+    X(GL_STENCIL_WRITEMASK, 0x0B98) \
+    X(GL_VIEWPORT, 0x0BA2) \
+    X(GL_SCISSOR_BOX, 0x0C10) \
+    X(GL_COLOR_CLEAR_VALUE, 0x0C22) \
+    X(GL_COLOR_WRITEMASK, 0x0C23) \
+    X(GL_UNPACK_ALIGNMENT, 0x0CF5) \
+    X(GL_PACK_ALIGNMENT, 0x0D05) \
+    X(GL_MAX_TEXTURE_SIZE, 0x0D33) \
+    X(GL_MAX_VIEWPORT_DIMS, 0x0D3A) \
+    X(GL_SUBPIXEL_BITS, 0x0D50) \
+    X(GL_RED_BITS, 0x0D52) \
+    X(GL_GREEN_BITS, 0x0D53) \
+    X(GL_BLUE_BITS, 0x0D54) \
+    X(GL_ALPHA_BITS, 0x0D55) \
+    X(GL_DEPTH_BITS, 0x0D56) \
+    X(GL_STENCIL_BITS, 0x0D57) \
+    X(GL_TEXTURE_2D, 0x0DE1) \
+    X(GL_DONT_CARE, 0x1100) \
+    X(GL_FASTEST, 0x1101) \
+    X(GL_NICEST, 0x1102) \
+    X(GL_BYTE, 0x1400) \
+    X(GL_UNSIGNED_BYTE, 0x1401) \
+    X(GL_SHORT, 0x1402) \
+    X(GL_UNSIGNED_SHORT, 0x1403) \
+    X(GL_INT, 0x1404) \
+    X(GL_UNSIGNED_INT, 0x1405) \
+    X(GL_FLOAT, 0x1406) \
+    X(GL_FIXED, 0x140C) \
+    X(GL_INVERT, 0x150A) \
+    X(GL_TEXTURE, 0x1702) \
+    X(GL_ALPHA, 0x1906) \
+    X(GL_RGB, 0x1907) \
+    X(GL_RGBA, 0x1908) \
+    X(GL_LUMINANCE, 0x1909) \
+    X(GL_LUMINANCE_ALPHA, 0x190A) \
+    X(GL_POINT, 0x1B00) \
+    X(GL_LINE, 0x1B01) \
+    X(GL_FILL, 0x1B02) \
+    X(GL_KEEP, 0x1E00) \
+    X(GL_REPLACE, 0x1E01) \
+    X(GL_INCR, 0x1E02) \
+    X(GL_DECR, 0x1E03) \
+    X(GL_VENDOR, 0x1F00) \
+    X(GL_RENDERER, 0x1F01) \
+    X(GL_VERSION, 0x1F02) \
+    X(GL_EXTENSIONS, 0x1F03) \
+    X(GL_NEAREST, 0x2600) \
+    X(GL_LINEAR, 0x2601) \
+    X(GL_NEAREST_MIPMAP_NEAREST, 0x2700) \
+    X(GL_LINEAR_MIPMAP_NEAREST, 0x2701) \
+    X(GL_NEAREST_MIPMAP_LINEAR, 0x2702) \
+    X(GL_LINEAR_MIPMAP_LINEAR, 0x2703) \
+    X(GL_TEXTURE_MAG_FILTER, 0x2800) \
+    X(GL_TEXTURE_MIN_FILTER, 0x2801) \
+    X(GL_TEXTURE_WRAP_S, 0x2802) \
+    X(GL_TEXTURE_WRAP_T, 0x2803) \
+    X(GL_REPEAT, 0x2901) \
+    X(GL_POLYGON_OFFSET_UNITS, 0x2A00) \
+    X(GL_CONSTANT_COLOR, 0x8001) \
+    X(GL_ONE_MINUS_CONSTANT_COLOR, 0x8002) \
+    X(GL_CONSTANT_ALPHA, 0x8003) \
+    X(GL_ONE_MINUS_CONSTANT_ALPHA, 0x8004) \
+    X(GL_BLEND_COLOR, 0x8005) \
+    X(GL_FUNC_ADD, 0x8006) \
+    X(GL_MIN, 0x8007) \
+    X(GL_MAX, 0x8008) \
+    X(GL_BLEND_EQUATION_RGB, 0x8009) \
+    X(GL_FUNC_SUBTRACT, 0x800A) \
+    X(GL_FUNC_REVERSE_SUBTRACT, 0x800B) \
+    X(GL_UNSIGNED_SHORT_4_4_4_4, 0x8033) \
+    X(GL_UNSIGNED_SHORT_5_5_5_1, 0x8034) \
+    X(GL_POLYGON_OFFSET_FACTOR, 0x8038) \
+    X(GL_RGB8_OES, 0x8051) \
+    X(GL_RGBA4, 0x8056) \
+    X(GL_RGB5_A1, 0x8057) \
+    X(GL_RGBA8_OES, 0x8058) \
+    X(GL_TEXTURE_BINDING_2D, 0x8069) \
+    X(GL_TEXTURE_WRAP_R_OES, 0x8072) \
+    X(GL_SAMPLE_COVERAGE_VALUE, 0x80AA) \
+    X(GL_SAMPLE_COVERAGE_INVERT, 0x80AB) \
+    X(GL_BLEND_DST_RGB, 0x80C8) \
+    X(GL_BLEND_SRC_RGB, 0x80C9) \
+    X(GL_BLEND_DST_ALPHA, 0x80CA) \
+    X(GL_BLEND_SRC_ALPHA, 0x80CB) \
+    X(GL_BGRA_EXT, 0x80E1) \
+    X(GL_CLAMP_TO_EDGE, 0x812F) \
+    X(GL_TEXTURE_MIN_LOD, 0x813A) \
+    X(GL_TEXTURE_MAX_LOD, 0x813B) \
+    X(GL_TEXTURE_BASE_LEVEL, 0x813C) \
+    X(GL_TEXTURE_MAX_LEVEL, 0x813D) \
+    X(GL_GENERATE_MIPMAP_HINT, 0x8192) \
+    X(GL_DEPTH_COMPONENT16, 0x81A5) \
+    X(GL_DEPTH_COMPONENT24_OES, 0x81A6) \
+    X(GL_DEPTH_COMPONENT32_OES, 0x81A7) \
+    X(GL_UNSIGNED_SHORT_5_6_5, 0x8363) \
+    X(GL_MIRRORED_REPEAT, 0x8370) \
+    X(GL_ALIASED_POINT_SIZE_RANGE, 0x846D) \
+    X(GL_ALIASED_LINE_WIDTH_RANGE, 0x846E) \
+    X(GL_ACTIVE_TEXTURE, 0x84E0) \
+    X(GL_TEXTURE_RECTANGLE, 0x84F5) \
+    X(GL_TEXTURE_BINDING_RECTANGLE, 0x84F6) \
+    X(GL_PROXY_TEXTURE_RECTANGLE, 0x84F7) \
+    X(GL_MAX_RECTANGLE_TEXTURE_SIZE, 0x84F8) \
+    X(GL_DEPTH_STENCIL_OES, 0x84F9) \
+    X(GL_UNSIGNED_INT_24_8_OES, 0x84FA) \
+    X(GL_MAX_TEXTURE_LOD_BIAS, 0x84FD) \
+    X(GL_TEXTURE_MAX_ANISOTROPY_EXT, 0x84FE) \
+    X(GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT, 0x84FF) \
+    X(GL_TEXTURE_LOD_BIAS, 0x8501) \
+    X(GL_INCR_WRAP, 0x8507) \
+    X(GL_DECR_WRAP, 0x8508) \
+    X(GL_TEXTURE_CUBE_MAP, 0x8513) \
+    X(GL_TEXTURE_BINDING_CUBE_MAP, 0x8514) \
+    X(GL_TEXTURE_CUBE_MAP_POSITIVE_X, 0x8515) \
+    X(GL_TEXTURE_CUBE_MAP_NEGATIVE_X, 0x8516) \
+    X(GL_TEXTURE_CUBE_MAP_POSITIVE_Y, 0x8517) \
+    X(GL_TEXTURE_CUBE_MAP_NEGATIVE_Y, 0x8518) \
+    X(GL_TEXTURE_CUBE_MAP_POSITIVE_Z, 0x8519) \
+    X(GL_TEXTURE_CUBE_MAP_NEGATIVE_Z, 0x851A) \
+    X(GL_MAX_CUBE_MAP_TEXTURE_SIZE, 0x851C) \
+    X(GL_VERTEX_ATTRIB_ARRAY_ENABLED, 0x8622) \
+    X(GL_VERTEX_ATTRIB_ARRAY_SIZE, 0x8623) \
+    X(GL_VERTEX_ATTRIB_ARRAY_STRIDE, 0x8624) \
+    X(GL_VERTEX_ATTRIB_ARRAY_TYPE, 0x8625) \
+    X(GL_CURRENT_VERTEX_ATTRIB, 0x8626) \
+    X(GL_VERTEX_ATTRIB_ARRAY_POINTER, 0x8645) \
+    X(GL_NUM_COMPRESSED_TEXTURE_FORMATS, 0x86A2) \
+    X(GL_COMPRESSED_TEXTURE_FORMATS, 0x86A3) \
+    X(GL_PROGRAM_BINARY_LENGTH_OES, 0x8741) \
+    X(GL_MIRROR_CLAMP_TO_EDGE, 0x8743) \
+    X(GL_BUFFER_SIZE, 0x8764) \
+    X(GL_BUFFER_USAGE, 0x8765) \
+    X(GL_NUM_PROGRAM_BINARY_FORMATS_OES, 0x87FE) \
+    X(GL_PROGRAM_BINARY_FORMATS_OES, 0x87FF) \
+    X(GL_STENCIL_BACK_FUNC, 0x8800) \
+    X(GL_STENCIL_BACK_FAIL, 0x8801) \
+    X(GL_STENCIL_BACK_PASS_DEPTH_FAIL, 0x8802) \
+    X(GL_STENCIL_BACK_PASS_DEPTH_PASS, 0x8803) \
+    X(GL_BLEND_EQUATION_ALPHA, 0x883D) \
+    X(GL_VERTEX_ATTRIB_ARRAY_NORMALIZED, 0x886A) \
+    X(GL_ARRAY_BUFFER, 0x8892) \
+    X(GL_ELEMENT_ARRAY_BUFFER, 0x8893) \
+    X(GL_ARRAY_BUFFER_BINDING, 0x8894) \
+    X(GL_ELEMENT_ARRAY_BUFFER_BINDING, 0x8895) \
+    X(GL_VERTEX_ATTRIB_ARRAY_BUFFER_BINDING, 0x889F) \
+    X(GL_WRITE_ONLY_OES, 0x88B9) \
+    X(GL_BUFFER_ACCESS, 0x88BB) \
+    X(GL_BUFFER_MAPPED, 0x88BC) \
+    X(GL_BUFFER_MAP_POINTER_OES, 0x88BD) \
+    X(GL_STREAM_DRAW, 0x88E0) \
+    X(GL_STATIC_DRAW, 0x88E4) \
+    X(GL_DYNAMIC_DRAW, 0x88E8) \
+    X(GL_DEPTH24_STENCIL8_OES, 0x88F0) \
+    X(GL_FRAGMENT_SHADER, 0x8B30) \
+    X(GL_VERTEX_SHADER, 0x8B31) \
+    X(GL_SHADER_TYPE, 0x8B4F) \
+    X(GL_FLOAT_VEC2, 0x8B50) \
+    X(GL_FLOAT_VEC3, 0x8B51) \
+    X(GL_FLOAT_VEC4, 0x8B52) \
+    X(GL_INT_VEC2, 0x8B53) \
+    X(GL_INT_VEC3, 0x8B54) \
+    X(GL_INT_VEC4, 0x8B55) \
+    X(GL_BOOL, 0x8B56) \
+    X(GL_BOOL_VEC2, 0x8B57) \
+    X(GL_BOOL_VEC3, 0x8B58) \
+    X(GL_BOOL_VEC4, 0x8B59) \
+    X(GL_FLOAT_MAT2, 0x8B5A) \
+    X(GL_FLOAT_MAT3, 0x8B5B) \
+    X(GL_FLOAT_MAT4, 0x8B5C) \
+    X(GL_SAMPLER_2D, 0x8B5E) \
+    X(GL_SAMPLER_CUBE, 0x8B60) \
+    X(GL_SAMPLER_2D_RECT, 0x8B63) \
+    X(GL_DELETE_STATUS, 0x8B80) \
+    X(GL_COMPILE_STATUS, 0x8B81) \
+    X(GL_LINK_STATUS, 0x8B82) \
+    X(GL_VALIDATE_STATUS, 0x8B83) \
+    X(GL_INFO_LOG_LENGTH, 0x8B84) \
+    X(GL_ATTACHED_SHADERS, 0x8B85) \
+    X(GL_ACTIVE_UNIFORMS, 0x8B86) \
+    X(GL_ACTIVE_UNIFORM_MAX_LENGTH, 0x8B87) \
+    X(GL_SHADER_SOURCE_LENGTH, 0x8B88) \
+    X(GL_ACTIVE_ATTRIBUTES, 0x8B89) \
+    X(GL_ACTIVE_ATTRIBUTE_MAX_LENGTH, 0x8B8A) \
+    X(GL_FRAGMENT_SHADER_DERIVATIVE_HINT_OES, 0x8B8B) \
+    X(GL_SHADING_LANGUAGE_VERSION, 0x8B8C) \
+    X(GL_CURRENT_PROGRAM, 0x8B8D) \
+    X(GL_IMPLEMENTATION_COLOR_READ_TYPE, 0x8B9A) \
+    X(GL_IMPLEMENTATION_COLOR_READ_FORMAT, 0x8B9B) \
+    X(GL_STENCIL_BACK_REF, 0x8CA3) \
+    X(GL_STENCIL_BACK_VALUE_MASK, 0x8CA4) \
+    X(GL_STENCIL_BACK_WRITEMASK, 0x8CA5) \
+    X(GL_FRAMEBUFFER_BINDING, 0x8CA6) \
+    X(GL_RENDERBUFFER_BINDING, 0x8CA7) \
+    X(GL_FRAMEBUFFER_ATTACHMENT_OBJECT_TYPE, 0x8CD0) \
+    X(GL_FRAMEBUFFER_ATTACHMENT_OBJECT_NAME, 0x8CD1) \
+    X(GL_FRAMEBUFFER_ATTACHMENT_TEXTURE_LEVEL, 0x8CD2) \
+    X(GL_FRAMEBUFFER_ATTACHMENT_TEXTURE_CUBE_MAP_FACE, 0x8CD3) \
+    X(GL_FRAMEBUFFER_COMPLETE, 0x8CD5) \
+    X(GL_FRAMEBUFFER_INCOMPLETE_ATTACHMENT, 0x8CD6) \
+    X(GL_FRAMEBUFFER_INCOMPLETE_MISSING_ATTACHMENT, 0x8CD7) \
+    X(GL_FRAMEBUFFER_INCOMPLETE_DIMENSIONS, 0x8CD9) \
+    X(GL_FRAMEBUFFER_UNSUPPORTED, 0x8CDD) \
+    X(GL_COLOR_ATTACHMENT0, 0x8CE0) \
+    X(GL_DEPTH_ATTACHMENT, 0x8D00) \
+    X(GL_STENCIL_ATTACHMENT, 0x8D20) \
+    X(GL_FRAMEBUFFER, 0x8D40) \
+    X(GL_RENDERBUFFER, 0x8D41) \
+    X(GL_RENDERBUFFER_WIDTH, 0x8D42) \
+    X(GL_RENDERBUFFER_HEIGHT, 0x8D43) \
+    X(GL_RENDERBUFFER_INTERNAL_FORMAT, 0x8D44) \
+    X(GL_STENCIL_INDEX1_OES, 0x8D46) \
+    X(GL_STENCIL_INDEX4_OES, 0x8D47) \
+    X(GL_STENCIL_INDEX8, 0x8D48) \
+    X(GL_RENDERBUFFER_RED_SIZE, 0x8D50) \
+    X(GL_RENDERBUFFER_GREEN_SIZE, 0x8D51) \
+    X(GL_RENDERBUFFER_BLUE_SIZE, 0x8D52) \
+    X(GL_RENDERBUFFER_ALPHA_SIZE, 0x8D53) \
+    X(GL_RENDERBUFFER_DEPTH_SIZE, 0x8D54) \
+    X(GL_RENDERBUFFER_STENCIL_SIZE, 0x8D55) \
+    X(GL_HALF_FLOAT_OES, 0x8D61) \
+    X(GL_RGB565, 0x8D62) \
+    X(GL_LOW_FLOAT, 0x8DF0) \
+    X(GL_MEDIUM_FLOAT, 0x8DF1) \
+    X(GL_HIGH_FLOAT, 0x8DF2) \
+    X(GL_LOW_INT, 0x8DF3) \
+    X(GL_MEDIUM_INT, 0x8DF4) \
+    X(GL_HIGH_INT, 0x8DF5) \
+    X(GL_QUADS_FOLLOW_PROVOKING_VERTEX_CONVENTION, 0x8E4C) \
+    X(GL_FIRST_VERTEX_CONVENTION, 0x8E4D) \
+    X(GL_LAST_VERTEX_CONVENTION, 0x8E4E) \
+    X(GL_PROVOKING_VERTEX, 0x8E4F)
+
+// TODO: GL_SAMPLE_COVERAGE_TO_ALPHA? Typo?
+#define OGLES2_CAPABILITY_NAMES(X) \
+    X(GL_CULL_FACE, 0x0B44) \
+    X(GL_DEPTH_TEST, 0x0B71) \
+    X(GL_STENCIL_TEST, 0x0B90) \
+    X(GL_DITHER, 0x0BD0) \
+    X(GL_BLEND, 0x0BE2) \
+    X(GL_SCISSOR_TEST, 0x0C11) \
+    X(GL_POLYGON_OFFSET_FILL, 0x8037) \
+    X(GL_SAMPLE_ALPHA_TO_COVERAGE, 0x809E) \
+    X(GL_SAMPLE_COVERAGE, 0x80A0)
+
+#define OGLES2_PRIMITIVE_NAMES(X) \
+    X(GL_POINTS, 0x0000) \
+    X(GL_LINES, 0x0001) \
+    X(GL_LINE_LOOP, 0x0002) \
+    X(GL_LINE_STRIP, 0x0003) \
+    X(GL_TRIANGLES, 0x0004) \
+    X(GL_TRIANGLE_STRIP, 0x0005) \
+    X(GL_TRIANGLE_FAN, 0x0006)
+
+// Tables generated from the lists, in ogles2_enums.c
+extern const EnumTable ogles2ValueTable;
+extern const EnumTable ogles2CapabilityTable;
+extern const EnumTable ogles2PrimitiveTable;
+
+#endif
@@ -0,0 +1,172 @@
+#ifndef OGLES2_FUNCTIONS_H
+#define OGLES2_FUNCTIONS_H
+
+// The patched OGLES2 functions: X(prefix, name, returnType, parameters, categories)
+//
+// Everything per function (ids, names, original function pointers, patches and
+// filter categories) is generated from this list. Keep the order, function ids
+// are stored into the binary traces.
+
+#define OGLES2_FUNCTIONS(X) \
+    X(gl, ActiveTexture, void, (struct OGLES2IFace *Self, GLenum texture), Category_State) \
+    X(gl, AttachShader, void, (struct OGLES2IFace *Self, GLuint program, GLuint shader), Category_Shader) \
+    X(gl, BindAttribLocation, void, (struct OGLES2IFace *Self, GLuint program, GLuint index, const GLchar * name), Category_State | Category_Shader) \
+    X(gl, BindBuffer, void, (struct OGLES2IFace *Self, GLenum target, GLuint buffer), Category_State) \
+    X(gl, BindFramebuffer, void, (struct OGLES2IFace *Self, GLenum target, GLuint framebuffer), Category_State) \
+    X(gl, BindRenderbuffer, void, (struct OGLES2IFace *Self, GLenum target, GLuint renderbuffer), Category_State) \
+    X(gl, BindTexture, void, (struct OGLES2IFace *Self, GLenum target, GLuint texture), Category_State) \
+    X(gl, BlendColor, void, (struct OGLES2IFace *Self, GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha), Category_State) \
+    X(gl, BlendEquation, void, (struct OGLES2IFace *Self, GLenum mode), Category_State) \
+    X(gl, BlendEquationSeparate, void, (struct OGLES2IFace *Self, GLenum modeRGB, GLenum modeAlpha), Category_State) \
+    X(gl, BlendFunc, void, (struct OGLES2IFace *Self, GLenum sfactor, GLenum dfactor), Category_State) \
+    X(gl, BlendFuncSeparate, void, (struct OGLES2IFace *Self, GLenum sfactorRGB, GLenum dfactorRGB, GLenum sfactorAlpha, GLenum dfactorAlpha), Category_State) \
+    X(gl, BufferData, void, (struct OGLES2IFace *Self, GLenum target, GLsizeiptr size, const void * data, GLenum usage), Category_Upload) \
+    X(gl, BufferSubData, void, (struct OGLES2IFace *Self, GLenum target, GLintptr offset, GLsizeiptr size, const void * data), Category_Upload) \
+    X(gl, CheckFramebufferStatus, GLenum, (struct OGLES2IFace *Self, GLenum target), Category_Query) \
+    X(gl, Clear, void, (struct OGLES2IFace *Self, GLbitfield mask), Category_Draw) \
+    X(gl, ClearColor, void, (struct OGLES2IFace *Self, GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha), Category_State) \
+    X(gl, ClearDepthf, void, (struct OGLES2IFace *Self, GLfloat d), Category_State) \
+    X(gl, ClearStencil, void, (struct OGLES2IFace *Self, GLint s), Category_State) \
+    X(gl, ColorMask, void, (struct OGLES2IFace *Self, GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha), Category_State) \
+    X(gl, CompileShader, void, (struct OGLES2IFace *Self, GLuint shader), Category_Shader) \
+    X(gl, CompressedTexImage2D, void, (struct OGLES2IFace *Self, GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLint border, GLsizei imageSize, const void * data), Category_Upload) \
+    X(gl, CompressedTexSubImage2D, void, (struct OGLES2IFace *Self, GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLsizei imageSize, const void * data), Category_Upload) \
+    X(gl, CopyTexImage2D, void, (struct OGLES2IFace *Self, GLenum target, GLint level, GLenum internalformat, GLint x, GLint y, GLsizei width, GLsizei height, GLint border), Category_Upload) \
+    X(gl, CopyTexSubImage2D, void, (struct OGLES2IFace *Self, GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint x, GLint y, GLsizei width, GLsizei height), Category_Upload) \
+    X(agl, CreateContext_AVOID, void*, (struct OGLES2IFace *Self, ULONG * errcode, struct TagItem * tags), Category_None) \
+    X(agl, CreateContext2, void*, (struct OGLES2IFace *Self, ULONG * errcode, struct TagItem * tags), Category_None) \
+    X(gl, CreateProgram, GLuint, (struct OGLES2IFace *Self), Category_Shader) \
+    X(gl, CreateShader, GLuint, (struct OGLES2IFace *Self, GLenum type), Category_Shader) \
+    X(gl, CullFace, void, (struct OGLES2IFace *Self, GLenum mode), Category_State) \
+    X(gl, DeleteBuffers, void, (struct OGLES2IFace *Self, GLsizei n, GLuint * buffers), Category_None) \
+    X(gl, DeleteFramebuffers, void, (struct OGLES2IFace *Self, GLsizei n, const GLuint * framebuffers), Category_None) \
+    X(gl, DeleteProgram, void, (struct OGLES2IFace *Self, GLuint program), Category_Shader) \
+    X(gl, DeleteRenderbuffers, void, (struct OGLES2IFace *Self, GLsizei n, const GLuint * renderbuffers), Category_None) \
+    X(gl, DeleteShader, void, (struct OGLES2IFace *Self, GLuint shader), Category_Shader) \
+    X(gl, DeleteTextures, void, (struct OGLES2IFace *Self, GLsizei n, const GLuint * textures), Category_None) \
+    X(gl, DepthFunc, void, (struct OGLES2IFace *Self, GLenum func), Category_State) \
+    X(gl, DepthMask, void, (struct OGLES2IFace *Self, GLboolean flag), Category_State) \
+    X(gl, DepthRangef, void, (struct OGLES2IFace *Self, GLfloat n, GLfloat f), Category_State) \
+    X(agl, DestroyContext, void, (struct OGLES2IFace *Self, void* context), Category_None) \
+    X(gl, DetachShader, void, (struct OGLES2IFace *Self, GLuint program, GLuint shader), Category_Shader) \
+    X(gl, Disable, void, (struct OGLES2IFace *Self, GLenum cap), Category_State) \
+    X(gl, DisableVertexAttribArray, void, (struct OGLES2IFace *Self, GLuint index), Category_State) \
+    X(gl, DrawArrays, void, (struct OGLES2IFace *Self, GLenum mode, GLint first, GLsizei count), Category_Draw) \
+    X(gl, DrawElements, void, (struct OGLES2IFace *Self, GLenum mode, GLsizei count, GLenum type, const void * indices), Category_Draw) \
+    X(gl, DrawElementsBaseVertexOES, void, (struct OGLES2IFace *Self, GLenum mode, GLsizei count, GLenum type, const void * indices, GLint basevertex), Category_Draw) \
+    X(gl, Enable, void, (struct OGLES2IFace *Self, GLenum cap), Category_State) \
+    X(gl, EnableVertexAttribArray, void, (struct OGLES2IFace *Self, GLuint index), Category_State) \
+    X(gl, Finish, void, (struct OGLES2IFace *Self), Category_Draw) \
+    X(gl, Flush, void, (struct OGLES2IFace *Self), Category_Draw) \
+    X(gl, FramebufferRenderbuffer, void, (struct OGLES2IFace *Self, GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer), Category_None) \
+    X(gl, FramebufferTexture2D, void, (struct OGLES2IFace *Self, GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level), Category_None) \
+    X(gl, FrontFace, void, (struct OGLES2IFace *Self, GLenum mode), Category_State) \
+    X(gl, GenBuffers, void, (struct OGLES2IFace *Self, GLsizei n, GLuint * buffers), Category_None) \
+    X(gl, GenerateMipmap, void, (struct OGLES2IFace *Self, GLenum target), Category_Upload) \
+    X(gl, GenFramebuffers, void, (struct OGLES2IFace *Self, GLsizei n, GLuint * framebuffers), Category_None) \
+    X(gl, GenRenderbuffers, void, (struct OGLES2IFace *Self, GLsizei n, GLuint * renderbuffers), Category_None) \
+    X(gl, GenTextures, void, (struct OGLES2IFace *Self, GLsizei n, GLuint * textures), Category_None) \
+    X(gl, GetActiveAttrib, void, (struct OGLES2IFace *Self, GLuint program, GLuint index, GLsizei bufSize, GLsizei * length, GLint * size, GLenum * type, GLchar * name), Category_Query) \
+    X(gl, GetActiveUniform, void, (struct OGLES2IFace *Self, GLuint program, GLuint index, GLsizei bufSize, GLsizei * length, GLint * size, GLenum * type, GLchar * name), Category_Query) \
+    X(gl, GetAttachedShaders, void, (struct OGLES2IFace *Self, GLuint program, GLsizei maxCount, GLsizei * count, GLuint * shaders), Category_Query) \
+    X(gl, GetAttribLocation, GLint, (struct OGLES2IFace *Self, GLuint program, const GLchar * name), Category_Query) \
+    X(gl, GetBooleanv, void, (struct OGLES2IFace *Self, GLenum pname, GLboolean * data), Category_Query) \
+    X(gl, GetBufferParameteriv, void, (struct OGLES2IFace *Self, GLenum target, GLenum pname, GLint * params), Category_Query) \
+    X(gl, GetBufferParameterivOES, void, (struct OGLES2IFace *Self, GLenum target, GLenum value, GLint *data), Category_Query) \
+    X(gl, GetBufferPointervOES, void, (struct OGLES2IFace *Self, GLenum target, GLenum pname, void **params), Category_Query) \
+    X(gl, GetError, GLenum, (struct OGLES2IFace *Self), Category_Query) \
+    X(gl, GetFloatv, void, (struct OGLES2IFace *Self, GLenum pname, GLfloat * data), Category_Query) \
+    X(gl, GetFramebufferAttachmentParameteriv, void, (struct OGLES2IFace *Self, GLenum target, GLenum attachment, GLenum pname, GLint * params), Category_Query) \
+    X(gl, GetIntegerv, void, (struct OGLES2IFace *Self, GLenum pname, GLint * data), Category_Query) \
+    X(agl, GetProcAddress, void*, (struct OGLES2IFace *Self, const char *name), Category_Query) \
+    X(gl, GetProgramBinaryOES, void, (struct OGLES2IFace *Self, GLuint program, GLsizei bufSize, GLsizei *length, GLenum *binaryFormat, void *binary), Category_Query) \
+    X(gl, GetProgramiv, void, (struct OGLES2IFace *Self, GLuint program, GLenum pname, GLint * params), Category_Query) \
+    X(gl, GetProgramInfoLog, void, (struct OGLES2IFace *Self, GLuint program, GLsizei bufSize, GLsizei * length, GLchar * infoLog), Category_Query) \
+    X(gl, GetRenderbufferParameteriv, void, (struct OGLES2IFace *Self, GLenum target, GLenum pname, GLint * params), Category_Query) \
+    X(gl, GetShaderiv, void, (struct OGLES2IFace *Self, GLuint shader, GLenum pname, GLint * params), Category_Query) \
+    X(gl, GetShaderInfoLog, void, (struct OGLES2IFace *Self, GLuint shader, GLsizei bufSize, GLsizei * length, GLchar * infoLog), Category_Query) \
+    X(gl, GetShaderPrecisionFormat, void, (struct OGLES2IFace *Self, GLenum shadertype, GLenum precisiontype, GLint * range, GLint * precision), Category_Query) \
+    X(gl, GetShaderSource, void, (struct OGLES2IFace *Self, GLuint shader, GLsizei bufSize, GLsizei * length, GLchar * source), Category_Query) \
+    X(gl, GetString, const GLubyte *, (struct OGLES2IFace *Self, GLenum name), Category_Query) \
+    X(gl, GetTexParameterfv, void, (struct OGLES2IFace *Self, GLenum target, GLenum pname, GLfloat * params), Category_Query) \
+    X(gl, GetTexParameteriv, void, (struct OGLES2IFace *Self, GLenum target, GLenum pname, GLint * params), Category_Query) \
+    X(gl, GetUniformfv, void, (struct OGLES2IFace *Self, GLuint program, GLint location, GLfloat * params), Category_Query) \
+    X(gl, GetUniformiv, void, (struct OGLES2IFace *Self, GLuint program, GLint location, GLint * params), Category_Query) \
+    X(gl, GetUniformLocation, GLint, (struct OGLES2IFace *Self, GLuint program, const GLchar * name), Category_Query) \
+    X(gl, GetVertexAttribfv, void, (struct OGLES2IFace *Self, GLuint index, GLenum pname, GLfloat * params), Category_Query) \
+    X(gl, GetVertexAttribiv, void, (struct OGLES2IFace *Self, GLuint index, GLenum pname, GLint * params), Category_Query) \
+    X(gl, GetVertexAttribPointerv, void, (struct OGLES2IFace *Self, GLuint index, GLenum pname, void ** pointer), Category_Query) \
+    X(gl, Hint, void, (struct OGLES2IFace *Self, GLenum target, GLenum mode), Category_State) \
+    X(gl, IsBuffer, GLboolean, (struct OGLES2IFace *Self, GLuint buffer), Category_Query) \
+    X(gl, IsEnabled, GLboolean, (struct OGLES2IFace *Self, GLenum cap), Category_Query) \
+    X(gl, IsFramebuffer, GLboolean, (struct OGLES2IFace *Self, GLuint framebuffer), Category_Query) \
+    X(gl, IsProgram, GLboolean, (struct OGLES2IFace *Self, GLuint program), Category_Query) \
+    X(gl, IsRenderbuffer, GLboolean, (struct OGLES2IFace *Self, GLuint renderbuffer), Category_Query) \
+    X(gl, IsShader, GLboolean, (struct OGLES2IFace *Self, GLuint shader), Category_Query) \
+    X(gl, IsTexture, GLboolean, (struct OGLES2IFace *Self, GLuint texture), Category_Query) \
+    X(gl, LineWidth, void, (struct OGLES2IFace *Self, GLfloat width), Category_State) \
+    X(gl, LinkProgram, void, (struct OGLES2IFace *Self, GLuint program), Category_Shader) \
+    X(agl, MakeCurrent, void, (struct OGLES2IFace *Self, void* context), Category_None) \
+    X(gl, MapBufferOES, void*, (struct OGLES2IFace *Self, GLenum target, GLenum access), Category_Upload) \
+    X(gl, PixelStorei, void, (struct OGLES2IFace *Self, GLenum pname, GLint param), Category_State) \
+    X(gl, PolygonMode, void, (struct OGLES2IFace *Self, GLenum face, GLenum mode), Category_State) \
+    X(gl, PolygonOffset, void, (struct OGLES2IFace *Self, GLfloat factor, GLfloat units), Category_State) \
+    X(gl, ProgramBinaryOES, void, (struct OGLES2IFace *Self, GLuint program, GLenum binaryFormat, const void *binary, GLint length), Category_Shader) \
+    X(gl, ProvokingVertex, void, (struct OGLES2IFace *Self, GLenum provokeMode), Category_State) \
+    X(gl, ReadPixels, void, (struct OGLES2IFace *Self, GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, void * pixels), Category_None) \
+    X(gl, ReleaseShaderCompiler, void, (struct OGLES2IFace *Self), Category_Shader) \
+    X(gl, RenderbufferStorage, void, (struct OGLES2IFace *Self, GLenum target, GLenum internalformat, GLsizei width, GLsizei height), Category_None) \
+    X(gl, SampleCoverage, void, (struct OGLES2IFace *Self, GLfloat value, GLboolean invert), Category_State) \
+    X(gl, Scissor, void, (struct OGLES2IFace *Self, GLint x, GLint y, GLsizei width, GLsizei height), Category_State) \
+    X(agl, SetBitmap, void, (struct OGLES2IFace *Self, struct BitMap *bitmap), Category_None) \
+    X(agl, SetParams_AVOID, void, (struct OGLES2IFace *Self, struct TagItem * tags), Category_None) \
+    X(agl, SetParams2, void, (struct OGLES2IFace *Self, struct TagItem * tags), Category_None) \
+    X(gl, ShaderBinary, void, (struct OGLES2IFace *Self, GLsizei count, const GLuint * shaders, GLenum binaryformat, const void * binary, GLsizei length), Category_Shader) \
+    X(gl, ShaderSource, void, (struct OGLES2IFace *Self, GLuint shader, GLsizei count, const GLchar *const* string, const GLint * length), Category_Shader) \
+    X(gl, StencilFunc, void, (struct OGLES2IFace *Self, GLenum func, GLint ref, GLuint mask), Category_State) \
+    X(gl, StencilFuncSeparate, void, (struct OGLES2IFace *Self, GLenum face, GLenum func, GLint ref, GLuint mask), Category_State) \
+    X(gl, StencilMask, void, (struct OGLES2IFace *Self, GLuint mask), Category_State) \
+    X(gl, StencilMaskSeparate, void, (struct OGLES2IFace *Self, GLenum face, GLuint mask), Category_State) \
+    X(gl, StencilOp, void, (struct OGLES2IFace *Self, GLenum fail, GLenum zfail, GLenum zpass), Category_State) \
+    X(gl, StencilOpSeparate, void, (struct OGLES2IFace *Self, GLenum face, GLenum sfail, GLenum dpfail, GLenum dppass), Category_State) \
+    X(agl, SwapBuffers, void, (struct OGLES2IFace *Self), Category_Draw) \
+    X(gl, TexImage2D, void, (struct OGLES2IFace *Self, GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void * pixels), Category_Upload) \
+    X(gl, TexParameterf, void, (struct OGLES2IFace *Self, GLenum target, GLenum pname, GLfloat param), Category_State) \
+    X(gl, TexParameterfv, void, (struct OGLES2IFace *Self, GLenum target, GLenum pname, const GLfloat * params), Category_State) \
+    X(gl, TexParameteri, void, (struct OGLES2IFace *Self, GLenum target, GLenum pname, GLint param), Category_State) \
+    X(gl, TexParameteriv, void, (struct OGLES2IFace *Self, GLenum target, GLenum pname, const GLint * params), Category_State) \
+    X(gl, TexSubImage2D, void, (struct OGLES2IFace *Self, GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const void * pixels), Category_Upload) \
+    X(gl, Uniform1f, void, (struct OGLES2IFace *Self, GLint location, GLfloat v0), Category_State) \
+    X(gl, Uniform1fv, void, (struct OGLES2IFace *Self, GLint location, GLsizei count, const GLfloat * value), Category_State) \
+    X(gl, Uniform1i, void, (struct OGLES2IFace *Self, GLint location, GLint v0), Category_State) \
+    X(gl, Uniform1iv, void, (struct OGLES2IFace *Self, GLint location, GLsizei count, const GLint * value), Category_State) \
+    X(gl, Uniform2f, void, (struct OGLES2IFace *Self, GLint location, GLfloat v0, GLfloat v1), Category_State) \
+    X(gl, Uniform2fv, void, (struct OGLES2IFace *Self, GLint location, GLsizei count, const GLfloat * value), Category_State) \
+    X(gl, Uniform2i, void, (struct OGLES2IFace *Self, GLint location, GLint v0, GLint v1), Category_State) \
+    X(gl, Uniform2iv, void, (struct OGLES2IFace *Self, GLint location, GLsizei count, const GLint * value), Category_State) \
+    X(gl, Uniform3f, void, (struct OGLES2IFace *Self, GLint location, GLfloat v0, GLfloat v1, GLfloat v2), Category_State) \
+    X(gl, Uniform3fv, void, (struct OGLES2IFace *Self, GLint location, GLsizei count, const GLfloat * value), Category_State) \
+    X(gl, Uniform3i, void, (struct OGLES2IFace *Self, GLint location, GLint v0, GLint v1, GLint v2), Category_State) \
+    X(gl, Uniform3iv, void, (struct OGLES2IFace *Self, GLint location, GLsizei count, const GLint * value), Category_State) \
+    X(gl, Uniform4f, void, (struct OGLES2IFace *Self, GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3), Category_State) \
+    X(gl, Uniform4fv, void, (struct OGLES2IFace *Self, GLint location, GLsizei count, const GLfloat * value), Category_State) \
+    X(gl, Uniform4i, void, (struct OGLES2IFace *Self, GLint location, GLint v0, GLint v1, GLint v2, GLint v3), Category_State) \
+    X(gl, Uniform4iv, void, (struct OGLES2IFace *Self, GLint location, GLsizei count, const GLint * value), Category_State) \
+    X(gl, UniformMatrix2fv, void, (struct OGLES2IFace *Self, GLint location, GLsizei count, GLboolean transpose, const GLfloat * value), Category_State) \
+    X(gl, UniformMatrix3fv, void, (struct OGLES2IFace *Self, GLint location, GLsizei count, GLboolean transpose, const GLfloat * value), Category_State) \
+    X(gl, UniformMatrix4fv, void, (struct OGLES2IFace *Self, GLint location, GLsizei count, GLboolean transpose, const GLfloat * value), Category_State) \
+    X(gl, UnmapBufferOES, GLboolean, (struct OGLES2IFace *Self, GLenum target), Category_Upload) \
+    X(gl, UseProgram, void, (struct OGLES2IFace *Self, GLuint program), Category_State) \
+    X(gl, ValidateProgram, void, (struct OGLES2IFace *Self, GLuint program), Category_Shader) \
+    X(gl, VertexAttrib1f, void, (struct OGLES2IFace *Self, GLuint index, GLfloat x), Category_State) \
+    X(gl, VertexAttrib1fv, void, (struct OGLES2IFace *Self, GLuint index, const GLfloat * v), Category_State) \
+    X(gl, VertexAttrib2f, void, (struct OGLES2IFace *Self, GLuint index, GLfloat x, GLfloat y), Category_State) \
+    X(gl, VertexAttrib2fv, void, (struct OGLES2IFace *Self, GLuint index, const GLfloat * v), Category_State) \
+    X(gl, VertexAttrib3f, void, (struct OGLES2IFace *Self, GLuint index, GLfloat x, GLfloat y, GLfloat z), Category_State) \
+    X(gl, VertexAttrib3fv, void, (struct OGLES2IFace *Self, GLuint index, const GLfloat * v), Category_State) \
+    X(gl, VertexAttrib4f, void, (struct OGLES2IFace *Self, GLuint index, GLfloat x, GLfloat y, GLfloat z, GLfloat w), Category_State) \
+    X(gl, VertexAttrib4fv, void, (struct OGLES2IFace *Self, GLuint index, const GLfloat * v), Category_State) \
+    X(gl, VertexAttribPointer, void, (struct OGLES2IFace *Self, GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void * pointer), Category_State) \
+    X(gl, Viewport, void, (struct OGLES2IFace *Self, GLint x, GLint y, GLsizei width, GLsizei height), Category_State)
+
+#endif
@@ -1,9 +1,14 @@
 #include "ogles2_module.h"
+#include "warp3dnova_module.h"
 #include "common.h"
 #include "filter.h"
 #include "timer.h"
 #include "profiling.h"
 #include "logger.h"
+#include "recorder.h"
+#include "ogles2_enums.h"
+#include "clients.h"
+#include "ogles2_functions.h"
 
 #include <proto/exec.h>
 #include <proto/ogles2.h>
@@ -19,346 +24,65 @@ struct Library* OGLES2Base;
 
 static unsigned errorCount;
 static BOOL profilingStarted = TRUE;
+static BOOL frameSummaryMode = FALSE;
 
 typedef enum Ogles2Function {
-    ActiveTexture,
-    AttachShader,
-    BindAttribLocation,
-    BindBuffer,
-    BindFramebuffer,
-    BindRenderbuffer,
-    BindTexture,
-    BlendColor,
-    BlendEquation,
-    BlendEquationSeparate,
-    BlendFunc,
-    BlendFuncSeparate,
-    BufferData,
-    BufferSubData,
-    CheckFramebufferStatus,
-    Clear,
-    ClearColor,
-    ClearDepthf,
-    ClearStencil,
-    ColorMask,
-    CompileShader,
-    CompressedTexImage2D,
-    CompressedTexSubImage2D,
-    CopyTexImage2D,
-    CopyTexSubImage2D,
-    CreateContext_AVOID,
-    CreateContext2,
-    CreateProgram,
-    CreateShader,
-    CullFace,
-    DeleteBuffers,
-    DeleteFramebuffers,
-    DeleteProgram,
-    DeleteRenderbuffers,
-    DeleteShader,
-    DeleteTextures,
-    DepthFunc,
-    DepthMask,
-    DepthRangef,
-    DestroyContext,
-    DetachShader,
-    Disable,
-    DisableVertexAttribArray,
-    DrawArrays,
-    DrawElements,
-    DrawElementsBaseVertexOES,
-    Enable,
-    EnableVertexAttribArray,
-    Finish,
-    Flush,
-    FramebufferRenderbuffer,
-    FramebufferTexture2D,
-    FrontFace,
-    GenBuffers,
-    GenerateMipmap,
-    GenFramebuffers,
-    GenRenderbuffers,
-    GenTextures,
-    GetActiveAttrib,
-    GetActiveUniform,
-    GetAttachedShaders,
-    GetAttribLocation,
-    GetBooleanv,
-    GetBufferParameteriv,
-    GetBufferParameterivOES,
-    GetBufferPointervOES,
-    GetError,
-    GetFloatv,
-    GetFramebufferAttachmentParameteriv,
-    GetIntegerv,
-    GetProcAddress,
-    GetProgramBinaryOES,
-    GetProgramiv,
-    GetProgramInfoLog,
-    GetRenderbufferParameteriv,
-    GetShaderiv,
-    GetShaderInfoLog,
-    GetShaderPrecisionFormat,
-    GetShaderSource,
-    GetString,
-    GetTexParameterfv,
-    GetTexParameteriv,
-    GetUniformfv,
-    GetUniformiv,
-    GetUniformLocation,
-    GetVertexAttribfv,
-    GetVertexAttribiv,
-    GetVertexAttribPointerv,
-    Hint,
-    IsBuffer,
-    IsEnabled,
-    IsFramebuffer,
-    IsProgram,
-    IsRenderbuffer,
-    IsShader,
-    IsTexture,
-    LineWidth,
-    LinkProgram,
-    MakeCurrent,
-    MapBufferOES,
-    PixelStorei,
-    PolygonMode,
-    PolygonOffset,
-    ProgramBinaryOES,
-    ProvokingVertex,
-    ReadPixels,
-    ReleaseShaderCompiler,
-    RenderbufferStorage,
-    SampleCoverage,
-    Scissor,
-    SetBitmap,
-    SetParams_AVOID,
-    SetParams2,
-    ShaderBinary,
-    ShaderSource,
-    StencilFunc,
-    StencilFuncSeparate,
-    StencilMask,
-    StencilMaskSeparate,
-    StencilOp,
-    StencilOpSeparate,
-    SwapBuffers,
-    TexImage2D,
-    TexParameterf,
-    TexParameterfv,
-    TexParameteri,
-    TexParameteriv,
-    TexSubImage2D,
-    Uniform1f,
-    Uniform1fv,
-    Uniform1i,
-    Uniform1iv,
-    Uniform2f,
-    Uniform2fv,
-    Uniform2i,
-    Uniform2iv,
-    Uniform3f,
-    Uniform3fv,
-    Uniform3i,
-    Uniform3iv,
-    Uniform4f,
-    Uniform4fv,
-    Uniform4i,
-    Uniform4iv,
-    UniformMatrix2fv,
-    UniformMatrix3fv,
-    UniformMatrix4fv,
-    UnmapBufferOES,
-    UseProgram,
-    ValidateProgram,
-    VertexAttrib1f,
-    VertexAttrib1fv,
-    VertexAttrib2f,
-    VertexAttrib2fv,
-    VertexAttrib3f,
-    VertexAttrib3fv,
-    VertexAttrib4f,
-    VertexAttrib4fv,
-    VertexAttribPointer,
-    Viewport,
+    #define OGLES2_ENUM(prefix, name, returnType, parameters, categories) name,
+    OGLES2_FUNCTIONS(OGLES2_ENUM)
+    #undef OGLES2_ENUM
     // Keep last
     Ogles2FunctionCount
 } Ogles2Function;
 
+static const char* const ogles2FunctionNames[Ogles2FunctionCount] = {
+    #define OGLES2_NAME(prefix, name, returnType, parameters, categories) #name,
+    OGLES2_FUNCTIONS(OGLES2_NAME)
+    #undef OGLES2_NAME
+};
+
+static const char* const ogles2LibraryNames[Ogles2FunctionCount] = {
+    #define OGLES2_LIBRARY_NAME(prefix, name, returnType, parameters, categories) #prefix #name,
+    OGLES2_FUNCTIONS(OGLES2_LIBRARY_NAME)
+    #undef OGLES2_LIBRARY_NAME
+};
+
+static const uint8 ogles2Categories[Ogles2FunctionCount] = {
+    #define OGLES2_CATEGORIES(prefix, name, returnType, parameters, categories) categories,
+    OGLES2_FUNCTIONS(OGLES2_CATEGORIES)
+    #undef OGLES2_CATEGORIES
+};
+
+static const char* const ogles2Signatures[Ogles2FunctionCount] = {
+    #define OGLES2_SIGNATURE(prefix, name, returnType, parameters, categories) #parameters,
+    OGLES2_FUNCTIONS(OGLES2_SIGNATURE)
+    #undef OGLES2_SIGNATURE
+};
+
+static const FilterTable ogles2FilterTable = {
+    Ogles2FunctionCount,
+    ogles2LibraryNames,
+    ogles2Categories,
+    ogles2Signatures
+};
+
 static const char* mapOgles2Function(const Ogles2Function func)
 {
-    #define MAP_ENUM(x) case x: return #x;
-
-    switch (func) {
-        MAP_ENUM(ActiveTexture)
-        MAP_ENUM(AttachShader)
-        MAP_ENUM(BindAttribLocation)
-        MAP_ENUM(BindBuffer)
-        MAP_ENUM(BindFramebuffer)
-        MAP_ENUM(BindRenderbuffer)
-        MAP_ENUM(BindTexture)
-        MAP_ENUM(BlendColor)
-        MAP_ENUM(BlendEquation)
-        MAP_ENUM(BlendEquationSeparate)
-        MAP_ENUM(BlendFunc)
-        MAP_ENUM(BlendFuncSeparate)
-        MAP_ENUM(BufferData)
-        MAP_ENUM(BufferSubData)
-        MAP_ENUM(CheckFramebufferStatus)
-        MAP_ENUM(Clear)
-        MAP_ENUM(ClearColor)
-        MAP_ENUM(ClearDepthf)
-        MAP_ENUM(ClearStencil)
-        MAP_ENUM(ColorMask)
-        MAP_ENUM(CompileShader)
-        MAP_ENUM(CompressedTexImage2D)
-        MAP_ENUM(CompressedTexSubImage2D)
-        MAP_ENUM(CopyTexImage2D)
-        MAP_ENUM(CopyTexSubImage2D)
-        MAP_ENUM(CreateContext_AVOID)
-        MAP_ENUM(CreateContext2)
-        MAP_ENUM(CreateProgram)
-        MAP_ENUM(CreateShader)
-        MAP_ENUM(CullFace)
-        MAP_ENUM(DeleteBuffers)
-        MAP_ENUM(DeleteFramebuffers)
-        MAP_ENUM(DeleteProgram)
-        MAP_ENUM(DeleteRenderbuffers)
-        MAP_ENUM(DeleteShader)
-        MAP_ENUM(DeleteTextures)
-        MAP_ENUM(DepthFunc)
-        MAP_ENUM(DepthMask)
-        MAP_ENUM(DepthRangef)
-        MAP_ENUM(DestroyContext)
-        MAP_ENUM(DetachShader)
-        MAP_ENUM(Disable)
-        MAP_ENUM(DisableVertexAttribArray)
-        MAP_ENUM(DrawArrays)
-        MAP_ENUM(DrawElements)
-        MAP_ENUM(DrawElementsBaseVertexOES)
-        MAP_ENUM(Enable)
-        MAP_ENUM(EnableVertexAttribArray)
-        MAP_ENUM(Finish)
-        MAP_ENUM(Flush)
-        MAP_ENUM(FramebufferRenderbuffer)
-        MAP_ENUM(FramebufferTexture2D)
-        MAP_ENUM(FrontFace)
-        MAP_ENUM(GenBuffers)
-        MAP_ENUM(GenerateMipmap)
-        MAP_ENUM(GenFramebuffers)
-        MAP_ENUM(GenRenderbuffers)
-        MAP_ENUM(GenTextures)
-        MAP_ENUM(GetActiveAttrib)
-        MAP_ENUM(GetActiveUniform)
-        MAP_ENUM(GetAttachedShaders)
-        MAP_ENUM(GetAttribLocation)
-        MAP_ENUM(GetBooleanv)
-        MAP_ENUM(GetBufferParameteriv)
-        MAP_ENUM(GetBufferParameterivOES)
-        MAP_ENUM(GetBufferPointervOES)
-        MAP_ENUM(GetError)
-        MAP_ENUM(GetFloatv)
-        MAP_ENUM(GetFramebufferAttachmentParameteriv)
-        MAP_ENUM(GetIntegerv)
-        MAP_ENUM(GetProcAddress)
-        MAP_ENUM(GetProgramBinaryOES)
-        MAP_ENUM(GetProgramiv)
-        MAP_ENUM(GetProgramInfoLog)
-        MAP_ENUM(GetRenderbufferParameteriv)
-        MAP_ENUM(GetShaderiv)
-        MAP_ENUM(GetShaderInfoLog)
-        MAP_ENUM(GetShaderPrecisionFormat)
-        MAP_ENUM(GetShaderSource)
-        MAP_ENUM(GetString)
-        MAP_ENUM(GetTexParameterfv)
-        MAP_ENUM(GetTexParameteriv)
-        MAP_ENUM(GetUniformfv)
-        MAP_ENUM(GetUniformiv)
-        MAP_ENUM(GetUniformLocation)
-        MAP_ENUM(GetVertexAttribfv)
-        MAP_ENUM(GetVertexAttribiv)
-        MAP_ENUM(GetVertexAttribPointerv)
-        MAP_ENUM(Hint)
-        MAP_ENUM(IsBuffer)
-        MAP_ENUM(IsEnabled)
-        MAP_ENUM(IsFramebuffer)
-        MAP_ENUM(IsProgram)
-        MAP_ENUM(IsRenderbuffer)
-        MAP_ENUM(IsShader)
-        MAP_ENUM(IsTexture)
-        MAP_ENUM(LineWidth)
-        MAP_ENUM(LinkProgram)
-        MAP_ENUM(MakeCurrent)
-        MAP_ENUM(MapBufferOES)
-        MAP_ENUM(PixelStorei)
-        MAP_ENUM(PolygonMode)
-        MAP_ENUM(PolygonOffset)
-        MAP_ENUM(ProgramBinaryOES)
-        MAP_ENUM(ProvokingVertex)
-        MAP_ENUM(ReadPixels)
-        MAP_ENUM(ReleaseShaderCompiler)
-        MAP_ENUM(RenderbufferStorage)
-        MAP_ENUM(SampleCoverage)
-        MAP_ENUM(Scissor)
-        MAP_ENUM(SetBitmap)
-        MAP_ENUM(SetParams_AVOID)
-        MAP_ENUM(SetParams2)
-        MAP_ENUM(ShaderBinary)
-        MAP_ENUM(ShaderSource)
-        MAP_ENUM(StencilFunc)
-        MAP_ENUM(StencilFuncSeparate)
-        MAP_ENUM(StencilMask)
-        MAP_ENUM(StencilMaskSeparate)
-        MAP_ENUM(StencilOp)
-        MAP_ENUM(StencilOpSeparate)
-        MAP_ENUM(SwapBuffers)
-        MAP_ENUM(TexImage2D)
-        MAP_ENUM(TexParameterf)
-        MAP_ENUM(TexParameterfv)
-        MAP_ENUM(TexParameteri)
-        MAP_ENUM(TexParameteriv)
-        MAP_ENUM(TexSubImage2D)
-        MAP_ENUM(Uniform1f)
-        MAP_ENUM(Uniform1fv)
-        MAP_ENUM(Uniform1i)
-        MAP_ENUM(Uniform1iv)
-        MAP_ENUM(Uniform2f)
-        MAP_ENUM(Uniform2fv)
-        MAP_ENUM(Uniform2i)
-        MAP_ENUM(Uniform2iv)
-        MAP_ENUM(Uniform3f)
-        MAP_ENUM(Uniform3fv)
-        MAP_ENUM(Uniform3i)
-        MAP_ENUM(Uniform3iv)
-        MAP_ENUM(Uniform4f)
-        MAP_ENUM(Uniform4fv)
-        MAP_ENUM(Uniform4i)
-        MAP_ENUM(Uniform4iv)
-        MAP_ENUM(UniformMatrix2fv)
-        MAP_ENUM(UniformMatrix3fv)
-        MAP_ENUM(UniformMatrix4fv)
-        MAP_ENUM(UnmapBufferOES)
-        MAP_ENUM(UseProgram)
-        MAP_ENUM(ValidateProgram)
-        MAP_ENUM(VertexAttrib1f)
-        MAP_ENUM(VertexAttrib1fv)
-        MAP_ENUM(VertexAttrib2f)
-        MAP_ENUM(VertexAttrib2fv)
-        MAP_ENUM(VertexAttrib3f)
-        MAP_ENUM(VertexAttrib3fv)
-        MAP_ENUM(VertexAttrib4f)
-        MAP_ENUM(VertexAttrib4fv)
-        MAP_ENUM(VertexAttribPointer)
-        MAP_ENUM(Viewport)
-
-        case Ogles2FunctionCount: break;
+    if ((size_t)func < Ogles2FunctionCount) {
+        return ogles2FunctionNames[func];
     }
 
-    #undef MAP_ENUM
-
     return "Unknown";
 }
 
+static const char* mapOgles2TraceFunction(const uint16_t func)
+{
+    return mapOgles2Function((Ogles2Function)func);
+}
+
+static uint32 patchFilter[FILTER_WORDS(Ogles2FunctionCount)];
+static uint32 traceFilter[FILTER_WORDS(Ogles2FunctionCount)]; // Patched functions outside it are only profiled
+static PredicateSet* predicates; // Argument conditions, NULL until a filter file has any
+
 static const char* mapOgles2Error(const GLenum code)
 {
     #define MAP_ENUM(x) case x: ++errorCount; return #x;
@@ -420,372 +144,36 @@ static const char* decodeTexture(const GLenum texture)
     return "Unknown texture";
 }
 
+// The values of ogles2_enums.h must match the GLES2 headers
+#define CHECK_ENUM_VALUE(name, value) _Static_assert((name) == (value), #name " differs from the GLES2 headers");
+OGLES2_VALUE_NAMES(CHECK_ENUM_VALUE)
+OGLES2_CAPABILITY_NAMES(CHECK_ENUM_VALUE)
+OGLES2_PRIMITIVE_NAMES(CHECK_ENUM_VALUE)
+#undef CHECK_ENUM_VALUE
+
 static const char* decodeValue(const GLenum value)
 {
-    #define MAP_ENUM(x) case x: return #x;
-
-    switch (value) {
-        MAP_ENUM(GL_ACTIVE_ATTRIBUTE_MAX_LENGTH)
-        MAP_ENUM(GL_ACTIVE_ATTRIBUTES)
-        MAP_ENUM(GL_ACTIVE_TEXTURE)
-        MAP_ENUM(GL_ACTIVE_UNIFORM_MAX_LENGTH)
-        MAP_ENUM(GL_ACTIVE_UNIFORMS)
-        MAP_ENUM(GL_ALIASED_POINT_SIZE_RANGE)
-        MAP_ENUM(GL_ALIASED_LINE_WIDTH_RANGE)
-        MAP_ENUM(GL_ALPHA)
-        MAP_ENUM(GL_ALPHA_BITS)
-        MAP_ENUM(GL_ALWAYS)
-        MAP_ENUM(GL_ARRAY_BUFFER)
-        MAP_ENUM(GL_ARRAY_BUFFER_BINDING)
-        MAP_ENUM(GL_ATTACHED_SHADERS)
-        MAP_ENUM(GL_BACK)
-        MAP_ENUM(GL_BLEND_COLOR)
-        MAP_ENUM(GL_BLEND_DST_ALPHA)
-        MAP_ENUM(GL_BLEND_DST_RGB)
-        MAP_ENUM(GL_BLEND_EQUATION_ALPHA)
-        MAP_ENUM(GL_BLEND_EQUATION_RGB)
-        MAP_ENUM(GL_BLEND_SRC_ALPHA)
-        MAP_ENUM(GL_BLEND_SRC_RGB)
-        MAP_ENUM(GL_BLUE_BITS)
-        MAP_ENUM(GL_BOOL)
-        MAP_ENUM(GL_BOOL_VEC2)
-        MAP_ENUM(GL_BOOL_VEC3)
-        MAP_ENUM(GL_BOOL_VEC4)
-        MAP_ENUM(GL_BUFFER_ACCESS)
-        MAP_ENUM(GL_BUFFER_MAPPED)
-        MAP_ENUM(GL_BUFFER_MAP_POINTER_OES)
-        MAP_ENUM(GL_BUFFER_SIZE)
-        MAP_ENUM(GL_BUFFER_USAGE)
-        MAP_ENUM(GL_BYTE)
-        MAP_ENUM(GL_CCW)
-        MAP_ENUM(GL_CLAMP_TO_EDGE)
-        MAP_ENUM(GL_COLOR_ATTACHMENT0)
-        MAP_ENUM(GL_COLOR_CLEAR_VALUE)
-        MAP_ENUM(GL_COLOR_WRITEMASK)
-        MAP_ENUM(GL_COMPILE_STATUS)
-        MAP_ENUM(GL_COMPRESSED_TEXTURE_FORMATS)
-        MAP_ENUM(GL_CONSTANT_ALPHA)
-        MAP_ENUM(GL_CONSTANT_COLOR)
-        MAP_ENUM(GL_CULL_FACE_MODE)
-        MAP_ENUM(GL_CURRENT_PROGRAM)
-        MAP_ENUM(GL_CURRENT_VERTEX_ATTRIB)
-        MAP_ENUM(GL_CW)
-        MAP_ENUM(GL_DECR)
-        MAP_ENUM(GL_DECR_WRAP)
-        MAP_ENUM(GL_DELETE_STATUS)
-        MAP_ENUM(GL_DEPTH_BITS)
-        MAP_ENUM(GL_DEPTH_ATTACHMENT)
-        MAP_ENUM(GL_DEPTH_CLEAR_VALUE)
-        MAP_ENUM(GL_DEPTH_COMPONENT16)
-        MAP_ENUM(GL_DEPTH_COMPONENT24_OES)
-        MAP_ENUM(GL_DEPTH_COMPONENT32_OES)
-        MAP_ENUM(GL_DEPTH_FUNC)
-        MAP_ENUM(GL_DEPTH_WRITEMASK)
-        MAP_ENUM(GL_DEPTH_RANGE)
-        MAP_ENUM(GL_DEPTH24_STENCIL8_OES)
-        MAP_ENUM(GL_DONT_CARE)
-        MAP_ENUM(GL_DST_ALPHA)
-        MAP_ENUM(GL_DST_COLOR)
-        MAP_ENUM(GL_DYNAMIC_DRAW)
-        MAP_ENUM(GL_ELEMENT_ARRAY_BUFFER)
-        MAP_ENUM(GL_ELEMENT_ARRAY_BUFFER_BINDING)
-        MAP_ENUM(GL_EQUAL)
-        MAP_ENUM(GL_EXTENSIONS)
-        MAP_ENUM(GL_FASTEST)
-        MAP_ENUM(GL_FILL)
-        MAP_ENUM(GL_FIXED)
-        MAP_ENUM(GL_FLOAT)
-        MAP_ENUM(GL_FLOAT_VEC2)
-        MAP_ENUM(GL_FLOAT_VEC3)
-        MAP_ENUM(GL_FLOAT_VEC4)
-        MAP_ENUM(GL_FLOAT_MAT2)
-        MAP_ENUM(GL_FLOAT_MAT3)
-        MAP_ENUM(GL_FLOAT_MAT4)
-        MAP_ENUM(GL_FRAGMENT_SHADER)
-        MAP_ENUM(GL_FRAGMENT_SHADER_DERIVATIVE_HINT_OES)
-        MAP_ENUM(GL_FRAMEBUFFER)
-        MAP_ENUM(GL_FRAMEBUFFER_ATTACHMENT_OBJECT_NAME)
-        MAP_ENUM(GL_FRAMEBUFFER_ATTACHMENT_OBJECT_TYPE)
-        MAP_ENUM(GL_FRAMEBUFFER_ATTACHMENT_TEXTURE_CUBE_MAP_FACE)
-        MAP_ENUM(GL_FRAMEBUFFER_ATTACHMENT_TEXTURE_LEVEL)
-        MAP_ENUM(GL_FRAMEBUFFER_BINDING)
-        MAP_ENUM(GL_FRAMEBUFFER_COMPLETE)
-        MAP_ENUM(GL_FRAMEBUFFER_INCOMPLETE_ATTACHMENT)
-        MAP_ENUM(GL_FRAMEBUFFER_INCOMPLETE_MISSING_ATTACHMENT)
-        MAP_ENUM(GL_FRAMEBUFFER_INCOMPLETE_DIMENSIONS)
-        //MAP_ENUM(GL_FRAMEBUFFER_INCOMPLETE_FORMATS) - missing?
-        MAP_ENUM(GL_FRAMEBUFFER_UNSUPPORTED)
-        MAP_ENUM(GL_FRONT)
-        MAP_ENUM(GL_FRONT_FACE)
-        MAP_ENUM(GL_FRONT_AND_BACK)
-        MAP_ENUM(GL_FUNC_ADD)
-        MAP_ENUM(GL_FUNC_REVERSE_SUBTRACT)
-        MAP_ENUM(GL_FUNC_SUBTRACT)
-        MAP_ENUM(GL_GENERATE_MIPMAP_HINT)
-        MAP_ENUM(GL_GEQUAL)
-        MAP_ENUM(GL_GREATER)
-        MAP_ENUM(GL_GREEN_BITS)
-        MAP_ENUM(GL_HALF_FLOAT_OES)
-        MAP_ENUM(GL_HIGH_FLOAT)
-        MAP_ENUM(GL_HIGH_INT)
-        MAP_ENUM(GL_IMPLEMENTATION_COLOR_READ_FORMAT)
-        MAP_ENUM(GL_IMPLEMENTATION_COLOR_READ_TYPE)
-        MAP_ENUM(GL_INCR)
-        MAP_ENUM(GL_INCR_WRAP)
-        MAP_ENUM(GL_INFO_LOG_LENGTH)
-        MAP_ENUM(GL_INT)
-        MAP_ENUM(GL_INT_VEC2)
-        MAP_ENUM(GL_INT_VEC3)
-        MAP_ENUM(GL_INT_VEC4)
-        MAP_ENUM(GL_INVERT)
-        MAP_ENUM(GL_KEEP)
-        MAP_ENUM(GL_LEQUAL)
-        MAP_ENUM(GL_LESS)
-        MAP_ENUM(GL_LINE)
-        MAP_ENUM(GL_LINEAR)
-        MAP_ENUM(GL_LINEAR_MIPMAP_NEAREST)
-        MAP_ENUM(GL_LINEAR_MIPMAP_LINEAR)
-        MAP_ENUM(GL_LINK_STATUS)
-        MAP_ENUM(GL_LOW_FLOAT)
-        MAP_ENUM(GL_LOW_INT)
-        MAP_ENUM(GL_LUMINANCE)
-        MAP_ENUM(GL_LUMINANCE_ALPHA)
-        MAP_ENUM(GL_MAX_CUBE_MAP_TEXTURE_SIZE)
-        MAP_ENUM(GL_MAX_TEXTURE_SIZE)
-        MAP_ENUM(GL_MAX_VIEWPORT_DIMS)
-        MAP_ENUM(GL_MEDIUM_FLOAT)
-        MAP_ENUM(GL_MEDIUM_INT)
-        MAP_ENUM(GL_MIRRORED_REPEAT)
-        MAP_ENUM(GL_NEAREST)
-        MAP_ENUM(GL_NEAREST_MIPMAP_NEAREST)
-        MAP_ENUM(GL_NEAREST_MIPMAP_LINEAR)
-        MAP_ENUM(GL_NEVER)
-        MAP_ENUM(GL_NICEST)
-        // MAP_ENUM(GL_NONE)
-        MAP_ENUM(GL_NOTEQUAL)
-        MAP_ENUM(GL_NUM_COMPRESSED_TEXTURE_FORMATS)
-        MAP_ENUM(GL_ONE)
-        MAP_ENUM(GL_ONE_MINUS_CONSTANT_ALPHA)
-        MAP_ENUM(GL_ONE_MINUS_CONSTANT_COLOR)
-        MAP_ENUM(GL_ONE_MINUS_DST_ALPHA)
-        MAP_ENUM(GL_ONE_MINUS_DST_COLOR)
-        MAP_ENUM(GL_ONE_MINUS_SRC_ALPHA)
-        MAP_ENUM(GL_ONE_MINUS_SRC_COLOR)
-        MAP_ENUM(GL_PACK_ALIGNMENT)
-        MAP_ENUM(GL_POINT)
-        MAP_ENUM(GL_POLYGON_OFFSET_FACTOR)
-        MAP_ENUM(GL_POLYGON_OFFSET_UNITS)
-        MAP_ENUM(GL_RED_BITS)
-        MAP_ENUM(GL_RENDERBUFFER)
-        MAP_ENUM(GL_RENDERBUFFER_ALPHA_SIZE)
-        MAP_ENUM(GL_RENDERBUFFER_BINDING)
-        MAP_ENUM(GL_RENDERBUFFER_BLUE_SIZE)
-        MAP_ENUM(GL_RENDERBUFFER_DEPTH_SIZE)
-        MAP_ENUM(GL_RENDERBUFFER_GREEN_SIZE)
-        MAP_ENUM(GL_RENDERBUFFER_HEIGHT)
-        MAP_ENUM(GL_RENDERBUFFER_INTERNAL_FORMAT)
-        MAP_ENUM(GL_RENDERBUFFER_RED_SIZE)
-        MAP_ENUM(GL_RENDERBUFFER_STENCIL_SIZE)
-        MAP_ENUM(GL_RENDERBUFFER_WIDTH)
-        MAP_ENUM(GL_RENDERER)
-        MAP_ENUM(GL_REPEAT)
-        MAP_ENUM(GL_REPLACE)
-        MAP_ENUM(GL_RGB)
-        MAP_ENUM(GL_RGB5_A1)
-        MAP_ENUM(GL_RGB565)
-        MAP_ENUM(GL_RGB8_OES)
-        MAP_ENUM(GL_RGBA)
-        MAP_ENUM(GL_RGBA4)
-        MAP_ENUM(GL_RGBA8_OES)
-        MAP_ENUM(GL_SAMPLE_COVERAGE_VALUE)
-        MAP_ENUM(GL_SAMPLE_COVERAGE_INVERT)
-        MAP_ENUM(GL_SAMPLER_2D)
-        MAP_ENUM(GL_SAMPLER_CUBE)
-        MAP_ENUM(GL_SCISSOR_BOX)
-        MAP_ENUM(GL_SHADER_SOURCE_LENGTH)
-        MAP_ENUM(GL_SHADER_TYPE)
-        MAP_ENUM(GL_SHADING_LANGUAGE_VERSION)
-        MAP_ENUM(GL_SHORT)
-        MAP_ENUM(GL_SRC_ALPHA)
-        MAP_ENUM(GL_SRC_ALPHA_SATURATE)
-        MAP_ENUM(GL_SRC_COLOR)
-        MAP_ENUM(GL_STATIC_DRAW)
-        MAP_ENUM(GL_STENCIL_ATTACHMENT)
-        MAP_ENUM(GL_STENCIL_BACK_FAIL)
-        MAP_ENUM(GL_STENCIL_BACK_FUNC)
-        MAP_ENUM(GL_STENCIL_BACK_PASS_DEPTH_FAIL)
-        MAP_ENUM(GL_STENCIL_BACK_PASS_DEPTH_PASS)
-        MAP_ENUM(GL_STENCIL_BACK_REF)
-        MAP_ENUM(GL_STENCIL_BACK_VALUE_MASK)
-        MAP_ENUM(GL_STENCIL_BACK_WRITEMASK)
-        MAP_ENUM(GL_STENCIL_BITS)
-        MAP_ENUM(GL_STENCIL_CLEAR_VALUE)
-        MAP_ENUM(GL_STENCIL_FAIL)
-        MAP_ENUM(GL_STENCIL_FUNC)
-        MAP_ENUM(GL_STENCIL_INDEX1_OES)
-        MAP_ENUM(GL_STENCIL_INDEX4_OES)
-        MAP_ENUM(GL_STENCIL_INDEX8)
-        MAP_ENUM(GL_STENCIL_PASS_DEPTH_FAIL)
-        MAP_ENUM(GL_STENCIL_REF)
-        MAP_ENUM(GL_STENCIL_VALUE_MASK)
-        MAP_ENUM(GL_STENCIL_WRITEMASK)
-        MAP_ENUM(GL_STREAM_DRAW)
-        MAP_ENUM(GL_SUBPIXEL_BITS)
-        MAP_ENUM(GL_TEXTURE)
-        MAP_ENUM(GL_TEXTURE_2D)
-        MAP_ENUM(GL_TEXTURE_BINDING_2D)
-        MAP_ENUM(GL_TEXTURE_BINDING_CUBE_MAP)
-        MAP_ENUM(GL_TEXTURE_CUBE_MAP)
-        MAP_ENUM(GL_TEXTURE_CUBE_MAP_NEGATIVE_X)
-        MAP_ENUM(GL_TEXTURE_CUBE_MAP_NEGATIVE_Y)
-        MAP_ENUM(GL_TEXTURE_CUBE_MAP_NEGATIVE_Z)
-        MAP_ENUM(GL_TEXTURE_CUBE_MAP_POSITIVE_X)
-        MAP_ENUM(GL_TEXTURE_CUBE_MAP_POSITIVE_Y)
-        MAP_ENUM(GL_TEXTURE_CUBE_MAP_POSITIVE_Z)
-        MAP_ENUM(GL_TEXTURE_MAG_FILTER)
-        MAP_ENUM(GL_TEXTURE_MIN_FILTER)
-        MAP_ENUM(GL_TEXTURE_WRAP_S)
-        MAP_ENUM(GL_TEXTURE_WRAP_T)
-        MAP_ENUM(GL_UNPACK_ALIGNMENT)
-        MAP_ENUM(GL_UNSIGNED_BYTE)
-        MAP_ENUM(GL_UNSIGNED_INT)
-        MAP_ENUM(GL_UNSIGNED_SHORT)
-        MAP_ENUM(GL_UNSIGNED_SHORT_4_4_4_4)
-        MAP_ENUM(GL_UNSIGNED_SHORT_5_5_5_1)
-        MAP_ENUM(GL_UNSIGNED_SHORT_5_6_5)
-        MAP_ENUM(GL_VALIDATE_STATUS)
-        MAP_ENUM(GL_VENDOR)
-        MAP_ENUM(GL_VERSION)
-        MAP_ENUM(GL_VERTEX_ATTRIB_ARRAY_BUFFER_BINDING)
-        MAP_ENUM(GL_VERTEX_ATTRIB_ARRAY_ENABLED)
-        MAP_ENUM(GL_VERTEX_ATTRIB_ARRAY_NORMALIZED)
-        MAP_ENUM(GL_VERTEX_ATTRIB_ARRAY_POINTER)
-        MAP_ENUM(GL_VERTEX_ATTRIB_ARRAY_SIZE)
-        MAP_ENUM(GL_VERTEX_ATTRIB_ARRAY_STRIDE)
-        MAP_ENUM(GL_VERTEX_ATTRIB_ARRAY_TYPE)
-        MAP_ENUM(GL_VERTEX_SHADER)
-        MAP_ENUM(GL_VIEWPORT)
-        MAP_ENUM(GL_ZERO)
-
-        // GL_ARB_provoking_vertex
-        MAP_ENUM(GL_FIRST_VERTEX_CONVENTION)
-        MAP_ENUM(GL_LAST_VERTEX_CONVENTION)
-        MAP_ENUM(GL_PROVOKING_VERTEX)
-        MAP_ENUM(GL_QUADS_FOLLOW_PROVOKING_VERTEX_CONVENTION)
-
-        // GL_ARB_texture_mirror_clamp_to_edge
-        MAP_ENUM(GL_TEXTURE_WRAP_R_OES)
-        MAP_ENUM(GL_MIRROR_CLAMP_TO_EDGE)
-
-        // GL_ARB_texture_rectangle
-        MAP_ENUM(GL_TEXTURE_RECTANGLE)
-        MAP_ENUM(GL_TEXTURE_BINDING_RECTANGLE)
-        MAP_ENUM(GL_PROXY_TEXTURE_RECTANGLE)
-        MAP_ENUM(GL_MAX_RECTANGLE_TEXTURE_SIZE)
-        MAP_ENUM(GL_SAMPLER_2D_RECT)
-        // MAP_ENUM(GL_SAMPLER_2D_RECT_SHADOW) - may be added later?
-
-        // GL_EXT_blend_minmax
-        // MAP_ENUM(GL_FUNC_ADD)
-        MAP_ENUM(GL_MIN)
-        MAP_ENUM(GL_MAX)
-        // MAP_ENUM(GL_BLEND_EQUATION)
-
-        // GL_EXT_texture_filter_anisotropic
-        MAP_ENUM(GL_TEXTURE_MAX_ANISOTROPY_EXT)
-        MAP_ENUM(GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT)
-
-        // GL_EXT_texture_format_BGRA8888
-        MAP_ENUM(GL_BGRA_EXT)
-
-        // GL_EXT_texture_lod_bias
-        // MAP_ENUM(GL_TEXTURE_FILTER_CONTROL_EXT) - there is no texture env
-        MAP_ENUM(GL_TEXTURE_LOD_BIAS)
-        MAP_ENUM(GL_MAX_TEXTURE_LOD_BIAS)
-
-        // GL_OES_element_index_uint
-        // MAP_ENUM(GL_UNSIGNED_INT)
-
-        // GL_OES_texture_float
-        // MAP_ENUM(GL_HALF_FLOAT_OES)
-        // MAP_ENUM(GL_FLOAT)
-
-        // GL_OES_get_program_binary
-        MAP_ENUM(GL_PROGRAM_BINARY_LENGTH_OES)
-        MAP_ENUM(GL_NUM_PROGRAM_BINARY_FORMATS_OES)
-        MAP_ENUM(GL_PROGRAM_BINARY_FORMATS_OES)
-
-        // GL_OES_mapbuffer
-        MAP_ENUM(GL_WRITE_ONLY_OES)
-        // MAP_ENUM(GL_BUFFER_ACCESS_OES)
-        // MAP_ENUM(GL_BUFFER_MAPPED_OES)
-        // MAP_ENUM(GL_BUFFER_MAP_POINTER_OES)
-
-        // GL_OES_packed_depth_stencil
-        MAP_ENUM(GL_DEPTH_STENCIL_OES)
-        MAP_ENUM(GL_UNSIGNED_INT_24_8_OES)
-        //MAP_ENUM(GL_DEPTH24_STENCIL8_OES)
-
-        // GL_SGIS_texture_lod
-        MAP_ENUM(GL_TEXTURE_MIN_LOD)
-        MAP_ENUM(GL_TEXTURE_MAX_LOD)
-        MAP_ENUM(GL_TEXTURE_BASE_LEVEL)
-        MAP_ENUM(GL_TEXTURE_MAX_LEVEL)
-
-        //MAP_ENUM(GL_)
-        //MAP_ENUM(GL_)
-        //MAP_ENUM(GL_)
-        //MAP_ENUM(GL_)
-    }
-
-    #undef MAP_ENUM
+    const char* const name = enum_table_find(&ogles2ValueTable, value);
 
-    return "Unknown enum";
+    return name ? name : "Unknown enum";
 }
 
 static const char* decodeCapability(const GLenum value)
 {
-    #define MAP_ENUM(x) case x: return #x;
-
-    switch (value) {
-        MAP_ENUM(GL_CULL_FACE)
-        MAP_ENUM(GL_POLYGON_OFFSET_FILL)
-        MAP_ENUM(GL_SCISSOR_TEST)
-        MAP_ENUM(GL_SAMPLE_COVERAGE)
-        MAP_ENUM(GL_SAMPLE_ALPHA_TO_COVERAGE)
-        // TODO: MAP_ENUM(GL_SAMPLE_COVERAGE_TO_ALPHA) ? Typo?
-        MAP_ENUM(GL_STENCIL_TEST)
-        MAP_ENUM(GL_DEPTH_TEST)
-        MAP_ENUM(GL_BLEND)
-        MAP_ENUM(GL_DITHER)
-        //MAP_ENUM()
-    }
+    const char* const name = enum_table_find(&ogles2CapabilityTable, value);
 
-    #undef MAP_ENUM
-
-    return "Unknown capability";
+    return name ? name : "Unknown capability";
 }
 
 static const char* decodePrimitive(const GLenum value)
 {
-    #define MAP_ENUM(x) case x: return #x;
-
-    switch (value) {
-        MAP_ENUM(GL_LINES)
-        MAP_ENUM(GL_LINE_LOOP)
-        MAP_ENUM(GL_LINE_STRIP)
-        MAP_ENUM(GL_POINTS)
-        MAP_ENUM(GL_TRIANGLES)
-        MAP_ENUM(GL_TRIANGLE_STRIP)
-        MAP_ENUM(GL_TRIANGLE_FAN)
-    }
+    const char* const name = enum_table_find(&ogles2PrimitiveTable, value);
 
-    #undef MAP_ENUM
-
-    return "Unknown primitive";
+    return name ? name : "Unknown primitive";
 }
 
 #define MAX_GL_ERRORS 10
+#define NESTING_TOP_CHILDREN 3 // Nova functions listed per OpenGL ES 2.0 function
 
 // Store original function pointers so that they can be still called
 struct Ogles2Context
@@ -793,181 +181,42 @@ struct Ogles2Context
     struct OGLES2IFace* interface;
     struct Task* task;
     char name[NAME_LEN];
+    ULONG id; // Stable client number for logs
     char tagBuffer[TAG_BUFFER_LEN];
 
     MyClock start;
+    MyClock closed; // When the interface was dropped
     uint64 ticks;
     ProfilingItem profiling[Ogles2FunctionCount];
+    Histogram latency[Ogles2FunctionCount]; // Call durations in ticks
 
     PrimitiveCounter counter;
 
+    FrameState frame;
+    ProfilingItem frameProfiling[Ogles2FunctionCount]; // Snapshot at the previous frame boundary
+    FrameState interval;
+    ProfilingItem intervalProfiling[Ogles2FunctionCount]; // Snapshot at the previous INTERVAL
+    NestingChildren children[Ogles2FunctionCount]; // Nova calls made inside each function
+    struct NestingStack* nesting; // Cached nesting stack of the task
+    uint64 afterTicks; // Time spent recording and checking GL errors after the calls
+    FrameTimes frameTimes; // Recorded at aglSwapBuffers
+
     GLenum errors[MAX_GL_ERRORS];
     size_t errorRead;
     size_t errorWritten;
+    uint32 patched[FILTER_WORDS(Ogles2FunctionCount)];
+    uint64 errorOverflows; // Errors lost because the buffer was full
 
-    void* (*old_aglCreateContext_AVOID)(struct OGLES2IFace *Self, ULONG * errcode, struct TagItem * tags);
-    void* (*old_aglCreateContext2)(struct OGLES2IFace *Self, ULONG * errcode, struct TagItem * tags);
-    void (*old_aglDestroyContext)(struct OGLES2IFace *Self, void* context);
-    void* (*old_aglGetProcAddress)(struct OGLES2IFace *Self, const char *name);
-    void (*old_aglMakeCurrent)(struct OGLES2IFace *Self, void* context);
-    void (*old_aglSetBitmap)(struct OGLES2IFace *Self, struct BitMap *bitmap);
-    void (*old_aglSetParams_AVOID)(struct OGLES2IFace *Self, struct TagItem * tags);
-    void (*old_aglSetParams2)(struct OGLES2IFace *Self, struct TagItem * tags);
-    void (*old_aglSwapBuffers)(struct OGLES2IFace *Self);
-    void (*old_glActiveTexture)(struct OGLES2IFace *Self, GLenum texture);
-    void (*old_glAttachShader)(struct OGLES2IFace *Self, GLuint program, GLuint shader);
-    void (*old_glBindAttribLocation)(struct OGLES2IFace *Self, GLuint program, GLuint index, const GLchar * name);
-    void (*old_glBindBuffer)(struct OGLES2IFace *Self, GLenum target, GLuint buffer);
-    void (*old_glBindFramebuffer)(struct OGLES2IFace *Self, GLenum target, GLuint framebuffer);
-    void (*old_glBindRenderbuffer)(struct OGLES2IFace *Self, GLenum target, GLuint renderbuffer);
-    void (*old_glBindTexture)(struct OGLES2IFace *Self, GLenum target, GLuint texture);
-    void (*old_glBlendColor)(struct OGLES2IFace *Self, GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha);
-    void (*old_glBlendEquation)(struct OGLES2IFace *Self, GLenum mode);
-    void (*old_glBlendEquationSeparate)(struct OGLES2IFace *Self, GLenum modeRGB, GLenum modeAlpha);
-    void (*old_glBlendFunc)(struct OGLES2IFace *Self, GLenum sfactor, GLenum dfactor);
-    void (*old_glBlendFuncSeparate)(struct OGLES2IFace *Self, GLenum sfactorRGB, GLenum dfactorRGB, GLenum sfactorAlpha, GLenum dfactorAlpha);
-    void (*old_glBufferData)(struct OGLES2IFace *Self, GLenum target, GLsizeiptr size, const void * data, GLenum usage);
-    void (*old_glBufferSubData)(struct OGLES2IFace *Self, GLenum target, GLintptr offset, GLsizeiptr size, const void * data);
-    GLenum (*old_glCheckFramebufferStatus)(struct OGLES2IFace *Self, GLenum target);
-    void (*old_glClear)(struct OGLES2IFace *Self, GLbitfield mask);
-    void (*old_glClearColor)(struct OGLES2IFace *Self, GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha);
-    void (*old_glClearDepthf)(struct OGLES2IFace *Self, GLfloat d);
-    void (*old_glClearStencil)(struct OGLES2IFace *Self, GLint s);
-    void (*old_glColorMask)(struct OGLES2IFace *Self, GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha);
-    void (*old_glCompileShader)(struct OGLES2IFace *Self, GLuint shader);
-    void (*old_glCompressedTexImage2D)(struct OGLES2IFace *Self, GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLint border, GLsizei imageSize, const void * data);
-    void (*old_glCompressedTexSubImage2D)(struct OGLES2IFace *Self, GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLsizei imageSize, const void * data);
-    void (*old_glCopyTexImage2D)(struct OGLES2IFace *Self, GLenum target, GLint level, GLenum internalformat, GLint x, GLint y, GLsizei width, GLsizei height, GLint border);
-    void (*old_glCopyTexSubImage2D)(struct OGLES2IFace *Self, GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint x, GLint y, GLsizei width, GLsizei height);
-    GLuint (*old_glCreateProgram)(struct OGLES2IFace *Self);
-    GLuint (*old_glCreateShader)(struct OGLES2IFace *Self, GLenum type);
-    void (*old_glCullFace)(struct OGLES2IFace *Self, GLenum mode);
-    void (*old_glDeleteBuffers)(struct OGLES2IFace *Self, GLsizei n, GLuint * buffers);
-    void (*old_glDeleteFramebuffers)(struct OGLES2IFace *Self, GLsizei n, const GLuint * framebuffers);
-    void (*old_glDeleteProgram)(struct OGLES2IFace *Self, GLuint program);
-    void (*old_glDeleteRenderbuffers)(struct OGLES2IFace *Self, GLsizei n, const GLuint * renderbuffers);
-    void (*old_glDeleteShader)(struct OGLES2IFace *Self, GLuint shader);
-    void (*old_glDeleteTextures)(struct OGLES2IFace *Self, GLsizei n, const GLuint * textures);
-    void (*old_glDepthFunc)(struct OGLES2IFace *Self, GLenum func);
-    void (*old_glDepthMask)(struct OGLES2IFace *Self, GLboolean flag);
-    void (*old_glDepthRangef)(struct OGLES2IFace *Self, GLfloat n, GLfloat f);
-    void (*old_glDetachShader)(struct OGLES2IFace *Self, GLuint program, GLuint shader);
-    void (*old_glDisable)(struct OGLES2IFace *Self, GLenum cap);
-    void (*old_glDisableVertexAttribArray)(struct OGLES2IFace *Self, GLuint index);
-    void (*old_glDrawArrays)(struct OGLES2IFace *Self, GLenum mode, GLint first, GLsizei count);
-    void (*old_glDrawElements)(struct OGLES2IFace *Self, GLenum mode, GLsizei count, GLenum type, const void * indices);
-    void (*old_glDrawElementsBaseVertexOES)(struct OGLES2IFace *Self, GLenum mode, GLsizei count, GLenum type, const void * indices, GLint basevertex);
-    void (*old_glEnable)(struct OGLES2IFace *Self, GLenum cap);
-    void (*old_glEnableVertexAttribArray)(struct OGLES2IFace *Self, GLuint index);
-    void (*old_glFinish)(struct OGLES2IFace *Self);
-    void (*old_glFlush)(struct OGLES2IFace *Self);
-    void (*old_glFramebufferRenderbuffer)(struct OGLES2IFace *Self, GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer);
-    void (*old_glFramebufferTexture2D)(struct OGLES2IFace *Self, GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level);
-    void (*old_glFrontFace)(struct OGLES2IFace *Self, GLenum mode);
-    void (*old_glGenBuffers)(struct OGLES2IFace *Self, GLsizei n, GLuint * buffers);
-    void (*old_glGenerateMipmap)(struct OGLES2IFace *Self, GLenum target);
-    void (*old_glGenFramebuffers)(struct OGLES2IFace *Self, GLsizei n, GLuint * framebuffers);
-    void (*old_glGenRenderbuffers)(struct OGLES2IFace *Self, GLsizei n, GLuint * renderbuffers);
-    void (*old_glGenTextures)(struct OGLES2IFace *Self, GLsizei n, GLuint * textures);
-    void (*old_glGetActiveAttrib)(struct OGLES2IFace *Self, GLuint program, GLuint index, GLsizei bufSize, GLsizei * length, GLint * size, GLenum * type, GLchar * name);
-    void (*old_glGetActiveUniform)(struct OGLES2IFace *Self, GLuint program, GLuint index, GLsizei bufSize, GLsizei * length, GLint * size, GLenum * type, GLchar * name);
-    void (*old_glGetAttachedShaders)(struct OGLES2IFace *Self, GLuint program, GLsizei maxCount, GLsizei * count, GLuint * shaders);
-    GLint (*old_glGetAttribLocation)(struct OGLES2IFace *Self, GLuint program, const GLchar * name);
-    void (*old_glGetBooleanv)(struct OGLES2IFace *Self, GLenum pname, GLboolean * data);
-    void (*old_glGetBufferParameteriv)(struct OGLES2IFace *Self, GLenum target, GLenum pname, GLint * params);
-    void (*old_glGetBufferParameterivOES)(struct OGLES2IFace *Self, GLenum target, GLenum value, GLint *data);
-    void (*old_glGetBufferPointervOES)(struct OGLES2IFace *Self, GLenum target, GLenum pname, void **params);
-    GLenum (*old_glGetError)(struct OGLES2IFace *Self);
-    void (*old_glGetFloatv)(struct OGLES2IFace *Self, GLenum pname, GLfloat * data);
-    void (*old_glGetFramebufferAttachmentParameteriv)(struct OGLES2IFace *Self, GLenum target, GLenum attachment, GLenum pname, GLint * params);
-    void (*old_glGetIntegerv)(struct OGLES2IFace *Self, GLenum pname, GLint * data);
-    void (*old_glGetProgramBinaryOES)(struct OGLES2IFace *Self, GLuint program, GLsizei bufSize, GLsizei *length, GLenum *binaryFormat, void *binary);
-    void (*old_glGetProgramiv)(struct OGLES2IFace *Self, GLuint program, GLenum pname, GLint * params);
-    void (*old_glGetProgramInfoLog)(struct OGLES2IFace *Self, GLuint program, GLsizei bufSize, GLsizei * length, GLchar * infoLog);
-    void (*old_glGetRenderbufferParameteriv)(struct OGLES2IFace *Self, GLenum target, GLenum pname, GLint * params);
-    void (*old_glGetShaderiv)(struct OGLES2IFace *Self, GLuint shader, GLenum pname, GLint * params);
-    void (*old_glGetShaderInfoLog)(struct OGLES2IFace *Self, GLuint shader, GLsizei bufSize, GLsizei * length, GLchar * infoLog);
-    void (*old_glGetShaderPrecisionFormat)(struct OGLES2IFace *Self, GLenum shadertype, GLenum precisiontype, GLint * range, GLint * precision);
-    void (*old_glGetShaderSource)(struct OGLES2IFace *Self, GLuint shader, GLsizei bufSize, GLsizei * length, GLchar * source);
-    const GLubyte * (*old_glGetString)(struct OGLES2IFace *Self, GLenum name);
-    void (*old_glGetTexParameterfv)(struct OGLES2IFace *Self, GLenum target, GLenum pname, GLfloat * params);
-    void (*old_glGetTexParameteriv)(struct OGLES2IFace *Self, GLenum target, GLenum pname, GLint * params);
-    void (*old_glGetUniformfv)(struct OGLES2IFace *Self, GLuint program, GLint location, GLfloat * params);
-    void (*old_glGetUniformiv)(struct OGLES2IFace *Self, GLuint program, GLint location, GLint * params);
-    GLint (*old_glGetUniformLocation)(struct OGLES2IFace *Self, GLuint program, const GLchar * name);
-    void (*old_glGetVertexAttribfv)(struct OGLES2IFace *Self, GLuint index, GLenum pname, GLfloat * params);
-    void (*old_glGetVertexAttribiv)(struct OGLES2IFace *Self, GLuint index, GLenum pname, GLint * params);
-    void (*old_glGetVertexAttribPointerv)(struct OGLES2IFace *Self, GLuint index, GLenum pname, void ** pointer);
-    void (*old_glHint)(struct OGLES2IFace *Self, GLenum target, GLenum mode);
-    GLboolean (*old_glIsBuffer)(struct OGLES2IFace *Self, GLuint buffer);
-    GLboolean (*old_glIsEnabled)(struct OGLES2IFace *Self, GLenum cap);
-    GLboolean (*old_glIsFramebuffer)(struct OGLES2IFace *Self, GLuint framebuffer);
-    GLboolean (*old_glIsProgram)(struct OGLES2IFace *Self, GLuint program);
-    GLboolean (*old_glIsRenderbuffer)(struct OGLES2IFace *Self, GLuint renderbuffer);
-    GLboolean (*old_glIsShader)(struct OGLES2IFace *Self, GLuint shader);
-    GLboolean (*old_glIsTexture)(struct OGLES2IFace *Self, GLuint texture);
-    void (*old_glLineWidth)(struct OGLES2IFace *Self, GLfloat width);
-    void (*old_glLinkProgram)(struct OGLES2IFace *Self, GLuint program);
-    void* (*old_glMapBufferOES)(struct OGLES2IFace *Self, GLenum target, GLenum access);
-    void (*old_glPixelStorei)(struct OGLES2IFace *Self, GLenum pname, GLint param);
-    void (*old_glPolygonMode)(struct OGLES2IFace *Self, GLenum face, GLenum mode);
-    void (*old_glPolygonOffset)(struct OGLES2IFace *Self, GLfloat factor, GLfloat units);
-    void (*old_glProgramBinaryOES)(struct OGLES2IFace *Self, GLuint program, GLenum binaryFormat, const void *binary, GLint length);
-    void (*old_glProvokingVertex)(struct OGLES2IFace *Self, GLenum provokeMode);
-    void (*old_glReadPixels)(struct OGLES2IFace *Self, GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, void * pixels);
-    void (*old_glReleaseShaderCompiler)(struct OGLES2IFace *Self);
-    void (*old_glRenderbufferStorage)(struct OGLES2IFace *Self, GLenum target, GLenum internalformat, GLsizei width, GLsizei height);
-    void (*old_glSampleCoverage)(struct OGLES2IFace *Self, GLfloat value, GLboolean invert);
-    void (*old_glScissor)(struct OGLES2IFace *Self, GLint x, GLint y, GLsizei width, GLsizei height);
-    void (*old_glShaderBinary)(struct OGLES2IFace *Self, GLsizei count, const GLuint * shaders, GLenum binaryformat, const void * binary, GLsizei length);
-    void (*old_glShaderSource)(struct OGLES2IFace *Self, GLuint shader, GLsizei count, const GLchar *const* string, const GLint * length);
-    void (*old_glStencilFunc)(struct OGLES2IFace *Self, GLenum func, GLint ref, GLuint mask);
-    void (*old_glStencilFuncSeparate)(struct OGLES2IFace *Self, GLenum face, GLenum func, GLint ref, GLuint mask);
-    void (*old_glStencilMask)(struct OGLES2IFace *Self, GLuint mask);
-    void (*old_glStencilMaskSeparate)(struct OGLES2IFace *Self, GLenum face, GLuint mask);
-    void (*old_glStencilOp)(struct OGLES2IFace *Self, GLenum fail, GLenum zfail, GLenum zpass);
-    void (*old_glStencilOpSeparate)(struct OGLES2IFace *Self, GLenum face, GLenum sfail, GLenum dpfail, GLenum dppass);
-    void (*old_glTexImage2D)(struct OGLES2IFace *Self, GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void * pixels);
-    void (*old_glTexParameterf)(struct OGLES2IFace *Self, GLenum target, GLenum pname, GLfloat param);
-    void (*old_glTexParameterfv)(struct OGLES2IFace *Self, GLenum target, GLenum pname, const GLfloat * params);
-    void (*old_glTexParameteri)(struct OGLES2IFace *Self, GLenum target, GLenum pname, GLint param);
-    void (*old_glTexParameteriv)(struct OGLES2IFace *Self, GLenum target, GLenum pname, const GLint * params);
-    void (*old_glTexSubImage2D)(struct OGLES2IFace *Self, GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const void * pixels);
-    void (*old_glUniform1f)(struct OGLES2IFace *Self, GLint location, GLfloat v0);
-    void (*old_glUniform1fv)(struct OGLES2IFace *Self, GLint location, GLsizei count, const GLfloat * value);
-    void (*old_glUniform1i)(struct OGLES2IFace *Self, GLint location, GLint v0);
-    void (*old_glUniform1iv)(struct OGLES2IFace *Self, GLint location, GLsizei count, const GLint * value);
-    void (*old_glUniform2f)(struct OGLES2IFace *Self, GLint location, GLfloat v0, GLfloat v1);
-    void (*old_glUniform2fv)(struct OGLES2IFace *Self, GLint location, GLsizei count, const GLfloat * value);
-    void (*old_glUniform2i)(struct OGLES2IFace *Self, GLint location, GLint v0, GLint v1);
-    void (*old_glUniform2iv)(struct OGLES2IFace *Self, GLint location, GLsizei count, const GLint * value);
-    void (*old_glUniform3f)(struct OGLES2IFace *Self, GLint location, GLfloat v0, GLfloat v1, GLfloat v2);
-    void (*old_glUniform3fv)(struct OGLES2IFace *Self, GLint location, GLsizei count, const GLfloat * value);
-    void (*old_glUniform3i)(struct OGLES2IFace *Self, GLint location, GLint v0, GLint v1, GLint v2);
-    void (*old_glUniform3iv)(struct OGLES2IFace *Self, GLint location, GLsizei count, const GLint * value);
-    void (*old_glUniform4f)(struct OGLES2IFace *Self, GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3);
-    void (*old_glUniform4fv)(struct OGLES2IFace *Self, GLint location, GLsizei count, const GLfloat * value);
-    void (*old_glUniform4i)(struct OGLES2IFace *Self, GLint location, GLint v0, GLint v1, GLint v2, GLint v3);
-    void (*old_glUniform4iv)(struct OGLES2IFace *Self, GLint location, GLsizei count, const GLint * value);
-    void (*old_glUniformMatrix2fv)(struct OGLES2IFace *Self, GLint location, GLsizei count, GLboolean transpose, const GLfloat * value);
-    void (*old_glUniformMatrix3fv)(struct OGLES2IFace *Self, GLint location, GLsizei count, GLboolean transpose, const GLfloat * value);
-    void (*old_glUniformMatrix4fv)(struct OGLES2IFace *Self, GLint location, GLsizei count, GLboolean transpose, const GLfloat * value);
-    GLboolean (*old_glUnmapBufferOES)(struct OGLES2IFace *Self, GLenum target);
-    void (*old_glUseProgram)(struct OGLES2IFace *Self, GLuint program);
-    void (*old_glValidateProgram)(struct OGLES2IFace *Self, GLuint program);
-    void (*old_glVertexAttrib1f)(struct OGLES2IFace *Self, GLuint index, GLfloat x);
-    void (*old_glVertexAttrib1fv)(struct OGLES2IFace *Self, GLuint index, const GLfloat * v);
-    void (*old_glVertexAttrib2f)(struct OGLES2IFace *Self, GLuint index, GLfloat x, GLfloat y);
-    void (*old_glVertexAttrib2fv)(struct OGLES2IFace *Self, GLuint index, const GLfloat * v);
-    void (*old_glVertexAttrib3f)(struct OGLES2IFace *Self, GLuint index, GLfloat x, GLfloat y, GLfloat z);
-    void (*old_glVertexAttrib3fv)(struct OGLES2IFace *Self, GLuint index, const GLfloat * v);
-    void (*old_glVertexAttrib4f)(struct OGLES2IFace *Self, GLuint index, GLfloat x, GLfloat y, GLfloat z, GLfloat w);
-    void (*old_glVertexAttrib4fv)(struct OGLES2IFace *Self, GLuint index, const GLfloat * v);
-    void (*old_glVertexAttribPointer)(struct OGLES2IFace *Self, GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void * pointer);
-    void (*old_glViewport)(struct OGLES2IFace *Self, GLint x, GLint y, GLsizei width, GLsizei height);
+    struct TraceClient* trace;
+    struct FlightClient* flight;
+
+    #define OGLES2_OLD_POINTER(prefix, name, returnType, parameters, categories) \
+        returnType (*old_ ## prefix ## name) parameters;
+    OGLES2_FUNCTIONS(OGLES2_OLD_POINTER)
+    #undef OGLES2_OLD_POINTER
 };
 
-static struct Ogles2Context* contexts[MAX_CLIENTS];
+static ClientTable clientTable; // Patched interfaces and the archive of the dropped ones
 static APTR mutex;
 
 static void patch_ogles2_functions(struct Ogles2Context *);
@@ -1077,6 +326,61 @@ static void checkPointer(struct Ogles2Context* context, const Ogles2Function id,
     }
 }
 
+static uint64 nestedCalls(const NestingChildren* const children)
+{
+    uint64 calls = children->otherCalls;
+
+    for (int i = 0; i < NESTING_CHILDREN; i++) {
+        calls += children->children[i].calls;
+    }
+
+    return calls;
+}
+
+// Top Warp3D Nova functions called inside each OpenGL ES 2.0 function, in the order of the given stats
+static void childResults(const struct Ogles2Context* const context, const ProfilingItem* const stats)
+{
+    BOOL header = FALSE;
+
+    for (int i = 0; i < Ogles2FunctionCount; i++) {
+        const NestingChildren* const children = &context->children[stats[i].index];
+
+        NestingChild sorted[NESTING_CHILDREN];
+        const size_t count = nesting_sorted(children, sorted);
+
+        if (stats[i].callCount == 0 || count == 0) {
+            continue;
+        }
+
+        if (!header) {
+            logAlways("  Warp3D Nova functions called inside OpenGL ES 2.0 functions:");
+            logAlways("%30s | %30s | %10s | %20s", "function", "Nova function", "call count", "corrected (ms)");
+            header = TRUE;
+        }
+
+        const char* name = mapOgles2Function(stats[i].index);
+
+        for (size_t c = 0; c < count && c < NESTING_TOP_CHILDREN; c++) {
+            logAlways("%30s | %30s | %10lu | %20.6f", name, warp3dnova_function_name(sorted[c].function),
+                sorted[c].calls, timer_ticks_to_ms(correctTicks(sorted[c].ticks, childOverheadTicks(sorted[c].calls))));
+            name = "";
+        }
+
+        uint64 otherTicks = children->otherTicks;
+        ULONG otherCalls = children->otherCalls;
+
+        for (size_t c = NESTING_TOP_CHILDREN; c < count; c++) {
+            otherTicks += sorted[c].ticks;
+            otherCalls += sorted[c].calls;
+        }
+
+        if (otherCalls) {
+            logAlways("%30s | %30s | %10lu | %20.6f", name, "(other)", otherCalls,
+                timer_ticks_to_ms(correctTicks(otherTicks, childOverheadTicks(otherCalls))));
+        }
+    }
+}
+
 static void profileResults(struct Ogles2Context* const context)
 {
     if (!profilingStarted) {
@@ -1107,27 +411,76 @@ static void profileResults(struct Ogles2Context* const context)
 
     logAlways("  Frames/s %.1f", swaps / seconds);
 
-    logAlways("%30s | %10s | %10s | %20s | %20s | %24s | %20s",
-        "function", "call count", "errors", "duration (ms)", "avg. call dur. (us)", timeUsedBuffer, "% of CPU time");
+    frametime_summary(&context->frameTimes, "aglSwapBuffers");
+
+    overheadStats(context->profiling, Ogles2FunctionCount, overhead.ogles2Call, context->afterTicks, totalTicks);
+
+    logAlways("%30s | %10s | %10s | %20s | %20s | %20s | %20s | %20s | %20s | %24s | %20s | %12s | %12s | %12s | %12s",
+        "function", "call count", "errors", "duration (ms)", "overhead (ms)", "corrected (ms)", "self (ms)", "Nova (ms)",
+        "avg. call dur. (us)", timeUsedBuffer, "% of CPU time", "p50 (us)", "p95 (us)", "p99 (us)", "max (us)");
 
     for (int i = 0; i < Ogles2FunctionCount; i++) {
         if (stats[i].callCount > 0) {
-            logAlways("%30s | %10llu | %10llu | %20.6f | %20.3f | %24.2f | %20.2f",
+            const Histogram* const latency = &context->latency[stats[i].index];
+            const uint64 nested = nestedCalls(&context->children[stats[i].index]);
+            const uint64 tracer = overheadTicks(&stats[i], nested);
+            const uint64 childTracer = childOverheadTicks(nested);
+
+            logAlways("%30s | %10llu | %10llu | %20.6f | %20.6f | %20.6f | %20.6f | %20.6f | %20.3f | %24.2f | %20.2f | %12.3f | %12.3f | %12.3f | %12.3f",
                 mapOgles2Function(stats[i].index),
                 stats[i].callCount,
                 stats[i].errors,
                 timer_ticks_to_ms(stats[i].ticks),
+                timer_ticks_to_ms(tracer),
+                timer_ticks_to_ms(correctTicks(stats[i].ticks, tracer)),
+                timer_ticks_to_ms(correctTicks(stats[i].ticks - stats[i].childTicks, correctTicks(tracer, childTracer))),
+                timer_ticks_to_ms(correctTicks(stats[i].childTicks, childTracer)),
                 timer_ticks_to_us(stats[i].ticks) / (double)stats[i].callCount,
                 (double)stats[i].ticks * 100.0 / (double)context->ticks,
-                (double)stats[i].ticks * 100.0 / (double)totalTicks);
+                (double)stats[i].ticks * 100.0 / (double)totalTicks,
+                timer_ticks_to_us(histogram_percentile(latency, 50.0)),
+                timer_ticks_to_us(histogram_percentile(latency, 95.0)),
+                timer_ticks_to_us(histogram_percentile(latency, 99.0)),
+                timer_ticks_to_us(latency->max));
         }
     }
 
-    logAlways("  *) Please note that the above time measurements include time spent inside Warp3D Nova functions");
+    logAlways("  *) Please note that the above time measurements, except self time, include time spent inside Warp3D Nova functions");
+    logAlways("  *) Overhead is the estimated tracer time inside the measured duration, including the nested Nova wrappers.");
+    logAlways("     Self and Nova times are corrected the same way and add up to the corrected duration");
+
+    childResults(context, stats);
+
+    if (context->errorOverflows) {
+        logAlways("  GL error buffer overflowed %llu times, application didn't call glGetError", context->errorOverflows);
+    }
 
     primitiveStats(&context->counter, seconds, drawcalls);
 }
 
+static const int drawFunctions[] = { DrawElements, DrawArrays, DrawElementsBaseVertexOES };
+static ProfilingItem snapshotItems[Ogles2FunctionCount]; // Used by the snapshot process, under the mutex
+
+void ogles2_snapshot(void)
+{
+    if (!mutex || !profilingStarted) {
+        return;
+    }
+
+    IExec->MutexObtain(mutex);
+
+    size_t position = 0;
+    struct Ogles2Context* context;
+
+    while ((context = client_table_next(&clientTable, &position))) {
+        intervalSummary(&context->interval, context->name, mapOgles2TraceFunction, context->profiling, &context->counter,
+            snapshotItems, context->intervalProfiling, Ogles2FunctionCount, SwapBuffers, drawFunctions,
+            (int)(sizeof(drawFunctions) / sizeof(drawFunctions[0])));
+    }
+
+    IExec->MutexRelease(mutex);
+}
+
 void ogles2_start_profiling(void)
 {
     profilingStarted = TRUE;
@@ -1135,11 +488,13 @@ void ogles2_start_profiling(void)
     if (mutex) {
         IExec->MutexObtain(mutex);
 
-        for (size_t c = 0; c < MAX_CLIENTS; c++) {
-            if (contexts[c]) {
-                // TODO: concurrency issues?
-                PROF_INIT(contexts[c], Ogles2FunctionCount)
-            }
+        size_t position = 0;
+        struct Ogles2Context* context;
+
+        while ((context = client_table_next(&clientTable, &position))) {
+            // TODO: concurrency issues?
+            PROF_INIT(context, Ogles2FunctionCount)
+            memset(context->children, 0, sizeof(context->children));
         }
 
         IExec->MutexRelease(mutex);
@@ -1151,10 +506,11 @@ void ogles2_finish_profiling(void)
     if (mutex) {
         IExec->MutexObtain(mutex);
 
-        for (size_t c = 0; c < MAX_CLIENTS; c++) {
-            if (contexts[c]) {
-                profileResults(contexts[c]);
-            }
+        size_t position = 0;
+        struct Ogles2Context* context;
+
+        while ((context = client_table_next(&clientTable, &position))) {
+            profileResults(context);
         }
 
         IExec->MutexRelease(mutex);
@@ -1173,6 +529,28 @@ struct ExecContext {
 
 static struct ExecContext execContext;
 
+// Logs the results and keeps only a summary of the context. Needs the mutex.
+static void closeContext(struct Ogles2Context* const context)
+{
+    profileResults(context);
+
+    nesting_forget(context->task);
+    log_forget_task(context->task);
+    recorder_close(context->trace);
+    flight_close(context->flight);
+    ITimer->ReadEClock(&context->closed.clockVal);
+
+    ClientSummary* const summary = summarizeClient(context->name, context->id, context->task,
+        context->closed.ticks - context->start.ticks, context->ticks, context->profiling, Ogles2FunctionCount);
+
+    if (!client_table_remove(&clientTable, context->interface, summary)) {
+        logAlways("%s: cannot archive client data", context->name);
+        IExec->FreeVec(summary);
+    }
+
+    IExec->FreeVec(context);
+}
+
 static struct Interface* EXEC_GetInterface(struct ExecIFace* Self, struct Library * library, STRPTR name, ULONG version, struct TagItem *ti)
 {
     struct Interface* interface = NULL;
@@ -1181,6 +559,13 @@ static struct Interface* EXEC_GetInterface(struct ExecIFace* Self, struct Librar
         interface = execContext.old_GetInterface(Self, library, name, version, ti);
 
         if (library == OGLES2Base) {
+            char taskName[NAME_LEN];
+            find_process_name2((struct Node *)IExec->FindTask(NULL), taskName);
+
+            if (!task_filter_match(taskName)) {
+                logAlways("Task %s doesn't match the TASK pattern, OGLES2IFace %p not patched", taskName, interface);
+                return interface;
+            }
 
             struct Ogles2Context * context = IExec->AllocVecTags(sizeof(struct Ogles2Context), AVT_ClearValue, 0, TAG_DONE);
 
@@ -1192,21 +577,31 @@ static struct Interface* EXEC_GetInterface(struct ExecIFace* Self, struct Librar
 
                 IExec->MutexObtain(mutex);
 
-                size_t i;
-                for (i = 0; i < MAX_CLIENTS; i++) {
-                    if (contexts[i] == NULL) {
-                        logAlways("[%u] Patching task %s OGLES2IFace %p", i, context->name, interface);
-                        contexts[i] = context;
-                        break;
-                    }
+                struct Ogles2Context* const stale = client_table_find(&clientTable, interface);
+
+                if (stale) {
+                    logAlways("%s: OGLES2IFace %p was not dropped", stale->name, interface);
+                    closeContext(stale);
                 }
 
+                context->id = client_table_add(&clientTable, interface, context);
+
                 IExec->MutexRelease(mutex);
 
-                if (i == MAX_CLIENTS) {
-                    logAlways("glSnoop: too many clients, cannot patch");
+                if (!context->id) {
+                    logAlways("Cannot allocate memory for client registry: cannot patch");
                     IExec->FreeVec(context);
                 } else {
+                    logAlways("[%lu] Patching task %s OGLES2IFace %p", context->id, context->name, interface);
+
+                    if (recorder_enabled()) {
+                        context->trace = recorder_open(context->name, mapOgles2TraceFunction);
+                    }
+
+                    if (flight_enabled()) {
+                        context->flight = flight_open(context->name, mapOgles2TraceFunction);
+                    }
+
                     patch_ogles2_functions(context);
                     PROF_INIT(context, Ogles2FunctionCount)
                 }
@@ -1221,21 +616,15 @@ static struct Interface* EXEC_GetInterface(struct ExecIFace* Self, struct Librar
 
 static void EXEC_DropInterface(struct ExecIFace* Self, struct Interface* interface)
 {
-    size_t i;
-
     IExec->MutexObtain(mutex);
 
-    for (i = 0; i < MAX_CLIENTS; i++) {
-        if (contexts[i] && (struct Interface *)contexts[i]->interface == interface) {
-            profileResults(contexts[i]);
+    struct Ogles2Context* context = client_table_find(&clientTable, interface);
 
-            logAlways("%s: dropping patched OGLES2 interface %p [%u]", contexts[i]->name, interface, i);
+    if (context) {
+        logAlways("%s: dropping patched OGLES2 interface %p [%lu]", context->name, interface, context->id);
 
-            // No need to remove patches because every OGLES2 applications has its own interface
-            IExec->FreeVec(contexts[i]);
-            contexts[i] = NULL;
-            break;
-        }
+        // No need to remove patches because every OGLES2 applications has its own interface
+        closeContext(context);
     }
 
     IExec->MutexRelease(mutex);
@@ -1245,29 +634,42 @@ static void EXEC_DropInterface(struct ExecIFace* Self, struct Interface* interfa
     }
 }
 
-GENERATE_PATCH(ExecIFace, GetInterface, EXEC, ExecContext)
-GENERATE_PATCH(ExecIFace, DropInterface, EXEC, ExecContext)
-
-static struct Ogles2Context* find_context(const struct OGLES2IFace * const interface)
+BOOL ogles2_task_patched(const struct Task* const task)
 {
-    size_t i;
-    struct Ogles2Context* context = NULL;
+    BOOL found = FALSE;
 
-    IExec->MutexObtain(mutex);
+    if (mutex) {
+        IExec->MutexObtain(mutex);
 
-    for (i = 0; i < MAX_CLIENTS; i++) {
-        if (contexts[i]->interface == interface) {
-            context = contexts[i];
-            break;
+        size_t position = 0;
+        struct Ogles2Context* context;
+
+        while (!found && (context = client_table_next(&clientTable, &position))) {
+            found = context->task == task;
+        }
+
+        for (size_t i = 0; !found && i < clientTable.archiveCount; i++) {
+            found = ((const ClientSummary *)clientTable.archive[i])->task == task;
         }
+
+        IExec->MutexRelease(mutex);
     }
 
-    IExec->MutexRelease(mutex);
+    return found;
+}
+
+GENERATE_PATCH(ExecIFace, GetInterface, EXEC, ExecContext)
+GENERATE_PATCH(ExecIFace, DropInterface, EXEC, ExecContext)
 
-    return context;
+static struct Ogles2Context* find_context(const struct OGLES2IFace * const interface)
+{
+    return client_table_find(&clientTable, interface);
 }
 
-#define GET_CONTEXT struct Ogles2Context* context = find_context(Self);
+#define GET_CONTEXT(id, ...) \
+    struct Ogles2Context* context = find_context(Self); \
+    const Predicate* const predicate = predicate_find(&predicates, id); \
+    const BOOL traced = filter_test(traceFilter, id) && PREDICATE_MATCH(predicate, ##__VA_ARGS__);
 
 // Error checking helpers
 
@@ -1288,6 +690,7 @@ static void checkErrors(struct Ogles2Context * context, const Ogles2Function id,
         const size_t next = (context->errorWritten + 1) % MAX_GL_ERRORS;
         if (next == context->errorRead) {
             logLine("%s: GL error buffer overflow after %s", context->name, name);
+            context->errorOverflows++;
         } else {
             context->errors[next] = err;
             context->errorWritten = next;
@@ -1295,45 +698,57 @@ static void checkErrors(struct Ogles2Context * context, const Ogles2Function id,
 
         logLine("%s: GL error %d (%s) detected after %s", context->name, err, mapOgles2Error(err), name);
         context->profiling[id].errors++;
+
+        if (context->flight) {
+            flight_trigger("%s: GL error %d after %s", context->name, err, name);
+        }
     }
 }
 
 #define GL_CALL(id, ...) \
 if (context->old_gl ## id) { \
-    PROF_START \
+    PROF_START_PARENT(id) \
     context->old_gl ## id(Self, ##__VA_ARGS__); \
-    PROF_FINISH(id) \
+    PROF_FINISH_PARENT(id) \
+    RECORD_CALL(context, traced, TraceModule_Ogles2, id, start.ticks, ##__VA_ARGS__) \
     checkErrors(context, id, #id); \
+    PROF_AFTER \
 } else { \
     logDebug("%s: " #id " function pointer is NULL (call ignored)", context->name); \
 }
 
 #define AGL_CALL(id, ...) \
 if (context->old_agl ## id) { \
-    PROF_START \
+    PROF_START_PARENT(id) \
     context->old_agl ## id(Self, ##__VA_ARGS__); \
-    PROF_FINISH(id) \
+    PROF_FINISH_PARENT(id) \
+    RECORD_CALL(context, traced, TraceModule_Ogles2, id, start.ticks, ##__VA_ARGS__) \
     checkErrors(context, id, #id); \
+    PROF_AFTER \
 } else { \
     logDebug("%s: " #id " function pointer is NULL (call ignored)", context->name); \
 }
 
 #define GL_CALL_STATUS(id, ...) \
 if (context->old_gl ## id) { \
-    PROF_START \
+    PROF_START_PARENT(id) \
     status = context->old_gl ## id(Self, ##__VA_ARGS__); \
-    PROF_FINISH(id) \
+    PROF_FINISH_PARENT(id) \
+    RECORD_CALL(context, traced, TraceModule_Ogles2, id, start.ticks, ##__VA_ARGS__) \
     checkErrors(context, id, #id); \
+    PROF_AFTER \
 } else { \
     logDebug("%s: " #id " function pointer is NULL (call ignored)", context->name); \
 }
 
 #define AGL_CALL_STATUS(id, ...) \
 if (context->old_agl ## id) { \
-    PROF_START \
+    PROF_START_PARENT(id) \
     status = context->old_agl ## id(Self, ##__VA_ARGS__); \
-    PROF_FINISH(id) \
+    PROF_FINISH_PARENT(id) \
+    RECORD_CALL(context, traced, TraceModule_Ogles2, id, start.ticks, ##__VA_ARGS__) \
     checkErrors(context, id, #id); \
+    PROF_AFTER \
 } else { \
     logDebug("%s: " #id " function pointer is NULL (call ignored)", context->name); \
 }
@@ -1342,18 +757,18 @@ if (context->old_agl ## id) { \
 
 static void* OGLES2_aglCreateContext_AVOID(struct OGLES2IFace *Self, ULONG * errcode, struct TagItem * tags)
 {
-    GET_CONTEXT
+    GET_CONTEXT(CreateContext_AVOID, errcode, tags)
 
     void* status = NULL;
 
     ULONG tempErrCode = 0;
 
-    logLine("%s: %s: errcode pointer %p, tags %p (%s)", context->name, __func__,
+    traceLine("%s: %s: errcode pointer %p, tags %p (%s)", context->name, __func__,
         errcode, tags, decodeTags(tags, context));
 
     AGL_CALL_STATUS(CreateContext_AVOID, &tempErrCode, tags)
 
-    logLine("%s: %s: <- errcode %lu. Context address %p", context->name, __func__,
+    traceLine("%s: %s: <- errcode %lu. Context address %p", context->name, __func__,
         tempErrCode, status);
 
     if (errcode) {
@@ -1365,18 +780,18 @@ static void* OGLES2_aglCreateContext_AVOID(struct OGLES2IFace *Self, ULONG * err
 
 static void* OGLES2_aglCreateContext2(struct OGLES2IFace *Self, ULONG * errcode, struct TagItem * tags)
 {
-    GET_CONTEXT
+    GET_CONTEXT(CreateContext2, errcode, tags)
 
     void* status = NULL;
 
     ULONG tempErrCode = 0;
 
-    logLine("%s: %s: errcode pointer %p, tags %p (%s)", context->name, __func__,
+    traceLine("%s: %s: errcode pointer %p, tags %p (%s)", context->name, __func__,
         errcode, tags, decodeTags(tags, context));
 
     AGL_CALL_STATUS(CreateContext2, &tempErrCode, tags)
 
-    logLine("%s: %s: <- errcode %lu. Context address %p", context->name, __func__,
+    traceLine("%s: %s: <- errcode %lu. Context address %p", context->name, __func__,
         tempErrCode, status);
 
     if (errcode) {
@@ -1388,9 +803,9 @@ static void* OGLES2_aglCreateContext2(struct OGLES2IFace *Self, ULONG * errcode,
 
 static void OGLES2_aglDestroyContext(struct OGLES2IFace *Self, void* context_)
 {
-    GET_CONTEXT
+    GET_CONTEXT(DestroyContext, context_)
 
-    logLine("%s: %s: context %p", context->name, __func__,
+    traceLine("%s: %s: context %p", context->name, __func__,
         context_);
 
     AGL_CALL(DestroyContext, context_)
@@ -1398,16 +813,16 @@ static void OGLES2_aglDestroyContext(struct OGLES2IFace *Self, void* context_)
 
 static void* OGLES2_aglGetProcAddress(struct OGLES2IFace *Self, const char *name)
 {
-    GET_CONTEXT
+    GET_CONTEXT(GetProcAddress, name)
 
     void* status = NULL;
 
-    logLine("%s: %s: name '%s'", context->name, __func__,
+    traceLine("%s: %s: name '%s'", context->name, __func__,
         name);
 
     AGL_CALL_STATUS(GetProcAddress, name)
 
-    logLine("%s: %s: <- address %p", context->name, __func__,
+    traceLine("%s: %s: <- address %p", context->name, __func__,
         status);
 
     return status;
@@ -1415,9 +830,9 @@ static void* OGLES2_aglGetProcAddress(struct OGLES2IFace *Self, const char *name
 
 static void OGLES2_aglMakeCurrent(struct OGLES2IFace *Self, void* context_)
 {
-    GET_CONTEXT
+    GET_CONTEXT(MakeCurrent, context_)
 
-    logLine("%s: %s: context %p", context->name, __func__,
+    traceLine("%s: %s: context %p", context->name, __func__,
         context_);
 
     AGL_CALL(MakeCurrent, context_)
@@ -1425,9 +840,9 @@ static void OGLES2_aglMakeCurrent(struct OGLES2IFace *Self, void* context_)
 
 static void OGLES2_aglSetBitmap(struct OGLES2IFace *Self, struct BitMap *bitmap)
 {
-    GET_CONTEXT
+    GET_CONTEXT(SetBitmap, bitmap)
 
-    logLine("%s: %s: bitmap %p", context->name, __func__,
+    traceLine("%s: %s: bitmap %p", context->name, __func__,
         bitmap);
 
     AGL_CALL(SetBitmap, bitmap)
@@ -1435,9 +850,9 @@ static void OGLES2_aglSetBitmap(struct OGLES2IFace *Self, struct BitMap *bitmap)
 
 static void OGLES2_aglSetParams_AVOID(struct OGLES2IFace *Self, struct TagItem * tags)
 {
-    GET_CONTEXT
+    GET_CONTEXT(SetParams_AVOID, tags)
 
-    logLine("%s: %s: tags %p (%s)", context->name, __func__,
+    traceLine("%s: %s: tags %p (%s)", context->name, __func__,
         tags, decodeTags(tags, context));
 
     AGL_CALL(SetParams_AVOID, tags)
@@ -1445,9 +860,9 @@ static void OGLES2_aglSetParams_AVOID(struct OGLES2IFace *Self, struct TagItem *
 
 static void OGLES2_aglSetParams2(struct OGLES2IFace *Self, struct TagItem * tags)
 {
-    GET_CONTEXT
+    GET_CONTEXT(SetParams2, tags)
 
-    logLine("%s: %s: tags %p (%s)", context->name, __func__,
+    traceLine("%s: %s: tags %p (%s)", context->name, __func__,
         tags, decodeTags(tags, context));
 
     AGL_CALL(SetParams2, tags)
@@ -1455,18 +870,33 @@ static void OGLES2_aglSetParams2(struct OGLES2IFace *Self, struct TagItem * tags
 
 static void OGLES2_aglSwapBuffers(struct OGLES2IFace *Self)
 {
-    GET_CONTEXT
+    GET_CONTEXT(SwapBuffers)
 
-    logLine("%s: %s", context->name, __func__);
+    traceLine("%s: %s", context->name, __func__);
 
     AGL_CALL(SwapBuffers)
+
+    frametime_add(&context->frameTimes, timer_get_ticks());
+
+    if (context->flight) {
+        flight_frame(context->flight);
+    }
+
+    if (context->trace) {
+        recorder_frame(context->trace);
+    }
+
+    if (frameSummaryMode) {
+        frameSummary(&context->frame, context->name, mapOgles2TraceFunction, context->profiling,
+            context->frameProfiling, Ogles2FunctionCount, &context->counter);
+    }
 }
 
 static void OGLES2_glActiveTexture(struct OGLES2IFace *Self, GLenum texture)
 {
-    GET_CONTEXT
+    GET_CONTEXT(ActiveTexture, texture)
 
-    logLine("%s: %s: texture 0x%X (%s)", context->name, __func__,
+    traceLine("%s: %s: texture 0x%X (%s)", context->name, __func__,
         texture, decodeTexture(texture));
 
     GL_CALL(ActiveTexture, texture)
@@ -1474,9 +904,9 @@ static void OGLES2_glActiveTexture(struct OGLES2IFace *Self, GLenum texture)
 
 static void OGLES2_glAttachShader(struct OGLES2IFace *Self, GLuint program, GLuint shader)
 {
-    GET_CONTEXT
+    GET_CONTEXT(AttachShader, program, shader)
 
-    logLine("%s: %s: program %u, shader %u", context->name, __func__,
+    traceLine("%s: %s: program %u, shader %u", context->name, __func__,
         program, shader);
 
     GL_CALL(AttachShader, program, shader)
@@ -1484,9 +914,9 @@ static void OGLES2_glAttachShader(struct OGLES2IFace *Self, GLuint program, GLui
 
 static void OGLES2_glBindAttribLocation(struct OGLES2IFace *Self, GLuint program, GLuint index, const GLchar * name)
 {
-    GET_CONTEXT
+    GET_CONTEXT(BindAttribLocation, program, index, name)
 
-    logLine("%s: %s: program %u, index %u, name '%s'", context->name, __func__,
+    traceLine("%s: %s: program %u, index %u, name '%s'", context->name, __func__,
         program, index, name);
 
     GL_CALL(BindAttribLocation, program, index, name)
@@ -1494,9 +924,9 @@ static void OGLES2_glBindAttribLocation(struct OGLES2IFace *Self, GLuint program
 
 static void OGLES2_glBindBuffer(struct OGLES2IFace *Self, GLenum target, GLuint buffer)
 {
-    GET_CONTEXT
+    GET_CONTEXT(BindBuffer, target, buffer)
 
-    logLine("%s: %s: target 0x%X (%s), buffer %u", context->name, __func__,
+    traceLine("%s: %s: target 0x%X (%s), buffer %u", context->name, __func__,
         target, decodeValue(target),
         buffer);
 
@@ -1505,9 +935,9 @@ static void OGLES2_glBindBuffer(struct OGLES2IFace *Self, GLenum target, GLuint
 
 static void OGLES2_glBindFramebuffer(struct OGLES2IFace *Self, GLenum target, GLuint framebuffer)
 {
-    GET_CONTEXT
+    GET_CONTEXT(BindFramebuffer, target, framebuffer)
 
-    logLine("%s: %s: target 0x%X (%s), framebuffer %u", context->name, __func__,
+    traceLine("%s: %s: target 0x%X (%s), framebuffer %u", context->name, __func__,
         target, decodeValue(target),
         framebuffer);
 
@@ -1516,9 +946,9 @@ static void OGLES2_glBindFramebuffer(struct OGLES2IFace *Self, GLenum target, GL
 
 static void OGLES2_glBindRenderbuffer(struct OGLES2IFace *Self, GLenum target, GLuint renderbuffer)
 {
-    GET_CONTEXT
+    GET_CONTEXT(BindRenderbuffer, target, renderbuffer)
 
-    logLine("%s: %s: target 0x%X (%s), renderbuffer %u", context->name, __func__,
+    traceLine("%s: %s: target 0x%X (%s), renderbuffer %u", context->name, __func__,
         target, decodeValue(target),
         renderbuffer);
 
@@ -1527,9 +957,9 @@ static void OGLES2_glBindRenderbuffer(struct OGLES2IFace *Self, GLenum target, G
 
 static void OGLES2_glBindTexture(struct OGLES2IFace *Self, GLenum target, GLuint texture)
 {
-    GET_CONTEXT
+    GET_CONTEXT(BindTexture, target, texture)
 
-    logLine("%s: %s: target 0x%X (%s), texture %d", context->name, __func__,
+    traceLine("%s: %s: target 0x%X (%s), texture %d", context->name, __func__,
         target, decodeValue(target),
         texture);
 
@@ -1538,9 +968,9 @@ static void OGLES2_glBindTexture(struct OGLES2IFace *Self, GLenum target, GLuint
 
 static void OGLES2_glBlendColor(struct OGLES2IFace *Self, GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha)
 {
-    GET_CONTEXT
+    GET_CONTEXT(BlendColor, red, green, blue, alpha)
 
-    logLine("%s: %s: red %f, green %f, blue %f, alpha %f", context->name, __func__,
+    traceLine("%s: %s: red %f, green %f, blue %f, alpha %f", context->name, __func__,
         red, green, blue, alpha);
 
     GL_CALL(BlendColor, red, green, blue, alpha)
@@ -1548,9 +978,9 @@ static void OGLES2_glBlendColor(struct OGLES2IFace *Self, GLfloat red, GLfloat g
 
 static void OGLES2_glBlendEquation(struct OGLES2IFace *Self, GLenum mode)
 {
-    GET_CONTEXT
+    GET_CONTEXT(BlendEquation, mode)
 
-    logLine("%s: %s: mode 0x%X (%s)", context->name, __func__,
+    traceLine("%s: %s: mode 0x%X (%s)", context->name, __func__,
         mode, decodeValue(mode));
 
     GL_CALL(BlendEquation, mode)
@@ -1558,9 +988,9 @@ static void OGLES2_glBlendEquation(struct OGLES2IFace *Self, GLenum mode)
 
 static void OGLES2_glBlendEquationSeparate(struct OGLES2IFace *Self, GLenum modeRGB, GLenum modeAlpha)
 {
-    GET_CONTEXT
+    GET_CONTEXT(BlendEquationSeparate, modeRGB, modeAlpha)
 
-    logLine("%s: %s: modeRGB 0x%X (%s), modeAlpha 0x%X (%s)", context->name, __func__,
+    traceLine("%s: %s: modeRGB 0x%X (%s), modeAlpha 0x%X (%s)", context->name, __func__,
         modeRGB, decodeValue(modeRGB),
         modeAlpha, decodeValue(modeAlpha));
 
@@ -1569,9 +999,9 @@ static void OGLES2_glBlendEquationSeparate(struct OGLES2IFace *Self, GLenum mode
 
 static void OGLES2_glBlendFunc(struct OGLES2IFace *Self, GLenum sfactor, GLenum dfactor)
 {
-    GET_CONTEXT
+    GET_CONTEXT(BlendFunc, sfactor, dfactor)
 
-    logLine("%s: %s: sfactor 0x%X (%s), dfactor 0x%X (%s)", context->name, __func__,
+    traceLine("%s: %s: sfactor 0x%X (%s), dfactor 0x%X (%s)", context->name, __func__,
         sfactor, decodeValue(sfactor),
         dfactor, decodeValue(dfactor));
 
@@ -1580,9 +1010,9 @@ static void OGLES2_glBlendFunc(struct OGLES2IFace *Self, GLenum sfactor, GLenum
 
 static void OGLES2_glBlendFuncSeparate(struct OGLES2IFace *Self, GLenum sfactorRGB, GLenum dfactorRGB, GLenum sfactorAlpha, GLenum dfactorAlpha)
 {
-    GET_CONTEXT
+    GET_CONTEXT(BlendFuncSeparate, sfactorRGB, dfactorRGB, sfactorAlpha, dfactorAlpha)
 
-    logLine("%s: %s: sfactorRGB 0x%X (%s), dfactorRGB 0x%X (%s), sfactorAlpha 0x%X (%s), dfactorAlpha 0x%X (%s)", context->name, __func__,
+    traceLine("%s: %s: sfactorRGB 0x%X (%s), dfactorRGB 0x%X (%s), sfactorAlpha 0x%X (%s), dfactorAlpha 0x%X (%s)", context->name, __func__,
         sfactorRGB, decodeValue(sfactorRGB),
         dfactorRGB, decodeValue(dfactorRGB),
         sfactorAlpha, decodeValue(sfactorAlpha),
@@ -1593,9 +1023,9 @@ static void OGLES2_glBlendFuncSeparate(struct OGLES2IFace *Self, GLenum sfactorR
 
 static void OGLES2_glBufferData(struct OGLES2IFace *Self, GLenum target, GLsizeiptr size, const void * data, GLenum usage)
 {
-    GET_CONTEXT
+    GET_CONTEXT(BufferData, target, size, data, usage)
 
-    logLine("%s: %s: target 0x%X (%s), size %u, data %p, usage 0x%X (%s)", context->name, __func__,
+    traceLine("%s: %s: target 0x%X (%s), size %u, data %p, usage 0x%X (%s)", context->name, __func__,
         target, decodeValue(target),
         size, data,
         usage, decodeValue(usage));
@@ -1605,9 +1035,9 @@ static void OGLES2_glBufferData(struct OGLES2IFace *Self, GLenum target, GLsizei
 
 static void OGLES2_glBufferSubData(struct OGLES2IFace *Self, GLenum target, GLintptr offset, GLsizeiptr size, const void * data)
 {
-    GET_CONTEXT
+    GET_CONTEXT(BufferSubData, target, offset, size, data)
 
-    logLine("%s: %s: target 0x%X (%s), offset %u, size %u, data %p", context->name, __func__,
+    traceLine("%s: %s: target 0x%X (%s), offset %u, size %u, data %p", context->name, __func__,
         target, decodeValue(target),
         offset, size, data);
 
@@ -1616,16 +1046,16 @@ static void OGLES2_glBufferSubData(struct OGLES2IFace *Self, GLenum target, GLin
 
 static GLenum OGLES2_glCheckFramebufferStatus(struct OGLES2IFace *Self, GLenum target)
 {
-    GET_CONTEXT
+    GET_CONTEXT(CheckFramebufferStatus, target)
 
     GLenum status = 0;
 
-    logLine("%s: %s: target 0x%X (%s)", context->name, __func__,
+    traceLine("%s: %s: target 0x%X (%s)", context->name, __func__,
         target, decodeValue(target));
 
     GL_CALL_STATUS(CheckFramebufferStatus, target)
 
-    logLine("%s: %s: <- status 0x%X (%s)", context->name, __func__,
+    traceLine("%s: %s: <- status 0x%X (%s)", context->name, __func__,
         status, decodeValue(status));
 
     return status;
@@ -1633,9 +1063,9 @@ static GLenum OGLES2_glCheckFramebufferStatus(struct OGLES2IFace *Self, GLenum t
 
 static void OGLES2_glClear(struct OGLES2IFace *Self, GLbitfield mask)
 {
-    GET_CONTEXT
+    GET_CONTEXT(Clear, mask)
 
-    logLine("%s: %s: mask 0x%X %s%s%s", context->name, __func__,
+    traceLine("%s: %s: mask 0x%X %s%s%s", context->name, __func__,
         mask,
         (mask & GL_COLOR_BUFFER_BIT) ? "[COLOR]" : "",
         (mask & GL_DEPTH_BUFFER_BIT) ? "[DEPTH]" : "",
@@ -1646,9 +1076,9 @@ static void OGLES2_glClear(struct OGLES2IFace *Self, GLbitfield mask)
 
 static void OGLES2_glClearColor(struct OGLES2IFace *Self, GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha)
 {
-    GET_CONTEXT
+    GET_CONTEXT(ClearColor, red, green, blue, alpha)
 
-    logLine("%s: %s: red %f, green %f, blue %f, alpha %f", context->name, __func__,
+    traceLine("%s: %s: red %f, green %f, blue %f, alpha %f", context->name, __func__,
         red, green, blue, alpha);
 
     GL_CALL(ClearColor, red, green, blue, alpha)
@@ -1656,9 +1086,9 @@ static void OGLES2_glClearColor(struct OGLES2IFace *Self, GLfloat red, GLfloat g
 
 static void OGLES2_glClearDepthf(struct OGLES2IFace *Self, GLfloat d)
 {
-    GET_CONTEXT
+    GET_CONTEXT(ClearDepthf, d)
 
-    logLine("%s: %s: d %f", context->name, __func__,
+    traceLine("%s: %s: d %f", context->name, __func__,
         d);
 
     GL_CALL(ClearDepthf, d)
@@ -1666,9 +1096,9 @@ static void OGLES2_glClearDepthf(struct OGLES2IFace *Self, GLfloat d)
 
 static void OGLES2_glClearStencil(struct OGLES2IFace *Self, GLint s)
 {
-    GET_CONTEXT
+    GET_CONTEXT(ClearStencil, s)
 
-    logLine("%s: %s: s %d", context->name, __func__,
+    traceLine("%s: %s: s %d", context->name, __func__,
         s);
 
     GL_CALL(ClearStencil, s)
@@ -1676,9 +1106,9 @@ static void OGLES2_glClearStencil(struct OGLES2IFace *Self, GLint s)
 
 static void OGLES2_glColorMask(struct OGLES2IFace *Self, GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha)
 {
-    GET_CONTEXT
+    GET_CONTEXT(ColorMask, red, green, blue, alpha)
 
-    logLine("%s: %s: red %d, green %d, blue %d, alpha %d", context->name, __func__,
+    traceLine("%s: %s: red %d, green %d, blue %d, alpha %d", context->name, __func__,
         red, green, blue, alpha);
 
     GL_CALL(ColorMask, red, green, blue, alpha)
@@ -1686,9 +1116,9 @@ static void OGLES2_glColorMask(struct OGLES2IFace *Self, GLboolean red, GLboolea
 
 static void OGLES2_glCompileShader(struct OGLES2IFace *Self, GLuint shader)
 {
-    GET_CONTEXT
+    GET_CONTEXT(CompileShader, shader)
 
-    logLine("%s: %s: shader %u", context->name, __func__,
+    traceLine("%s: %s: shader %u", context->name, __func__,
         shader);
 
     GL_CALL(CompileShader, shader)
@@ -1696,9 +1126,9 @@ static void OGLES2_glCompileShader(struct OGLES2IFace *Self, GLuint shader)
 
 static void OGLES2_glCompressedTexImage2D(struct OGLES2IFace *Self, GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLint border, GLsizei imageSize, const void * data)
 {
-    GET_CONTEXT
+    GET_CONTEXT(CompressedTexImage2D, target, level, internalformat, width, height, border, imageSize, data)
 
-    logLine("%s: %s: target 0x%X (%s), level %d, internalformat 0x%X (%s), width %d, height %d, border %d, imageSize %d, data %p", context->name, __func__,
+    traceLine("%s: %s: target 0x%X (%s), level %d, internalformat 0x%X (%s), width %d, height %d, border %d, imageSize %d, data %p", context->name, __func__,
         target, decodeValue(target),
         level,
         internalformat, decodeValue(internalformat),
@@ -1709,9 +1139,9 @@ static void OGLES2_glCompressedTexImage2D(struct OGLES2IFace *Self, GLenum targe
 
 static void OGLES2_glCompressedTexSubImage2D(struct OGLES2IFace *Self, GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLsizei imageSize, const void * data)
 {
-    GET_CONTEXT
+    GET_CONTEXT(CompressedTexSubImage2D, target, level, xoffset, yoffset, width, height, format, imageSize, data)
 
-    logLine("%s: %s: target 0x%X (%s), level %d, xoffset %d, yoffset %d, width %d, height %d, format 0x%X (%s), imageSize %d, data %p", context->name, __func__,
+    traceLine("%s: %s: target 0x%X (%s), level %d, xoffset %d, yoffset %d, width %d, height %d, format 0x%X (%s), imageSize %d, data %p", context->name, __func__,
         target, decodeValue(target),
         level, xoffset, yoffset, width, height,
         format, decodeValue(format),
@@ -1722,9 +1152,9 @@ static void OGLES2_glCompressedTexSubImage2D(struct OGLES2IFace *Self, GLenum ta
 
 static void OGLES2_glCopyTexImage2D(struct OGLES2IFace *Self, GLenum target, GLint level, GLenum internalformat, GLint x, GLint y, GLsizei width, GLsizei height, GLint border)
 {
-    GET_CONTEXT
+    GET_CONTEXT(CopyTexImage2D, target, level, internalformat, x, y, width, height, border)
 
-    logLine("%s: %s: target 0x%X (%s), level %d, internalformat 0x%X (%s), x %d, y %d, width %d, height %d, border %d", context->name, __func__,
+    traceLine("%s: %s: target 0x%X (%s), level %d, internalformat 0x%X (%s), x %d, y %d, width %d, height %d, border %d", context->name, __func__,
         target, decodeValue(target),
         level,
         internalformat, decodeValue(internalformat),
@@ -1735,9 +1165,9 @@ static void OGLES2_glCopyTexImage2D(struct OGLES2IFace *Self, GLenum target, GLi
 
 static void OGLES2_glCopyTexSubImage2D(struct OGLES2IFace *Self, GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint x, GLint y, GLsizei width, GLsizei height)
 {
-    GET_CONTEXT
+    GET_CONTEXT(CopyTexSubImage2D, target, level, xoffset, yoffset, x, y, width, height)
 
-    logLine("%s: %s: target 0x%X (%s), level %d, xoffset %d, yoffset %d, x %d, y %d, width %d, height %d", context->name, __func__,
+    traceLine("%s: %s: target 0x%X (%s), level %d, xoffset %d, yoffset %d, x %d, y %d, width %d, height %d", context->name, __func__,
         target, decodeValue(target),
         level, xoffset, yoffset, x, y, width, height);
 
@@ -1746,15 +1176,15 @@ static void OGLES2_glCopyTexSubImage2D(struct OGLES2IFace *Self, GLenum target,
 
 static GLuint OGLES2_glCreateProgram(struct OGLES2IFace *Self)
 {
-    GET_CONTEXT
+    GET_CONTEXT(CreateProgram)
 
     GLuint status = 0;
 
-    logLine("%s: %s", context->name, __func__);
+    traceLine("%s: %s", context->name, __func__);
 
     GL_CALL_STATUS(CreateProgram)
 
-    logLine("%s: %s: <- program %u", context->name, __func__,
+    traceLine("%s: %s: <- program %u", context->name, __func__,
         status);
 
     return status;
@@ -1762,16 +1192,16 @@ static GLuint OGLES2_glCreateProgram(struct OGLES2IFace *Self)
 
 static GLuint OGLES2_glCreateShader(struct OGLES2IFace *Self, GLenum type)
 {
-    GET_CONTEXT
+    GET_CONTEXT(CreateShader, type)
 
     GLuint status = 0;
 
-    logLine("%s: %s: type 0x%X (%s)", context->name, __func__,
+    traceLine("%s: %s: type 0x%X (%s)", context->name, __func__,
         type, decodeValue(type));
 
     GL_CALL_STATUS(CreateShader, type)
 
-    logLine("%s: %s: <- shader %u", context->name, __func__,
+    traceLine("%s: %s: <- shader %u", context->name, __func__,
         status);
 
     return status;
@@ -1779,9 +1209,9 @@ static GLuint OGLES2_glCreateShader(struct OGLES2IFace *Self, GLenum type)
 
 static void OGLES2_glCullFace(struct OGLES2IFace *Self, GLenum mode)
 {
-    GET_CONTEXT
+    GET_CONTEXT(CullFace, mode)
 
-    logLine("%s: %s: mode 0x%X (%s)", context->name, __func__,
+    traceLine("%s: %s: mode 0x%X (%s)", context->name, __func__,
         mode, decodeValue(mode));
 
     GL_CALL(CullFace, mode)
@@ -1789,14 +1219,14 @@ static void OGLES2_glCullFace(struct OGLES2IFace *Self, GLenum mode)
 
 static void OGLES2_glDeleteBuffers(struct OGLES2IFace *Self, GLsizei n, GLuint * buffers)
 {
-    GET_CONTEXT
+    GET_CONTEXT(DeleteBuffers, n, buffers)
 
-    logLine("%s: %s: n %d, buffers %p", context->name, __func__,
+    traceLine("%s: %s: n %d, buffers %p", context->name, __func__,
          n, buffers);
 
     GLsizei i;
     for (i = 0; i < n; i++) {
-        logLine("Deleting buffer[%u] = %u", i, buffers[i]);
+        traceLine("Deleting buffer[%u] = %u", i, buffers[i]);
     }
 
     GL_CALL(DeleteBuffers, n, buffers)
@@ -1804,14 +1234,14 @@ static void OGLES2_glDeleteBuffers(struct OGLES2IFace *Self, GLsizei n, GLuint *
 
 static void OGLES2_glDeleteFramebuffers(struct OGLES2IFace *Self, GLsizei n, const GLuint * framebuffers)
 {
-    GET_CONTEXT
+    GET_CONTEXT(DeleteFramebuffers, n, framebuffers)
 
-    logLine("%s: %s: n %u, framebuffers %p", context->name, __func__,
+    traceLine("%s: %s: n %u, framebuffers %p", context->name, __func__,
         n, framebuffers);
 
     GLsizei i;
     for (i = 0; i < n; i++) {
-        logLine("Deleting framebuffer[%u] = %u", i, framebuffers[i]);
+        traceLine("Deleting framebuffer[%u] = %u", i, framebuffers[i]);
     }
 
     GL_CALL(DeleteFramebuffers, n, framebuffers)
@@ -1819,9 +1249,9 @@ static void OGLES2_glDeleteFramebuffers(struct OGLES2IFace *Self, GLsizei n, con
 
 static void OGLES2_glDeleteProgram(struct OGLES2IFace *Self, GLuint program)
 {
-    GET_CONTEXT
+    GET_CONTEXT(DeleteProgram, program)
 
-    logLine("%s: %s: program %u", context->name, __func__,
+    traceLine("%s: %s: program %u", context->name, __func__,
         program);
 
     GL_CALL(DeleteProgram, program)
@@ -1829,14 +1259,14 @@ static void OGLES2_glDeleteProgram(struct OGLES2IFace *Self, GLuint program)
 
 static void OGLES2_glDeleteRenderbuffers(struct OGLES2IFace *Self, GLsizei n, const GLuint * renderbuffers)
 {
-    GET_CONTEXT
+    GET_CONTEXT(DeleteRenderbuffers, n, renderbuffers)
 
-    logLine("%s: %s: n %d, renderbuffers %p", context->name, __func__,
+    traceLine("%s: %s: n %d, renderbuffers %p", context->name, __func__,
         n, renderbuffers);
 
     GLsizei i;
     for (i = 0; i < n; i++) {
-        logLine("Deleting renderbuffer[%u] = %u", i, renderbuffers[i]);
+        traceLine("Deleting renderbuffer[%u] = %u", i, renderbuffers[i]);
     }
 
     GL_CALL(DeleteRenderbuffers, n, renderbuffers)
@@ -1844,9 +1274,9 @@ static void OGLES2_glDeleteRenderbuffers(struct OGLES2IFace *Self, GLsizei n, co
 
 static void OGLES2_glDeleteShader(struct OGLES2IFace *Self, GLuint shader)
 {
-    GET_CONTEXT
+    GET_CONTEXT(DeleteShader, shader)
 
-    logLine("%s: %s: shader %u", context->name, __func__,
+    traceLine("%s: %s: shader %u", context->name, __func__,
         shader);
 
     GL_CALL(DeleteShader, shader)
@@ -1854,14 +1284,14 @@ static void OGLES2_glDeleteShader(struct OGLES2IFace *Self, GLuint shader)
 
 static void OGLES2_glDeleteTextures(struct OGLES2IFace *Self, GLsizei n, const GLuint * textures)
 {
-    GET_CONTEXT
+    GET_CONTEXT(DeleteTextures, n, textures)
 
-    logLine("%s: %s: n %u, textures %p", context->name, __func__,
+    traceLine("%s: %s: n %u, textures %p", context->name, __func__,
         n, textures);
 
     GLsizei i;
     for (i = 0; i < n; i++) {
-        logLine("Deleting texture[%u] = %u", i, textures[i]);
+        traceLine("Deleting texture[%u] = %u", i, textures[i]);
     }
 
     GL_CALL(DeleteTextures, n, textures)
@@ -1869,9 +1299,9 @@ static void OGLES2_glDeleteTextures(struct OGLES2IFace *Self, GLsizei n, const G
 
 static void OGLES2_glDepthFunc(struct OGLES2IFace *Self, GLenum func)
 {
-    GET_CONTEXT
+    GET_CONTEXT(DepthFunc, func)
 
-    logLine("%s: %s: func 0x%X (%s)", context->name, __func__,
+    traceLine("%s: %s: func 0x%X (%s)", context->name, __func__,
         func, decodeValue(func));
 
     GL_CALL(DepthFunc, func)
@@ -1879,9 +1309,9 @@ static void OGLES2_glDepthFunc(struct OGLES2IFace *Self, GLenum func)
 
 static void OGLES2_glDepthMask(struct OGLES2IFace *Self, GLboolean flag)
 {
-    GET_CONTEXT
+    GET_CONTEXT(DepthMask, flag)
 
-    logLine("%s: %s: flag %d", context->name, __func__,
+    traceLine("%s: %s: flag %d", context->name, __func__,
         flag);
 
     GL_CALL(DepthMask, flag)
@@ -1889,9 +1319,9 @@ static void OGLES2_glDepthMask(struct OGLES2IFace *Self, GLboolean flag)
 
 static void OGLES2_glDepthRangef(struct OGLES2IFace *Self, GLfloat n, GLfloat f)
 {
-    GET_CONTEXT
+    GET_CONTEXT(DepthRangef, n, f)
 
-    logLine("%s: %s: n %f f %f", context->name, __func__,
+    traceLine("%s: %s: n %f f %f", context->name, __func__,
         n, f);
 
     GL_CALL(DepthRangef, n, f)
@@ -1899,9 +1329,9 @@ static void OGLES2_glDepthRangef(struct OGLES2IFace *Self, GLfloat n, GLfloat f)
 
 static void OGLES2_glDetachShader(struct OGLES2IFace *Self, GLuint program, GLuint shader)
 {
-    GET_CONTEXT
+    GET_CONTEXT(DetachShader, program, shader)
 
-    logLine("%s: %s: program %u, shader %u", context->name, __func__,
+    traceLine("%s: %s: program %u, shader %u", context->name, __func__,
         program, shader);
 
     GL_CALL(DetachShader, program, shader)
@@ -1909,9 +1339,9 @@ static void OGLES2_glDetachShader(struct OGLES2IFace *Self, GLuint program, GLui
 
 static void OGLES2_glDisable(struct OGLES2IFace *Self, GLenum cap)
 {
-    GET_CONTEXT
+    GET_CONTEXT(Disable, cap)
 
-    logLine("%s: %s: cap 0x%X (%s)", context->name, __func__,
+    traceLine("%s: %s: cap 0x%X (%s)", context->name, __func__,
         cap, decodeCapability(cap));
 
     GL_CALL(Disable, cap)
@@ -1919,9 +1349,9 @@ static void OGLES2_glDisable(struct OGLES2IFace *Self, GLenum cap)
 
 static void OGLES2_glDisableVertexAttribArray(struct OGLES2IFace *Self, GLuint index)
 {
-    GET_CONTEXT
+    GET_CONTEXT(DisableVertexAttribArray, index)
 
-    logLine("%s: %s: index %u", context->name, __func__,
+    traceLine("%s: %s: index %u", context->name, __func__,
         index);
 
     GL_CALL(DisableVertexAttribArray, index)
@@ -1960,9 +1390,9 @@ static void countPrimitive(PrimitiveCounter * counter, const GLenum type, const
 
 static void OGLES2_glDrawArrays(struct OGLES2IFace *Self, GLenum mode, GLint first, GLsizei count)
 {
-    GET_CONTEXT
+    GET_CONTEXT(DrawArrays, mode, first, count)
 
-    logLine("%s: %s: mode 0x%X (%s), first %d, count %u", context->name, __func__,
+    traceLine("%s: %s: mode 0x%X (%s), first %d, count %u", context->name, __func__,
         mode, decodePrimitive(mode),
         first, count);
 
@@ -1973,9 +1403,9 @@ static void OGLES2_glDrawArrays(struct OGLES2IFace *Self, GLenum mode, GLint fir
 
 static void OGLES2_glDrawElements(struct OGLES2IFace *Self, GLenum mode, GLsizei count, GLenum type, const void * indices)
 {
-    GET_CONTEXT
+    GET_CONTEXT(DrawElements, mode, count, type, indices)
 
-    logLine("%s: %s: mode 0x%X (%s), count %u, type 0x%X (%s), indices %p", context->name, __func__,
+    traceLine("%s: %s: mode 0x%X (%s), count %u, type 0x%X (%s), indices %p", context->name, __func__,
         mode, decodePrimitive(mode),
         count,
         type, decodeValue(type),
@@ -1988,9 +1418,9 @@ static void OGLES2_glDrawElements(struct OGLES2IFace *Self, GLenum mode, GLsizei
 
 static void OGLES2_glDrawElementsBaseVertexOES(struct OGLES2IFace *Self, GLenum mode, GLsizei count, GLenum type, const void * indices, GLint basevertex)
 {
-    GET_CONTEXT
+    GET_CONTEXT(DrawElementsBaseVertexOES, mode, count, type, indices, basevertex)
 
-    logLine("%s: %s: mode 0x%X (%s), count %u, type 0x%X (%s), indices %p, basevertex %d", context->name, __func__,
+    traceLine("%s: %s: mode 0x%X (%s), count %u, type 0x%X (%s), indices %p, basevertex %d", context->name, __func__,
         mode, decodePrimitive(mode),
         count,
         type, decodeValue(type),
@@ -2003,9 +1433,9 @@ static void OGLES2_glDrawElementsBaseVertexOES(struct OGLES2IFace *Self, GLenum
 
 static void OGLES2_glEnable(struct OGLES2IFace *Self, GLenum cap)
 {
-    GET_CONTEXT
+    GET_CONTEXT(Enable, cap)
 
-    logLine("%s: %s: cap 0x%X (%s)", context->name, __func__,
+    traceLine("%s: %s: cap 0x%X (%s)", context->name, __func__,
         cap, decodeCapability(cap));
 
     GL_CALL(Enable, cap)
@@ -2013,9 +1443,9 @@ static void OGLES2_glEnable(struct OGLES2IFace *Self, GLenum cap)
 
 static void OGLES2_glEnableVertexAttribArray(struct OGLES2IFace *Self, GLuint index)
 {
-    GET_CONTEXT
+    GET_CONTEXT(EnableVertexAttribArray, index)
 
-    logLine("%s: %s: index %u", context->name, __func__,
+    traceLine("%s: %s: index %u", context->name, __func__,
         index);
 
     GL_CALL(EnableVertexAttribArray, index)
@@ -2023,27 +1453,27 @@ static void OGLES2_glEnableVertexAttribArray(struct OGLES2IFace *Self, GLuint in
 
 static void OGLES2_glFinish(struct OGLES2IFace *Self)
 {
-    GET_CONTEXT
+    GET_CONTEXT(Finish)
 
-    logLine("%s: %s", context->name, __func__);
+    traceLine("%s: %s", context->name, __func__);
 
     GL_CALL(Finish)
 }
 
 static void OGLES2_glFlush(struct OGLES2IFace *Self)
 {
-    GET_CONTEXT
+    GET_CONTEXT(Flush)
 
-    logLine("%s: %s", context->name, __func__);
+    traceLine("%s: %s", context->name, __func__);
 
     GL_CALL(Flush)
 }
 
 static void OGLES2_glFramebufferRenderbuffer(struct OGLES2IFace *Self, GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer)
 {
-    GET_CONTEXT
+    GET_CONTEXT(FramebufferRenderbuffer, target, attachment, renderbuffertarget, renderbuffer)
 
-    logLine("%s: %s: target 0x%X (%s), attachment 0x%X (%s), renderbuffertarget 0x%X (%s), renderbuffer %u", context->name, __func__,
+    traceLine("%s: %s: target 0x%X (%s), attachment 0x%X (%s), renderbuffertarget 0x%X (%s), renderbuffer %u", context->name, __func__,
         target, decodeValue(target),
         attachment, decodeValue(attachment),
         renderbuffertarget, decodeValue(renderbuffertarget),
@@ -2054,9 +1484,9 @@ static void OGLES2_glFramebufferRenderbuffer(struct OGLES2IFace *Self, GLenum ta
 
 static void OGLES2_glFramebufferTexture2D(struct OGLES2IFace *Self, GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level)
 {
-    GET_CONTEXT
+    GET_CONTEXT(FramebufferTexture2D, target, attachment, textarget, texture, level)
 
-    logLine("%s: %s: target 0x%X (%s), attachment 0x%X (%s), textarget 0x%X (%s), texture %u, level %d", context->name, __func__,
+    traceLine("%s: %s: target 0x%X (%s), attachment 0x%X (%s), textarget 0x%X (%s), texture %u, level %d", context->name, __func__,
         target, decodeValue(target),
         attachment, decodeValue(attachment),
         textarget, decodeValue(textarget),
@@ -2067,9 +1497,9 @@ static void OGLES2_glFramebufferTexture2D(struct OGLES2IFace *Self, GLenum targe
 
 static void OGLES2_glFrontFace(struct OGLES2IFace *Self, GLenum mode)
 {
-    GET_CONTEXT
+    GET_CONTEXT(FrontFace, mode)
 
-    logLine("%s: %s: mode 0x%X (%s)", context->name, __func__,
+    traceLine("%s: %s: mode 0x%X (%s)", context->name, __func__,
         mode, decodeValue(mode));
 
     GL_CALL(FrontFace, mode)
@@ -2077,24 +1507,24 @@ static void OGLES2_glFrontFace(struct OGLES2IFace *Self, GLenum mode)
 
 static void OGLES2_glGenBuffers(struct OGLES2IFace *Self, GLsizei n, GLuint * buffers)
 {
-    GET_CONTEXT
+    GET_CONTEXT(GenBuffers, n, buffers)
 
-    logLine("%s: %s: n %d, buffers %p", context->name, __func__,
+    traceLine("%s: %s: n %d, buffers %p", context->name, __func__,
         n, buffers);
 
     GL_CALL(GenBuffers, n, buffers)
 
     GLsizei i;
     for (i = 0; i < n; i++) {
-        logLine("Buffer[%u] = %u", i, buffers[i]);
+        traceLine("Buffer[%u] = %u", i, buffers[i]);
     }
 }
 
 static void OGLES2_glGenerateMipmap(struct OGLES2IFace *Self, GLenum target)
 {
-    GET_CONTEXT
+    GET_CONTEXT(GenerateMipmap, target)
 
-    logLine("%s: %s: target 0x%X (%s)", context->name, __func__,
+    traceLine("%s: %s: target 0x%X (%s)", context->name, __func__,
         target, decodeValue(target));
 
     GL_CALL(GenerateMipmap, target)
@@ -2102,61 +1532,61 @@ static void OGLES2_glGenerateMipmap(struct OGLES2IFace *Self, GLenum target)
 
 static void OGLES2_glGenFramebuffers(struct OGLES2IFace *Self, GLsizei n, GLuint * framebuffers)
 {
-    GET_CONTEXT
+    GET_CONTEXT(GenFramebuffers, n, framebuffers)
 
-    logLine("%s: %s: n %u, framebuffers %p", context->name, __func__,
+    traceLine("%s: %s: n %u, framebuffers %p", context->name, __func__,
         n, framebuffers);
 
     GL_CALL(GenFramebuffers, n, framebuffers)
 
     GLsizei i;
     for (i = 0; i < n; i++) {
-        logLine("Framebuffer[%u] = %u", i, framebuffers[i]);
+        traceLine("Framebuffer[%u] = %u", i, framebuffers[i]);
     }
 }
 
 static void OGLES2_glGenRenderbuffers(struct OGLES2IFace *Self, GLsizei n, GLuint * renderbuffers)
 {
-    GET_CONTEXT
+    GET_CONTEXT(GenRenderbuffers, n, renderbuffers)
 
-    logLine("%s: %s: n %u, renderbuffers %p", context->name, __func__,
+    traceLine("%s: %s: n %u, renderbuffers %p", context->name, __func__,
         n, renderbuffers);
 
     GL_CALL(GenRenderbuffers, n, renderbuffers)
 
     GLsizei i;
     for (i = 0; i < n; i++) {
-        logLine("Renderbuffer[%u] = %u", i, renderbuffers[i]);
+        traceLine("Renderbuffer[%u] = %u", i, renderbuffers[i]);
     }
 }
 
 static void OGLES2_glGenTextures(struct OGLES2IFace *Self, GLsizei n, GLuint * textures)
 {
-    GET_CONTEXT
+    GET_CONTEXT(GenTextures, n, textures)
 
-    logLine("%s: %s: n %d, textures %p", context->name, __func__,
+    traceLine("%s: %s: n %d, textures %p", context->name, __func__,
         n, textures);
 
     GL_CALL(GenTextures, n, textures)
 
     GLsizei i;
     for (i = 0; i < n; i++) {
-        logLine("Texture[%u] = %u", i, textures[i]);
+        traceLine("Texture[%u] = %u", i, textures[i]);
     }
 }
 
 static void OGLES2_glGetActiveAttrib(struct OGLES2IFace *Self, GLuint program, GLuint index, GLsizei bufSize, GLsizei * length, GLint * size, GLenum * type, GLchar * name)
 {
-    GET_CONTEXT
+    GET_CONTEXT(GetActiveAttrib, program, index, bufSize, length, size, type, name)
 
     GLsizei tempLength = 0;
 
-    logLine("%s: %s: program %u, index %u, bufSize %u, length %p, size %p, type %p, name %p", context->name, __func__,
+    traceLine("%s: %s: program %u, index %u, bufSize %u, length %p, size %p, type %p, name %p", context->name, __func__,
         program, index, bufSize, length, size, type, name);
 
     GL_CALL(GetActiveAttrib, program, index, bufSize, &tempLength, size, type, name)
 
-    logLine("%s: %s: <- length %u, size %d, type 0x%X (%s), name '%s'", context->name, __func__,
+    traceLine("%s: %s: <- length %u, size %d, type 0x%X (%s), name '%s'", context->name, __func__,
         tempLength, *size,
         *type, decodeValue(*type),
         name);
@@ -2168,16 +1598,16 @@ static void OGLES2_glGetActiveAttrib(struct OGLES2IFace *Self, GLuint program, G
 
 static void OGLES2_glGetActiveUniform(struct OGLES2IFace *Self, GLuint program, GLuint index, GLsizei bufSize, GLsizei * length, GLint * size, GLenum * type, GLchar * name)
 {
-    GET_CONTEXT
+    GET_CONTEXT(GetActiveUniform, program, index, bufSize, length, size, type, name)
 
     GLsizei tempLength = 0;
 
-    logLine("%s: %s: program %u, index %u, bufSize %u, length %p, size %p, type %p, name %p", context->name, __func__,
+    traceLine("%s: %s: program %u, index %u, bufSize %u, length %p, size %p, type %p, name %p", context->name, __func__,
         program, index, bufSize, length, size, type, name);
 
     GL_CALL(GetActiveUniform, program, index, bufSize, &tempLength, size, type, name)
 
-    logLine("%s: %s: <- length %u, size %d, type 0x%X (%s), name '%s'", context->name, __func__,
+    traceLine("%s: %s: <- length %u, size %d, type 0x%X (%s), name '%s'", context->name, __func__,
         tempLength, *size,
         *type, decodeValue(*type),
         name);
@@ -2189,9 +1619,9 @@ static void OGLES2_glGetActiveUniform(struct OGLES2IFace *Self, GLuint program,
 
 static void OGLES2_glGetAttachedShaders(struct OGLES2IFace *Self, GLuint program, GLsizei maxCount, GLsizei * count, GLuint * shaders)
 {
-    GET_CONTEXT
+    GET_CONTEXT(GetAttachedShaders, program, maxCount, count, shaders)
 
-    logLine("%s: %s: program %u, maxCount %u, count %p, shaders %p", context->name, __func__,
+    traceLine("%s: %s: program %u, maxCount %u, count %p, shaders %p", context->name, __func__,
         program, maxCount, count, shaders);
 
     GLsizei tempCount = 0;
@@ -2200,7 +1630,7 @@ static void OGLES2_glGetAttachedShaders(struct OGLES2IFace *Self, GLuint program
 
     GLsizei i;
     for (i = 0; i < tempCount; i++) {
-        logLine("shader[%u] = %u", i, shaders[i]);
+        traceLine("shader[%u] = %u", i, shaders[i]);
     }
 
     if (count) {
@@ -2210,16 +1640,16 @@ static void OGLES2_glGetAttachedShaders(struct OGLES2IFace *Self, GLuint program
 
 static GLint OGLES2_glGetAttribLocation(struct OGLES2IFace *Self, GLuint program, const GLchar * name)
 {
-    GET_CONTEXT
+    GET_CONTEXT(GetAttribLocation, program, name)
 
     GLint status = 0;
 
-    logLine("%s: %s: program %u, name '%s'", context->name, __func__,
+    traceLine("%s: %s: program %u, name '%s'", context->name, __func__,
         program, name);
 
     GL_CALL_STATUS(GetAttribLocation, program, name)
 
-    logLine("%s: %s: <- location %d", context->name, __func__,
+    traceLine("%s: %s: <- location %d", context->name, __func__,
         status);
 
     return status;
@@ -2227,60 +1657,60 @@ static GLint OGLES2_glGetAttribLocation(struct OGLES2IFace *Self, GLuint program
 
 static void OGLES2_glGetBooleanv(struct OGLES2IFace *Self, GLenum pname, GLboolean * data)
 {
-    GET_CONTEXT
+    GET_CONTEXT(GetBooleanv, pname, data)
 
-    logLine("%s: %s: pname 0x%X (%s), data %p", context->name, __func__,
+    traceLine("%s: %s: pname 0x%X (%s), data %p", context->name, __func__,
         pname, decodeValue(pname),
         data);
 
     GL_CALL(GetBooleanv, pname, data)
 
-    logLine("%s: %s: <- data %d", context->name, __func__,
+    traceLine("%s: %s: <- data %d", context->name, __func__,
         *data);
 }
 
 static void OGLES2_glGetBufferParameteriv(struct OGLES2IFace *Self, GLenum target, GLenum pname, GLint * params)
 {
-    GET_CONTEXT
+    GET_CONTEXT(GetBufferParameteriv, target, pname, params)
 
-    logLine("%s: %s: target 0x%X (%s), pname 0x%X (%s), params %p", context->name, __func__,
+    traceLine("%s: %s: target 0x%X (%s), pname 0x%X (%s), params %p", context->name, __func__,
         target, decodeValue(target),
         pname, decodeValue(pname),
         params);
 
     GL_CALL(GetBufferParameteriv, target, pname, params)
 
-    logLine("%s: %s: <- params %d", context->name, __func__,
+    traceLine("%s: %s: <- params %d", context->name, __func__,
         *params);
 }
 
 static void OGLES2_glGetBufferParameterivOES(struct OGLES2IFace *Self, GLenum target, GLenum value, GLint *data)
 {
-    GET_CONTEXT
+    GET_CONTEXT(GetBufferParameterivOES, target, value, data)
 
-    logLine("%s: %s: target 0x%X (%s), value 0x%X (%s), data %p", context->name, __func__,
+    traceLine("%s: %s: target 0x%X (%s), value 0x%X (%s), data %p", context->name, __func__,
         target, decodeValue(target),
         value, decodeValue(value),
         data);
 
     GL_CALL(GetBufferParameterivOES, target, value, data)
 
-    logLine("%s: %s: <- data %d", context->name, __func__,
+    traceLine("%s: %s: <- data %d", context->name, __func__,
         *data);
 }
 
 static void OGLES2_glGetBufferPointervOES(struct OGLES2IFace *Self, GLenum target, GLenum pname, void **params)
 {
-    GET_CONTEXT
+    GET_CONTEXT(GetBufferPointervOES, target, pname, params)
 
-    logLine("%s: %s: target 0x%X (%s), pname 0x%X (%s), params %p", context->name, __func__,
+    traceLine("%s: %s: target 0x%X (%s), pname 0x%X (%s), params %p", context->name, __func__,
         target, decodeValue(target),
         pname, decodeValue(pname),
         params);
 
     GL_CALL(GetBufferPointervOES, target, pname, params)
 
-    logLine("%s: %s: <- params %p", context->name, __func__,
+    traceLine("%s: %s: <- params %p", context->name, __func__,
         *params);
 
     checkPointer(context, GetBufferPointervOES, *params);
@@ -2288,7 +1718,7 @@ static void OGLES2_glGetBufferPointervOES(struct OGLES2IFace *Self, GLenum targe
 
 static GLenum OGLES2_glGetError(struct OGLES2IFace *Self)
 {
-    GET_CONTEXT
+    GET_CONTEXT(GetError)
 
     GLenum status = GL_NO_ERROR;
 
@@ -2299,7 +1729,7 @@ static GLenum OGLES2_glGetError(struct OGLES2IFace *Self)
         status = context->errors[context->errorRead];
     }
 
-    logLine("%s: %s: <- error 0x%X (%s)", context->name, __func__,
+    traceLine("%s: %s: <- error 0x%X (%s)", context->name, __func__,
         status, (status == GL_NO_ERROR) ? "GL_NO_ERROR" : mapOgles2Error(status));
 
     return status;
@@ -2307,23 +1737,23 @@ static GLenum OGLES2_glGetError(struct OGLES2IFace *Self)
 
 static void OGLES2_glGetFloatv(struct OGLES2IFace *Self, GLenum pname, GLfloat * data)
 {
-    GET_CONTEXT
+    GET_CONTEXT(GetFloatv, pname, data)
 
-    logLine("%s: %s: pname 0x%X (%s), data %p", context->name, __func__,
+    traceLine("%s: %s: pname 0x%X (%s), data %p", context->name, __func__,
         pname, decodeValue(pname),
         data);
 
     GL_CALL(GetFloatv, pname, data)
 
-    logLine("%s: %s: <- data %f", context->name, __func__,
+    traceLine("%s: %s: <- data %f", context->name, __func__,
         *data);
 }
 
 static void OGLES2_glGetFramebufferAttachmentParameteriv(struct OGLES2IFace *Self, GLenum target, GLenum attachment, GLenum pname, GLint * params)
 {
-    GET_CONTEXT
+    GET_CONTEXT(GetFramebufferAttachmentParameteriv, target, attachment, pname, params)
 
-    logLine("%s: %s: target 0x%X (%s), attachment 0x%X (%s), pname 0x%X (%s), params %p", context->name, __func__,
+    traceLine("%s: %s: target 0x%X (%s), attachment 0x%X (%s), pname 0x%X (%s), params %p", context->name, __func__,
         target, decodeValue(target),
         attachment, decodeValue(attachment),
         pname, decodeValue(pname),
@@ -2331,36 +1761,36 @@ static void OGLES2_glGetFramebufferAttachmentParameteriv(struct OGLES2IFace *Sel
 
     GL_CALL(GetFramebufferAttachmentParameteriv, target, attachment, pname, params)
 
-    logLine("%s: %s: <- params %d", context->name, __func__,
+    traceLine("%s: %s: <- params %d", context->name, __func__,
         *params);
 }
 
 static void OGLES2_glGetIntegerv(struct OGLES2IFace *Self, GLenum pname, GLint * data)
 {
-    GET_CONTEXT
+    GET_CONTEXT(GetIntegerv, pname, data)
 
-    logLine("%s: %s: pname 0x%X (%s), data %p", context->name, __func__,
+    traceLine("%s: %s: pname 0x%X (%s), data %p", context->name, __func__,
         pname, decodeValue(pname),
         data);
 
     GL_CALL(GetIntegerv, pname, data)
 
-    logLine("%s: %s: <- data %d", context->name, __func__,
+    traceLine("%s: %s: <- data %d", context->name, __func__,
         *data);
 }
 
 static void OGLES2_glGetProgramBinaryOES(struct OGLES2IFace *Self, GLuint program, GLsizei bufSize, GLsizei *length, GLenum *binaryFormat, void *binary)
 {
-    GET_CONTEXT
+    GET_CONTEXT(GetProgramBinaryOES, program, bufSize, length, binaryFormat, binary)
 
     GLsizei tempLength = 0;
 
-    logLine("%s: %s: program %u, bufSize %u, length %p, binaryFormat %p, binary %p", context->name, __func__,
+    traceLine("%s: %s: program %u, bufSize %u, length %p, binaryFormat %p, binary %p", context->name, __func__,
         program, bufSize, length, binaryFormat, binary);
 
     GL_CALL(GetProgramBinaryOES, program, bufSize, &tempLength, binaryFormat, binary)
 
-    logLine("%s: %s: <- length %u, binaryFormat 0x%X (%s)", context->name, __func__,
+    traceLine("%s: %s: <- length %u, binaryFormat 0x%X (%s)", context->name, __func__,
         tempLength,
         *binaryFormat, decodeValue(*binaryFormat));
 
@@ -2371,31 +1801,31 @@ static void OGLES2_glGetProgramBinaryOES(struct OGLES2IFace *Self, GLuint progra
 
 static void OGLES2_glGetProgramiv(struct OGLES2IFace *Self, GLuint program, GLenum pname, GLint * params)
 {
-    GET_CONTEXT
+    GET_CONTEXT(GetProgramiv, program, pname, params)
 
-    logLine("%s: %s: program %u, pname 0x%X (%s), params %p", context->name, __func__,
+    traceLine("%s: %s: program %u, pname 0x%X (%s), params %p", context->name, __func__,
         program,
         pname, decodeValue(pname),
         params);
 
     GL_CALL(GetProgramiv, program, pname, params)
 
-    logLine("%s: %s: <- params %d", context->name, __func__,
+    traceLine("%s: %s: <- params %d", context->name, __func__,
         *params);
 }
 
 static void OGLES2_glGetProgramInfoLog(struct OGLES2IFace *Self, GLuint program, GLsizei bufSize, GLsizei * length, GLchar * infoLog)
 {
-    GET_CONTEXT
+    GET_CONTEXT(GetProgramInfoLog, program, bufSize, length, infoLog)
 
     GLsizei tempLength = 0;
 
-    logLine("%s: %s: program %u, bufSize %u, length %p, infoLog %p", context->name, __func__,
+    traceLine("%s: %s: program %u, bufSize %u, length %p, infoLog %p", context->name, __func__,
         program, bufSize, length, infoLog);
 
     GL_CALL(GetProgramInfoLog, program, bufSize, &tempLength, infoLog)
 
-    logLine("%s: %s: <- length %u, infoLog '%s'", context->name, __func__,
+    traceLine("%s: %s: <- length %u, infoLog '%s'", context->name, __func__,
         tempLength, infoLog);
 
     if (length) {
@@ -2405,46 +1835,46 @@ static void OGLES2_glGetProgramInfoLog(struct OGLES2IFace *Self, GLuint program,
 
 static void OGLES2_glGetRenderbufferParameteriv(struct OGLES2IFace *Self, GLenum target, GLenum pname, GLint * params)
 {
-    GET_CONTEXT
+    GET_CONTEXT(GetRenderbufferParameteriv, target, pname, params)
 
-    logLine("%s: %s: target 0x%X (%s), pname 0x%X (%s), params %p", context->name, __func__,
+    traceLine("%s: %s: target 0x%X (%s), pname 0x%X (%s), params %p", context->name, __func__,
         target, decodeValue(target),
         pname, decodeValue(pname),
         params);
 
     GL_CALL(GetRenderbufferParameteriv, target, pname, params)
 
-    logLine("%s: %s: <- params %d", context->name, __func__,
+    traceLine("%s: %s: <- params %d", context->name, __func__,
         *params);
 }
 
 static void OGLES2_glGetShaderiv(struct OGLES2IFace *Self, GLuint shader, GLenum pname, GLint * params)
 {
-    GET_CONTEXT
+    GET_CONTEXT(GetShaderiv, shader, pname, params)
 
-    logLine("%s: %s: shader %u, pname 0x%X (%s), params %p", context->name, __func__,
+    traceLine("%s: %s: shader %u, pname 0x%X (%s), params %p", context->name, __func__,
         shader,
         pname, decodeValue(pname),
         params);
 
     GL_CALL(GetShaderiv, shader, pname, params)
 
-    logLine("%s: %s: <- params %d", context->name, __func__,
+    traceLine("%s: %s: <- params %d", context->name, __func__,
         *params);
 }
 
 static void OGLES2_glGetShaderInfoLog(struct OGLES2IFace *Self, GLuint shader, GLsizei bufSize, GLsizei * length, GLchar * infoLog)
 {
-    GET_CONTEXT
+    GET_CONTEXT(GetShaderInfoLog, shader, bufSize, length, infoLog)
 
     GLsizei tempLength = 0;
 
-    logLine("%s: %s: shader %u, bufSize %u, length %p, infoLog %p", context->name, __func__,
+    traceLine("%s: %s: shader %u, bufSize %u, length %p, infoLog %p", context->name, __func__,
         shader, bufSize, length, infoLog);
 
     GL_CALL(GetShaderInfoLog, shader, bufSize, &tempLength, infoLog)
 
-    logLine("%s: %s: <- length %u, infoLog '%s'", context->name, __func__,
+    traceLine("%s: %s: <- length %u, infoLog '%s'", context->name, __func__,
         tempLength, infoLog);
 
     if (length) {
@@ -2454,31 +1884,31 @@ static void OGLES2_glGetShaderInfoLog(struct OGLES2IFace *Self, GLuint shader, G
 
 static void OGLES2_glGetShaderPrecisionFormat(struct OGLES2IFace *Self, GLenum shadertype, GLenum precisiontype, GLint * range, GLint * precision)
 {
-    GET_CONTEXT
+    GET_CONTEXT(GetShaderPrecisionFormat, shadertype, precisiontype, range, precision)
 
-    logLine("%s: %s: shadertype 0x%X (%s), precisiontype 0x%X (%s), range %p, precision %p", context->name, __func__,
+    traceLine("%s: %s: shadertype 0x%X (%s), precisiontype 0x%X (%s), range %p, precision %p", context->name, __func__,
         shadertype, decodeValue(shadertype),
         precisiontype, decodeValue(precisiontype),
         range, precision);
 
     GL_CALL(GetShaderPrecisionFormat, shadertype, precisiontype, range, precision)
 
-    logLine("%s: %s: <- range [%d, %d], precision %d", context->name, __func__,
+    traceLine("%s: %s: <- range [%d, %d], precision %d", context->name, __func__,
         range[0], range[1], *precision);
 }
 
 static void OGLES2_glGetShaderSource(struct OGLES2IFace *Self, GLuint shader, GLsizei bufSize, GLsizei * length, GLchar * source)
 {
-    GET_CONTEXT
+    GET_CONTEXT(GetShaderSource, shader, bufSize, length, source)
 
     GLsizei tempLength = 0;
 
-    logLine("%s: %s: shader %u, bufSize %u, length %p, source %p", context->name, __func__,
+    traceLine("%s: %s: shader %u, bufSize %u, length %p, source %p", context->name, __func__,
         shader, bufSize, length, source);
 
     GL_CALL(GetShaderSource, shader, bufSize, &tempLength, source)
 
-    logLine("%s: %s: <- length %u, source '%s'", context->name, __func__,
+    traceLine("%s: %s: <- length %u, source '%s'", context->name, __func__,
         tempLength, source);
 
     if (length) {
@@ -2488,16 +1918,16 @@ static void OGLES2_glGetShaderSource(struct OGLES2IFace *Self, GLuint shader, GL
 
 static const GLubyte * OGLES2_glGetString(struct OGLES2IFace *Self, GLenum name)
 {
-    GET_CONTEXT
+    GET_CONTEXT(GetString, name)
 
     const GLubyte *status = NULL;
 
-    logLine("%s: %s: name 0x%X (%s)", context->name, __func__,
+    traceLine("%s: %s: name 0x%X (%s)", context->name, __func__,
         name, decodeValue(name));
 
     GL_CALL_STATUS(GetString, name)
 
-    logLine("%s: %s: <- string '%s'", context->name, __func__,
+    traceLine("%s: %s: <- string '%s'", context->name, __func__,
         status);
 
     return status;
@@ -2505,72 +1935,72 @@ static const GLubyte * OGLES2_glGetString(struct OGLES2IFace *Self, GLenum name)
 
 static void OGLES2_glGetTexParameterfv(struct OGLES2IFace *Self, GLenum target, GLenum pname, GLfloat * params)
 {
-    GET_CONTEXT
+    GET_CONTEXT(GetTexParameterfv, target, pname, params)
 
-    logLine("%s: %s: target 0x%X (%s), pname 0x%X (%s), params %p", context->name, __func__,
+    traceLine("%s: %s: target 0x%X (%s), pname 0x%X (%s), params %p", context->name, __func__,
         target, decodeValue(target),
         pname, decodeValue(pname),
         params);
 
     GL_CALL(GetTexParameterfv, target, pname, params)
 
-    logLine("%s: %s: <- params %f", context->name, __func__,
+    traceLine("%s: %s: <- params %f", context->name, __func__,
         *params);
 }
 
 static void OGLES2_glGetTexParameteriv(struct OGLES2IFace *Self, GLenum target, GLenum pname, GLint * params)
 {
-    GET_CONTEXT
+    GET_CONTEXT(GetTexParameteriv, target, pname, params)
 
-    logLine("%s: %s: target 0x%X (%s), pname 0x%X (%s), params %p", context->name, __func__,
+    traceLine("%s: %s: target 0x%X (%s), pname 0x%X (%s), params %p", context->name, __func__,
         target, decodeValue(target),
         pname, decodeValue(pname),
         params);
 
     GL_CALL(GetTexParameteriv, target, pname, params)
 
-    logLine("%s: %s: <- params %d", context->name, __func__,
+    traceLine("%s: %s: <- params %d", context->name, __func__,
         *params);
 }
 
 static void OGLES2_glGetUniformfv(struct OGLES2IFace *Self, GLuint program, GLint location, GLfloat * params)
 {
-    GET_CONTEXT
+    GET_CONTEXT(GetUniformfv, program, location, params)
 
-    logLine("%s: %s: program %u, location %u, params %p", context->name, __func__,
+    traceLine("%s: %s: program %u, location %u, params %p", context->name, __func__,
         program, location, params);
 
     GL_CALL(GetUniformfv, program, location, params)
 
-    logLine("%s: %s: <- params %f", context->name, __func__,
+    traceLine("%s: %s: <- params %f", context->name, __func__,
         *params);
 }
 
 static void OGLES2_glGetUniformiv(struct OGLES2IFace *Self, GLuint program, GLint location, GLint * params)
 {
-    GET_CONTEXT
+    GET_CONTEXT(GetUniformiv, program, location, params)
 
-    logLine("%s: %s: program %u, location %u, params %p", context->name, __func__,
+    traceLine("%s: %s: program %u, location %u, params %p", context->name, __func__,
         program, location, params);
 
     GL_CALL(GetUniformiv, program, location, params)
 
-    logLine("%s: %s: <- params %d", context->name, __func__,
+    traceLine("%s: %s: <- params %d", context->name, __func__,
         *params);
 }
 
 static GLint OGLES2_glGetUniformLocation(struct OGLES2IFace *Self, GLuint program, const GLchar * name)
 {
-    GET_CONTEXT
+    GET_CONTEXT(GetUniformLocation, program, name)
 
     GLint status = 0;
 
-    logLine("%s: %s: program %u, name '%s'", context->name, __func__,
+    traceLine("%s: %s: program %u, name '%s'", context->name, __func__,
         program, name);
 
     GL_CALL_STATUS(GetUniformLocation, program, name)
 
-    logLine("%s: %s: <- location %d", context->name, __func__,
+    traceLine("%s: %s: <- location %d", context->name, __func__,
         status);
 
     return status;
@@ -2578,54 +2008,54 @@ static GLint OGLES2_glGetUniformLocation(struct OGLES2IFace *Self, GLuint progra
 
 static void OGLES2_glGetVertexAttribfv(struct OGLES2IFace *Self, GLuint index, GLenum pname, GLfloat * params)
 {
-    GET_CONTEXT
+    GET_CONTEXT(GetVertexAttribfv, index, pname, params)
 
-    logLine("%s: %s: index %u, pname 0x%X (%s), params %p", context->name, __func__,
+    traceLine("%s: %s: index %u, pname 0x%X (%s), params %p", context->name, __func__,
         index,
         pname, decodeValue(pname),
         params);
 
     GL_CALL(GetVertexAttribfv, index, pname, params)
 
-    logLine("%s: %s: <- params %f", context->name, __func__,
+    traceLine("%s: %s: <- params %f", context->name, __func__,
         *params);
 }
 
 static void OGLES2_glGetVertexAttribiv(struct OGLES2IFace *Self, GLuint index, GLenum pname, GLint * params)
 {
-    GET_CONTEXT
+    GET_CONTEXT(GetVertexAttribiv, index, pname, params)
 
-    logLine("%s: %s: index %u, pname 0x%X (%s), params %p", context->name, __func__,
+    traceLine("%s: %s: index %u, pname 0x%X (%s), params %p", context->name, __func__,
         index,
         pname, decodeValue(pname),
         params);
 
     GL_CALL(GetVertexAttribiv, index, pname, params)
 
-    logLine("%s: %s: <- params %d", context->name, __func__,
+    traceLine("%s: %s: <- params %d", context->name, __func__,
         *params);
 }
 
 static void OGLES2_glGetVertexAttribPointerv(struct OGLES2IFace *Self, GLuint index, GLenum pname, void ** pointer)
 {
-    GET_CONTEXT
+    GET_CONTEXT(GetVertexAttribPointerv, index, pname, pointer)
 
-    logLine("%s: %s: index %u, pname 0x%X (%s), pointer %p", context->name, __func__,
+    traceLine("%s: %s: index %u, pname 0x%X (%s), pointer %p", context->name, __func__,
         index,
         pname, decodeValue(pname),
         pointer);
 
     GL_CALL(GetVertexAttribPointerv, index, pname, pointer)
 
-    logLine("%s: %s: <- pointer %p", context->name, __func__,
+    traceLine("%s: %s: <- pointer %p", context->name, __func__,
         *pointer);
 }
 
 static void OGLES2_glHint(struct OGLES2IFace *Self, GLenum target, GLenum mode)
 {
-    GET_CONTEXT
+    GET_CONTEXT(Hint, target, mode)
 
-    logLine("%s: %s: target 0x%X (%s), mode 0x%X (%s)", context->name, __func__,
+    traceLine("%s: %s: target 0x%X (%s), mode 0x%X (%s)", context->name, __func__,
         target, decodeValue(target),
         mode, decodeValue(mode));
 
@@ -2634,16 +2064,16 @@ static void OGLES2_glHint(struct OGLES2IFace *Self, GLenum target, GLenum mode)
 
 static GLboolean OGLES2_glIsBuffer(struct OGLES2IFace *Self, GLuint buffer)
 {
-    GET_CONTEXT
+    GET_CONTEXT(IsBuffer, buffer)
 
     GLboolean status = GL_FALSE;
 
-    logLine("%s: %s: buffer %u", context->name, __func__,
+    traceLine("%s: %s: buffer %u", context->name, __func__,
         buffer);
 
     GL_CALL_STATUS(IsBuffer, buffer)
 
-    logLine("%s: %s: <- result %d", context->name, __func__,
+    traceLine("%s: %s: <- result %d", context->name, __func__,
         status);
 
     return status;
@@ -2651,16 +2081,16 @@ static GLboolean OGLES2_glIsBuffer(struct OGLES2IFace *Self, GLuint buffer)
 
 static GLboolean OGLES2_glIsEnabled(struct OGLES2IFace *Self, GLenum cap)
 {
-    GET_CONTEXT
+    GET_CONTEXT(IsEnabled, cap)
 
     GLboolean status = GL_FALSE;
 
-    logLine("%s: %s: cap 0x%X (%s)", context->name, __func__,
+    traceLine("%s: %s: cap 0x%X (%s)", context->name, __func__,
         cap, decodeValue(cap));
 
     GL_CALL_STATUS(IsEnabled, cap)
 
-    logLine("%s: %s: <- result %d", context->name, __func__,
+    traceLine("%s: %s: <- result %d", context->name, __func__,
         status);
 
     return status;
@@ -2668,16 +2098,16 @@ static GLboolean OGLES2_glIsEnabled(struct OGLES2IFace *Self, GLenum cap)
 
 static GLboolean OGLES2_glIsFramebuffer(struct OGLES2IFace *Self, GLuint framebuffer)
 {
-    GET_CONTEXT
+    GET_CONTEXT(IsFramebuffer, framebuffer)
 
     GLboolean status = GL_FALSE;
 
-    logLine("%s: %s: framebuffer %u", context->name, __func__,
+    traceLine("%s: %s: framebuffer %u", context->name, __func__,
         framebuffer);
 
     GL_CALL_STATUS(IsFramebuffer, framebuffer)
 
-    logLine("%s: %s: <- result %d", context->name, __func__,
+    traceLine("%s: %s: <- result %d", context->name, __func__,
         status);
 
     return status;
@@ -2685,16 +2115,16 @@ static GLboolean OGLES2_glIsFramebuffer(struct OGLES2IFace *Self, GLuint framebu
 
 static GLboolean OGLES2_glIsProgram(struct OGLES2IFace *Self, GLuint program)
 {
-    GET_CONTEXT
+    GET_CONTEXT(IsProgram, program)
 
     GLboolean status = GL_FALSE;
 
-    logLine("%s: %s: program %u", context->name, __func__,
+    traceLine("%s: %s: program %u", context->name, __func__,
         program);
 
     GL_CALL_STATUS(IsProgram, program)
 
-    logLine("%s: %s: <- result %d", context->name, __func__,
+    traceLine("%s: %s: <- result %d", context->name, __func__,
         status);
 
     return status;
@@ -2702,16 +2132,16 @@ static GLboolean OGLES2_glIsProgram(struct OGLES2IFace *Self, GLuint program)
 
 static GLboolean OGLES2_glIsRenderbuffer(struct OGLES2IFace *Self, GLuint renderbuffer)
 {
-    GET_CONTEXT
+    GET_CONTEXT(IsRenderbuffer, renderbuffer)
 
     GLboolean status = GL_FALSE;
 
-    logLine("%s: %s: renderbuffer %u", context->name, __func__,
+    traceLine("%s: %s: renderbuffer %u", context->name, __func__,
         renderbuffer);
 
     GL_CALL_STATUS(IsRenderbuffer, renderbuffer)
 
-    logLine("%s: %s: <- result %d", context->name, __func__,
+    traceLine("%s: %s: <- result %d", context->name, __func__,
         status);
 
     return status;
@@ -2719,16 +2149,16 @@ static GLboolean OGLES2_glIsRenderbuffer(struct OGLES2IFace *Self, GLuint render
 
 static GLboolean OGLES2_glIsShader(struct OGLES2IFace *Self, GLuint shader)
 {
-    GET_CONTEXT
+    GET_CONTEXT(IsShader, shader)
 
     GLboolean status = GL_FALSE;
 
-    logLine("%s: %s: shader %u", context->name, __func__,
+    traceLine("%s: %s: shader %u", context->name, __func__,
         shader);
 
     GL_CALL_STATUS(IsShader, shader)
 
-    logLine("%s: %s: <- result %d", context->name, __func__,
+    traceLine("%s: %s: <- result %d", context->name, __func__,
         status);
 
     return status;
@@ -2736,16 +2166,16 @@ static GLboolean OGLES2_glIsShader(struct OGLES2IFace *Self, GLuint shader)
 
 static GLboolean OGLES2_glIsTexture(struct OGLES2IFace *Self, GLuint texture)
 {
-    GET_CONTEXT
+    GET_CONTEXT(IsTexture, texture)
 
     GLboolean status = GL_FALSE;
 
-    logLine("%s: %s: texture %u", context->name, __func__,
+    traceLine("%s: %s: texture %u", context->name, __func__,
         texture);
 
     GL_CALL_STATUS(IsTexture, texture)
 
-    logLine("%s: %s: <- result %d", context->name, __func__,
+    traceLine("%s: %s: <- result %d", context->name, __func__,
         status);
 
     return status;
@@ -2753,9 +2183,9 @@ static GLboolean OGLES2_glIsTexture(struct OGLES2IFace *Self, GLuint texture)
 
 static void OGLES2_glLineWidth(struct OGLES2IFace *Self, GLfloat width)
 {
-    GET_CONTEXT
+    GET_CONTEXT(LineWidth, width)
 
-    logLine("%s: %s: width %f", context->name, __func__,
+    traceLine("%s: %s: width %f", context->name, __func__,
         width);
 
     GL_CALL(LineWidth, width)
@@ -2763,9 +2193,9 @@ static void OGLES2_glLineWidth(struct OGLES2IFace *Self, GLfloat width)
 
 static void OGLES2_glLinkProgram(struct OGLES2IFace *Self, GLuint program)
 {
-    GET_CONTEXT
+    GET_CONTEXT(LinkProgram, program)
 
-    logLine("%s: %s: program %u", context->name, __func__,
+    traceLine("%s: %s: program %u", context->name, __func__,
         program);
 
     GL_CALL(LinkProgram, program)
@@ -2773,17 +2203,17 @@ static void OGLES2_glLinkProgram(struct OGLES2IFace *Self, GLuint program)
 
 static void* OGLES2_glMapBufferOES(struct OGLES2IFace *Self, GLenum target, GLenum access)
 {
-    GET_CONTEXT
+    GET_CONTEXT(MapBufferOES, target, access)
 
     void* status = NULL;
 
-    logLine("%s: %s: target 0x%X (%s), access 0x%X (%s)", context->name, __func__,
+    traceLine("%s: %s: target 0x%X (%s), access 0x%X (%s)", context->name, __func__,
         target, decodeValue(target),
         access, decodeValue(access));
 
     GL_CALL_STATUS(MapBufferOES, target, access)
 
-    logLine("%s: %s: <- address %p", context->name, __func__,
+    traceLine("%s: %s: <- address %p", context->name, __func__,
         status);
 
     checkPointer(context, MapBufferOES, status);
@@ -2793,9 +2223,9 @@ static void* OGLES2_glMapBufferOES(struct OGLES2IFace *Self, GLenum target, GLen
 
 static void OGLES2_glPixelStorei(struct OGLES2IFace *Self, GLenum pname, GLint param)
 {
-    GET_CONTEXT
+    GET_CONTEXT(PixelStorei, pname, param)
 
-    logLine("%s: %s: pname 0x%X (%s), param %d", context->name, __func__,
+    traceLine("%s: %s: pname 0x%X (%s), param %d", context->name, __func__,
         pname, decodeValue(pname),
         param);
 
@@ -2804,9 +2234,9 @@ static void OGLES2_glPixelStorei(struct OGLES2IFace *Self, GLenum pname, GLint p
 
 static void OGLES2_glPolygonMode(struct OGLES2IFace *Self, GLenum face, GLenum mode)
 {
-    GET_CONTEXT
+    GET_CONTEXT(PolygonMode, face, mode)
 
-    logLine("%s: %s: face 0x%X (%s), mode 0x%X (%s)", context->name, __func__,
+    traceLine("%s: %s: face 0x%X (%s), mode 0x%X (%s)", context->name, __func__,
         face, decodeValue(face),
         mode, decodeValue(mode));
 
@@ -2815,9 +2245,9 @@ static void OGLES2_glPolygonMode(struct OGLES2IFace *Self, GLenum face, GLenum m
 
 static void OGLES2_glPolygonOffset(struct OGLES2IFace *Self, GLfloat factor, GLfloat units)
 {
-    GET_CONTEXT
+    GET_CONTEXT(PolygonOffset, factor, units)
 
-    logLine("%s: %s: factor %f, units %f", context->name, __func__,
+    traceLine("%s: %s: factor %f, units %f", context->name, __func__,
         factor, units);
 
     GL_CALL(PolygonOffset, factor, units)
@@ -2825,9 +2255,9 @@ static void OGLES2_glPolygonOffset(struct OGLES2IFace *Self, GLfloat factor, GLf
 
 static void OGLES2_glProgramBinaryOES(struct OGLES2IFace *Self, GLuint program, GLenum binaryFormat, const void *binary, GLint length)
 {
-    GET_CONTEXT
+    GET_CONTEXT(ProgramBinaryOES, program, binaryFormat, binary, length)
 
-    logLine("%s: %s: program %u, binaryFormat 0x%X (%s), binary %p, length %d", context->name, __func__,
+    traceLine("%s: %s: program %u, binaryFormat 0x%X (%s), binary %p, length %d", context->name, __func__,
         program,
         binaryFormat, decodeValue(binaryFormat),
         binary, length);
@@ -2837,9 +2267,9 @@ static void OGLES2_glProgramBinaryOES(struct OGLES2IFace *Self, GLuint program,
 
 static void OGLES2_glProvokingVertex(struct OGLES2IFace *Self, GLenum provokeMode)
 {
-    GET_CONTEXT
+    GET_CONTEXT(ProvokingVertex, provokeMode)
 
-    logLine("%s: %s: provokeMode 0x%X (%s)", context->name, __func__,
+    traceLine("%s: %s: provokeMode 0x%X (%s)", context->name, __func__,
         provokeMode, decodeValue(provokeMode));
 
     GL_CALL(ProvokingVertex, provokeMode)
@@ -2847,9 +2277,9 @@ static void OGLES2_glProvokingVertex(struct OGLES2IFace *Self, GLenum provokeMod
 
 static void OGLES2_glReadPixels(struct OGLES2IFace *Self, GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, void * pixels)
 {
-    GET_CONTEXT
+    GET_CONTEXT(ReadPixels, x, y, width, height, format, type, pixels)
 
-    logLine("%s: %s: x %d, y %d, width %u, height %u, format 0x%X (%s), type 0x%X (%s), pixels %p", context->name, __func__,
+    traceLine("%s: %s: x %d, y %d, width %u, height %u, format 0x%X (%s), type 0x%X (%s), pixels %p", context->name, __func__,
         x, y, width, height,
         format, decodeValue(format),
         type, decodeValue(type),
@@ -2860,18 +2290,18 @@ static void OGLES2_glReadPixels(struct OGLES2IFace *Self, GLint x, GLint y, GLsi
 
 static void OGLES2_glReleaseShaderCompiler(struct OGLES2IFace *Self)
 {
-    GET_CONTEXT
+    GET_CONTEXT(ReleaseShaderCompiler)
 
-    logLine("%s: %s", context->name, __func__);
+    traceLine("%s: %s", context->name, __func__);
 
     GL_CALL(ReleaseShaderCompiler)
 }
 
 static void OGLES2_glRenderbufferStorage(struct OGLES2IFace *Self, GLenum target, GLenum internalformat, GLsizei width, GLsizei height)
 {
-    GET_CONTEXT
+    GET_CONTEXT(RenderbufferStorage, target, internalformat, width, height)
 
-    logLine("%s: %s: target 0x%X (%s), internalformat 0x%X (%s), width %u, height %u", context->name, __func__,
+    traceLine("%s: %s: target 0x%X (%s), internalformat 0x%X (%s), width %u, height %u", context->name, __func__,
         target, decodeValue(target),
         internalformat, decodeValue(internalformat),
         width, height);
@@ -2881,9 +2311,9 @@ static void OGLES2_glRenderbufferStorage(struct OGLES2IFace *Self, GLenum target
 
 static void OGLES2_glSampleCoverage(struct OGLES2IFace *Self, GLfloat value, GLboolean invert)
 {
-    GET_CONTEXT
+    GET_CONTEXT(SampleCoverage, value, invert)
 
-    logLine("%s: %s: value %f, invert %d", context->name, __func__,
+    traceLine("%s: %s: value %f, invert %d", context->name, __func__,
         value, invert);
 
     GL_CALL(SampleCoverage, value, invert)
@@ -2891,9 +2321,9 @@ static void OGLES2_glSampleCoverage(struct OGLES2IFace *Self, GLfloat value, GLb
 
 static void OGLES2_glScissor(struct OGLES2IFace *Self, GLint x, GLint y, GLsizei width, GLsizei height)
 {
-    GET_CONTEXT
+    GET_CONTEXT(Scissor, x, y, width, height)
 
-    logLine("%s: %s: x %d, y %d, width %u, height %u", context->name, __func__,
+    traceLine("%s: %s: x %d, y %d, width %u, height %u", context->name, __func__,
         x, y, width, height);
 
     GL_CALL(Scissor, x, y, width, height)
@@ -2901,9 +2331,9 @@ static void OGLES2_glScissor(struct OGLES2IFace *Self, GLint x, GLint y, GLsizei
 
 static void OGLES2_glShaderBinary(struct OGLES2IFace *Self, GLsizei count, const GLuint * shaders, GLenum binaryformat, const void * binary, GLsizei length)
 {
-    GET_CONTEXT
+    GET_CONTEXT(ShaderBinary, count, shaders, binaryformat, binary, length)
 
-    logLine("%s: %s: count %u, shaders %p, binaryformat 0x%X (%s), binary %p, length %u", context->name, __func__,
+    traceLine("%s: %s: count %u, shaders %p, binaryformat 0x%X (%s), binary %p, length %u", context->name, __func__,
         count, shaders,
         binaryformat, decodeValue(binaryformat),
         binary, length);
@@ -2913,39 +2343,42 @@ static void OGLES2_glShaderBinary(struct OGLES2IFace *Self, GLsizei count, const
 
 static void OGLES2_glShaderSource(struct OGLES2IFace *Self, GLuint shader, GLsizei count, const GLchar *const* string, const GLint * length)
 {
-    GET_CONTEXT
+    GET_CONTEXT(ShaderSource, shader, count, string, length)
 
-    logLine("%s: %s: shader %u, count %u, string %p length %p", context->name, __func__,
+    traceLine("%s: %s: shader %u, count %u, string %p length %p", context->name, __func__,
         shader, count, string, length);
 
     GLsizei i;
 
-    if (length) {
-        for (i = 0; i < count; i++) {
-            if (length[i] < 0) {
-                // These should be NUL-terminated
-                logLine("Line %u: '%s'", i, string[i]);
-            } else if (length[i] == 0) {
-                logLine("Line %u: length 0:", i);
-            } else {
-                // Use temporary buffer to NUL-terminate strings
-                const size_t len = (size_t)length[i] + 1;
+    // Avoid the temporary allocations when tracing is paused
+    if (traced && logEnabled()) {
+        if (length) {
+            for (i = 0; i < count; i++) {
+                if (length[i] < 0) {
+                    // These should be NUL-terminated
+                    traceLine("Line %u: '%s'", i, string[i]);
+                } else if (length[i] == 0) {
+                    traceLine("Line %u: length 0:", i);
+                } else {
+                    // Use temporary buffer to NUL-terminate strings
+                    const size_t len = (size_t)length[i] + 1;
 
-                char* temp = IExec->AllocVecTags(len, TAG_DONE);
+                    char* temp = IExec->AllocVecTags(len, TAG_DONE);
 
-                if (temp) {
-                    snprintf(temp, len, "%s", string[i]);
-                    logLine("Line %u: length %d: '%s'", i, length[i], temp);
+                    if (temp) {
+                        snprintf(temp, len, "%s", string[i]);
+                        traceLine("Line %u: length %d: '%s'", i, length[i], temp);
 
-                    IExec->FreeVec(temp);
-                } else {
-                    logLine("Failed to allocate %u bytes", len);
+                        IExec->FreeVec(temp);
+                    } else {
+                        traceLine("Failed to allocate %u bytes", len);
+                    }
                 }
             }
-        }
-    } else {
-        for (i = 0; i < count; i++) {
-            logLine("Line %u: '%s'", i, string[i]);
+        } else {
+            for (i = 0; i < count; i++) {
+                traceLine("Line %u: '%s'", i, string[i]);
+            }
         }
     }
 
@@ -2954,9 +2387,9 @@ static void OGLES2_glShaderSource(struct OGLES2IFace *Self, GLuint shader, GLsiz
 
 static void OGLES2_glStencilFunc(struct OGLES2IFace *Self, GLenum func, GLint ref, GLuint mask)
 {
-    GET_CONTEXT
+    GET_CONTEXT(StencilFunc, func, ref, mask)
 
-    logLine("%s: %s: func 0x%X (%s), ref %d, mask %u", context->name, __func__,
+    traceLine("%s: %s: func 0x%X (%s), ref %d, mask %u", context->name, __func__,
         func, decodeValue(func),
         ref, mask);
 
@@ -2965,9 +2398,9 @@ static void OGLES2_glStencilFunc(struct OGLES2IFace *Self, GLenum func, GLint re
 
 static void OGLES2_glStencilFuncSeparate(struct OGLES2IFace *Self, GLenum face, GLenum func, GLint ref, GLuint mask)
 {
-    GET_CONTEXT
+    GET_CONTEXT(StencilFuncSeparate, face, func, ref, mask)
 
-    logLine("%s: %s: face 0x%X (%s), func 0x%X (%s), ref %d, mask %u", context->name, __func__,
+    traceLine("%s: %s: face 0x%X (%s), func 0x%X (%s), ref %d, mask %u", context->name, __func__,
         face, decodeValue(face),
         func, decodeValue(func),
         ref, mask);
@@ -2977,9 +2410,9 @@ static void OGLES2_glStencilFuncSeparate(struct OGLES2IFace *Self, GLenum face,
 
 static void OGLES2_glStencilMask(struct OGLES2IFace *Self, GLuint mask)
 {
-    GET_CONTEXT
+    GET_CONTEXT(StencilMask, mask)
 
-    logLine("%s: %s: mask %u", context->name, __func__,
+    traceLine("%s: %s: mask %u", context->name, __func__,
         mask);
 
     GL_CALL(StencilMask, mask)
@@ -2987,9 +2420,9 @@ static void OGLES2_glStencilMask(struct OGLES2IFace *Self, GLuint mask)
 
 static void OGLES2_glStencilMaskSeparate(struct OGLES2IFace *Self, GLenum face, GLuint mask)
 {
-    GET_CONTEXT
+    GET_CONTEXT(StencilMaskSeparate, face, mask)
 
-    logLine("%s: %s: face 0x%X (%s), mask %u", context->name, __func__,
+    traceLine("%s: %s: face 0x%X (%s), mask %u", context->name, __func__,
         face, decodeValue(face),
         mask);
 
@@ -2998,9 +2431,9 @@ static void OGLES2_glStencilMaskSeparate(struct OGLES2IFace *Self, GLenum face,
 
 static void OGLES2_glStencilOp(struct OGLES2IFace *Self, GLenum fail, GLenum zfail, GLenum zpass)
 {
-    GET_CONTEXT
+    GET_CONTEXT(StencilOp, fail, zfail, zpass)
 
-    logLine("%s: %s: fail 0x%X (%s), zfail 0x%X (%s), zpass 0x%X (%s)", context->name, __func__,
+    traceLine("%s: %s: fail 0x%X (%s), zfail 0x%X (%s), zpass 0x%X (%s)", context->name, __func__,
         fail, decodeValue(fail),
         zfail, decodeValue(zfail),
         zpass, decodeValue(zpass));
@@ -3010,9 +2443,9 @@ static void OGLES2_glStencilOp(struct OGLES2IFace *Self, GLenum fail, GLenum zfa
 
 static void OGLES2_glStencilOpSeparate(struct OGLES2IFace *Self, GLenum face, GLenum sfail, GLenum dpfail, GLenum dppass)
 {
-    GET_CONTEXT
+    GET_CONTEXT(StencilOpSeparate, face, sfail, dpfail, dppass)
 
-    logLine("%s: %s: face 0x%X (%s), sfail 0x%X (%s), dpfail 0x%X (%s), dppass 0x%X (%s)", context->name, __func__,
+    traceLine("%s: %s: face 0x%X (%s), sfail 0x%X (%s), dpfail 0x%X (%s), dppass 0x%X (%s)", context->name, __func__,
         face, decodeValue(face),
         sfail, decodeValue(sfail),
         dpfail, decodeValue(dpfail),
@@ -3023,9 +2456,9 @@ static void OGLES2_glStencilOpSeparate(struct OGLES2IFace *Self, GLenum face, GL
 
 static void OGLES2_glTexImage2D(struct OGLES2IFace *Self, GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void * pixels)
 {
-    GET_CONTEXT
+    GET_CONTEXT(TexImage2D, target, level, internalformat, width, height, border, format, type, pixels)
 
-    logLine("%s: %s: target 0x%X (%s), level %d, internalformat 0x%X (%s), width %u, height %u, border %d, format 0x%X (%s), type 0x%X (%s), pixels %p", context->name, __func__,
+    traceLine("%s: %s: target 0x%X (%s), level %d, internalformat 0x%X (%s), width %u, height %u, border %d, format 0x%X (%s), type 0x%X (%s), pixels %p", context->name, __func__,
         target, decodeValue(target),
         level,
         internalformat, decodeValue((GLenum)internalformat),
@@ -3039,9 +2472,9 @@ static void OGLES2_glTexImage2D(struct OGLES2IFace *Self, GLenum target, GLint l
 
 static void OGLES2_glTexParameterf(struct OGLES2IFace *Self, GLenum target, GLenum pname, GLfloat param)
 {
-    GET_CONTEXT
+    GET_CONTEXT(TexParameterf, target, pname, param)
 
-    logLine("%s: %s: target 0x%X (%s), pname 0x%X (%s), param %f", context->name, __func__,
+    traceLine("%s: %s: target 0x%X (%s), pname 0x%X (%s), param %f", context->name, __func__,
         target, decodeValue(target),
         pname, decodeValue(pname),
         param);
@@ -3051,9 +2484,9 @@ static void OGLES2_glTexParameterf(struct OGLES2IFace *Self, GLenum target, GLen
 
 static void OGLES2_glTexParameterfv(struct OGLES2IFace *Self, GLenum target, GLenum pname, const GLfloat * params)
 {
-    GET_CONTEXT
+    GET_CONTEXT(TexParameterfv, target, pname, params)
 
-    logLine("%s: %s: target 0x%X (%s), pname 0x%X (%s), params %p", context->name, __func__,
+    traceLine("%s: %s: target 0x%X (%s), pname 0x%X (%s), params %p", context->name, __func__,
         target, decodeValue(target),
         pname, decodeValue(pname),
         params);
@@ -3063,9 +2496,9 @@ static void OGLES2_glTexParameterfv(struct OGLES2IFace *Self, GLenum target, GLe
 
 static void OGLES2_glTexParameteri(struct OGLES2IFace *Self, GLenum target, GLenum pname, GLint param)
 {
-    GET_CONTEXT
+    GET_CONTEXT(TexParameteri, target, pname, param)
 
-    logLine("%s: %s: target 0x%X (%s), pname 0x%X (%s), param 0x%X (%s)", context->name, __func__,
+    traceLine("%s: %s: target 0x%X (%s), pname 0x%X (%s), param 0x%X (%s)", context->name, __func__,
         target, decodeValue(target),
         pname, decodeValue(pname),
         param, decodeValue((GLenum)param));
@@ -3075,9 +2508,9 @@ static void OGLES2_glTexParameteri(struct OGLES2IFace *Self, GLenum target, GLen
 
 static void OGLES2_glTexParameteriv(struct OGLES2IFace *Self, GLenum target, GLenum pname, const GLint * params)
 {
-    GET_CONTEXT
+    GET_CONTEXT(TexParameteriv, target, pname, params)
 
-    logLine("%s: %s: target 0x%X (%s), pname 0x%X (%s), params %p", context->name, __func__,
+    traceLine("%s: %s: target 0x%X (%s), pname 0x%X (%s), params %p", context->name, __func__,
         target, decodeValue(target),
         pname, decodeValue(pname),
         params);
@@ -3087,9 +2520,9 @@ static void OGLES2_glTexParameteriv(struct OGLES2IFace *Self, GLenum target, GLe
 
 static void OGLES2_glTexSubImage2D(struct OGLES2IFace *Self, GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const void * pixels)
 {
-    GET_CONTEXT
+    GET_CONTEXT(TexSubImage2D, target, level, xoffset, yoffset, width, height, format, type, pixels)
 
-    logLine("%s: %s: target 0x%X (%s, level %d, xoffset %d, yoffset %d, width %u, height %u, format 0x%X (%s), type 0x%X (%s), pixels %p", context->name, __func__,
+    traceLine("%s: %s: target 0x%X (%s, level %d, xoffset %d, yoffset %d, width %u, height %u, format 0x%X (%s), type 0x%X (%s), pixels %p", context->name, __func__,
         target, decodeValue(target),
         level, xoffset, yoffset, width, height,
         format, decodeValue(format),
@@ -3101,9 +2534,9 @@ static void OGLES2_glTexSubImage2D(struct OGLES2IFace *Self, GLenum target, GLin
 
 static void OGLES2_glUniform1f(struct OGLES2IFace *Self, GLint location, GLfloat v0)
 {
-    GET_CONTEXT
+    GET_CONTEXT(Uniform1f, location, v0)
 
-    logLine("%s: %s: location %d, v0 %f", context->name, __func__,
+    traceLine("%s: %s: location %d, v0 %f", context->name, __func__,
         location, v0);
 
     GL_CALL(Uniform1f, location, v0)
@@ -3111,13 +2544,13 @@ static void OGLES2_glUniform1f(struct OGLES2IFace *Self, GLint location, GLfloat
 
 static void OGLES2_glUniform1fv(struct OGLES2IFace *Self, GLint location, GLsizei count, const GLfloat * value)
 {
-    GET_CONTEXT
+    GET_CONTEXT(Uniform1fv, location, count, value)
 
-    logLine("%s: %s: location %d, count %d", context->name, __func__,
+    traceLine("%s: %s: location %d, count %d", context->name, __func__,
         location, count);
 
     for (GLsizei i = 0; i < count; i++) {
-        logLine("v%d { %f }", i, value[i]);
+        traceLine("v%d { %f }", i, value[i]);
     }
 
     GL_CALL(Uniform1fv, location, count, value)
@@ -3125,9 +2558,9 @@ static void OGLES2_glUniform1fv(struct OGLES2IFace *Self, GLint location, GLsize
 
 static void OGLES2_glUniform1i(struct OGLES2IFace *Self, GLint location, GLint v0)
 {
-    GET_CONTEXT
+    GET_CONTEXT(Uniform1i, location, v0)
 
-    logLine("%s: %s: location %d, v0 %d", context->name, __func__,
+    traceLine("%s: %s: location %d, v0 %d", context->name, __func__,
         location, v0);
 
     GL_CALL(Uniform1i, location, v0)
@@ -3135,13 +2568,13 @@ static void OGLES2_glUniform1i(struct OGLES2IFace *Self, GLint location, GLint v
 
 static void OGLES2_glUniform1iv(struct OGLES2IFace *Self, GLint location, GLsizei count, const GLint * value)
 {
-    GET_CONTEXT
+    GET_CONTEXT(Uniform1iv, location, count, value)
 
-    logLine("%s: %s: location %d, count %d", context->name, __func__,
+    traceLine("%s: %s: location %d, count %d", context->name, __func__,
         location, count);
 
     for (GLsizei i = 0; i < count; i++) {
-        logLine("v%d { %d }", i, value[i]);
+        traceLine("v%d { %d }", i, value[i]);
     }
 
     GL_CALL(Uniform1iv, location, count, value)
@@ -3149,9 +2582,9 @@ static void OGLES2_glUniform1iv(struct OGLES2IFace *Self, GLint location, GLsize
 
 static void OGLES2_glUniform2f(struct OGLES2IFace *Self, GLint location, GLfloat v0, GLfloat v1)
 {
-    GET_CONTEXT
+    GET_CONTEXT(Uniform2f, location, v0, v1)
 
-    logLine("%s: %s: location %d, v0 %f, v1 %f", context->name, __func__,
+    traceLine("%s: %s: location %d, v0 %f, v1 %f", context->name, __func__,
         location, v0, v1);
 
     GL_CALL(Uniform2f, location, v0, v1)
@@ -3159,14 +2592,14 @@ static void OGLES2_glUniform2f(struct OGLES2IFace *Self, GLint location, GLfloat
 
 static void OGLES2_glUniform2fv(struct OGLES2IFace *Self, GLint location, GLsizei count, const GLfloat * value)
 {
-    GET_CONTEXT
+    GET_CONTEXT(Uniform2fv, location, count, value)
 
-    logLine("%s: %s: location %d, count %d", context->name, __func__,
+    traceLine("%s: %s: location %d, count %d", context->name, __func__,
         location, count);
 
     for (GLsizei i = 0; i < count; i++) {
         const GLsizei index = 2 * i;
-        logLine("v%d {%f, %f}", i, value[index], value[index + 1]);
+        traceLine("v%d {%f, %f}", i, value[index], value[index + 1]);
     }
 
     GL_CALL(Uniform2fv, location, count, value)
@@ -3174,9 +2607,9 @@ static void OGLES2_glUniform2fv(struct OGLES2IFace *Self, GLint location, GLsize
 
 static void OGLES2_glUniform2i(struct OGLES2IFace *Self, GLint location, GLint v0, GLint v1)
 {
-    GET_CONTEXT
+    GET_CONTEXT(Uniform2i, location, v0, v1)
 
-    logLine("%s: %s: location %d, v0 %d, v1 %d", context->name, __func__,
+    traceLine("%s: %s: location %d, v0 %d, v1 %d", context->name, __func__,
         location, v0, v1);
 
     GL_CALL(Uniform2i, location, v0, v1)
@@ -3184,14 +2617,14 @@ static void OGLES2_glUniform2i(struct OGLES2IFace *Self, GLint location, GLint v
 
 static void OGLES2_glUniform2iv(struct OGLES2IFace *Self, GLint location, GLsizei count, const GLint * value)
 {
-    GET_CONTEXT
+    GET_CONTEXT(Uniform2iv, location, count, value)
 
-    logLine("%s: %s: location %d, count %d", context->name, __func__,
+    traceLine("%s: %s: location %d, count %d", context->name, __func__,
         location, count);
 
     for (GLsizei i = 0; i < count; i++) {
         const GLsizei index = 2 * i;
-        logLine("v%d {%d, %d}", i, value[index], value[index + 1]);
+        traceLine("v%d {%d, %d}", i, value[index], value[index + 1]);
     }
 
     GL_CALL(Uniform2iv, location, count, value)
@@ -3199,9 +2632,9 @@ static void OGLES2_glUniform2iv(struct OGLES2IFace *Self, GLint location, GLsize
 
 static void OGLES2_glUniform3f(struct OGLES2IFace *Self, GLint location, GLfloat v0, GLfloat v1, GLfloat v2)
 {
-    GET_CONTEXT
+    GET_CONTEXT(Uniform3f, location, v0, v1, v2)
 
-    logLine("%s: %s: location %d, v0 %f, v1 %f, v2 %f", context->name, __func__,
+    traceLine("%s: %s: location %d, v0 %f, v1 %f, v2 %f", context->name, __func__,
         location, v0, v1, v2);
 
     GL_CALL(Uniform3f, location, v0, v1, v2)
@@ -3209,14 +2642,14 @@ static void OGLES2_glUniform3f(struct OGLES2IFace *Self, GLint location, GLfloat
 
 static void OGLES2_glUniform3fv(struct OGLES2IFace *Self, GLint location, GLsizei count, const GLfloat * value)
 {
-    GET_CONTEXT
+    GET_CONTEXT(Uniform3fv, location, count, value)
 
-    logLine("%s: %s: location %d, count %d", context->name, __func__,
+    traceLine("%s: %s: location %d, count %d", context->name, __func__,
         location, count);
 
     for (GLsizei i = 0; i < count; i++) {
         const GLsizei index = 3 * i;
-        logLine("v%d {%f, %f, %f}", i, value[index], value[index + 1], value[index + 2]);
+        traceLine("v%d {%f, %f, %f}", i, value[index], value[index + 1], value[index + 2]);
     }
 
     GL_CALL(Uniform3fv, location, count, value)
@@ -3224,9 +2657,9 @@ static void OGLES2_glUniform3fv(struct OGLES2IFace *Self, GLint location, GLsize
 
 static void OGLES2_glUniform3i(struct OGLES2IFace *Self, GLint location, GLint v0, GLint v1, GLint v2)
 {
-    GET_CONTEXT
+    GET_CONTEXT(Uniform3i, location, v0, v1, v2)
 
-    logLine("%s: %s: location %d, v0 %d, v1 %d, v2 %d", context->name, __func__,
+    traceLine("%s: %s: location %d, v0 %d, v1 %d, v2 %d", context->name, __func__,
         location, v0, v1, v2);
 
     GL_CALL(Uniform3i, location, v0, v1, v2)
@@ -3234,14 +2667,14 @@ static void OGLES2_glUniform3i(struct OGLES2IFace *Self, GLint location, GLint v
 
 static void OGLES2_glUniform3iv(struct OGLES2IFace *Self, GLint location, GLsizei count, const GLint * value)
 {
-    GET_CONTEXT
+    GET_CONTEXT(Uniform3iv, location, count, value)
 
-    logLine("%s: %s: location %d, count %d", context->name, __func__,
+    traceLine("%s: %s: location %d, count %d", context->name, __func__,
         location, count);
 
     for (GLsizei i = 0; i < count; i++) {
         const GLsizei index = 3 * i;
-        logLine("v%d {%d, %d, %d}", i, value[index], value[index + 1], value[index + 2]);
+        traceLine("v%d {%d, %d, %d}", i, value[index], value[index + 1], value[index + 2]);
     }
 
     GL_CALL(Uniform3iv, location, count, value)
@@ -3249,9 +2682,9 @@ static void OGLES2_glUniform3iv(struct OGLES2IFace *Self, GLint location, GLsize
 
 static void OGLES2_glUniform4f(struct OGLES2IFace *Self, GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3)
 {
-    GET_CONTEXT
+    GET_CONTEXT(Uniform4f, location, v0, v1, v2, v3)
 
-    logLine("%s: %s: location %d, v0 %f, v1 %f, v2 %f, v3 %f", context->name, __func__,
+    traceLine("%s: %s: location %d, v0 %f, v1 %f, v2 %f, v3 %f", context->name, __func__,
         location, v0, v1, v2, v3);
 
     GL_CALL(Uniform4f, location, v0, v1, v2, v3)
@@ -3259,14 +2692,14 @@ static void OGLES2_glUniform4f(struct OGLES2IFace *Self, GLint location, GLfloat
 
 static void OGLES2_glUniform4fv(struct OGLES2IFace *Self, GLint location, GLsizei count, const GLfloat * value)
 {
-    GET_CONTEXT
+    GET_CONTEXT(Uniform4fv, location, count, value)
 
-    logLine("%s: %s: location %d, count %d", context->name, __func__,
+    traceLine("%s: %s: location %d, count %d", context->name, __func__,
         location, count);
 
     for (GLsizei i = 0; i < count; i++) {
         const GLsizei index = 4 * i;
-        logLine("v%d {%f, %f, %f, %f}", i, value[index], value[index + 1], value[index + 2], value[index + 3]);
+        traceLine("v%d {%f, %f, %f, %f}", i, value[index], value[index + 1], value[index + 2], value[index + 3]);
     }
 
     GL_CALL(Uniform4fv, location, count, value)
@@ -3274,9 +2707,9 @@ static void OGLES2_glUniform4fv(struct OGLES2IFace *Self, GLint location, GLsize
 
 static void OGLES2_glUniform4i(struct OGLES2IFace *Self, GLint location, GLint v0, GLint v1, GLint v2, GLint v3)
 {
-    GET_CONTEXT
+    GET_CONTEXT(Uniform4i, location, v0, v1, v2, v3)
 
-    logLine("%s: %s: location %d, v0 %d, v1 %d, v2 %d, v3 %d", context->name, __func__,
+    traceLine("%s: %s: location %d, v0 %d, v1 %d, v2 %d, v3 %d", context->name, __func__,
         location, v0, v1, v2, v3);
 
     GL_CALL(Uniform4i, location, v0, v1, v2, v3)
@@ -3284,14 +2717,14 @@ static void OGLES2_glUniform4i(struct OGLES2IFace *Self, GLint location, GLint v
 
 static void OGLES2_glUniform4iv(struct OGLES2IFace *Self, GLint location, GLsizei count, const GLint * value)
 {
-    GET_CONTEXT
+    GET_CONTEXT(Uniform4iv, location, count, value)
 
-    logLine("%s: %s: location %d, count %d", context->name, __func__,
+    traceLine("%s: %s: location %d, count %d", context->name, __func__,
         location, count);
 
     for (GLsizei i = 0; i < count; i++) {
         const GLsizei index = 4 * i;
-        logLine("v%d {%d, %d, %d, %d}", i, value[index], value[index + 1], value[index + 2], value[index + 3]);
+        traceLine("v%d {%d, %d, %d, %d}", i, value[index], value[index + 1], value[index + 2], value[index + 3]);
     }
 
     GL_CALL(Uniform4iv, location, count, value)
@@ -3299,14 +2732,14 @@ static void OGLES2_glUniform4iv(struct OGLES2IFace *Self, GLint location, GLsize
 
 static void OGLES2_glUniformMatrix2fv(struct OGLES2IFace *Self, GLint location, GLsizei count, GLboolean transpose, const GLfloat * value)
 {
-    GET_CONTEXT
+    GET_CONTEXT(UniformMatrix2fv, location, count, transpose, value)
 
-    logLine("%s: %s: location %d, count %d, transpose %d", context->name, __func__,
+    traceLine("%s: %s: location %d, count %d, transpose %d", context->name, __func__,
         location, count, transpose);
 
     for (GLsizei i = 0; i < count; i++) {
         const GLsizei index = 4 * i;
-        logLine("matrix #%d {%f, %f, %f, %f}", i,
+        traceLine("matrix #%d {%f, %f, %f, %f}", i,
             value[index    ], value[index + 1],
             value[index + 2], value[index + 3]);
     }
@@ -3316,14 +2749,14 @@ static void OGLES2_glUniformMatrix2fv(struct OGLES2IFace *Self, GLint location,
 
 static void OGLES2_glUniformMatrix3fv(struct OGLES2IFace *Self, GLint location, GLsizei count, GLboolean transpose, const GLfloat * value)
 {
-    GET_CONTEXT
+    GET_CONTEXT(UniformMatrix3fv, location, count, transpose, value)
 
-    logLine("%s: %s: location %d, count %d, transpose %d", context->name, __func__,
+    traceLine("%s: %s: location %d, count %d, transpose %d", context->name, __func__,
         location, count, transpose);
 
     for (GLsizei i = 0; i < count; i++) {
         const GLsizei index = 9 * i;
-        logLine("matrix #%d {%f, %f, %f, %f, %f, %f, %f, %f, %f}", i,
+        traceLine("matrix #%d {%f, %f, %f, %f, %f, %f, %f, %f, %f}", i,
             value[index    ], value[index + 1], value[index + 2],
             value[index + 3], value[index + 4], value[index + 5],
             value[index + 6], value[index + 7], value[index + 8]);
@@ -3334,14 +2767,14 @@ static void OGLES2_glUniformMatrix3fv(struct OGLES2IFace *Self, GLint location,
 
 static void OGLES2_glUniformMatrix4fv(struct OGLES2IFace *Self, GLint location, GLsizei count, GLboolean transpose, const GLfloat * value)
 {
-    GET_CONTEXT
+    GET_CONTEXT(UniformMatrix4fv, location, count, transpose, value)
 
-    logLine("%s: %s: location %d, count %d, transpose %d", context->name, __func__,
+    traceLine("%s: %s: location %d, count %d, transpose %d", context->name, __func__,
         location, count, transpose);
 
     for (GLsizei i = 0; i < count; i++) {
         const GLsizei index = 16 * i;
-        logLine("matrix #%d {%f, %f, %f, %f, %f, %f, %f, %f, %f, %f, %f, %f, %f, %f, %f, %f}", i,
+        traceLine("matrix #%d {%f, %f, %f, %f, %f, %f, %f, %f, %f, %f, %f, %f, %f, %f, %f, %f}", i,
             value[index     ], value[index +  1], value[index +  2], value[index +  3],
             value[index +  4], value[index +  5], value[index +  6], value[index +  7],
             value[index +  8], value[index +  9], value[index + 10], value[index + 11],
@@ -3353,16 +2786,16 @@ static void OGLES2_glUniformMatrix4fv(struct OGLES2IFace *Self, GLint location,
 
 static GLboolean OGLES2_glUnmapBufferOES(struct OGLES2IFace *Self, GLenum target)
 {
-    GET_CONTEXT
+    GET_CONTEXT(UnmapBufferOES, target)
 
     GLboolean status = GL_FALSE;
 
-    logLine("%s: %s: target 0x%X (%s)", context->name, __func__,
+    traceLine("%s: %s: target 0x%X (%s)", context->name, __func__,
         target, decodeValue(target));
 
     GL_CALL_STATUS(UnmapBufferOES, target)
 
-    logLine("%s: %s: <- return value %d", context->name, __func__,
+    traceLine("%s: %s: <- return value %d", context->name, __func__,
         status);
 
     return status;
@@ -3370,9 +2803,9 @@ static GLboolean OGLES2_glUnmapBufferOES(struct OGLES2IFace *Self, GLenum target
 
 static void OGLES2_glUseProgram(struct OGLES2IFace *Self, GLuint program)
 {
-    GET_CONTEXT
+    GET_CONTEXT(UseProgram, program)
 
-    logLine("%s: %s program %u", context->name, __func__,
+    traceLine("%s: %s program %u", context->name, __func__,
         program);
 
     GL_CALL(UseProgram, program);
@@ -3380,9 +2813,9 @@ static void OGLES2_glUseProgram(struct OGLES2IFace *Self, GLuint program)
 
 static void OGLES2_glValidateProgram(struct OGLES2IFace *Self, GLuint program)
 {
-    GET_CONTEXT
+    GET_CONTEXT(ValidateProgram, program)
 
-    logLine("%s: %s program %u", context->name, __func__,
+    traceLine("%s: %s program %u", context->name, __func__,
         program);
 
     GL_CALL(ValidateProgram, program);
@@ -3390,9 +2823,9 @@ static void OGLES2_glValidateProgram(struct OGLES2IFace *Self, GLuint program)
 
 static void OGLES2_glVertexAttrib1f(struct OGLES2IFace *Self, GLuint index, GLfloat x)
 {
-    GET_CONTEXT
+    GET_CONTEXT(VertexAttrib1f, index, x)
 
-    logLine("%s: %s index %u, x %f", context->name, __func__,
+    traceLine("%s: %s index %u, x %f", context->name, __func__,
         index, x);
 
     GL_CALL(VertexAttrib1f, index, x);
@@ -3400,9 +2833,9 @@ static void OGLES2_glVertexAttrib1f(struct OGLES2IFace *Self, GLuint index, GLfl
 
 static void OGLES2_glVertexAttrib1fv(struct OGLES2IFace *Self, GLuint index, const GLfloat * v)
 {
-    GET_CONTEXT
+    GET_CONTEXT(VertexAttrib1fv, index, v)
 
-    logLine("%s: %s index %u, v { %f }", context->name, __func__,
+    traceLine("%s: %s index %u, v { %f }", context->name, __func__,
         index, v[0]);
 
     GL_CALL(VertexAttrib1fv, index, v);
@@ -3410,9 +2843,9 @@ static void OGLES2_glVertexAttrib1fv(struct OGLES2IFace *Self, GLuint index, con
 
 static void OGLES2_glVertexAttrib2f(struct OGLES2IFace *Self, GLuint index, GLfloat x, GLfloat y)
 {
-    GET_CONTEXT
+    GET_CONTEXT(VertexAttrib2f, index, x, y)
 
-    logLine("%s: %s index %u, x %f, y %f", context->name, __func__,
+    traceLine("%s: %s index %u, x %f, y %f", context->name, __func__,
         index, x, y);
 
     GL_CALL(VertexAttrib2f, index, x, y);
@@ -3420,9 +2853,9 @@ static void OGLES2_glVertexAttrib2f(struct OGLES2IFace *Self, GLuint index, GLfl
 
 static void OGLES2_glVertexAttrib2fv(struct OGLES2IFace *Self, GLuint index, const GLfloat * v)
 {
-    GET_CONTEXT
+    GET_CONTEXT(VertexAttrib2fv, index, v)
 
-    logLine("%s: %s index %u, v { %f, %f }", context->name, __func__,
+    traceLine("%s: %s index %u, v { %f, %f }", context->name, __func__,
         index, v[0], v[1]);
 
     GL_CALL(VertexAttrib2fv, index, v);
@@ -3430,9 +2863,9 @@ static void OGLES2_glVertexAttrib2fv(struct OGLES2IFace *Self, GLuint index, con
 
 static void OGLES2_glVertexAttrib3f(struct OGLES2IFace *Self, GLuint index, GLfloat x, GLfloat y, GLfloat z)
 {
-    GET_CONTEXT
+    GET_CONTEXT(VertexAttrib3f, index, x, y, z)
 
-    logLine("%s: %s index %u, x %f, y %f, z %f", context->name, __func__,
+    traceLine("%s: %s index %u, x %f, y %f, z %f", context->name, __func__,
         index, x, y, z);
 
     GL_CALL(VertexAttrib3f, index, x, y, z);
@@ -3440,9 +2873,9 @@ static void OGLES2_glVertexAttrib3f(struct OGLES2IFace *Self, GLuint index, GLfl
 
 static void OGLES2_glVertexAttrib3fv(struct OGLES2IFace *Self, GLuint index, const GLfloat * v)
 {
-    GET_CONTEXT
+    GET_CONTEXT(VertexAttrib3fv, index, v)
 
-    logLine("%s: %s index %u, v { %f, %f, %f }", context->name, __func__,
+    traceLine("%s: %s index %u, v { %f, %f, %f }", context->name, __func__,
         index, v[0], v[1], v[2]);
 
     GL_CALL(VertexAttrib3fv, index, v);
@@ -3450,9 +2883,9 @@ static void OGLES2_glVertexAttrib3fv(struct OGLES2IFace *Self, GLuint index, con
 
 static void OGLES2_glVertexAttrib4f(struct OGLES2IFace *Self, GLuint index, GLfloat x, GLfloat y, GLfloat z, GLfloat w)
 {
-    GET_CONTEXT
+    GET_CONTEXT(VertexAttrib4f, index, x, y, z, w)
 
-    logLine("%s: %s index %u, x %f, y %f, z %f, w %f", context->name, __func__,
+    traceLine("%s: %s index %u, x %f, y %f, z %f, w %f", context->name, __func__,
         index, x, y, z, w);
 
     GL_CALL(VertexAttrib4f, index, x, y, z, w);
@@ -3460,9 +2893,9 @@ static void OGLES2_glVertexAttrib4f(struct OGLES2IFace *Self, GLuint index, GLfl
 
 static void OGLES2_glVertexAttrib4fv(struct OGLES2IFace *Self, GLuint index, const GLfloat * v)
 {
-    GET_CONTEXT
+    GET_CONTEXT(VertexAttrib4fv, index, v)
 
-    logLine("%s: %s index %u, v { %f, %f, %f, %f }", context->name, __func__,
+    traceLine("%s: %s index %u, v { %f, %f, %f, %f }", context->name, __func__,
         index, v[0], v[1], v[2], v[3]);
 
     GL_CALL(VertexAttrib4fv, index, v);
@@ -3470,9 +2903,9 @@ static void OGLES2_glVertexAttrib4fv(struct OGLES2IFace *Self, GLuint index, con
 
 static void OGLES2_glVertexAttribPointer(struct OGLES2IFace *Self, GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void * pointer)
 {
-    GET_CONTEXT
+    GET_CONTEXT(VertexAttribPointer, index, size, type, normalized, stride, pointer)
 
-    logLine("%s: %s: index %u, size %d, type 0x%X (%s), normalized %d, stride %d, pointer %p", context->name, __func__,
+    traceLine("%s: %s: index %u, size %d, type 0x%X (%s), normalized %d, stride %d, pointer %p", context->name, __func__,
         index, size,
         type, decodeValue(type),
         normalized, stride, pointer);
@@ -3482,340 +2915,33 @@ static void OGLES2_glVertexAttribPointer(struct OGLES2IFace *Self, GLuint index,
 
 static void OGLES2_glViewport(struct OGLES2IFace *Self, GLint x, GLint y, GLsizei width, GLsizei height)
 {
-    GET_CONTEXT
+    GET_CONTEXT(Viewport, x, y, width, height)
 
-    logLine("%s: %s: x %d, y %d, width %u, height %u", context->name, __func__,
+    traceLine("%s: %s: x %d, y %d, width %u, height %u", context->name, __func__,
         x, y, width, height);
 
     GL_CALL(Viewport, x, y, width, height)
 }
 
-GENERATE_FILTERED_PATCH(OGLES2IFace, aglCreateContext_AVOID, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, aglCreateContext2, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, aglDestroyContext, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, aglGetProcAddress, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, aglMakeCurrent, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, aglSetBitmap, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, aglSetParams_AVOID, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, aglSetParams2, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, aglSwapBuffers, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glActiveTexture, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glAttachShader, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glBindAttribLocation, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glBindBuffer, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glBindFramebuffer, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glBindRenderbuffer, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glBindTexture, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glBlendColor, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glBlendEquation, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glBlendEquationSeparate, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glBlendFunc, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glBlendFuncSeparate, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glBufferData, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glBufferSubData, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glClear, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glClearColor, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glClearDepthf, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glClearStencil, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glCheckFramebufferStatus, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glColorMask, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glCompileShader, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glCompressedTexImage2D, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glCompressedTexSubImage2D, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glCopyTexImage2D, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glCopyTexSubImage2D, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glCreateProgram, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glCreateShader, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glCullFace, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glDeleteBuffers, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glDeleteFramebuffers, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glDeleteProgram, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glDeleteRenderbuffers, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glDeleteShader, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glDeleteTextures, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glDepthFunc, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glDepthMask, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glDepthRangef, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glDetachShader, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glDisable, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glDisableVertexAttribArray, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glDrawArrays, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glDrawElements, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glDrawElementsBaseVertexOES, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glEnable, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glEnableVertexAttribArray, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glFinish, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glFlush, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glFramebufferRenderbuffer, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glFramebufferTexture2D, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glFrontFace, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glGenBuffers, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glGenerateMipmap, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glGenFramebuffers, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glGenRenderbuffers, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glGenTextures, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glGetActiveAttrib, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glGetActiveUniform, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glGetAttachedShaders, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glGetAttribLocation, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glGetBooleanv, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glGetBufferParameteriv, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glGetBufferParameterivOES, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glGetBufferPointervOES, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glGetError, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glGetFloatv, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glGetFramebufferAttachmentParameteriv, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glGetIntegerv, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glGetProgramBinaryOES, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glGetProgramiv, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glGetProgramInfoLog, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glGetRenderbufferParameteriv, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glGetShaderiv, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glGetShaderInfoLog, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glGetShaderPrecisionFormat, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glGetShaderSource, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glGetString, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glGetTexParameterfv, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glGetTexParameteriv, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glGetUniformfv, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glGetUniformiv, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glGetUniformLocation, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glGetVertexAttribfv, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glGetVertexAttribiv, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glGetVertexAttribPointerv, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glHint, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glIsBuffer, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glIsEnabled, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glIsFramebuffer, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glIsProgram, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glIsRenderbuffer, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glIsShader, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glIsTexture, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glLineWidth, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glLinkProgram, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glMapBufferOES, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glPixelStorei, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glPolygonMode, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glPolygonOffset, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glProgramBinaryOES, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glProvokingVertex, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glReadPixels, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glReleaseShaderCompiler, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glRenderbufferStorage, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glSampleCoverage, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glScissor, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glShaderBinary, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glShaderSource, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glStencilFunc, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glStencilFuncSeparate, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glStencilMask, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glStencilMaskSeparate, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glStencilOp, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glStencilOpSeparate, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glTexImage2D, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glTexParameterf, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glTexParameterfv, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glTexParameteri, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glTexParameteriv, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glTexSubImage2D, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glUniform1f, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glUniform1fv, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glUniform1i, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glUniform1iv, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glUniform2f, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glUniform2fv, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glUniform2i, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glUniform2iv, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glUniform3f, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glUniform3fv, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glUniform3i, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glUniform3iv, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glUniform4f, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glUniform4fv, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glUniform4i, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glUniform4iv, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glUniformMatrix2fv, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glUniformMatrix3fv, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glUniformMatrix4fv, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glUnmapBufferOES, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glUseProgram, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glValidateProgram, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glVertexAttrib1f, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glVertexAttrib1fv, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glVertexAttrib2f, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glVertexAttrib2fv, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glVertexAttrib3f, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glVertexAttrib3fv, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glVertexAttrib4f, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glVertexAttrib4fv, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glVertexAttribPointer, OGLES2, Ogles2Context)
-GENERATE_FILTERED_PATCH(OGLES2IFace, glViewport, OGLES2, Ogles2Context)
+#define OGLES2_PATCH(prefix, name, returnType, parameters, categories) \
+    GENERATE_FILTERED_PATCH(OGLES2IFace, prefix ## name, OGLES2, Ogles2Context, name)
+OGLES2_FUNCTIONS(OGLES2_PATCH)
+#undef OGLES2_PATCH
 
 static void (*patches[])(BOOL, struct Ogles2Context *) = {
-    patch_aglCreateContext_AVOID,
-    patch_aglCreateContext2,
-    patch_aglDestroyContext,
-    patch_aglGetProcAddress,
-    patch_aglMakeCurrent,
-    patch_aglSetBitmap,
-    patch_aglSetParams_AVOID,
-    patch_aglSetParams2,
-    patch_aglSwapBuffers,
-    patch_glActiveTexture,
-    patch_glAttachShader,
-    patch_glBindAttribLocation,
-    patch_glBindBuffer,
-    patch_glBindFramebuffer,
-    patch_glBindRenderbuffer,
-    patch_glBindTexture,
-    patch_glBlendColor,
-    patch_glBlendEquation,
-    patch_glBlendEquationSeparate,
-    patch_glBlendFunc,
-    patch_glBlendFuncSeparate,
-    patch_glBufferData,
-    patch_glBufferSubData,
-    patch_glCheckFramebufferStatus,
-    patch_glClear,
-    patch_glClearColor,
-    patch_glClearDepthf,
-    patch_glClearStencil,
-    patch_glColorMask,
-    patch_glCompileShader,
-    patch_glCompressedTexImage2D,
-    patch_glCompressedTexSubImage2D,
-    patch_glCopyTexImage2D,
-    patch_glCopyTexSubImage2D,
-    patch_glCreateProgram,
-    patch_glCreateShader,
-    patch_glCullFace,
-    patch_glDeleteBuffers,
-    patch_glDeleteFramebuffers,
-    patch_glDeleteProgram,
-    patch_glDeleteRenderbuffers,
-    patch_glDeleteShader,
-    patch_glDeleteTextures,
-    patch_glDepthFunc,
-    patch_glDepthMask,
-    patch_glDepthRangef,
-    patch_glDetachShader,
-    patch_glDisable,
-    patch_glDisableVertexAttribArray,
-    patch_glDrawArrays,
-    patch_glDrawElements,
-    patch_glDrawElementsBaseVertexOES,
-    patch_glEnable,
-    patch_glEnableVertexAttribArray,
-    patch_glFinish,
-    patch_glFlush,
-    patch_glFramebufferRenderbuffer,
-    patch_glFramebufferTexture2D,
-    patch_glFrontFace,
-    patch_glGenBuffers,
-    patch_glGenerateMipmap,
-    patch_glGenFramebuffers,
-    patch_glGenRenderbuffers,
-    patch_glGenTextures,
-    patch_glGetActiveAttrib,
-    patch_glGetActiveUniform,
-    patch_glGetAttachedShaders,
-    patch_glGetAttribLocation,
-    patch_glGetBooleanv,
-    patch_glGetBufferParameteriv,
-    patch_glGetBufferParameterivOES,
-    patch_glGetBufferPointervOES,
-    patch_glGetError,
-    patch_glGetFloatv,
-    patch_glGetFramebufferAttachmentParameteriv,
-    patch_glGetIntegerv,
-    patch_glGetProgramBinaryOES,
-    patch_glGetProgramiv,
-    patch_glGetProgramInfoLog,
-    patch_glGetRenderbufferParameteriv,
-    patch_glGetShaderiv,
-    patch_glGetShaderInfoLog,
-    patch_glGetShaderPrecisionFormat,
-    patch_glGetShaderSource,
-    patch_glGetString,
-    patch_glGetTexParameterfv,
-    patch_glGetTexParameteriv,
-    patch_glGetUniformfv,
-    patch_glGetUniformiv,
-    patch_glGetUniformLocation,
-    patch_glGetVertexAttribfv,
-    patch_glGetVertexAttribiv,
-    patch_glGetVertexAttribPointerv,
-    patch_glHint,
-    patch_glIsBuffer,
-    patch_glIsEnabled,
-    patch_glIsFramebuffer,
-    patch_glIsProgram,
-    patch_glIsRenderbuffer,
-    patch_glIsShader,
-    patch_glIsTexture,
-    patch_glLineWidth,
-    patch_glLinkProgram,
-    patch_glMapBufferOES,
-    patch_glPixelStorei,
-    patch_glPolygonMode,
-    patch_glPolygonOffset,
-    patch_glProgramBinaryOES,
-    patch_glProvokingVertex,
-    patch_glReadPixels,
-    patch_glReleaseShaderCompiler,
-    patch_glRenderbufferStorage,
-    patch_glSampleCoverage,
-    patch_glScissor,
-    patch_glShaderBinary,
-    patch_glShaderSource,
-    patch_glStencilFunc,
-    patch_glStencilFuncSeparate,
-    patch_glStencilMask,
-    patch_glStencilMaskSeparate,
-    patch_glStencilOp,
-    patch_glStencilOpSeparate,
-    patch_glTexImage2D,
-    patch_glTexParameterf,
-    patch_glTexParameterfv,
-    patch_glTexParameteri,
-    patch_glTexParameteriv,
-    patch_glTexSubImage2D,
-    patch_glUniform1f,
-    patch_glUniform1fv,
-    patch_glUniform1i,
-    patch_glUniform1iv,
-    patch_glUniform2f,
-    patch_glUniform2fv,
-    patch_glUniform2i,
-    patch_glUniform2iv,
-    patch_glUniform3f,
-    patch_glUniform3fv,
-    patch_glUniform3i,
-    patch_glUniform3iv,
-    patch_glUniform4f,
-    patch_glUniform4fv,
-    patch_glUniform4i,
-    patch_glUniform4iv,
-    patch_glUniformMatrix2fv,
-    patch_glUniformMatrix3fv,
-    patch_glUniformMatrix4fv,
-    patch_glUnmapBufferOES,
-    patch_glUseProgram,
-    patch_glValidateProgram,
-    patch_glVertexAttrib1f,
-    patch_glVertexAttrib1fv,
-    patch_glVertexAttrib2f,
-    patch_glVertexAttrib2fv,
-    patch_glVertexAttrib3f,
-    patch_glVertexAttrib3fv,
-    patch_glVertexAttrib4f,
-    patch_glVertexAttrib4fv,
-    patch_glVertexAttribPointer,
-    patch_glViewport
+    #define OGLES2_PATCH_ENTRY(prefix, name, returnType, parameters, categories) patch_ ## prefix ## name,
+    OGLES2_FUNCTIONS(OGLES2_PATCH_ENTRY)
+    #undef OGLES2_PATCH_ENTRY
 };
 
-void ogles2_install_patches(void)
+void ogles2_install_patches(LONG frameSummaryEnabled)
 {
+    frameSummaryMode = frameSummaryEnabled != 0;
+
+    filter_compile(FilterSet_Profile, patchFilter, &ogles2FilterTable);
+    filter_compile(FilterSet_Trace, traceFilter, &ogles2FilterTable);
+    filter_compile_predicates(&predicates, &ogles2FilterTable);
+
     execContext.interface = IExec;
 
     mutex = IExec->AllocSysObject(ASOT_MUTEX, TAG_DONE);
@@ -3841,6 +2967,33 @@ static void patch_ogles2_functions(struct Ogles2Context * ctx)
     }
 }
 
+void ogles2_reload_filter(void)
+{
+    if (!mutex) {
+        return;
+    }
+
+    // Wrappers read the trace set and the conditions without locking. The trace
+    // set is published word by word, the conditions as a new set.
+    filter_compile(FilterSet_Trace, traceFilter, &ogles2FilterTable);
+    filter_compile_predicates(&predicates, &ogles2FilterTable);
+
+    IExec->MutexObtain(mutex);
+
+    filter_compile(FilterSet_Profile, patchFilter, &ogles2FilterTable);
+
+    size_t position = 0;
+    struct Ogles2Context* context;
+
+    while ((context = client_table_next(&clientTable, &position))) {
+        patch_ogles2_functions(context);
+        logAlways("%s: %lu OGLES2 functions patched after filter reload", context->name,
+            (ULONG)filter_count(context->patched, Ogles2FunctionCount));
+    }
+
+    IExec->MutexRelease(mutex);
+}
+
 void ogles2_remove_patches(void)
 {
     patch_DropInterface(FALSE, &execContext);
@@ -3848,21 +3001,24 @@ void ogles2_remove_patches(void)
 
     if (mutex) {
         // Remove patches
-        size_t i;
+        size_t position = 0;
+        struct Ogles2Context* context;
 
         IExec->MutexObtain(mutex);
 
-        for (i = 0; i < MAX_CLIENTS; i++) {
-            if (contexts[i]) {
-                profileResults(contexts[i]);
+        while ((context = client_table_next(&clientTable, &position))) {
+            profileResults(context);
 
-                size_t p;
-                for (p = 0; p < sizeof(patches) / sizeof(patches[0]); p++) {
-                    patches[p](FALSE, contexts[i]);
-                }
+            size_t p;
+            for (p = 0; p < sizeof(patches) / sizeof(patches[0]); p++) {
+                patches[p](FALSE, context);
             }
         }
 
+        // Full results of the dropped interfaces were logged when they were dropped
+        summaryResults("Dropped OGLES2 interfaces:", clientTable.archive, clientTable.archiveCount,
+            mapOgles2TraceFunction);
+
         IExec->MutexRelease(mutex);
     }
 
@@ -3875,17 +3031,24 @@ void ogles2_free(void)
 
     if (mutex) {
         // Remove all known context data
-        size_t i;
+        size_t position = 0;
+        struct Ogles2Context* context;
 
         IExec->MutexObtain(mutex);
 
-        for (i = 0; i < MAX_CLIENTS; i++) {
-            if (contexts[i]) {
-                IExec->FreeVec(contexts[i]);
-                contexts[i] = NULL;
-            }
+        while ((context = client_table_next(&clientTable, &position))) {
+            recorder_close(context->trace);
+            flight_close(context->flight);
+            IExec->FreeVec(context);
         }
 
+        for (size_t i = 0; i < clientTable.archiveCount; i++) {
+            IExec->FreeVec(clientTable.archive[i]);
+        }
+
+        client_table_free(&clientTable);
+        filter_free_predicates(&predicates);
+
         IExec->MutexRelease(mutex);
 
         IExec->FreeSysObject(ASOT_MUTEX, mutex);
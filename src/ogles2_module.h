@@ -1,14 +1,27 @@
 #ifndef OGLES2_MODULE_H
 #define OGLES2_MODULE_H
 
-void ogles2_install_patches(void);
+#include <exec/types.h>
+
+struct Task;
+
+void ogles2_install_patches(LONG frameSummaryEnabled);
 void ogles2_remove_patches(void);
+
+// Applies a reloaded filter to the live contexts
+void ogles2_reload_filter(void);
 void ogles2_free(void);
 
 const char* ogles2_version_string(void);
 const char* ogles2_errors_string(void);
 
+// TRUE when the task has, or had, a patched OGLES2 interface
+BOOL ogles2_task_patched(const struct Task* const task);
+
 void ogles2_start_profiling(void);
 void ogles2_finish_profiling(void);
 
+// Logs the work done by each client since the previous snapshot
+void ogles2_snapshot(void);
+
 #endif
@@ -1,8 +1,154 @@
 #include "profiling.h"
 #include "logger.h"
+#include "timer.h"
 
+#include <proto/exec.h>
+
+#include <stdio.h>
 #include <stdlib.h>
 
+#define FRAME_TOP_FUNCTIONS 3
+#define CALIBRATION_ROUNDS 5 // The fastest round is used, the others may have been interrupted
+#define CALIBRATION_CALLS 2000
+#define INTERVAL_TASKS 4 // Tasks that may share a context, scales the call budget of an interval
+#define INTERVAL_PRIMITIVES_PER_SECOND 1000000000ULL
+#define TORN_READ_RETRIES 3
+
+Overhead overhead;
+
+// Enough of a context for the profiling macros
+typedef struct CalibrationContext {
+    struct Task* task;
+    struct NestingStack* nesting;
+    uint64 ticks;
+    ProfilingItem profiling[1];
+    Histogram latency[1];
+    NestingChildren children[1];
+} CalibrationContext;
+
+static void empty_function(void)
+{
+}
+
+// Called through a pointer, like the original functions
+static void (* volatile originalFunction)(void) = empty_function;
+
+static void __attribute__((noinline)) ogles2_wrapper(CalibrationContext* context)
+{
+    PROF_START_PARENT(0)
+    originalFunction();
+    PROF_FINISH_PARENT(0)
+}
+
+static void __attribute__((noinline)) nova_wrapper(CalibrationContext* context)
+{
+    PROF_START
+    originalFunction();
+    PROF_FINISH(0)
+    PROF_CHILD(0, 0)
+}
+
+static double calibrate(void (*wrapper)(CalibrationContext *), CalibrationContext* context, double* interval)
+{
+    double fastest = 0.0;
+
+    for (int round = 0; round < CALIBRATION_ROUNDS; round++) {
+        MyClock start, finish;
+
+        context->ticks = 0;
+
+        ITimer->ReadEClock(&start.clockVal);
+
+        for (int i = 0; i < CALIBRATION_CALLS; i++) {
+            wrapper(context);
+        }
+
+        ITimer->ReadEClock(&finish.clockVal);
+
+        const double ticks = (double)(finish.ticks - start.ticks) / CALIBRATION_CALLS;
+        const double measured = (double)context->ticks / CALIBRATION_CALLS;
+
+        if (round == 0 || ticks < fastest) {
+            fastest = ticks;
+        }
+
+        if (interval && (round == 0 || measured < *interval)) {
+            *interval = measured;
+        }
+    }
+
+    return fastest;
+}
+
+void profiling_calibrate(void)
+{
+    static CalibrationContext context;
+
+    context.task = IExec->FindTask(NULL);
+
+    for (int round = 0; round < CALIBRATION_ROUNDS; round++) {
+        MyClock start, finish, dummy;
+
+        ITimer->ReadEClock(&start.clockVal);
+
+        for (int i = 0; i < CALIBRATION_CALLS; i++) {
+            ITimer->ReadEClock(&dummy.clockVal);
+        }
+
+        ITimer->ReadEClock(&finish.clockVal);
+
+        const double ticks = (double)(finish.ticks - start.ticks) / CALIBRATION_CALLS;
+
+        if (round == 0 || ticks < overhead.timerRead) {
+            overhead.timerRead = ticks;
+        }
+    }
+
+    overhead.ogles2Call = calibrate(ogles2_wrapper, &context, &overhead.interval);
+    overhead.novaCall = calibrate(nova_wrapper, &context, NULL);
+
+    nesting_forget(context.task);
+
+    logLine("Calibration: timer read %.3f us, measured empty call %.3f us, OGLES2 wrapper %.3f us, Nova wrapper %.3f us",
+        timer_ticks_to_us(1) * overhead.timerRead,
+        timer_ticks_to_us(1) * overhead.interval,
+        timer_ticks_to_us(1) * overhead.ogles2Call,
+        timer_ticks_to_us(1) * overhead.novaCall);
+}
+
+uint64 overheadTicks(const ProfilingItem* const item, const uint64 nestedCalls)
+{
+    return (uint64)((double)item->callCount * overhead.interval + (double)nestedCalls * overhead.novaCall) +
+        item->tracerTicks;
+}
+
+uint64 childOverheadTicks(const uint64 nestedCalls)
+{
+    return (uint64)((double)nestedCalls * overhead.interval);
+}
+
+uint64 correctTicks(const uint64 ticks, const uint64 overheadTicks)
+{
+    return ticks > overheadTicks ? ticks - overheadTicks : 0;
+}
+
+void overheadStats(const ProfilingItem* const items, const int count, const double callTicks,
+    const uint64 extraTicks, const uint64 totalTicks)
+{
+    uint64 calls = 0;
+
+    for (int i = 0; i < count; i++) {
+        calls += items[i].callCount;
+    }
+
+    const uint64 added = (uint64)((double)calls * callTicks) + extraTicks;
+
+    logAlways("  glSnoop added an estimated %.6f ms, %.2f %% of context life-time (%.3f us per call)",
+        timer_ticks_to_ms(added),
+        (double)added * 100.0 / (double)totalTicks,
+        calls ? timer_ticks_to_us(added) / (double)calls : 0.0);
+}
+
 int tickComparison(const void* first, const void* second)
 {
     const ProfilingItem* a = first;
@@ -19,12 +165,90 @@ void sort(ProfilingItem* items, const unsigned count)
     qsort(items, count, sizeof(ProfilingItem), tickComparison);
 }
 
+ClientSummary* summarizeClient(const char* const name, const ULONG id, const struct Task* const task,
+    const uint64 lifetime, const uint64 ticks, const ProfilingItem* const items, const int count)
+{
+    ClientSummary* const summary = IExec->AllocVecTags(sizeof(ClientSummary),
+        AVT_Type, MEMF_SHARED,
+        AVT_ClearValue, 0,
+        TAG_DONE);
+
+    if (!summary) {
+        return NULL;
+    }
+
+    snprintf(summary->name, sizeof(summary->name), "%s", name);
+    summary->id = id;
+    summary->task = task;
+    summary->lifetime = lifetime;
+    summary->ticks = ticks;
+
+    for (int i = 0; i < count; i++) {
+        summary->calls += items[i].callCount;
+
+        if (!items[i].callCount) {
+            continue;
+        }
+
+        // Insertion into the short list of the longest durations
+        unsigned position = summary->rowCount;
+
+        while (position > 0 && summary->rows[position - 1].ticks < items[i].ticks) {
+            if (position < SUMMARY_ROWS) {
+                summary->rows[position] = summary->rows[position - 1];
+            }
+            position--;
+        }
+
+        if (position < SUMMARY_ROWS) {
+            summary->rows[position] = items[i];
+            summary->rows[position].index = i;
+
+            if (summary->rowCount < SUMMARY_ROWS) {
+                summary->rowCount++;
+            }
+        }
+    }
+
+    return summary;
+}
+
+void summaryResults(const char* const title, void* const* const summaries, const size_t count,
+    const char* (*mapFunction)(uint16_t))
+{
+    if (count == 0) {
+        return;
+    }
+
+    logAlways("\n%s", title);
+    logAlways("%6s | %30s | %12s | %20s | %20s", "id", "task / function", "call count", "duration (ms)", "life-time (ms)");
+
+    for (size_t i = 0; i < count; i++) {
+        const ClientSummary* const summary = summaries[i];
+
+        logAlways("%6lu | %30s | %12llu | %20.6f | %20.6f", summary->id, summary->name, summary->calls,
+            timer_ticks_to_ms(summary->ticks), timer_ticks_to_ms(summary->lifetime));
+
+        for (unsigned row = 0; row < summary->rowCount; row++) {
+            const ProfilingItem* const item = &summary->rows[row];
+
+            logAlways("%6s | %30s | %12llu | %20.6f |", "", mapFunction((uint16_t)item->index), item->callCount,
+                timer_ticks_to_ms(item->ticks));
+        }
+    }
+}
+
+uint64 primitiveTotal(const PrimitiveCounter* const counter)
+{
+    return counter->triangles + counter->triangleStrips + counter->triangleFans +
+        counter->lines + counter->lineStrips + counter->lineLoops + counter->points;
+}
+
 void primitiveStats(const PrimitiveCounter* const counter, const double seconds, const double drawcalls)
 {
     logAlways("  Primitive statistics:");
 
-    const uint64 total = counter->triangles + counter->triangleStrips + counter->triangleFans +
-        counter->lines + counter->lineStrips + counter->lineLoops + counter->points;
+    const uint64 total = primitiveTotal(counter);
 
     if (total == 0) {
         logAlways("    Nothing was drawn, vertex count 0");
@@ -68,3 +292,183 @@ void primitiveStats(const PrimitiveCounter* const counter, const double seconds,
             (double)counter->points / seconds, (double)counter->points / drawcalls);
     }
 }
+
+// Counters may have been cleared in between (profiling restarted from GUI)
+static uint64 delta(const uint64 current, const uint64 previous)
+{
+    return current >= previous ? current - previous : current;
+}
+
+// Logs one line describing the work done since the previous frame boundary
+void frameSummary(FrameState* const frame, const char* const name, const char* (*mapFunction)(uint16_t),
+    const ProfilingItem* const current, ProfilingItem* const previous, const int count,
+    const PrimitiveCounter* const counter)
+{
+    MyClock now;
+    ITimer->ReadEClock(&now.clockVal);
+
+    uint64 calls = 0;
+    uint64 ticks = 0;
+    uint64 errors = 0;
+
+    ProfilingItem top[FRAME_TOP_FUNCTIONS] = { { 0 } };
+
+    for (int i = 0; i < count; i++) {
+        ProfilingItem item;
+        item.callCount = delta(current[i].callCount, previous[i].callCount);
+        item.ticks = delta(current[i].ticks, previous[i].ticks);
+        item.errors = delta(current[i].errors, previous[i].errors);
+        item.index = i;
+
+        calls += item.callCount;
+        ticks += item.ticks;
+        errors += item.errors;
+
+        // Keep the most expensive functions, in descending order
+        for (int t = 0; t < FRAME_TOP_FUNCTIONS; t++) {
+            if (item.callCount && item.ticks > top[t].ticks) {
+                for (int m = FRAME_TOP_FUNCTIONS - 1; m > t; m--) {
+                    top[m] = top[m - 1];
+                }
+                top[t] = item;
+                break;
+            }
+        }
+
+        previous[i] = current[i];
+    }
+
+    const uint64 frameTicks = frame->clock ? now.ticks - frame->clock : 0;
+    const uint64 vertices = delta(primitiveTotal(counter), primitiveTotal(&frame->counter));
+
+    char topBuffer[256];
+    size_t len = 0;
+
+    topBuffer[0] = '\0';
+
+    for (int t = 0; t < FRAME_TOP_FUNCTIONS && top[t].callCount && len < sizeof(topBuffer); t++) {
+        len += (size_t)snprintf(topBuffer + len, sizeof(topBuffer) - len, "%s%s %llux %.3f ms",
+            t ? ", " : "", mapFunction((uint16_t)top[t].index), top[t].callCount, timer_ticks_to_ms(top[t].ticks));
+    }
+
+    logAlways("%s: Frame %llu: %.3f ms, %llu calls taking %.3f ms, %llu errors, %llu vertices. Top: %s",
+        name, frame->number, timer_ticks_to_ms(frameTicks), calls, timer_ticks_to_ms(ticks), errors, vertices, topBuffer);
+
+    frame->number++;
+    frame->clock = now.ticks;
+    frame->counter = *counter;
+}
+
+// The application updates its 64-bit counters while they are read, and on
+// 32-bit PowerPC a read can mix the halves of two values. Such a value moved
+// backwards or grew more than the interval allows; read it again. If it stays
+// off, the previous value is kept and its delta goes into the next interval.
+static uint64 readCounter(const uint64* const live, const uint64 previous, const uint64 budget)
+{
+    for (int i = 0; i < TORN_READ_RETRIES; i++) {
+        const uint64 value = *(const volatile uint64 *)live;
+
+        if (value >= previous && value - previous <= budget) {
+            return value;
+        }
+    }
+
+    return previous;
+}
+
+void intervalSummary(FrameState* const state, const char* const name, const char* (*mapFunction)(uint16_t),
+    const ProfilingItem* const live, const PrimitiveCounter* const liveCounter, ProfilingItem* const current,
+    ProfilingItem* const previous, const int count, const int frameFunction, const int* const drawFunctions,
+    const int drawCount)
+{
+    MyClock now;
+    ITimer->ReadEClock(&now.clockVal);
+
+    const uint64 elapsed = now.ticks - state->clock;
+
+    // Neither the duration nor the number of calls can grow faster than
+    // the clock runs in each task using the context
+    const uint64 budget = elapsed * INTERVAL_TASKS;
+
+    uint64 calls = 0;
+    uint64 ticks = 0;
+    uint64 errors = 0;
+
+    for (int i = 0; i < count; i++) {
+        ProfilingItem item;
+
+        item.callCount = readCounter(&live[i].callCount, previous[i].callCount, budget);
+        item.ticks = readCounter(&live[i].ticks, previous[i].ticks, budget);
+        item.errors = readCounter(&live[i].errors, previous[i].errors, budget);
+
+        current[i].callCount = item.callCount - previous[i].callCount;
+        current[i].ticks = item.ticks - previous[i].ticks;
+        current[i].errors = item.errors - previous[i].errors;
+        current[i].index = i;
+
+        calls += current[i].callCount;
+        ticks += current[i].ticks;
+        errors += current[i].errors;
+
+        previous[i].callCount = item.callCount;
+        previous[i].ticks = item.ticks;
+        previous[i].errors = item.errors;
+    }
+
+    uint64 drawcalls = 0;
+
+    for (int d = 0; d < drawCount; d++) {
+        drawcalls += current[drawFunctions[d]].callCount;
+    }
+
+    const uint64 frames = current[frameFunction].callCount;
+
+    const double seconds = timer_ticks_to_s(elapsed);
+    const uint64 primitiveBudget = (uint64)(seconds * (double)INTERVAL_PRIMITIVES_PER_SECOND);
+
+    PrimitiveCounter counter;
+    counter.triangles = readCounter(&liveCounter->triangles, state->counter.triangles, primitiveBudget);
+    counter.triangleStrips = readCounter(&liveCounter->triangleStrips, state->counter.triangleStrips, primitiveBudget);
+    counter.triangleFans = readCounter(&liveCounter->triangleFans, state->counter.triangleFans, primitiveBudget);
+    counter.lines = readCounter(&liveCounter->lines, state->counter.lines, primitiveBudget);
+    counter.lineStrips = readCounter(&liveCounter->lineStrips, state->counter.lineStrips, primitiveBudget);
+    counter.lineLoops = readCounter(&liveCounter->lineLoops, state->counter.lineLoops, primitiveBudget);
+    counter.points = readCounter(&liveCounter->points, state->counter.points, primitiveBudget);
+
+    PrimitiveCounter primitives;
+    primitives.triangles = counter.triangles - state->counter.triangles;
+    primitives.triangleStrips = counter.triangleStrips - state->counter.triangleStrips;
+    primitives.triangleFans = counter.triangleFans - state->counter.triangleFans;
+    primitives.lines = counter.lines - state->counter.lines;
+    primitives.lineStrips = counter.lineStrips - state->counter.lineStrips;
+    primitives.lineLoops = counter.lineLoops - state->counter.lineLoops;
+    primitives.points = counter.points - state->counter.points;
+
+    logAlways("\n%s: Interval %llu: %.3f s, %llu calls taking %.3f ms, %llu errors, %llu frames (%.1f frames/s), %llu draw calls",
+        name, state->number, seconds, calls, timer_ticks_to_ms(ticks), errors, frames, (double)frames / seconds, drawcalls);
+
+    if (calls) {
+        sort(current, (unsigned)count);
+
+        logAlways("%30s | %10s | %10s | %20s | %20s", "function", "call count", "errors", "duration (ms)", "avg. call dur. (us)");
+
+        for (int i = 0; i < count; i++) {
+            if (current[i].callCount == 0) {
+                continue;
+            }
+
+            logAlways("%30s | %10llu | %10llu | %20.6f | %20.3f",
+                mapFunction((uint16_t)current[i].index),
+                current[i].callCount,
+                current[i].errors,
+                timer_ticks_to_ms(current[i].ticks),
+                timer_ticks_to_us(current[i].ticks) / (double)current[i].callCount);
+        }
+
+        primitiveStats(&primitives, seconds, (double)drawcalls);
+    }
+
+    state->number++;
+    state->clock = now.ticks;
+    state->counter = counter;
+}
@@ -1,11 +1,20 @@
 #ifndef PROFILING_H
 #define PROFILING_H
 
+#include "common.h"
+#include "histogram.h"
+#include "frametime.h"
+#include "nesting.h"
+
 #include <proto/timer.h>
 
+#include <stdint.h>
+
 typedef struct ProfilingItem
 {
     uint64 ticks;
+    uint64 childTicks; // Part of ticks spent in nested Warp3D Nova calls
+    uint64 tracerTicks; // Part of ticks spent recording the nested calls
     uint64 callCount;
     uint64 errors;
     uint64 nullptrs;
@@ -29,15 +38,31 @@ typedef struct PrimitiveCounter {
     uint64 points;
 } PrimitiveCounter;
 
+// State at the previous frame boundary (SwapBuffers or Submit) or interval snapshot
+typedef struct FrameState {
+    uint64 number;
+    uint64 clock; // EClock value at the boundary
+    PrimitiveCounter counter;
+} FrameState;
+
 #define PROF_INIT(context, LAST_INDEX) \
     ITimer->ReadEClock(&context->start.clockVal); \
     context->ticks = 0; \
+    context->frame.clock = context->start.ticks; \
+    context->afterTicks = 0; \
+    context->interval.clock = context->start.ticks; \
+    memset(&context->interval.counter, 0, sizeof(context->interval.counter)); \
+    memset(context->intervalProfiling, 0, sizeof(context->intervalProfiling)); \
+    frametime_reset(&context->frameTimes); \
     for (int item = 0; item < LAST_INDEX; item++) { \
         ProfilingItem *pi = &context->profiling[item]; \
         pi->ticks = 0; \
+        pi->childTicks = 0; \
+        pi->tracerTicks = 0; \
         pi->callCount = 0; \
         pi->errors = 0; \
         pi->index = item; \
+        histogram_reset(&context->latency[item]); \
     }
 
 #define PROF_START \
@@ -49,7 +74,36 @@ typedef struct PrimitiveCounter {
     const uint64 duration = finish.ticks - start.ticks; \
     context->ticks += duration; \
     context->profiling[func].ticks += duration; \
-    context->profiling[func].callCount++;
+    context->profiling[func].callCount++; \
+    histogram_add(&context->latency[func], duration);
+
+// OGLES2 calls push a nesting frame, so that the Nova calls made inside can be
+// counted as child time. The frame is pushed outside the measured time, on the
+// stack of the calling task, which may not be the one that opened the context.
+#define PROF_START_PARENT(func) \
+    NestingFrame* const nesting = nesting_enter(IExec->FindTask(NULL), context->task, &context->nesting, \
+        &context->children[func]); \
+    PROF_START
+
+#define PROF_FINISH_PARENT(func) \
+    PROF_FINISH(func) \
+    if (nesting) { \
+        context->profiling[func].childTicks += nesting->childTicks; \
+        context->profiling[func].tracerTicks += nesting->tracerTicks; \
+        nesting_leave(nesting); \
+    }
+
+// Tracer work after the measured duration: recording and GL error checks
+#define PROF_AFTER \
+    MyClock after; \
+    ITimer->ReadEClock(&after.clockVal); \
+    const uint64 afterDuration = after.ticks - finish.ticks; \
+    context->afterTicks += afterDuration;
+
+// Nova calls credit their duration, and the time spent recording them, to the
+// enclosing OGLES2 call, if any
+#define PROF_CHILD(func, tracer) \
+    nesting_child(IExec->FindTask(NULL), &context->nesting, func, duration, tracer);
 
 #define PROF_FINISH_CONTEXT \
     MyClock finish; \
@@ -66,10 +120,70 @@ typedef struct PrimitiveCounter {
         (double)context->ticks * 100.0 / (double)totalTicks, \
         timer_ticks_to_ms(totalTicks));
 
+// Instrumentation cost measured at startup, in EClock ticks per call
+typedef struct Overhead {
+    double timerRead; // One ReadEClock
+    double interval; // Measured by an empty PROF_START/PROF_FINISH pair, part of every call duration
+    double ogles2Call; // Whole empty OGLES2 wrapper, without recording and the GL error check
+    double novaCall; // Whole empty Nova wrapper, without recording
+} Overhead;
+
+extern Overhead overhead;
+
+void profiling_calibrate(void);
+
+// Tracer time included in the measured duration of a function: the calibrated
+// timer cost, the calibrated wrappers of the nested calls and their measured recording
+uint64 overheadTicks(const ProfilingItem* const item, const uint64 nestedCalls);
+
+// Tracer time included in the measured durations of the nested calls
+uint64 childOverheadTicks(const uint64 nestedCalls);
+
+// Ticks minus overhead, at least zero
+uint64 correctTicks(const uint64 ticks, const uint64 overheadTicks);
+
+// Logs the estimated time glSnoop added to the application
+void overheadStats(const ProfilingItem* const items, const int count, const double callTicks,
+    const uint64 extraTicks, const uint64 totalTicks);
+
+// Logs the work done since the previous snapshot. The live counters are read
+// while the application runs, current receives the deltas.
+void intervalSummary(FrameState* const state, const char* const name, const char* (*mapFunction)(uint16_t),
+    const ProfilingItem* const live, const PrimitiveCounter* const liveCounter, ProfilingItem* const current,
+    ProfilingItem* const previous, const int count, const int frameFunction, const int* const drawFunctions,
+    const int drawCount);
+
+#define SUMMARY_ROWS 5 // Functions kept per dropped client
+
+// What is kept of a dropped client for the final report. The full context is freed.
+typedef struct ClientSummary {
+    char name[NAME_LEN];
+    ULONG id;
+    const struct Task* task;
+    uint64 lifetime;
+    uint64 ticks; // Total duration of the patched calls
+    uint64 calls;
+    unsigned rowCount;
+    ProfilingItem rows[SUMMARY_ROWS]; // Longest total durations first
+} ClientSummary;
+
+// Returns NULL when out of memory
+ClientSummary* summarizeClient(const char* const name, const ULONG id, const struct Task* const task,
+    const uint64 lifetime, const uint64 ticks, const ProfilingItem* const items, const int count);
+
+// Logs the summaries of the dropped clients
+void summaryResults(const char* const title, void* const* const summaries, const size_t count,
+    const char* (*mapFunction)(uint16_t));
+
 int tickComparison(const void* first, const void* second);
 void sort(ProfilingItem* items, const unsigned count);
 
+uint64 primitiveTotal(const PrimitiveCounter* const counter);
 void primitiveStats(const PrimitiveCounter* const counter, const double seconds, const double drawcalls);
 
+void frameSummary(FrameState* const frame, const char* const name, const char* (*mapFunction)(uint16_t),
+    const ProfilingItem* const current, ProfilingItem* const previous, const int count,
+    const PrimitiveCounter* const counter);
+
 #endif
 
@@ -0,0 +1,342 @@
+#include "recorder.h"
+#include "common.h"
+#include "logger.h"
+#include "timer.h"
+
+#include <proto/exec.h>
+#include <proto/dos.h>
+
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#define TRACE_RING_CAPACITY 4096 // Records per client, must be a power of two
+#define DRAIN_DELAY_TICKS 5 // 1/10 second
+
+struct TraceClient
+{
+    struct TraceClient* next;
+    TraceRing ring;
+    TraceNameFunc mapFunction;
+    char name[NAME_LEN];
+
+    // Run-length compression: identical consecutive calls are counted, not recorded.
+    // Tasks sharing the context take turns with compressMutex.
+    APTR compressMutex;
+    TraceRecord last;
+    uint32_t repeats;
+    uint64 repeatTicks;
+};
+
+static struct TraceClient* clients; // List of the open clients
+static APTR mutex;
+
+static struct Process* drainProcess;
+static volatile BOOL drainRunning;
+static BOOL compressRepeats;
+static SinkCounters closedCounters; // Totals of the clients already closed
+
+static void add_counters(SinkCounters * counters, const struct TraceClient* const client)
+{
+    counters->written += client->ring.written;
+    counters->dropped += client->ring.dropped;
+    counters->bytes += client->ring.written * sizeof(TraceRecord);
+}
+
+static void drain_client(struct TraceClient* client)
+{
+    const TraceRecord* record;
+
+    while ((record = trace_ring_peek(&client->ring))) {
+        char buffer[256];
+
+        trace_format(record, client->name, client->mapFunction(record->function),
+            timer_get_elapsed_seconds_at(record->ticks), buffer, sizeof(buffer));
+
+        trace_ring_release(&client->ring);
+
+        logText(buffer);
+    }
+}
+
+static void push_record(struct TraceClient* client, const TraceRecord* record)
+{
+    uint32_t position;
+    TraceRecord* slot = trace_ring_reserve(&client->ring, &position);
+
+    if (slot) {
+        memcpy(slot, record, offsetof(TraceRecord, args) + record->argCount * sizeof(uint32_t));
+        trace_ring_commit(&client->ring, position);
+    }
+}
+
+// Needs compressMutex
+static void flush_repeats(struct TraceClient* client)
+{
+    if (client->repeats) {
+        TraceRecord record = client->last;
+
+        record.ticks = client->repeatTicks;
+        record.module |= TRACE_REPEAT_FLAG;
+        record.argCount = 1;
+        record.args[0] = client->repeats;
+
+        push_record(client, &record);
+
+        client->repeats = 0;
+    }
+}
+
+static void close_client(struct TraceClient* client)
+{
+    if (client->compressMutex) {
+        IExec->MutexObtain(client->compressMutex);
+        flush_repeats(client);
+        IExec->MutexRelease(client->compressMutex);
+    }
+
+    drain_client(client);
+    add_counters(&closedCounters, client);
+}
+
+static void free_client(struct TraceClient* client)
+{
+    if (client->compressMutex) {
+        IExec->FreeSysObject(ASOT_MUTEX, client->compressMutex);
+    }
+
+    IExec->FreeVec(client);
+}
+
+void recorder_drain(void)
+{
+    if (mutex) {
+        IExec->MutexObtain(mutex);
+
+        for (struct TraceClient* client = clients; client; client = client->next) {
+            drain_client(client);
+        }
+
+        IExec->MutexRelease(mutex);
+    }
+}
+
+static void drain_process(void)
+{
+    while (!(IExec->SetSignal(0L, SIGBREAKF_CTRL_C) & SIGBREAKF_CTRL_C)) {
+        recorder_drain();
+        IDOS->Delay(DRAIN_DELAY_TICKS);
+    }
+
+    recorder_drain();
+
+    drainRunning = FALSE;
+}
+
+BOOL recorder_init(LONG compress)
+{
+    compressRepeats = compress != 0;
+
+    mutex = IExec->AllocSysObject(ASOT_MUTEX, TAG_DONE);
+
+    if (!mutex) {
+        puts("Failed to allocate recorder mutex");
+        return FALSE;
+    }
+
+    drainRunning = TRUE;
+
+    drainProcess = IDOS->CreateNewProcTags(
+        NP_Entry, drain_process,
+        NP_Name, "glSnoop trace drain",
+        NP_Priority, -1,
+        NP_Child, TRUE,
+        TAG_DONE);
+
+    if (!drainProcess) {
+        puts("Failed to create trace drain process");
+        drainRunning = FALSE;
+        recorder_quit();
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+void recorder_quit(void)
+{
+    if (drainProcess) {
+        IExec->Signal((struct Task *)drainProcess, SIGBREAKF_CTRL_C);
+
+        while (drainRunning) {
+            IDOS->Delay(1);
+        }
+
+        drainProcess = NULL;
+    }
+
+    if (mutex) {
+        IExec->MutexObtain(mutex);
+
+        while (clients) {
+            struct TraceClient* const client = clients;
+            clients = client->next;
+
+            close_client(client);
+            free_client(client);
+        }
+
+        IExec->MutexRelease(mutex);
+
+        IExec->FreeSysObject(ASOT_MUTEX, mutex);
+        mutex = NULL;
+    }
+}
+
+BOOL recorder_enabled(void)
+{
+    return mutex != NULL;
+}
+
+struct TraceClient* recorder_open(const char* const name, TraceNameFunc mapFunction)
+{
+    if (!mutex) {
+        return NULL;
+    }
+
+    const size_t ringSize = trace_ring_memory_size(sizeof(TraceRecord), TRACE_RING_CAPACITY);
+
+    struct TraceClient* client = IExec->AllocVecTags(sizeof(struct TraceClient) + ringSize,
+        AVT_Type, MEMF_SHARED,
+        TAG_DONE);
+
+    if (!client) {
+        logAlways("Cannot allocate memory for trace buffer");
+        return NULL;
+    }
+
+    trace_ring_init(&client->ring, client + 1, sizeof(TraceRecord), TRACE_RING_CAPACITY);
+    client->mapFunction = mapFunction;
+    client->last.argCount = 0xFF; // Never matches a real call
+    client->repeats = 0;
+    snprintf(client->name, sizeof(client->name), "%s", name);
+
+    if (compressRepeats) {
+        client->compressMutex = IExec->AllocSysObject(ASOT_MUTEX, TAG_DONE);
+
+        if (!client->compressMutex) {
+            logAlways("Cannot allocate trace compression mutex");
+            IExec->FreeVec(client);
+            return NULL;
+        }
+    }
+
+    IExec->MutexObtain(mutex);
+
+    client->next = clients;
+    clients = client;
+
+    IExec->MutexRelease(mutex);
+
+    logDebug("%s: trace buffer %lu bytes", name, (ULONG)ringSize);
+
+    return client;
+}
+
+void recorder_close(struct TraceClient* client)
+{
+    if (!client || !mutex) {
+        return;
+    }
+
+    IExec->MutexObtain(mutex);
+
+    close_client(client);
+
+    for (struct TraceClient** link = &clients; *link; link = &(*link)->next) {
+        if (*link == client) {
+            *link = client->next;
+            break;
+        }
+    }
+
+    IExec->MutexRelease(mutex);
+
+    if (client->ring.dropped) {
+        logAlways("%s: %u trace records dropped, buffer was full", client->name, (unsigned)client->ring.dropped);
+    }
+
+    free_client(client);
+}
+
+void recorder_frame(struct TraceClient* client)
+{
+    if (client->compressMutex) {
+        IExec->MutexObtain(client->compressMutex);
+        flush_repeats(client);
+        IExec->MutexRelease(client->compressMutex);
+    }
+}
+
+void recorder_counters(SinkCounters * counters)
+{
+    *counters = closedCounters;
+
+    if (mutex) {
+        IExec->MutexObtain(mutex);
+
+        for (struct TraceClient* client = clients; client; client = client->next) {
+            add_counters(counters, client);
+        }
+
+        IExec->MutexRelease(mutex);
+    }
+}
+
+void recorder_write(struct TraceClient* client, const uint64 ticks, const struct Task* const task,
+    const TraceModule module, const uint16 function, const uint32_t* const args, const size_t argCount)
+{
+    if (client->compressMutex) {
+        TraceRecord* last = &client->last;
+
+        IExec->MutexObtain(client->compressMutex);
+
+        if (last->function == function && last->module == (uint8_t)module && last->argCount == argCount &&
+            memcmp(last->args, args, argCount * sizeof(uint32_t)) == 0) {
+            client->repeats++;
+            client->repeatTicks = ticks;
+            IExec->MutexRelease(client->compressMutex);
+            return;
+        }
+
+        flush_repeats(client);
+
+        last->ticks = ticks;
+        last->task = trace_word_pointer(task);
+        last->function = function;
+        last->module = (uint8_t)module;
+        last->argCount = (uint8_t)argCount;
+
+        memcpy(last->args, args, argCount * sizeof(uint32_t));
+
+        push_record(client, last);
+
+        IExec->MutexRelease(client->compressMutex);
+        return;
+    }
+
+    uint32_t position;
+    TraceRecord* record = trace_ring_reserve(&client->ring, &position);
+
+    if (record) {
+        record->ticks = ticks;
+        record->task = trace_word_pointer(task);
+        record->function = function;
+        record->module = (uint8_t)module;
+        record->argCount = (uint8_t)argCount;
+
+        memcpy(record->args, args, argCount * sizeof(uint32_t));
+
+        trace_ring_commit(&client->ring, position);
+    }
+}
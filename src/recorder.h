@@ -0,0 +1,46 @@
+#ifndef RECORDER_H
+#define RECORDER_H
+
+#include "trace.h"
+#include "flight.h"
+
+#include <exec/types.h>
+
+struct Task;
+struct TraceClient;
+
+// Identical consecutive calls are stored as a repeat count when compress is set
+BOOL recorder_init(LONG compress);
+void recorder_quit(void);
+BOOL recorder_enabled(void);
+void recorder_counters(SinkCounters * counters);
+
+struct TraceClient* recorder_open(const char* const name, TraceNameFunc mapFunction);
+void recorder_close(struct TraceClient* client);
+
+void recorder_write(struct TraceClient* client, const uint64 ticks, const struct Task* const task,
+    const TraceModule module, const uint16 function, const uint32_t* const args, const size_t argCount);
+
+// Writes the pending repeat count at the end of a frame (aglSwapBuffers, W3DN_Submit)
+void recorder_frame(struct TraceClient* client);
+
+void recorder_drain(void);
+
+// Append a binary record of the call, when the context has a trace buffer or a flight recorder.
+// Wrappers record after PROF_FINISH, stamped with the start ticks, so that the
+// recording cost stays outside the measured duration.
+#define RECORDING(context, traced) ((context->trace && traced) || context->flight)
+
+#define RECORD_CALL(context, traced, module, id, ticks, ...) \
+if (RECORDING(context, traced)) { \
+    const uint32_t traceWords[] = { 0, TRACE_WORDS(__VA_ARGS__) }; \
+    const size_t traceWordCount = sizeof(traceWords) / sizeof(traceWords[0]) - 1; \
+    if (context->trace && traced) { \
+        recorder_write(context->trace, ticks, context->task, module, id, traceWords + 1, traceWordCount); \
+    } \
+    if (context->flight) { \
+        flight_write(context->flight, ticks, context->task, module, id, traceWords + 1, traceWordCount); \
+    } \
+}
+
+#endif
@@ -0,0 +1,70 @@
+#include "sinks.h"
+#include "logger.h"
+#include "filesink.h"
+#include "recorder.h"
+#include "flight.h"
+#include "timer.h"
+
+#include <stdio.h>
+
+static void report(const char* const name, const SinkCounters* const counters)
+{
+    logAlways("%20s | %12llu | %12llu | %14llu | %16.3f", name, counters->written, counters->dropped,
+        counters->bytes, timer_ticks_to_ms(counters->blockedTicks));
+}
+
+void sinks_report(void)
+{
+    SinkCounters counters;
+
+    logAlways("\nLog sink statistics:");
+    logAlways("%20s | %12s | %12s | %14s | %16s", "sink", "written", "dropped", "bytes", "blocked (ms)");
+
+    log_formatter_counters(&counters);
+    report("formatter", &counters);
+
+    log_serial_counters(&counters);
+    report("serial", &counters);
+
+    if (filesink_enabled()) {
+        filesink_counters(&counters);
+        report("file", &counters);
+    }
+
+    if (recorder_enabled()) {
+        recorder_counters(&counters);
+        report("binary trace", &counters);
+    }
+
+    if (flight_enabled()) {
+        flight_counters(&counters);
+        report("flight recorder", &counters);
+    }
+}
+
+const char* sinks_string(void)
+{
+    static char sinkBuffer[64];
+
+    SinkCounters formatter;
+    SinkCounters records = { 0, 0, 0, 0 };
+
+    log_formatter_counters(&formatter);
+
+    if (recorder_enabled()) {
+        recorder_counters(&records);
+    }
+
+    uint64 dropped = formatter.dropped + records.dropped;
+
+    if (filesink_enabled()) {
+        SinkCounters file;
+        filesink_counters(&file);
+        dropped += file.dropped;
+    }
+
+    snprintf(sinkBuffer, sizeof(sinkBuffer), "Log lines: %llu, records: %llu, lost: %llu",
+        formatter.written, records.written, dropped);
+
+    return sinkBuffer;
+}
@@ -0,0 +1,17 @@
+#ifndef SINKS_H
+#define SINKS_H
+
+#include <exec/types.h>
+
+// Accounting for every place where log lines or trace records are written
+typedef struct SinkCounters {
+    uint64 written; // Lines or records
+    uint64 dropped; // Lost, or truncated in case of log lines
+    uint64 bytes;
+    uint64 blockedTicks; // Time callers spent waiting for the sink
+} SinkCounters;
+
+void sinks_report(void);
+const char* sinks_string(void);
+
+#endif
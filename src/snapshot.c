@@ -0,0 +1,76 @@
+#include "snapshot.h"
+#include "ogles2_module.h"
+#include "warp3dnova_module.h"
+#include "timer.h"
+
+#include <proto/exec.h>
+#include <proto/dos.h>
+
+#include <stdio.h>
+
+#define SNAPSHOT_POLL_TICKS 5 // 1/10 second
+
+static struct Process* snapshotProcess;
+static volatile BOOL snapshotRunning;
+static uint64 intervalTicks;
+
+static void snapshot_process(void)
+{
+    uint64 next = timer_get_ticks() + intervalTicks;
+
+    while (!(IExec->SetSignal(0L, SIGBREAKF_CTRL_C) & SIGBREAKF_CTRL_C)) {
+        IDOS->Delay(SNAPSHOT_POLL_TICKS);
+
+        const uint64 now = timer_get_ticks();
+
+        // Scheduled from the previous deadline so that the series doesn't drift
+        if (now >= next) {
+            ogles2_snapshot();
+            warp3dnova_snapshot();
+
+            next += intervalTicks;
+
+            // Skip the missed deadlines when logging was slower than the interval
+            if (next <= now) {
+                next = now + intervalTicks;
+            }
+        }
+    }
+
+    snapshotRunning = FALSE;
+}
+
+BOOL snapshot_init(const ULONG seconds)
+{
+    intervalTicks = (uint64)seconds * timer_get_frequency();
+
+    snapshotRunning = TRUE;
+
+    snapshotProcess = IDOS->CreateNewProcTags(
+        NP_Entry, snapshot_process,
+        NP_Name, "glSnoop interval snapshot",
+        NP_Priority, -1,
+        NP_Child, TRUE,
+        TAG_DONE);
+
+    if (!snapshotProcess) {
+        puts("Failed to create interval snapshot process");
+        snapshotRunning = FALSE;
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+void snapshot_quit(void)
+{
+    if (snapshotProcess) {
+        IExec->Signal((struct Task *)snapshotProcess, SIGBREAKF_CTRL_C);
+
+        while (snapshotRunning) {
+            IDOS->Delay(1);
+        }
+
+        snapshotProcess = NULL;
+    }
+}
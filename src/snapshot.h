@@ -0,0 +1,12 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <exec/types.h>
+
+// Interval snapshots: a background process logs the profiling deltas of every
+// client each N seconds, without resetting the counters.
+
+BOOL snapshot_init(const ULONG seconds);
+void snapshot_quit(void);
+
+#endif
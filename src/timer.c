@@ -219,19 +219,45 @@ double timer_ticks_to_us(const uint64 ticks)
     return 1000000.0 * timer_ticks_to_s(ticks);
 }
 
-double timer_get_elapsed_seconds()
+ULONG timer_get_frequency(void)
 {
-    double time = 0.0;
+    return frequency;
+}
 
-    if (ITimer) {
-        struct MyClock now;
+// EClock value at glSnoop start, log timestamps are relative to this
+uint64 timer_get_start_ticks(void)
+{
+    return start.ticks;
+}
 
+// Raw EClock value, or 0 before the timer is initialized
+uint64 timer_get_ticks(void)
+{
+    struct MyClock now;
+
+    now.ticks = 0;
+
+    if (ITimer) {
         ITimer->ReadEClock(&now.clockVal);
+    }
 
-        const uint64 elapsed = now.ticks - start.ticks;
-        time = timer_ticks_to_s(elapsed);
+    return now.ticks;
+}
+
+double timer_get_elapsed_seconds()
+{
+    double time = 0.0;
+
+    if (ITimer) {
+        time = timer_get_elapsed_seconds_at(timer_get_ticks());
     }
 
     return time;
 }
 
+// Convert an EClock value read earlier into seconds since glSnoop start
+double timer_get_elapsed_seconds_at(const uint64 ticks)
+{
+    return timer_ticks_to_s(ticks - start.ticks);
+}
+
@@ -33,6 +33,10 @@ double timer_ticks_to_s(const uint64 ticks);
 double timer_ticks_to_ms(const uint64 ticks);
 double timer_ticks_to_us(const uint64 ticks);
 
+ULONG timer_get_frequency(void);
+uint64 timer_get_start_ticks(void);
+uint64 timer_get_ticks(void);
 double timer_get_elapsed_seconds();
+double timer_get_elapsed_seconds_at(const uint64 ticks);
 
 #endif
@@ -0,0 +1,274 @@
+#include "trace.h"
+
+#include <stdio.h>
+#include <string.h>
+
+// Every slot starts with a sequence number (Vyukov bounded queue). Producers
+// claim a position with compare-and-swap, consumer releases it by bumping
+// the sequence by the ring capacity.
+
+typedef struct TraceSlotHeader {
+    uint32_t sequence;
+    uint32_t padding;
+} TraceSlotHeader;
+
+static size_t slot_size(const size_t recordSize)
+{
+    const size_t align = sizeof(uint64_t);
+    return (sizeof(TraceSlotHeader) + recordSize + align - 1) & ~(align - 1);
+}
+
+static TraceSlotHeader* slot_at(const TraceRing* ring, const uint32_t position)
+{
+    return (TraceSlotHeader *)(ring->memory + (size_t)(position & ring->mask) * ring->slotSize);
+}
+
+size_t trace_ring_memory_size(const size_t recordSize, const uint32_t capacity)
+{
+    return slot_size(recordSize) * capacity;
+}
+
+int trace_ring_init(TraceRing* ring, void* memory, const size_t recordSize, const uint32_t capacity)
+{
+    if (!ring || !memory || capacity < 2 || (capacity & (capacity - 1))) {
+        return 0;
+    }
+
+    ring->memory = memory;
+    ring->slotSize = slot_size(recordSize);
+    ring->mask = capacity - 1;
+    ring->head = 0;
+    ring->tail = 0;
+    ring->written = 0;
+    ring->dropped = 0;
+
+    for (uint32_t i = 0; i < capacity; i++) {
+        slot_at(ring, i)->sequence = i;
+    }
+
+    return 1;
+}
+
+void* trace_ring_reserve(TraceRing* ring, uint32_t* position)
+{
+    uint32_t pos = __atomic_load_n(&ring->head, __ATOMIC_RELAXED);
+
+    while (1) {
+        TraceSlotHeader* slot = slot_at(ring, pos);
+        const uint32_t sequence = __atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE);
+        const int32_t diff = (int32_t)(sequence - pos);
+
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&ring->head, &pos, pos + 1, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                *position = pos;
+                return slot + 1;
+            }
+        } else if (diff < 0) {
+            // Consumer hasn't released this slot yet: ring is full
+            __atomic_add_fetch(&ring->dropped, 1, __ATOMIC_RELAXED);
+            return NULL;
+        } else {
+            pos = __atomic_load_n(&ring->head, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+void trace_ring_commit(TraceRing* ring, const uint32_t position)
+{
+    __atomic_add_fetch(&ring->written, 1, __ATOMIC_RELAXED);
+    __atomic_store_n(&slot_at(ring, position)->sequence, position + 1, __ATOMIC_RELEASE);
+}
+
+const void* trace_ring_peek(TraceRing* ring)
+{
+    const uint32_t pos = ring->tail;
+    const TraceSlotHeader* slot = slot_at(ring, pos);
+
+    if (__atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE) != pos + 1) {
+        return NULL;
+    }
+
+    return slot + 1;
+}
+
+void trace_ring_release(TraceRing* ring)
+{
+    const uint32_t pos = ring->tail;
+
+    __atomic_store_n(&slot_at(ring, pos)->sequence, pos + ring->mask + 1, __ATOMIC_RELEASE);
+    ring->tail = pos + 1;
+}
+
+int trace_ring_push(TraceRing* ring, const void* record, const size_t size)
+{
+    uint32_t position;
+    void* slot = trace_ring_reserve(ring, &position);
+
+    if (!slot) {
+        return 0;
+    }
+
+    memcpy(slot, record, size);
+    trace_ring_commit(ring, position);
+
+    return 1;
+}
+
+int trace_ring_pop(TraceRing* ring, void* record, const size_t size)
+{
+    const void* slot = trace_ring_peek(ring);
+
+    if (!slot) {
+        return 0;
+    }
+
+    memcpy(record, slot, size);
+    trace_ring_release(ring);
+
+    return 1;
+}
+
+int trace_history_init(TraceHistory* history, void* memory, const uint32_t capacity)
+{
+    if (!history || !memory || capacity < 2 || (capacity & (capacity - 1))) {
+        return 0;
+    }
+
+    history->records = memory;
+    history->mask = capacity - 1;
+    history->head = 0;
+    history->frozen = 0;
+
+    return 1;
+}
+
+// Returns the slot for the next record, or NULL while the history is frozen
+TraceRecord* trace_history_next(TraceHistory* history)
+{
+    if (__atomic_load_n(&history->frozen, __ATOMIC_ACQUIRE)) {
+        return NULL;
+    }
+
+    return &history->records[history->head & history->mask];
+}
+
+void trace_history_publish(TraceHistory* history)
+{
+    __atomic_store_n(&history->head, history->head + 1, __ATOMIC_RELEASE);
+}
+
+uint32_t trace_history_freeze(TraceHistory* history)
+{
+    __atomic_store_n(&history->frozen, 1, __ATOMIC_SEQ_CST);
+    return __atomic_load_n(&history->head, __ATOMIC_ACQUIRE);
+}
+
+void trace_history_thaw(TraceHistory* history)
+{
+    __atomic_store_n(&history->frozen, 0, __ATOMIC_RELEASE);
+}
+
+// First position that is safe to read after freezing at head. The oldest slot
+// is skipped because a write that started before freezing may still target it.
+uint32_t trace_history_oldest(const TraceHistory* history, const uint32_t head)
+{
+    return head > history->mask ? head - history->mask : 0;
+}
+
+const TraceRecord* trace_history_at(const TraceHistory* history, const uint32_t position)
+{
+    return &history->records[position & history->mask];
+}
+
+static uint8_t* put16(uint8_t* p, const uint16_t value)
+{
+    p[0] = (uint8_t)(value >> 8);
+    p[1] = (uint8_t)value;
+    return p + 2;
+}
+
+static uint8_t* put32(uint8_t* p, const uint32_t value)
+{
+    p[0] = (uint8_t)(value >> 24);
+    p[1] = (uint8_t)(value >> 16);
+    p[2] = (uint8_t)(value >> 8);
+    p[3] = (uint8_t)value;
+    return p + 4;
+}
+
+static uint16_t get16(const uint8_t* p)
+{
+    return (uint16_t)((p[0] << 8) | p[1]);
+}
+
+static uint32_t get32(const uint8_t* p)
+{
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+size_t trace_encode(const TraceRecord* record, uint8_t* buffer)
+{
+    const uint8_t argCount = record->argCount > TRACE_MAX_ARGS ? TRACE_MAX_ARGS : record->argCount;
+
+    uint8_t* p = buffer;
+
+    p = put32(p, (uint32_t)(record->ticks >> 32));
+    p = put32(p, (uint32_t)record->ticks);
+    p = put32(p, record->task);
+    p = put16(p, record->function);
+    *p++ = record->module;
+    *p++ = argCount;
+
+    for (uint8_t i = 0; i < argCount; i++) {
+        p = put32(p, record->args[i]);
+    }
+
+    return (size_t)(p - buffer);
+}
+
+size_t trace_decode(const uint8_t* buffer, const size_t length, TraceRecord* record)
+{
+    if (length < TRACE_ENCODED_HEADER_SIZE) {
+        return 0;
+    }
+
+    const uint8_t argCount = buffer[15];
+    const size_t size = TRACE_ENCODED_HEADER_SIZE + 4 * (size_t)argCount;
+
+    if (argCount > TRACE_MAX_ARGS || length < size) {
+        return 0;
+    }
+
+    record->ticks = ((uint64_t)get32(buffer) << 32) | get32(buffer + 4);
+    record->task = get32(buffer + 8);
+    record->function = get16(buffer + 12);
+    record->module = buffer[14];
+    record->argCount = argCount;
+
+    for (uint8_t i = 0; i < argCount; i++) {
+        record->args[i] = get32(buffer + TRACE_ENCODED_HEADER_SIZE + 4 * i);
+    }
+
+    return size;
+}
+
+int trace_format(const TraceRecord* record, const char* client, const char* function, const double seconds,
+    char* buffer, const size_t size)
+{
+    if (record->module & TRACE_REPEAT_FLAG) {
+        return snprintf(buffer, size, "[%.6f] %s: %s: previous call repeated x%u", seconds, client, function,
+            record->argCount ? (unsigned)record->args[0] : 0);
+    }
+
+    int len = snprintf(buffer, size, "[%.6f] %s: %s(", seconds, client, function);
+
+    for (uint8_t i = 0; i < record->argCount && len >= 0 && (size_t)len < size; i++) {
+        len += snprintf(buffer + len, size - (size_t)len, i ? ", 0x%X" : "0x%X", (unsigned)record->args[i]);
+    }
+
+    if (len >= 0 && (size_t)len < size) {
+        len += snprintf(buffer + len, size - (size_t)len, ")");
+    }
+
+    return len;
+}
@@ -0,0 +1,150 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+// Binary trace record core. This file has no AmigaOS dependencies so that
+// records can be encoded, decoded and benchmarked also on other hosts.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define TRACE_MAX_ARGS 12
+
+typedef enum TraceModule {
+    TraceModule_Ogles2,
+    TraceModule_Nova
+} TraceModule;
+
+// Set in TraceRecord.module when the record only tells that the previous
+// record of the client was repeated args[0] more times
+#define TRACE_REPEAT_FLAG 0x80
+
+typedef struct TraceRecord {
+    uint64_t ticks; // Raw EClock value at call entry
+    uint32_t task; // Calling task address
+    uint16_t function; // Ogles2Function or NovaFunction
+    uint8_t module; // TraceModule
+    uint8_t argCount;
+    uint32_t args[TRACE_MAX_ARGS]; // Packed argument words, one per parameter, see trace_word_*
+} TraceRecord;
+
+// Bounded multi-producer, single-consumer ring of fixed-size slots.
+// Memory is provided by the caller so that no allocation happens when recording.
+typedef struct TraceRing {
+    uint8_t* memory;
+    size_t slotSize;
+    uint32_t mask;
+    uint32_t head;
+    uint32_t tail;
+    uint32_t written;
+    uint32_t dropped;
+} TraceRing;
+
+// History of the most recent records, the oldest record is overwritten when
+// full (flight recorder). One producer; a reader freezes it while copying.
+typedef struct TraceHistory {
+    TraceRecord* records;
+    uint32_t mask;
+    uint32_t head; // Total number of records written
+    uint32_t frozen;
+} TraceHistory;
+
+typedef const char* (*TraceNameFunc)(uint16_t function);
+
+// Encoded record: 16 bytes of header and 4 bytes per argument, big-endian
+#define TRACE_ENCODED_HEADER_SIZE 16
+#define TRACE_ENCODED_MAX_SIZE (TRACE_ENCODED_HEADER_SIZE + 4 * TRACE_MAX_ARGS)
+
+size_t trace_ring_memory_size(const size_t recordSize, const uint32_t capacity);
+int trace_ring_init(TraceRing* ring, void* memory, const size_t recordSize, const uint32_t capacity);
+
+void* trace_ring_reserve(TraceRing* ring, uint32_t* position);
+void trace_ring_commit(TraceRing* ring, const uint32_t position);
+const void* trace_ring_peek(TraceRing* ring);
+void trace_ring_release(TraceRing* ring);
+
+int trace_ring_push(TraceRing* ring, const void* record, const size_t size);
+int trace_ring_pop(TraceRing* ring, void* record, const size_t size);
+
+int trace_history_init(TraceHistory* history, void* memory, const uint32_t capacity);
+TraceRecord* trace_history_next(TraceHistory* history);
+void trace_history_publish(TraceHistory* history);
+uint32_t trace_history_freeze(TraceHistory* history);
+void trace_history_thaw(TraceHistory* history);
+uint32_t trace_history_oldest(const TraceHistory* history, const uint32_t head);
+const TraceRecord* trace_history_at(const TraceHistory* history, const uint32_t position);
+
+size_t trace_encode(const TraceRecord* record, uint8_t* buffer);
+size_t trace_decode(const uint8_t* buffer, const size_t length, TraceRecord* record);
+
+int trace_format(const TraceRecord* record, const char* client, const char* function, const double seconds,
+    char* buffer, const size_t size);
+
+// Argument packing helpers. Each traced argument is stored as one 32-bit word:
+// integers and pointers by value, floats by their bit pattern. Word i is
+// always parameter i, argument conditions and decoders rely on that.
+//
+// Lossy: 64-bit integers (the uint64 offsets and sizes of Nova) keep only
+// their low 32 bits, and doubles are narrowed to float. A recorded value
+// of such a parameter is exact only when it fits.
+
+static inline uint32_t trace_word_s32(const int32_t value) { return (uint32_t)value; }
+static inline uint32_t trace_word_u32(const uint32_t value) { return value; }
+static inline uint32_t trace_word_slong(const long value) { return (uint32_t)value; }
+static inline uint32_t trace_word_ulong(const unsigned long value) { return (uint32_t)value; }
+static inline uint32_t trace_word_s64(const long long value) { return (uint32_t)value; }
+static inline uint32_t trace_word_u64(const unsigned long long value) { return (uint32_t)value; }
+static inline uint32_t trace_word_pointer(const volatile void* value) { return (uint32_t)(uintptr_t)value; }
+
+static inline uint32_t trace_word_float(const float value)
+{
+    union { float f; uint32_t u; } conversion;
+    conversion.f = value;
+    return conversion.u;
+}
+
+static inline uint32_t trace_word_double(const double value)
+{
+    return trace_word_float((float)value);
+}
+
+#define TRACE_WORD(x) _Generic((x), \
+    float: trace_word_float, \
+    double: trace_word_double, \
+    _Bool: trace_word_u32, \
+    char: trace_word_s32, \
+    signed char: trace_word_s32, \
+    unsigned char: trace_word_u32, \
+    short: trace_word_s32, \
+    unsigned short: trace_word_u32, \
+    int: trace_word_s32, \
+    unsigned int: trace_word_u32, \
+    long: trace_word_slong, \
+    unsigned long: trace_word_ulong, \
+    long long: trace_word_s64, \
+    unsigned long long: trace_word_u64, \
+    default: trace_word_pointer)(x)
+
+#define TRACE_NARGS(...) TRACE_NARGS_(0, ##__VA_ARGS__, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define TRACE_NARGS_(_0, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, N, ...) N
+
+#define TRACE_WORDS_0()
+#define TRACE_WORDS_1(a) TRACE_WORD(a)
+#define TRACE_WORDS_2(a, ...) TRACE_WORD(a), TRACE_WORDS_1(__VA_ARGS__)
+#define TRACE_WORDS_3(a, ...) TRACE_WORD(a), TRACE_WORDS_2(__VA_ARGS__)
+#define TRACE_WORDS_4(a, ...) TRACE_WORD(a), TRACE_WORDS_3(__VA_ARGS__)
+#define TRACE_WORDS_5(a, ...) TRACE_WORD(a), TRACE_WORDS_4(__VA_ARGS__)
+#define TRACE_WORDS_6(a, ...) TRACE_WORD(a), TRACE_WORDS_5(__VA_ARGS__)
+#define TRACE_WORDS_7(a, ...) TRACE_WORD(a), TRACE_WORDS_6(__VA_ARGS__)
+#define TRACE_WORDS_8(a, ...) TRACE_WORD(a), TRACE_WORDS_7(__VA_ARGS__)
+#define TRACE_WORDS_9(a, ...) TRACE_WORD(a), TRACE_WORDS_8(__VA_ARGS__)
+#define TRACE_WORDS_10(a, ...) TRACE_WORD(a), TRACE_WORDS_9(__VA_ARGS__)
+#define TRACE_WORDS_11(a, ...) TRACE_WORD(a), TRACE_WORDS_10(__VA_ARGS__)
+#define TRACE_WORDS_12(a, ...) TRACE_WORD(a), TRACE_WORDS_11(__VA_ARGS__)
+
+#define TRACE_CONCAT_(a, b) a ## b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+
+// Expands to a comma separated list of argument words
+#define TRACE_WORDS(...) TRACE_CONCAT(TRACE_WORDS_, TRACE_NARGS(__VA_ARGS__))(__VA_ARGS__)
+
+#endif
@@ -0,0 +1,121 @@
+#ifndef WARP3DNOVA_FUNCTIONS_H
+#define WARP3DNOVA_FUNCTIONS_H
+
+// The patched Warp3DNova context functions: X(name, returnType, parameters, categories)
+//
+// Everything per function (ids, names, original function pointers, patches and
+// filter categories) is generated from this list. Keep the order, function ids
+// are stored into the binary traces.
+
+#define NOVA_FUNCTIONS(X) \
+    X(BindBitMapAsTexture, W3DN_ErrorCode, (struct W3DN_Context_s *self, W3DN_RenderState *renderState, uint32 texUnit, struct BitMap *bitMap, W3DN_TextureSampler *texSampler), Category_State) \
+    X(BindShaderDataBuffer, W3DN_ErrorCode, (struct W3DN_Context_s *self, W3DN_RenderState *renderState, W3DN_ShaderType shaderType, W3DN_DataBuffer *buffer, uint32 bufferIdx), Category_State) \
+    X(BindTexture, W3DN_ErrorCode, (struct W3DN_Context_s *self, W3DN_RenderState *renderState, uint32 texUnit, W3DN_Texture *texture, W3DN_TextureSampler *texSampler), Category_State) \
+    X(BindVertexAttribArray, W3DN_ErrorCode, (struct W3DN_Context_s *self, W3DN_RenderState *renderState, uint32 attribNum, W3DN_VertexBuffer *buffer, uint32 arrayIdx), Category_State) \
+    X(BufferUnlock, W3DN_ErrorCode, (struct W3DN_Context_s *self, W3DN_BufferLock *bufferLock, uint64 writeOffset, uint64 writeSize), Category_Upload) \
+    X(Clear, W3DN_ErrorCode, (struct W3DN_Context_s *self, W3DN_RenderState *renderState, const float *colour, const double *depth, const uint32* stencil), Category_Draw) \
+    X(CompileShader, W3DN_Shader*, (struct W3DN_Context_s *self, W3DN_ErrorCode *errCode, struct TagItem *tags), Category_Shader) \
+    X(CreateDataBufferObject, W3DN_DataBuffer*, (struct W3DN_Context_s *self, W3DN_ErrorCode *errCode, uint64 size, W3DN_BufferUsage usage, uint32 maxBuffers, struct TagItem *tags), Category_None) \
+    X(CreateFrameBuffer, W3DN_FrameBuffer*, (struct W3DN_Context_s *self, W3DN_ErrorCode *errCode), Category_None) \
+    X(CreateRenderStateObject, W3DN_RenderState*, (struct W3DN_Context_s *self, W3DN_ErrorCode *errCode), Category_None) \
+    X(CreateShaderPipeline, W3DN_ShaderPipeline*, (struct W3DN_Context_s *self, W3DN_ErrorCode *errCode, struct TagItem *tags), Category_Shader) \
+    X(CreateTexSampler, W3DN_TextureSampler*, (struct W3DN_Context_s *self, W3DN_ErrorCode *errCode), Category_None) \
+    X(CreateTexture, W3DN_Texture*, (struct W3DN_Context_s *self, W3DN_ErrorCode *errCode, W3DN_TextureType texType, W3DN_PixelFormat pixelFormat, W3DN_ElementFormat elementFormat, uint32 width, uint32 height, uint32 depth, BOOL mipmapped, W3DN_BufferUsage usage), Category_None) \
+    X(CreateTextureExtRMB, W3DN_Texture*, (struct W3DN_Context_s *self, W3DN_ErrorCode *errCode, void *rmBuffer, W3DN_ResourceLayout * layout, W3DN_TextureType texType, W3DN_PixelFormat pixelFormat, W3DN_ElementFormat elementFormat, uint32 width, uint32 height, uint32 depth, BOOL mipmapped), Category_None) \
+    X(CreateVertexBufferObject, W3DN_VertexBuffer*, (struct W3DN_Context_s *self, W3DN_ErrorCode *errCode, uint64 size, W3DN_BufferUsage usage, uint32 maxArrays, struct TagItem *tags), Category_None) \
+    X(DBOGetAttr, uint64, (struct W3DN_Context_s *self, W3DN_DataBuffer *dataBuffer, W3DN_BufferAttribute attr), Category_Query) \
+    X(DBOGetBuffer, W3DN_ErrorCode, (struct W3DN_Context_s *self, W3DN_DataBuffer *dataBuffer, uint32 bufferIdx, uint64 *offset, uint64 *size, W3DN_Shader **targetShader, struct TagItem *tags), Category_Query) \
+    X(DBOLock, W3DN_BufferLock*, (struct W3DN_Context_s *self, W3DN_ErrorCode *errCode, W3DN_DataBuffer *buffer, uint64 readOffset, uint64 readSize), Category_Upload) \
+    X(DBOSetBuffer, W3DN_ErrorCode, (struct W3DN_Context_s *self, W3DN_DataBuffer *dataBuffer, uint32 bufferIdx, uint64 offset, uint64 size, W3DN_Shader *targetShader, struct TagItem *tags), Category_Upload) \
+    X(Destroy, void, (struct W3DN_Context_s *self), Category_None) \
+    X(DestroyDataBufferObject, void, (struct W3DN_Context_s *self, W3DN_DataBuffer *dataBuffer), Category_None) \
+    X(DestroyFrameBuffer, void, (struct W3DN_Context_s *self, W3DN_FrameBuffer *frameBuffer), Category_None) \
+    X(DestroyRenderStateObject, void, (struct W3DN_Context_s *self, W3DN_RenderState *renderState), Category_None) \
+    X(DestroyShader, void, (struct W3DN_Context_s *self, W3DN_Shader *shader), Category_Shader) \
+    X(DestroyShaderLog, void, (struct W3DN_Context_s *self, const char *shaderLog), Category_Shader) \
+    X(DestroyShaderPipeline, void, (struct W3DN_Context_s *self, W3DN_ShaderPipeline *shaderPipeline), Category_Shader) \
+    X(DestroyTexSampler, void, (struct W3DN_Context_s *self, W3DN_TextureSampler *texSampler), Category_None) \
+    X(DestroyTexture, void, (struct W3DN_Context_s *self, W3DN_Texture *texture), Category_None) \
+    X(DestroyVertexBufferObject, void, (struct W3DN_Context_s *self, W3DN_VertexBuffer *vertexBuffer), Category_None) \
+    X(DrawArrays, W3DN_ErrorCode, (struct W3DN_Context_s *self, W3DN_RenderState *renderState, W3DN_Primitive primitive, uint32 base, uint32 count), Category_Draw) \
+    X(DrawElements, W3DN_ErrorCode, (struct W3DN_Context_s *self, W3DN_RenderState *renderState, W3DN_Primitive primitive, uint32 baseVertex, uint32 count, W3DN_VertexBuffer *indexBuffer, uint32 arrayIdx), Category_Draw) \
+    X(FBBindBuffer, W3DN_ErrorCode, (struct W3DN_Context_s *self, W3DN_FrameBuffer *frameBuffer, int32 attachmentPt, struct TagItem *tags), Category_State) \
+    X(FBGetAttr, uint64, (struct W3DN_Context_s *self, W3DN_FrameBuffer *frameBuffer, W3DN_FrameBufferAttribute attrib), Category_Query) \
+    X(FBGetBufferBM, struct BitMap*, (struct W3DN_Context_s *self, W3DN_FrameBuffer *frameBuffer, uint32 attachmentPt, W3DN_ErrorCode *errCode), Category_Query) \
+    X(FBGetBufferTex, W3DN_Texture*, (struct W3DN_Context_s *self, W3DN_FrameBuffer *frameBuffer, uint32 attachmentPt, W3DN_ErrorCode *errCode), Category_Query) \
+    X(FBGetStatus, W3DN_ErrorCode, (struct W3DN_Context_s *self, W3DN_FrameBuffer *frameBuffer), Category_Query) \
+    X(GetBitMapTexture, struct BitMap*, (struct W3DN_Context_s *self, W3DN_RenderState *renderState, uint32 texUnit), Category_Query) \
+    X(GetBlendColour, W3DN_ErrorCode, (struct W3DN_Context_s *self, W3DN_RenderState *renderState, float *red, float *green, float *blue, float *alpha), Category_Query) \
+    X(GetBlendEquation, W3DN_ErrorCode, (struct W3DN_Context_s *self, W3DN_RenderState *renderState, uint32 buffIdx, W3DN_BlendEquation *colEquation, W3DN_BlendEquation *alphaEquation), Category_Query) \
+    X(GetBlendMode, W3DN_ErrorCode, (struct W3DN_Context_s *self, W3DN_RenderState *renderState, uint32 buffIdx, W3DN_BlendMode *colSrc, W3DN_BlendMode *colDst, W3DN_BlendMode *alphaSrc, W3DN_BlendMode *alphaDst), Category_Query) \
+    X(GetColourMask, uint8, (struct W3DN_Context_s *self, W3DN_RenderState *renderState, uint32 index), Category_Query) \
+    X(GetDepthCompareFunc, W3DN_CompareFunc, (struct W3DN_Context_s *self, W3DN_RenderState *renderState), Category_Query) \
+    X(GetFrontFace, W3DN_Face, (struct W3DN_Context_s *self, W3DN_RenderState *renderState), Category_Query) \
+    X(GetLineWidth, float, (struct W3DN_Context_s *self, W3DN_RenderState *renderState), Category_Query) \
+    X(GetPolygonMode, W3DN_PolygonMode, (struct W3DN_Context_s *self, W3DN_RenderState *renderState, W3DN_FaceSelect face), Category_Query) \
+    X(GetPolygonOffset, W3DN_ErrorCode, (struct W3DN_Context_s *self, W3DN_RenderState *renderState, float *factor, float *units, float *clamp), Category_Query) \
+    X(GetProvokingVertex, W3DN_ProvokingVertexMode, (struct W3DN_Context_s *self, W3DN_RenderState *renderState), Category_Query) \
+    X(GetRenderTarget, W3DN_FrameBuffer*, (struct W3DN_Context_s *self, W3DN_RenderState *renderState), Category_Query) \
+    X(GetScissor, W3DN_ErrorCode, (struct W3DN_Context_s *self, W3DN_RenderState *renderState, uint32 *x, uint32 *y, uint32 *width, uint32 *height), Category_Query) \
+    X(GetShaderDataBuffer, W3DN_ErrorCode, (struct W3DN_Context_s *self, W3DN_RenderState *renderState, W3DN_ShaderType shaderType, W3DN_DataBuffer **buffer, uint32 *bufferIdx), Category_Query) \
+    X(GetShaderPipeline, W3DN_ShaderPipeline*, (struct W3DN_Context_s *self, W3DN_RenderState *renderState), Category_Query) \
+    X(GetState, W3DN_State, (struct W3DN_Context_s *self, W3DN_RenderState *renderState, W3DN_StateFlag stateFlag), Category_Query) \
+    X(GetStencilFunc, W3DN_ErrorCode, (struct W3DN_Context_s *self, W3DN_RenderState *renderState, W3DN_FaceSelect face, W3DN_CompareFunc *func, uint32 *ref, uint32 *mask), Category_Query) \
+    X(GetStencilOp, W3DN_ErrorCode, (struct W3DN_Context_s *self, W3DN_RenderState *renderState, W3DN_FaceSelect face, W3DN_StencilOp *sFail, W3DN_StencilOp *dpFail, W3DN_StencilOp *dpPass), Category_Query) \
+    X(GetStencilWriteMask, uint32, (struct W3DN_Context_s *self, W3DN_RenderState *renderState, W3DN_FaceSelect face, W3DN_ErrorCode *errCode), Category_Query) \
+    X(GetTexSampler, W3DN_TextureSampler*, (struct W3DN_Context_s *self, W3DN_RenderState *renderState, uint32 texUnit), Category_Query) \
+    X(GetTexture, W3DN_Texture*, (struct W3DN_Context_s *self, W3DN_RenderState *renderState, uint32 texUnit), Category_Query) \
+    X(GetVertexAttribArray, W3DN_ErrorCode, (struct W3DN_Context_s *self, W3DN_RenderState *renderState, uint32 attribNum, W3DN_VertexBuffer **buffer, uint32 *arrayIdx), Category_Query) \
+    X(GetViewport, W3DN_ErrorCode, (struct W3DN_Context_s *self, W3DN_RenderState *renderState, double *x, double *y, double *width, double *height, double *zNear, double *zFar), Category_Query) \
+    X(IsDone, BOOL, (struct W3DN_Context_s *self, uint32 submitID), Category_Query) \
+    X(Query, uint32, (struct W3DN_Context_s *self, W3DN_CapQuery query), Category_Query) \
+    X(RSOCopy, W3DN_ErrorCode, (struct W3DN_Context_s *self, W3DN_RenderState *dest, const W3DN_RenderState *src), Category_State) \
+    X(RSOSetMaster, W3DN_ErrorCode, (struct W3DN_Context_s *self, W3DN_RenderState *renderState, W3DN_RenderState *master), Category_State) \
+    X(SetBlendColour, W3DN_ErrorCode, (struct W3DN_Context_s *self, W3DN_RenderState *renderState, float red, float green, float blue, float alpha), Category_State) \
+    X(SetBlendEquation, W3DN_ErrorCode, (struct W3DN_Context_s *self, W3DN_RenderState *renderState, uint32 buffIdx, W3DN_BlendEquation equation), Category_State) \
+    X(SetBlendEquationSeparate, W3DN_ErrorCode, (struct W3DN_Context_s *self, W3DN_RenderState *renderState, uint32 buffIdx, W3DN_BlendEquation colEquation, W3DN_BlendEquation alphaEquation), Category_State) \
+    X(SetBlendMode, W3DN_ErrorCode, (struct W3DN_Context_s *self, W3DN_RenderState *renderState, uint32 buffIdx, W3DN_BlendMode src, W3DN_BlendMode dst), Category_State) \
+    X(SetBlendModeSeparate, W3DN_ErrorCode, (struct W3DN_Context_s *self, W3DN_RenderState *renderState, uint32 buffIdx, W3DN_BlendMode colSrc, W3DN_BlendMode colDst, W3DN_BlendMode alphaSrc, W3DN_BlendMode alphaDst), Category_State) \
+    X(SetColourMask, W3DN_ErrorCode, (struct W3DN_Context_s *self, W3DN_RenderState *renderState, uint32 index, uint8 mask), Category_State) \
+    X(SetDepthCompareFunc, W3DN_ErrorCode, (struct W3DN_Context_s *self, W3DN_RenderState *renderState, W3DN_CompareFunc func), Category_State) \
+    X(SetFrontFace, W3DN_ErrorCode, (struct W3DN_Context_s *self, W3DN_RenderState *renderState, W3DN_Face face), Category_State) \
+    X(SetLineWidth, W3DN_ErrorCode, (struct W3DN_Context_s *self, W3DN_RenderState *renderState, float width), Category_State) \
+    X(SetPolygonMode, W3DN_ErrorCode, (struct W3DN_Context_s *self, W3DN_RenderState *renderState, W3DN_FaceSelect face, W3DN_PolygonMode mode), Category_State) \
+    X(SetPolygonOffset, W3DN_ErrorCode, (struct W3DN_Context_s *self, W3DN_RenderState *renderState, float factor, float units, float clamp), Category_State) \
+    X(SetProvokingVertex, W3DN_ErrorCode, (struct W3DN_Context_s *self, W3DN_RenderState *renderState, W3DN_ProvokingVertexMode mode), Category_State) \
+    X(SetRenderTarget, W3DN_ErrorCode, (struct W3DN_Context_s *self, W3DN_RenderState *renderState, W3DN_FrameBuffer *frameBuffer), Category_State) \
+    X(SetScissor, W3DN_ErrorCode, (struct W3DN_Context_s *self, W3DN_RenderState *renderState, uint32 x, uint32 y, uint32 width, uint32 height), Category_State) \
+    X(SetShaderPipeline, W3DN_ErrorCode, (struct W3DN_Context_s *self, W3DN_RenderState *renderState, W3DN_ShaderPipeline *shaderPipeline), Category_State) \
+    X(SetState, W3DN_ErrorCode, (struct W3DN_Context_s *self, W3DN_RenderState *renderState, W3DN_StateFlag stateFlag, W3DN_State value), Category_State) \
+    X(SetStencilFunc, W3DN_ErrorCode, (struct W3DN_Context_s *self, W3DN_RenderState *renderState, W3DN_CompareFunc func, uint32 ref, uint32 mask), Category_State) \
+    X(SetStencilFuncSeparate, W3DN_ErrorCode, (struct W3DN_Context_s *self, W3DN_RenderState *renderState, W3DN_FaceSelect face, W3DN_CompareFunc func, uint32 ref, uint32 mask), Category_State) \
+    X(SetStencilOp, W3DN_ErrorCode, (struct W3DN_Context_s *self, W3DN_RenderState *renderState, W3DN_StencilOp sFail, W3DN_StencilOp dpFail, W3DN_StencilOp dpPass), Category_State) \
+    X(SetStencilOpSeparate, W3DN_ErrorCode, (struct W3DN_Context_s *self, W3DN_RenderState *renderState, W3DN_FaceSelect face, W3DN_StencilOp sFail, W3DN_StencilOp dpFail, W3DN_StencilOp dpPass), Category_State) \
+    X(SetStencilWriteMask, W3DN_ErrorCode, (struct W3DN_Context_s *self, W3DN_RenderState *renderState, uint32 mask), Category_State) \
+    X(SetStencilWriteMaskSeparate, W3DN_ErrorCode, (struct W3DN_Context_s *self, W3DN_RenderState *renderState, W3DN_FaceSelect face, uint32 mask), Category_State) \
+    X(SetViewport, W3DN_ErrorCode, (struct W3DN_Context_s *self, W3DN_RenderState *renderState, double x, double y, double width, double height, double zNear, double zFar), Category_State) \
+    X(ShaderGetCount, uint32, (struct W3DN_Context_s *self, W3DN_ErrorCode *errCode, W3DN_Shader *shader, W3DN_ShaderObjectType objectType), Category_Query | Category_Shader) \
+    X(ShaderGetObjectInfo, W3DN_ErrorCode, (struct W3DN_Context_s *self, W3DN_Shader *shader, W3DN_ShaderObjectType objectType, uint32 index, struct TagItem *tags), Category_Query | Category_Shader) \
+    X(ShaderGetOffset, uint32, (struct W3DN_Context_s *self, W3DN_ErrorCode *errCode, W3DN_Shader *shader, W3DN_ShaderObjectType objectType, const char *name), Category_Query | Category_Shader) \
+    X(ShaderGetTotalStorage, uint64, (struct W3DN_Context_s *self, W3DN_Shader *shader), Category_Query | Category_Shader) \
+    X(ShaderGetType, W3DN_ShaderType, (struct W3DN_Context_s *self, W3DN_Shader *shader), Category_Query | Category_Shader) \
+    X(ShaderPipelineGetShader, W3DN_Shader*, (struct W3DN_Context_s *self, W3DN_ShaderPipeline *shaderPipeline, W3DN_ShaderType shaderType), Category_Query | Category_Shader) \
+    X(Submit, uint32, (struct W3DN_Context_s *self, W3DN_ErrorCode *errCode), Category_Draw) \
+    X(TexGenMipMaps, W3DN_ErrorCode, (struct W3DN_Context_s *self, W3DN_Texture *texture, uint32 base, uint32 last), Category_Upload) \
+    X(TexGetParameters, W3DN_ErrorCode, (struct W3DN_Context_s *self, W3DN_Texture *texture, struct TagItem *tags), Category_Query) \
+    X(TexGetProperty, W3DN_ErrorCode, (struct W3DN_Context_s *self, W3DN_Texture *texture, W3DN_TextureProperty texProp, void *buffer), Category_Query) \
+    X(TexGetRMBuffer, void*, (struct W3DN_Context_s *self, W3DN_Texture *texture), Category_Query) \
+    X(TexGetSubResourceLayout, W3DN_ErrorCode, (struct W3DN_Context_s *self, W3DN_Texture *texture, W3DN_TexAspect aspect, uint32 mipLevel, uint32 arrayIdx, W3DN_ResourceLayout *layout), Category_Query) \
+    X(TexSetParameters, W3DN_ErrorCode, (struct W3DN_Context_s *self, W3DN_Texture *texture, struct TagItem *tags), Category_State) \
+    X(TexUpdateImage, W3DN_ErrorCode, (struct W3DN_Context_s *self, W3DN_Texture *texture, void *source, uint32 level, uint32 arrayIdx, uint32 srcBytesPerRow, uint32 srcRowsPerLayer), Category_Upload) \
+    X(TexUpdateSubImage, W3DN_ErrorCode, (struct W3DN_Context_s *self, W3DN_Texture *texture, void *source, uint32 level, uint32 arrayIdx, uint32 srcBytesPerRow, uint32 srcRowsPerLayer, uint32 dstX, uint32 dstY, uint32 dstLayer, uint32 width, uint32 height, uint32 depth), Category_Upload) \
+    X(TSGetParameters, W3DN_ErrorCode, (struct W3DN_Context_s *self, W3DN_TextureSampler *texSampler, struct TagItem *tags), Category_Query) \
+    X(TSSetParameters, W3DN_ErrorCode, (struct W3DN_Context_s *self, W3DN_TextureSampler *texSampler, struct TagItem *tags), Category_State) \
+    X(VBOGetArray, W3DN_ErrorCode, (struct W3DN_Context_s *self, W3DN_VertexBuffer *buffer, uint32 arrayIdx, W3DN_ElementFormat *elementType, BOOL *normalized, uint64 *numElements, uint64 *stride, uint64 *offset, uint64 *count), Category_Query) \
+    X(VBOGetAttr, uint64, (struct W3DN_Context_s *self, W3DN_VertexBuffer *vertexBuffer, W3DN_BufferAttribute attr), Category_Query) \
+    X(VBOLock, W3DN_BufferLock*, (struct W3DN_Context_s *self, W3DN_ErrorCode *errCode, W3DN_VertexBuffer *buffer, uint64 readOffset, uint64 readSize), Category_Upload) \
+    X(VBOSetArray, W3DN_ErrorCode, (struct W3DN_Context_s *self, W3DN_VertexBuffer *buffer, uint32 arrayIdx, W3DN_ElementFormat elementType, BOOL normalized, uint64 numElements, uint64 stride, uint64 offset, uint64 count), Category_Upload) \
+    X(WaitDone, W3DN_ErrorCode, (struct W3DN_Context_s *self, uint32 submitID, uint32 timeout), Category_None) \
+    X(WaitIdle, W3DN_ErrorCode, (struct W3DN_Context_s *self, uint32 timeout), Category_None)
+
+#endif
@@ -1,9 +1,13 @@
 #include "warp3dnova_module.h"
+#include "ogles2_module.h"
 #include "common.h"
 #include "filter.h"
 #include "timer.h"
 #include "profiling.h"
 #include "logger.h"
+#include "recorder.h"
+#include "clients.h"
+#include "warp3dnova_functions.h"
 
 #include <proto/exec.h>
 #include <proto/warp3dnova.h>
@@ -16,246 +20,73 @@ extern BYTE mainSig;
 extern struct Task* mainTask;
 
 typedef enum NovaFunction {
-    BindBitMapAsTexture,
-    BindShaderDataBuffer,
-    BindTexture,
-    BindVertexAttribArray,
-    BufferUnlock,
-    Clear,
-    CompileShader,
-    CreateDataBufferObject,
-    CreateFrameBuffer,
-    CreateRenderStateObject,
-    CreateShaderPipeline,
-    CreateTexSampler,
-    CreateTexture,
-    CreateTextureExtRMB,
-    CreateVertexBufferObject,
-    DBOGetAttr,
-    DBOGetBuffer,
-    DBOLock,
-    DBOSetBuffer,
-    Destroy,
-    DestroyDataBufferObject,
-    DestroyFrameBuffer,
-    DestroyRenderStateObject,
-    DestroyShader,
-    DestroyShaderLog,
-    DestroyShaderPipeline,
-    DestroyTexSampler,
-    DestroyTexture,
-    DestroyVertexBufferObject,
-    DrawArrays,
-    DrawElements,
-    FBBindBuffer,
-    FBGetAttr,
-    FBGetBufferBM,
-    FBGetBufferTex,
-    FBGetStatus,
-    GetBitMapTexture,
-    GetBlendColour,
-    GetBlendEquation,
-    GetBlendMode,
-    GetColourMask,
-    GetDepthCompareFunc,
-    GetFrontFace,
-    GetLineWidth,
-    GetPolygonMode,
-    GetPolygonOffset,
-    GetProvokingVertex,
-    GetRenderTarget,
-    GetScissor,
-    GetShaderDataBuffer,
-    GetShaderPipeline,
-    GetState,
-    GetStencilFunc,
-    GetStencilOp,
-    GetStencilWriteMask,
-    GetTexSampler,
-    GetTexture,
-    GetVertexAttribArray,
-    GetViewport,
-    IsDone,
-    Query,
-    RSOCopy,
-    RSOSetMaster,
-    SetBlendColour,
-    SetBlendEquation,
-    SetBlendEquationSeparate,
-    SetBlendMode,
-    SetBlendModeSeparate,
-    SetColourMask,
-    SetDepthCompareFunc,
-    SetFrontFace,
-    SetLineWidth,
-    SetPolygonMode,
-    SetPolygonOffset,
-    SetProvokingVertex,
-    SetRenderTarget,
-    SetScissor,
-    SetShaderPipeline,
-    SetState,
-    SetStencilFunc,
-    SetStencilFuncSeparate,
-    SetStencilOp,
-    SetStencilOpSeparate,
-    SetStencilWriteMask,
-    SetStencilWriteMaskSeparate,
-    SetViewport,
-    ShaderGetCount,
-    ShaderGetObjectInfo,
-    ShaderGetOffset,
-    ShaderGetTotalStorage,
-    ShaderGetType,
-    ShaderPipelineGetShader,
-    Submit,
-    TexGenMipMaps,
-    TexGetParameters,
-    TexGetProperty,
-    TexGetRMBuffer,
-    TexGetSubResourceLayout,
-    TexSetParameters,
-    TexUpdateImage,
-    TexUpdateSubImage,
-    TSGetParameters,
-    TSSetParameters,
-    VBOGetArray,
-    VBOGetAttr,
-    VBOLock,
-    VBOSetArray,
-    WaitDone,
-    WaitIdle,
+    #define NOVA_ENUM(name, returnType, parameters, categories) name,
+    NOVA_FUNCTIONS(NOVA_ENUM)
+    #undef NOVA_ENUM
     // Keep last
     NovaFunctionCount
 } NovaFunction;
 
+static const char* const novaFunctionNames[NovaFunctionCount] = {
+    #define NOVA_NAME(name, returnType, parameters, categories) #name,
+    NOVA_FUNCTIONS(NOVA_NAME)
+    #undef NOVA_NAME
+};
+
+static const char* const novaLibraryNames[NovaFunctionCount] = {
+    #define NOVA_LIBRARY_NAME(name, returnType, parameters, categories) "W3DN_" #name,
+    NOVA_FUNCTIONS(NOVA_LIBRARY_NAME)
+    #undef NOVA_LIBRARY_NAME
+};
+
+static const uint8 novaCategories[NovaFunctionCount] = {
+    #define NOVA_CATEGORIES(name, returnType, parameters, categories) categories,
+    NOVA_FUNCTIONS(NOVA_CATEGORIES)
+    #undef NOVA_CATEGORIES
+};
+
+static const char* const novaSignatures[NovaFunctionCount] = {
+    #define NOVA_SIGNATURE(name, returnType, parameters, categories) #parameters,
+    NOVA_FUNCTIONS(NOVA_SIGNATURE)
+    #undef NOVA_SIGNATURE
+};
+
+static const FilterTable novaFilterTable = {
+    NovaFunctionCount,
+    novaLibraryNames,
+    novaCategories,
+    novaSignatures
+};
+
 static const char* mapNovaFunction(const NovaFunction func)
 {
-    #define MAP_ENUM(x) case x: return #x;
-
-    switch (func) {
-        MAP_ENUM(BindBitMapAsTexture)
-        MAP_ENUM(BindShaderDataBuffer)
-        MAP_ENUM(BindTexture)
-        MAP_ENUM(BindVertexAttribArray)
-        MAP_ENUM(BufferUnlock)
-        MAP_ENUM(Clear)
-        MAP_ENUM(CompileShader)
-        MAP_ENUM(CreateDataBufferObject)
-        MAP_ENUM(CreateFrameBuffer)
-        MAP_ENUM(CreateRenderStateObject)
-        MAP_ENUM(CreateShaderPipeline)
-        MAP_ENUM(CreateTexSampler)
-        MAP_ENUM(CreateTexture)
-        MAP_ENUM(CreateTextureExtRMB)
-        MAP_ENUM(CreateVertexBufferObject)
-        MAP_ENUM(DBOGetAttr)
-        MAP_ENUM(DBOGetBuffer)
-        MAP_ENUM(DBOLock)
-        MAP_ENUM(DBOSetBuffer)
-        MAP_ENUM(Destroy)
-        MAP_ENUM(DestroyDataBufferObject)
-        MAP_ENUM(DestroyFrameBuffer)
-        MAP_ENUM(DestroyRenderStateObject)
-        MAP_ENUM(DestroyShader)
-        MAP_ENUM(DestroyShaderLog)
-        MAP_ENUM(DestroyShaderPipeline)
-        MAP_ENUM(DestroyTexSampler)
-        MAP_ENUM(DestroyTexture)
-        MAP_ENUM(DestroyVertexBufferObject)
-        MAP_ENUM(DrawArrays)
-        MAP_ENUM(DrawElements)
-        MAP_ENUM(FBBindBuffer)
-        MAP_ENUM(FBGetAttr)
-        MAP_ENUM(FBGetBufferBM)
-        MAP_ENUM(FBGetBufferTex)
-        MAP_ENUM(FBGetStatus)
-        MAP_ENUM(GetBitMapTexture)
-        MAP_ENUM(GetBlendColour)
-        MAP_ENUM(GetBlendEquation)
-        MAP_ENUM(GetBlendMode)
-        MAP_ENUM(GetColourMask)
-        MAP_ENUM(GetDepthCompareFunc)
-        MAP_ENUM(GetFrontFace)
-        MAP_ENUM(GetLineWidth)
-        MAP_ENUM(GetPolygonMode)
-        MAP_ENUM(GetPolygonOffset)
-        MAP_ENUM(GetProvokingVertex)
-        MAP_ENUM(GetRenderTarget)
-        MAP_ENUM(GetScissor)
-        MAP_ENUM(GetShaderDataBuffer)
-        MAP_ENUM(GetShaderPipeline)
-        MAP_ENUM(GetState)
-        MAP_ENUM(GetStencilFunc)
-        MAP_ENUM(GetStencilOp)
-        MAP_ENUM(GetStencilWriteMask)
-        MAP_ENUM(GetTexSampler)
-        MAP_ENUM(GetTexture)
-        MAP_ENUM(GetVertexAttribArray)
-        MAP_ENUM(GetViewport)
-        MAP_ENUM(IsDone)
-        MAP_ENUM(Query)
-        MAP_ENUM(RSOCopy)
-        MAP_ENUM(RSOSetMaster)
-        MAP_ENUM(SetBlendColour)
-        MAP_ENUM(SetBlendEquation)
-        MAP_ENUM(SetBlendEquationSeparate)
-        MAP_ENUM(SetBlendMode)
-        MAP_ENUM(SetBlendModeSeparate)
-        MAP_ENUM(SetColourMask)
-        MAP_ENUM(SetDepthCompareFunc)
-        MAP_ENUM(SetFrontFace)
-        MAP_ENUM(SetLineWidth)
-        MAP_ENUM(SetPolygonMode)
-        MAP_ENUM(SetPolygonOffset)
-        MAP_ENUM(SetProvokingVertex)
-        MAP_ENUM(SetRenderTarget)
-        MAP_ENUM(SetScissor)
-        MAP_ENUM(SetShaderPipeline)
-        MAP_ENUM(SetState)
-        MAP_ENUM(SetStencilFunc)
-        MAP_ENUM(SetStencilFuncSeparate)
-        MAP_ENUM(SetStencilOp)
-        MAP_ENUM(SetStencilOpSeparate)
-        MAP_ENUM(SetStencilWriteMask)
-        MAP_ENUM(SetStencilWriteMaskSeparate)
-        MAP_ENUM(SetViewport)
-        MAP_ENUM(ShaderGetCount)
-        MAP_ENUM(ShaderGetObjectInfo)
-        MAP_ENUM(ShaderGetOffset)
-        MAP_ENUM(ShaderGetTotalStorage)
-        MAP_ENUM(ShaderGetType)
-        MAP_ENUM(ShaderPipelineGetShader)
-        MAP_ENUM(Submit)
-        MAP_ENUM(TexGenMipMaps)
-        MAP_ENUM(TexGetParameters)
-        MAP_ENUM(TexGetProperty)
-        MAP_ENUM(TexGetRMBuffer)
-        MAP_ENUM(TexGetSubResourceLayout)
-        MAP_ENUM(TexSetParameters)
-        MAP_ENUM(TexUpdateImage)
-        MAP_ENUM(TexUpdateSubImage)
-        MAP_ENUM(TSGetParameters)
-        MAP_ENUM(TSSetParameters)
-        MAP_ENUM(VBOGetArray)
-        MAP_ENUM(VBOGetAttr)
-        MAP_ENUM(VBOLock)
-        MAP_ENUM(VBOSetArray)
-        MAP_ENUM(WaitDone)
-        MAP_ENUM(WaitIdle)
-        case NovaFunctionCount: break;
+    if ((size_t)func < NovaFunctionCount) {
+        return novaFunctionNames[func];
     }
 
-    #undef MAP_ENUM
-
     return "Unknown";
 }
 
+static const char* mapNovaTraceFunction(const uint16_t func)
+{
+    return mapNovaFunction((NovaFunction)func);
+}
+
+const char* warp3dnova_function_name(const uint16 function)
+{
+    return mapNovaFunction((NovaFunction)function);
+}
+
+static uint32 patchFilter[FILTER_WORDS(NovaFunctionCount)];
+static uint32 traceFilter[FILTER_WORDS(NovaFunctionCount)]; // Patched functions outside it are only profiled
+static PredicateSet* predicates; // Argument conditions, NULL until a filter file has any
+
 struct Library* Warp3DNovaBase;
 struct Interface* IWarp3DNova;
 
 static unsigned errorCount;
 static BOOL profilingStarted = TRUE;
+static BOOL frameSummaryMode = FALSE;
 
 static ULONG profilerStartTime = 0;
 static ULONG profilerDuration = 0;
@@ -777,295 +608,37 @@ struct NovaContext {
     struct Task* task;
     struct W3DN_Context_s* context;
     char name[NAME_LEN];
+    ULONG id; // Stable client number for logs
     char tagBuffer[TAG_BUFFER_LEN];
+    uint32 patched[FILTER_WORDS(NovaFunctionCount)];
 
     MyClock start;
+    MyClock closed; // When the context was destroyed
     uint64 ticks;
     ProfilingItem profiling[NovaFunctionCount];
+    Histogram latency[NovaFunctionCount]; // Call durations in ticks
 
     PrimitiveCounter counter;
 
-    // Store original function pointers so that they can be still called
-
-    W3DN_ErrorCode (*old_BindBitMapAsTexture)(struct W3DN_Context_s *self, W3DN_RenderState *renderState,
-        uint32 texUnit, struct BitMap *bitMap, W3DN_TextureSampler *texSampler);
-
-    W3DN_ErrorCode (*old_BindShaderDataBuffer)(struct W3DN_Context_s *self, W3DN_RenderState *renderState,
-        W3DN_ShaderType shaderType, W3DN_DataBuffer *buffer, uint32 bufferIdx);
-
-    W3DN_ErrorCode (*old_BindTexture)(struct W3DN_Context_s *self, W3DN_RenderState *renderState,
-        uint32 texUnit, W3DN_Texture *texture, W3DN_TextureSampler *texSampler);
-
-    W3DN_ErrorCode (*old_BindVertexAttribArray)(struct W3DN_Context_s *self,
-    		W3DN_RenderState *renderState, uint32 attribNum,
-    		W3DN_VertexBuffer *buffer, uint32 arrayIdx);
-
-    W3DN_ErrorCode (*old_BufferUnlock)(struct W3DN_Context_s *self,
-    		W3DN_BufferLock *bufferLock, uint64 writeOffset, uint64 writeSize);
-
-    W3DN_ErrorCode (*old_Clear)(struct W3DN_Context_s *self, W3DN_RenderState *renderState,
-        const float *colour, const double *depth, const uint32* stencil);
-
-    W3DN_Shader* (*old_CompileShader)(struct W3DN_Context_s *self,
-        W3DN_ErrorCode *errCode, struct TagItem *tags);
-
-    W3DN_DataBuffer* (*old_CreateDataBufferObject)(struct W3DN_Context_s *self, W3DN_ErrorCode *errCode,
-        uint64 size, W3DN_BufferUsage usage, uint32 maxBuffers, struct TagItem *tags);
-
-    W3DN_FrameBuffer* (*old_CreateFrameBuffer)(struct W3DN_Context_s *self, W3DN_ErrorCode *errCode);
-
-    W3DN_RenderState* (*old_CreateRenderStateObject)(struct W3DN_Context_s *self, W3DN_ErrorCode *errCode);
-
-    W3DN_ShaderPipeline* (*old_CreateShaderPipeline)(struct W3DN_Context_s *self, W3DN_ErrorCode *errCode, struct TagItem *tags);
-
-    W3DN_TextureSampler* (*old_CreateTexSampler)(struct W3DN_Context_s *self, W3DN_ErrorCode *errCode);
-
-    W3DN_Texture* (*old_CreateTexture)(struct W3DN_Context_s *self, W3DN_ErrorCode *errCode, W3DN_TextureType texType,
-        W3DN_PixelFormat pixelFormat, W3DN_ElementFormat elementFormat, uint32 width, uint32 height, uint32 depth,
-        BOOL mipmapped, W3DN_BufferUsage usage);
-
-    W3DN_Texture* (*old_CreateTextureExtRMB)(struct W3DN_Context_s *self, W3DN_ErrorCode *errCode, void *rmBuffer, W3DN_ResourceLayout * layout,
-        W3DN_TextureType texType, W3DN_PixelFormat pixelFormat, W3DN_ElementFormat elementFormat, uint32 width, uint32 height, uint32 depth, BOOL mipmapped);
-
-    W3DN_VertexBuffer* (*old_CreateVertexBufferObject)(struct W3DN_Context_s *self,
-    		W3DN_ErrorCode *errCode, uint64 size, W3DN_BufferUsage usage, uint32 maxArrays, struct TagItem *tags);
-
-    uint64 (*old_DBOGetAttr)(struct W3DN_Context_s *self, W3DN_DataBuffer *dataBuffer, W3DN_BufferAttribute attr);
-
-    W3DN_ErrorCode (*old_DBOGetBuffer)(struct W3DN_Context_s *self, W3DN_DataBuffer *dataBuffer, uint32 bufferIdx,
-        uint64 *offset, uint64 *size, W3DN_Shader **targetShader, struct TagItem *tags);
-
-    W3DN_BufferLock* (*old_DBOLock)(struct W3DN_Context_s *self, W3DN_ErrorCode *errCode, W3DN_DataBuffer *buffer, uint64 readOffset, uint64 readSize);
-
-    W3DN_ErrorCode (*old_DBOSetBuffer)(struct W3DN_Context_s *self, W3DN_DataBuffer *dataBuffer, uint32 bufferIdx,
-        uint64 offset, uint64 size, W3DN_Shader *targetShader, struct TagItem *tags);
-
-    void (*old_Destroy)(struct W3DN_Context_s *self);
-
-    void (*old_DestroyDataBufferObject)(struct W3DN_Context_s *self, W3DN_DataBuffer *dataBuffer);
-
-    void (*old_DestroyFrameBuffer)(struct W3DN_Context_s *self, W3DN_FrameBuffer *frameBuffer);
-
-    void (*old_DestroyRenderStateObject)(struct W3DN_Context_s *self, W3DN_RenderState *renderState);
-
-    void (*old_DestroyShader)(struct W3DN_Context_s *self, W3DN_Shader *shader);
-
-    void (*old_DestroyShaderLog)(struct W3DN_Context_s *self, const char *shaderLog);
-
-    void (*old_DestroyShaderPipeline)(struct W3DN_Context_s *self, W3DN_ShaderPipeline *shaderPipeline);
-
-    void (*old_DestroyTexSampler)(struct W3DN_Context_s *self, W3DN_TextureSampler *texSampler);
-
-    void (*old_DestroyTexture)(struct W3DN_Context_s *self, W3DN_Texture *texture);
-
-    void (*old_DestroyVertexBufferObject)(struct W3DN_Context_s *self, W3DN_VertexBuffer *vertexBuffer);
-
-    W3DN_ErrorCode (*old_DrawArrays)(struct W3DN_Context_s *self,
-    		W3DN_RenderState *renderState, W3DN_Primitive primitive, uint32 base, uint32 count);
-
-    W3DN_ErrorCode (*old_DrawElements)(struct W3DN_Context_s *self,
-    		W3DN_RenderState *renderState, W3DN_Primitive primitive, uint32 baseVertex, uint32 count,
-    		W3DN_VertexBuffer *indexBuffer, uint32 arrayIdx);
-
-    W3DN_ErrorCode (*old_FBBindBuffer)(struct W3DN_Context_s *self,
-    	W3DN_FrameBuffer *frameBuffer, int32 attachmentPt, struct TagItem *tags);
-
-    uint64 (*old_FBGetAttr)(struct W3DN_Context_s *self,
-    	W3DN_FrameBuffer *frameBuffer, W3DN_FrameBufferAttribute attrib);
-
-    struct BitMap* (*old_FBGetBufferBM)(struct W3DN_Context_s *self,
-    	W3DN_FrameBuffer *frameBuffer, uint32 attachmentPt, W3DN_ErrorCode *errCode);
-
-    W3DN_Texture* (*old_FBGetBufferTex)(struct W3DN_Context_s *self,
-    	W3DN_FrameBuffer *frameBuffer, uint32 attachmentPt, W3DN_ErrorCode *errCode);
-
-    W3DN_ErrorCode (*old_FBGetStatus)(struct W3DN_Context_s *self, W3DN_FrameBuffer *frameBuffer);
-
-    struct BitMap* (*old_GetBitMapTexture)(struct W3DN_Context_s *self, W3DN_RenderState *renderState, uint32 texUnit);
-
-    W3DN_ErrorCode (*old_GetBlendColour)(struct W3DN_Context_s *self, W3DN_RenderState *renderState,
-        float *red, float *green, float *blue, float *alpha);
-
-    W3DN_ErrorCode (*old_GetBlendEquation)(struct W3DN_Context_s *self, W3DN_RenderState *renderState,
-        uint32 buffIdx, W3DN_BlendEquation *colEquation, W3DN_BlendEquation *alphaEquation);
-
-    W3DN_ErrorCode (*old_GetBlendMode)(struct W3DN_Context_s *self, W3DN_RenderState *renderState, uint32 buffIdx,
-        W3DN_BlendMode *colSrc, W3DN_BlendMode *colDst, W3DN_BlendMode *alphaSrc, W3DN_BlendMode *alphaDst);
-
-    uint8 (*old_GetColourMask)(struct W3DN_Context_s *self, W3DN_RenderState *renderState, uint32 index);
-
-    W3DN_CompareFunc (*old_GetDepthCompareFunc)(struct W3DN_Context_s *self, W3DN_RenderState *renderState);
-
-    W3DN_Face (*old_GetFrontFace)(struct W3DN_Context_s *self, W3DN_RenderState *renderState);
-
-    float (*old_GetLineWidth)(struct W3DN_Context_s *self, W3DN_RenderState *renderState);
-
-    W3DN_PolygonMode (*old_GetPolygonMode)(struct W3DN_Context_s *self, W3DN_RenderState *renderState, W3DN_FaceSelect face);
-
-    W3DN_ErrorCode (*old_GetPolygonOffset)(struct W3DN_Context_s *self, W3DN_RenderState *renderState,
-        float *factor, float *units, float *clamp);
-
-    W3DN_ProvokingVertexMode (*old_GetProvokingVertex)(struct W3DN_Context_s *self, W3DN_RenderState *renderState);
-
-    W3DN_FrameBuffer* (*old_GetRenderTarget)(
-        struct W3DN_Context_s *self, W3DN_RenderState *renderState);
-
-    W3DN_ErrorCode (*old_GetScissor)(struct W3DN_Context_s *self, W3DN_RenderState *renderState,
-        uint32 *x, uint32 *y, uint32 *width, uint32 *height);
-
-    W3DN_ErrorCode (*old_GetShaderDataBuffer)(struct W3DN_Context_s *self, W3DN_RenderState *renderState,
-        W3DN_ShaderType shaderType, W3DN_DataBuffer **buffer, uint32 *bufferIdx);
-
-    W3DN_ShaderPipeline* (*old_GetShaderPipeline)(struct W3DN_Context_s *self, W3DN_RenderState *renderState);
-
-    W3DN_State (*old_GetState)(struct W3DN_Context_s *self, W3DN_RenderState *renderState, W3DN_StateFlag stateFlag);
-
-    W3DN_ErrorCode (*old_GetStencilFunc)(struct W3DN_Context_s *self, W3DN_RenderState *renderState,
-        W3DN_FaceSelect face, W3DN_CompareFunc *func, uint32 *ref, uint32 *mask);
-
-    W3DN_ErrorCode (*old_GetStencilOp)(struct W3DN_Context_s *self, W3DN_RenderState *renderState,
-        W3DN_FaceSelect face, W3DN_StencilOp *sFail, W3DN_StencilOp *dpFail, W3DN_StencilOp *dpPass);
-
-    uint32 (*old_GetStencilWriteMask)(struct W3DN_Context_s *self, W3DN_RenderState *renderState,
-        W3DN_FaceSelect face, W3DN_ErrorCode *errCode);
-
-    W3DN_TextureSampler* (*old_GetTexSampler)(struct W3DN_Context_s *self, W3DN_RenderState *renderState, uint32 texUnit);
-
-    W3DN_Texture* (*old_GetTexture)(struct W3DN_Context_s *self, W3DN_RenderState *renderState, uint32 texUnit);
-
-    W3DN_ErrorCode (*old_GetVertexAttribArray)(struct W3DN_Context_s *self, W3DN_RenderState *renderState,
-        uint32 attribNum, W3DN_VertexBuffer **buffer, uint32 *arrayIdx);
-
-    W3DN_ErrorCode (*old_GetViewport)(struct W3DN_Context_s *self, W3DN_RenderState *renderState,
-        double *x, double *y, double *width, double *height, double *zNear, double *zFar);
-
-    BOOL (*old_IsDone)(struct W3DN_Context_s *self, uint32 submitID);
-
-    uint32 (*old_Query)(struct W3DN_Context_s *self, W3DN_CapQuery query);
-
-    W3DN_ErrorCode (*old_RSOCopy)(struct W3DN_Context_s *self, W3DN_RenderState *dest, const W3DN_RenderState *src);
-
-    W3DN_ErrorCode (*old_RSOSetMaster)(struct W3DN_Context_s *self, W3DN_RenderState *renderState, W3DN_RenderState *master);
-
-    W3DN_ErrorCode (*old_SetBlendColour)(struct W3DN_Context_s *self, W3DN_RenderState *renderState, float red, float green, float blue, float alpha);
-
-    W3DN_ErrorCode (*old_SetBlendEquation)(struct W3DN_Context_s *self, W3DN_RenderState *renderState, uint32 buffIdx, W3DN_BlendEquation equation);
-
-    W3DN_ErrorCode (*old_SetBlendEquationSeparate)(struct W3DN_Context_s *self, W3DN_RenderState *renderState, uint32 buffIdx,
-        W3DN_BlendEquation colEquation, W3DN_BlendEquation alphaEquation);
-
-    W3DN_ErrorCode (*old_SetBlendMode)(struct W3DN_Context_s *self, W3DN_RenderState *renderState, uint32 buffIdx, W3DN_BlendMode src, W3DN_BlendMode dst);
-
-    W3DN_ErrorCode (*old_SetBlendModeSeparate)(struct W3DN_Context_s *self, W3DN_RenderState *renderState, uint32 buffIdx,
-        W3DN_BlendMode colSrc, W3DN_BlendMode colDst, W3DN_BlendMode alphaSrc, W3DN_BlendMode alphaDst);
-
-    W3DN_ErrorCode (*old_SetColourMask)(struct W3DN_Context_s *self, W3DN_RenderState *renderState, uint32 index, uint8 mask);
-
-    W3DN_ErrorCode (*old_SetDepthCompareFunc)(struct W3DN_Context_s *self, W3DN_RenderState *renderState, W3DN_CompareFunc func);
-
-    W3DN_ErrorCode (*old_SetFrontFace)(struct W3DN_Context_s *self, W3DN_RenderState *renderState, W3DN_Face face);
-
-    W3DN_ErrorCode (*old_SetLineWidth)(struct W3DN_Context_s *self, W3DN_RenderState *renderState, float width);
-
-    W3DN_ErrorCode (*old_SetPolygonMode)(struct W3DN_Context_s *self, W3DN_RenderState *renderState, W3DN_FaceSelect face, W3DN_PolygonMode mode);
-
-    W3DN_ErrorCode (*old_SetPolygonOffset)(struct W3DN_Context_s *self, W3DN_RenderState *renderState, float factor, float units, float clamp);
-
-    W3DN_ErrorCode (*old_SetProvokingVertex)(struct W3DN_Context_s *self, W3DN_RenderState *renderState, W3DN_ProvokingVertexMode mode);
-
-    W3DN_ErrorCode (*old_SetRenderTarget)(struct W3DN_Context_s *self,
-    	W3DN_RenderState *renderState, W3DN_FrameBuffer *frameBuffer);
-
-    W3DN_ErrorCode (*old_SetScissor)(struct W3DN_Context_s *self, W3DN_RenderState *renderState,
-        uint32 x, uint32 y, uint32 width, uint32 height);
-
-    W3DN_ErrorCode (*old_SetShaderPipeline)(struct W3DN_Context_s *self, W3DN_RenderState *renderState,
-        W3DN_ShaderPipeline *shaderPipeline);
-
-    W3DN_ErrorCode (*old_SetState)(struct W3DN_Context_s *self, W3DN_RenderState *renderState,
-        W3DN_StateFlag stateFlag, W3DN_State value);
-
-    W3DN_ErrorCode (*old_SetStencilFunc)(struct W3DN_Context_s *self, W3DN_RenderState *renderState,
-        W3DN_CompareFunc func, uint32 ref, uint32 mask);
-
-    W3DN_ErrorCode (*old_SetStencilFuncSeparate)(struct W3DN_Context_s *self, W3DN_RenderState *renderState,
-        W3DN_FaceSelect face, W3DN_CompareFunc func, uint32 ref, uint32 mask);
-
-    W3DN_ErrorCode (*old_SetStencilOp)(struct W3DN_Context_s *self, W3DN_RenderState *renderState,
-        W3DN_StencilOp sFail, W3DN_StencilOp dpFail, W3DN_StencilOp dpPass);
-
-    W3DN_ErrorCode (*old_SetStencilOpSeparate)(struct W3DN_Context_s *self, W3DN_RenderState *renderState,
-        W3DN_FaceSelect face, W3DN_StencilOp sFail, W3DN_StencilOp dpFail, W3DN_StencilOp dpPass);
-
-    W3DN_ErrorCode (*old_SetStencilWriteMask)(struct W3DN_Context_s *self, W3DN_RenderState *renderState, uint32 mask);
-
-    W3DN_ErrorCode (*old_SetStencilWriteMaskSeparate)(struct W3DN_Context_s *self, W3DN_RenderState *renderState,
-        W3DN_FaceSelect face, uint32 mask);
-
-    W3DN_ErrorCode (*old_SetViewport)(struct W3DN_Context_s *self, W3DN_RenderState *renderState,
-        double x, double y, double width, double height, double zNear, double zFar);
-
-    uint32 (*old_ShaderGetCount)(struct W3DN_Context_s *self, W3DN_ErrorCode *errCode, W3DN_Shader *shader,
-        W3DN_ShaderObjectType objectType);
-
-    W3DN_ErrorCode (*old_ShaderGetObjectInfo)(struct W3DN_Context_s *self, W3DN_Shader *shader,
-        W3DN_ShaderObjectType objectType, uint32 index, struct TagItem *tags);
-
-    uint32 (*old_ShaderGetOffset)(struct W3DN_Context_s *self, W3DN_ErrorCode *errCode, W3DN_Shader *shader,
-        W3DN_ShaderObjectType objectType, const char *name);
+    FrameState frame;
+    ProfilingItem frameProfiling[NovaFunctionCount]; // Snapshot at the previous frame boundary
+    FrameState interval;
+    ProfilingItem intervalProfiling[NovaFunctionCount]; // Snapshot at the previous INTERVAL
+    FrameTimes frameTimes; // Recorded at W3DN_Submit
+    struct NestingStack* nesting; // Cached nesting stack of the task
+    uint64 afterTicks; // Time spent recording after the calls
 
-    uint64 (*old_ShaderGetTotalStorage)(struct W3DN_Context_s *self, W3DN_Shader *shader);
+    struct TraceClient* trace;
+    struct FlightClient* flight;
 
-    W3DN_ShaderType (*old_ShaderGetType)(struct W3DN_Context_s *self, W3DN_Shader *shader);
-
-    W3DN_Shader* (*old_ShaderPipelineGetShader)(struct W3DN_Context_s *self, W3DN_ShaderPipeline *shaderPipeline,
-        W3DN_ShaderType shaderType);
-
-    uint32 (*old_Submit)(struct W3DN_Context_s *self, W3DN_ErrorCode *errCode);
-
-    W3DN_ErrorCode (*old_TexGenMipMaps)(struct W3DN_Context_s *self, W3DN_Texture *texture, uint32 base, uint32 last);
-
-    W3DN_ErrorCode (*old_TexGetParameters)(struct W3DN_Context_s *self, W3DN_Texture *texture, struct TagItem *tags);
-
-    W3DN_ErrorCode (*old_TexGetProperty)(struct W3DN_Context_s *self, W3DN_Texture *texture, W3DN_TextureProperty texProp, void *buffer);
-
-    void* (*old_TexGetRMBuffer)(struct W3DN_Context_s *self, W3DN_Texture *texture);
-
-    W3DN_ErrorCode (*old_TexGetSubResourceLayout)(struct W3DN_Context_s *self, W3DN_Texture *texture, W3DN_TexAspect aspect,
-         uint32 mipLevel, uint32 arrayIdx, W3DN_ResourceLayout *layout);
-
-    W3DN_ErrorCode (*old_TexSetParameters)(struct W3DN_Context_s *self, W3DN_Texture *texture, struct TagItem *tags);
-
-    W3DN_ErrorCode (*old_TexUpdateImage)(struct W3DN_Context_s *self, W3DN_Texture *texture, void *source,
-        uint32 level, uint32 arrayIdx, uint32 srcBytesPerRow, uint32 srcRowsPerLayer);
-
-    W3DN_ErrorCode (*old_TexUpdateSubImage)(struct W3DN_Context_s *self, W3DN_Texture *texture, void *source,
-        uint32 level, uint32 arrayIdx, uint32 srcBytesPerRow, uint32 srcRowsPerLayer,
-        uint32 dstX, uint32 dstY, uint32 dstLayer, uint32 width, uint32 height, uint32 depth);
-
-    W3DN_ErrorCode (*old_TSGetParameters)(struct W3DN_Context_s *self, W3DN_TextureSampler *texSampler, struct TagItem *tags);
-
-    W3DN_ErrorCode (*old_TSSetParameters)(struct W3DN_Context_s *self, W3DN_TextureSampler *texSampler, struct TagItem *tags);
-
-    W3DN_ErrorCode (*old_VBOGetArray)(struct W3DN_Context_s *self, W3DN_VertexBuffer *buffer,
-    		uint32 arrayIdx, W3DN_ElementFormat *elementType, BOOL *normalized,
-    		uint64 *numElements, uint64 *stride, uint64 *offset, uint64 *count);
-
-    uint64 (*old_VBOGetAttr)(struct W3DN_Context_s *self, W3DN_VertexBuffer *vertexBuffer, W3DN_BufferAttribute attr);
-
-    W3DN_BufferLock* (*old_VBOLock)(struct W3DN_Context_s *self, W3DN_ErrorCode *errCode,
-    		W3DN_VertexBuffer *buffer, uint64 readOffset, uint64 readSize);
-
-    W3DN_ErrorCode (*old_VBOSetArray)(struct W3DN_Context_s *self, W3DN_VertexBuffer *buffer,
-    		uint32 arrayIdx, W3DN_ElementFormat elementType, BOOL normalized, uint64 numElements,
-    		uint64 stride, uint64 offset, uint64 count);
-
-    W3DN_ErrorCode (*old_WaitDone)(struct W3DN_Context_s *self, uint32 submitID, uint32 timeout);
-
-    W3DN_ErrorCode (*old_WaitIdle)(struct W3DN_Context_s *self, uint32 timeout);
+    // Store original function pointers so that they can be still called
+    #define NOVA_OLD_POINTER(name, returnType, parameters, categories) \
+        returnType (*old_ ## name) parameters;
+    NOVA_FUNCTIONS(NOVA_OLD_POINTER)
+    #undef NOVA_OLD_POINTER
 };
 
-static struct NovaContext* contexts[MAX_CLIENTS];
+static ClientTable clientTable; // Patched contexts and the archive of the destroyed ones
 static APTR mutex;
 
 static const char* decodeTags(struct TagItem* tags, struct NovaContext* context)
@@ -1315,26 +888,68 @@ static void profileResults(struct NovaContext* const context)
 
     logAlways("  Draw calls/s %.1f", drawcalls / seconds);
 
-    logAlways("%30s | %10s | %10s | %10s | %20s | %20s | %24s | %20s",
-        "function", "call count", "errors", "nullptrs", "duration (ms)", "avg. call dur. (us)", timeUsedBuffer, "% of CPU time");
+    // OpenGL ES 2.0 may submit many times per frame, its frames are measured at aglSwapBuffers
+    if (ogles2_task_patched(context->task)) {
+        logAlways("  Frame times: see OpenGL ES 2.0 profiling results");
+    } else {
+        frametime_summary(&context->frameTimes, "W3DN_Submit");
+    }
+
+    overheadStats(context->profiling, NovaFunctionCount, overhead.novaCall, context->afterTicks, totalTicks);
+
+    logAlways("%30s | %10s | %10s | %10s | %20s | %20s | %20s | %20s | %24s | %20s | %12s | %12s | %12s | %12s",
+        "function", "call count", "errors", "nullptrs", "duration (ms)", "overhead (ms)", "corrected (ms)", "avg. call dur. (us)",
+        timeUsedBuffer, "% of CPU time", "p50 (us)", "p95 (us)", "p99 (us)", "max (us)");
 
     for (int i = 0; i < NovaFunctionCount; i++) {
         if (stats[i].callCount > 0) {
-            logAlways("%30s | %10llu | %10llu | %10llu | %20.6f | %20.3f | %24.2f | %20.2f",
+            const Histogram* const latency = &context->latency[stats[i].index];
+            const uint64 tracer = overheadTicks(&stats[i], 0);
+
+            logAlways("%30s | %10llu | %10llu | %10llu | %20.6f | %20.6f | %20.6f | %20.3f | %24.2f | %20.2f | %12.3f | %12.3f | %12.3f | %12.3f",
                 mapNovaFunction(stats[i].index),
                 stats[i].callCount,
                 stats[i].errors,
                 stats[i].nullptrs,
                 timer_ticks_to_ms(stats[i].ticks),
+                timer_ticks_to_ms(tracer),
+                timer_ticks_to_ms(correctTicks(stats[i].ticks, tracer)),
                 timer_ticks_to_us(stats[i].ticks) / (double)stats[i].callCount,
                 (double)stats[i].ticks * 100.0 / (double)context->ticks,
-                (double)stats[i].ticks * 100.0 / (double)totalTicks);
+                (double)stats[i].ticks * 100.0 / (double)totalTicks,
+                timer_ticks_to_us(histogram_percentile(latency, 50.0)),
+                timer_ticks_to_us(histogram_percentile(latency, 95.0)),
+                timer_ticks_to_us(histogram_percentile(latency, 99.0)),
+                timer_ticks_to_us(latency->max));
         }
     }
 
     primitiveStats(&context->counter, seconds, drawcalls);
 }
 
+static const int drawFunctions[] = { DrawElements, DrawArrays };
+static ProfilingItem snapshotItems[NovaFunctionCount]; // Used by the snapshot process, under the mutex
+
+void warp3dnova_snapshot(void)
+{
+    if (!mutex || !profilingStarted) {
+        return;
+    }
+
+    IExec->MutexObtain(mutex);
+
+    size_t position = 0;
+    struct NovaContext* context;
+
+    while ((context = client_table_next(&clientTable, &position))) {
+        intervalSummary(&context->interval, context->name, mapNovaTraceFunction, context->profiling, &context->counter,
+            snapshotItems, context->intervalProfiling, NovaFunctionCount, Submit, drawFunctions,
+            (int)(sizeof(drawFunctions) / sizeof(drawFunctions[0])));
+    }
+
+    IExec->MutexRelease(mutex);
+}
+
 void warp3dnova_start_profiling(void)
 {
     profilingStarted = TRUE;
@@ -1342,11 +957,12 @@ void warp3dnova_start_profiling(void)
     if (mutex) {
         IExec->MutexObtain(mutex);
 
-        for (size_t c = 0; c < MAX_CLIENTS; c++) {
-            if (contexts[c]) {
-                // TODO: concurrency issues?
-                PROF_INIT(contexts[c], NovaFunctionCount)
-            }
+        size_t position = 0;
+        struct NovaContext* context;
+
+        while ((context = client_table_next(&clientTable, &position))) {
+            // TODO: concurrency issues?
+            PROF_INIT(context, NovaFunctionCount)
         }
 
         IExec->MutexRelease(mutex);
@@ -1358,10 +974,11 @@ void warp3dnova_finish_profiling(void)
     if (mutex) {
         IExec->MutexObtain(mutex);
 
-        for (size_t c = 0; c < MAX_CLIENTS; c++) {
-            if (contexts[c]) {
-                profileResults(contexts[c]);
-            }
+        size_t position = 0;
+        struct NovaContext* context;
+
+        while ((context = client_table_next(&clientTable, &position))) {
+            profileResults(context);
         }
 
         IExec->MutexRelease(mutex);
@@ -1428,21 +1045,7 @@ static void find_process_name(struct NovaContext * context)
 
 static struct NovaContext* find_context(const struct W3DN_Context_s* const context)
 {
-    size_t i;
-    struct NovaContext* result = NULL;
-
-    IExec->MutexObtain(mutex);
-
-    for (i = 0; i < MAX_CLIENTS; i++) {
-        if (contexts[i]->context == context) {
-            result = contexts[i];
-            break;
-        }
-    }
-
-    IExec->MutexRelease(mutex);
-
-    return result;
+    return client_table_find(&clientTable, context);
 }
 
 static void checkPointer(struct NovaContext* context, const NovaFunction id, const void* ptr)
@@ -1460,16 +1063,34 @@ static void checkSuccess(struct NovaContext* context, const NovaFunction id, con
         logLine("%s: Warning: unsuccessful operation detected", context->name);
         context->profiling[id].errors++;
         errorCount++;
+
+        if (context->flight) {
+            flight_trigger("%s: %s failed with error %d", context->name, mapNovaFunction(id), code);
+        }
     }
 }
 
-#define GET_CONTEXT struct NovaContext* context = find_context(self);
+#define GET_CONTEXT(id, ...) \
+    struct NovaContext* context = find_context(self); \
+    const Predicate* const predicate = predicate_find(&predicates, id); \
+    const BOOL traced = filter_test(traceFilter, id) && PREDICATE_MATCH(predicate, ##__VA_ARGS__);
+
+// Recording is measured, so that an enclosing OGLES2 call can subtract it
+#define NOVA_RECORD(id, ...) \
+    if (RECORDING(context, traced)) { \
+        RECORD_CALL(context, traced, TraceModule_Nova, id, start.ticks, ##__VA_ARGS__) \
+        PROF_AFTER \
+        PROF_CHILD(id, afterDuration) \
+    } else { \
+        PROF_CHILD(id, 0) \
+    }
 
 #define NOVA_CALL(id, ...) \
 if (context->old_ ## id) { \
     PROF_START \
     context->old_ ## id(self, ##__VA_ARGS__); \
     PROF_FINISH(id) \
+    NOVA_RECORD(id, ##__VA_ARGS__) \
 } else { \
     logDebug("%s: " #id " function pointer is NULL (call ignored)", context->name); \
 }
@@ -1479,6 +1100,7 @@ if (context->old_ ## id) { \
     PROF_START \
     result = context->old_ ## id(self, ##__VA_ARGS__); \
     PROF_FINISH(id) \
+    NOVA_RECORD(id, ##__VA_ARGS__) \
 } else { \
     logDebug("%s: " #id " function pointer is NULL (call ignored)", context->name); \
 }
@@ -1490,15 +1112,15 @@ static W3DN_ErrorCode W3DN_BindBitMapAsTexture(struct W3DN_Context_s *self, W3DN
 {
     W3DN_ErrorCode result = W3DNEC_SUCCESS;
 
-    GET_CONTEXT
+    GET_CONTEXT(BindBitMapAsTexture, renderState, texUnit, bitMap, texSampler)
 
-    logLine("%s: %s: renderState %p, texUnit %lu, bitMap %p, texSampler %p",
+    traceLine("%s: %s: renderState %p, texUnit %lu, bitMap %p, texSampler %p",
         context->name, __func__,
         renderState, texUnit, bitMap, texSampler);
 
     NOVA_CALL_RESULT(result, BindBitMapAsTexture, renderState, texUnit, bitMap, texSampler)
 
-    logLine("%s: %s: <- result %d (%s)",
+    traceLine("%s: %s: <- result %d (%s)",
         context->name, __func__,
         result, mapNovaError(result));
 
@@ -1512,9 +1134,9 @@ static W3DN_ErrorCode W3DN_BindShaderDataBuffer(struct W3DN_Context_s *self, W3D
 {
     W3DN_ErrorCode result = W3DNEC_SUCCESS;
 
-    GET_CONTEXT
+    GET_CONTEXT(BindShaderDataBuffer, renderState, shaderType, buffer, bufferIdx)
 
-    logLine("%s: %s: renderState %p, shaderType %u (%s), buffer %p, bufferIdx %lu",
+    traceLine("%s: %s: renderState %p, shaderType %u (%s), buffer %p, bufferIdx %lu",
         context->name, __func__,
         renderState,
         shaderType, decodeShaderType(shaderType),
@@ -1522,7 +1144,7 @@ static W3DN_ErrorCode W3DN_BindShaderDataBuffer(struct W3DN_Context_s *self, W3D
 
     NOVA_CALL_RESULT(result, BindShaderDataBuffer, renderState, shaderType, buffer, bufferIdx)
 
-    logLine("%s: %s: <- result %d (%s)",
+    traceLine("%s: %s: <- result %d (%s)",
         context->name, __func__,
         result, mapNovaError(result));
 
@@ -1536,15 +1158,15 @@ static W3DN_ErrorCode W3DN_BindTexture(struct W3DN_Context_s *self, W3DN_RenderS
 {
     W3DN_ErrorCode result = W3DNEC_SUCCESS;
 
-    GET_CONTEXT
+    GET_CONTEXT(BindTexture, renderState, texUnit, texture, texSampler)
 
-    logLine("%s: %s: renderState %p, texUnit %lu, texture %p, texSampler %p",
+    traceLine("%s: %s: renderState %p, texUnit %lu, texture %p, texSampler %p",
         context->name, __func__,
         renderState, texUnit, texture, texSampler);
 
     NOVA_CALL_RESULT(result, BindTexture, renderState, texUnit, texture, texSampler)
 
-    logLine("%s: %s: <- result %d (%s)",
+    traceLine("%s: %s: <- result %d (%s)",
         context->name, __func__,
         result, mapNovaError(result));
 
@@ -1559,14 +1181,14 @@ static W3DN_ErrorCode W3DN_BindVertexAttribArray(struct W3DN_Context_s *self,
 {
     W3DN_ErrorCode result = W3DNEC_SUCCESS;
 
-    GET_CONTEXT
+    GET_CONTEXT(BindVertexAttribArray, renderState, attribNum, buffer, arrayIdx)
 
-    logLine("%s: %s: renderState %p, attribNum %lu, buffer %p, arrayIdx %lu", context->name, __func__,
+    traceLine("%s: %s: renderState %p, attribNum %lu, buffer %p, arrayIdx %lu", context->name, __func__,
         renderState, attribNum, buffer, arrayIdx);
 
     NOVA_CALL_RESULT(result, BindVertexAttribArray, renderState, attribNum, buffer, arrayIdx)
 
-    logLine("%s: %s: <- result %d (%s)", context->name, __func__,
+    traceLine("%s: %s: <- result %d (%s)", context->name, __func__,
         result, mapNovaError(result));
 
     checkSuccess(context, BindVertexAttribArray, result);
@@ -1590,18 +1212,18 @@ static W3DN_ErrorCode W3DN_BufferUnlock(struct W3DN_Context_s *self,
     const size_t items = bufferLock->size / 4;
     for (size_t i = 0; i < items; i++) {
         c.u = bufferLock->buffer[i];
-        logLine("[%u] = %f (%lx)", i, c.f, c.u);
+        traceLine("[%u] = %f (%lx)", i, c.f, c.u);
     }
 #endif
 
-    GET_CONTEXT
+    GET_CONTEXT(BufferUnlock, bufferLock, writeOffset, writeSize)
 
-    logLine("%s: %s: bufferLock %p, writeOffset %llu, writeSize %llu", context->name, __func__,
+    traceLine("%s: %s: bufferLock %p, writeOffset %llu, writeSize %llu", context->name, __func__,
         bufferLock, writeOffset, writeSize);
 
     NOVA_CALL_RESULT(result, BufferUnlock, bufferLock, writeOffset, writeSize)
 
-    logLine("%s: %s: <- result %d (%s)", context->name, __func__,
+    traceLine("%s: %s: <- result %d (%s)", context->name, __func__,
         result, mapNovaError(result));
 
     checkSuccess(context, BufferUnlock, result);
@@ -1614,9 +1236,9 @@ static W3DN_ErrorCode W3DN_Clear(struct W3DN_Context_s *self, W3DN_RenderState *
 {
     W3DN_ErrorCode result = W3DNEC_SUCCESS;
 
-    GET_CONTEXT
+    GET_CONTEXT(Clear, renderState, colour, depth, stencil)
 
-    logLine("%s: %s: renderState %p, colour %p (%f, %f, %f, %f), depth %p (%f), stencil %p (%lu)",
+    traceLine("%s: %s: renderState %p, colour %p (%f, %f, %f, %f), depth %p (%f), stencil %p (%lu)",
         context->name, __func__,
         renderState,
         colour,
@@ -1629,7 +1251,7 @@ static W3DN_ErrorCode W3DN_Clear(struct W3DN_Context_s *self, W3DN_RenderState *
 
     NOVA_CALL_RESULT(result, Clear, renderState, colour, depth, stencil)
 
-    logLine("%s: %s: <- result %d (%s)",
+    traceLine("%s: %s: <- result %d (%s)",
         context->name, __func__,
         result, mapNovaError(result));
 
@@ -1643,16 +1265,16 @@ static W3DN_Shader* W3DN_CompileShader(struct W3DN_Context_s *self,
 {
     W3DN_Shader *shader = NULL;
 
-    GET_CONTEXT
+    GET_CONTEXT(CompileShader, errCode, tags)
 
-    logLine("%s: %s: errCode %p, tags %p (%s)",
+    traceLine("%s: %s: errCode %p, tags %p (%s)",
         context->name, __func__,
         errCode,
         tags, decodeTags(tags, context));
 
     NOVA_CALL_RESULT(shader, CompileShader, errCode, tags)
 
-    logLine("%s: %s: <- errCode %d (%s). Shader address %p",
+    traceLine("%s: %s: <- errCode %d (%s). Shader address %p",
         context->name, __func__,
         mapNovaErrorPointerToCode(errCode),
         mapNovaErrorPointerToString(errCode),
@@ -1669,9 +1291,9 @@ static W3DN_DataBuffer* W3DN_CreateDataBufferObject(struct W3DN_Context_s *self,
 {
     W3DN_DataBuffer *buffer = NULL;
 
-    GET_CONTEXT
+    GET_CONTEXT(CreateDataBufferObject, errCode, size, usage, maxBuffers, tags)
 
-    logLine("%s: %s: errCode %p, size %llu, usage %u (%s), maxBuffers %lu, tags %p (%s)",
+    traceLine("%s: %s: errCode %p, size %llu, usage %u (%s), maxBuffers %lu, tags %p (%s)",
         context->name, __func__,
         errCode,
         size,
@@ -1681,7 +1303,7 @@ static W3DN_DataBuffer* W3DN_CreateDataBufferObject(struct W3DN_Context_s *self,
 
     NOVA_CALL_RESULT(buffer, CreateDataBufferObject, errCode, size, usage, maxBuffers, tags)
 
-    logLine("%s: %s: <- errCode %d (%s). Data buffer object address %p",
+    traceLine("%s: %s: <- errCode %d (%s). Data buffer object address %p",
         context->name, __func__,
         mapNovaErrorPointerToCode(errCode),
         mapNovaErrorPointerToString(errCode),
@@ -1697,15 +1319,15 @@ static W3DN_FrameBuffer* W3DN_CreateFrameBuffer(struct W3DN_Context_s *self, W3D
 {
     W3DN_FrameBuffer* buffer = NULL;
 
-    GET_CONTEXT
+    GET_CONTEXT(CreateFrameBuffer, errCode)
 
-    logLine("%s: %s: errCode %p",
+    traceLine("%s: %s: errCode %p",
         context->name, __func__,
         errCode);
 
     NOVA_CALL_RESULT(buffer, CreateFrameBuffer, errCode)
 
-    logLine("%s: %s: <- errCode %d (%s). Frame buffer address %p",
+    traceLine("%s: %s: <- errCode %d (%s). Frame buffer address %p",
         context->name, __func__,
         mapNovaErrorPointerToCode(errCode),
         mapNovaErrorPointerToString(errCode),
@@ -1721,15 +1343,15 @@ static W3DN_RenderState* W3DN_CreateRenderStateObject(struct W3DN_Context_s *sel
 {
     W3DN_RenderState* state = NULL;
 
-    GET_CONTEXT
+    GET_CONTEXT(CreateRenderStateObject, errCode)
 
-    logLine("%s: %s: errCode %p",
+    traceLine("%s: %s: errCode %p",
         context->name, __func__,
         errCode);
 
     NOVA_CALL_RESULT(state, CreateRenderStateObject, errCode)
 
-    logLine("%s: %s: <- errCode %d (%s). Render state object address %p",
+    traceLine("%s: %s: <- errCode %d (%s). Render state object address %p",
         context->name, __func__,
         mapNovaErrorPointerToCode(errCode),
         mapNovaErrorPointerToString(errCode),
@@ -1745,15 +1367,15 @@ static W3DN_ShaderPipeline* W3DN_CreateShaderPipeline(struct W3DN_Context_s *sel
 {
     W3DN_ShaderPipeline* pipeline = NULL;
 
-    GET_CONTEXT
+    GET_CONTEXT(CreateShaderPipeline, errCode, tags)
 
-    logLine("%s: %s: errCode %p, tags %p (%s)",
+    traceLine("%s: %s: errCode %p, tags %p (%s)",
         context->name, __func__,
         errCode, tags, decodeTags(tags, context));
 
     NOVA_CALL_RESULT(pipeline, CreateShaderPipeline, errCode, tags)
 
-    logLine("%s: %s: <- errCode %d (%s). Shader pipeline address %p",
+    traceLine("%s: %s: <- errCode %d (%s). Shader pipeline address %p",
         context->name, __func__,
         mapNovaErrorPointerToCode(errCode),
         mapNovaErrorPointerToString(errCode),
@@ -1769,15 +1391,15 @@ static W3DN_TextureSampler* W3DN_CreateTexSampler(struct W3DN_Context_s *self, W
 {
     W3DN_TextureSampler* sampler = NULL;
 
-    GET_CONTEXT
+    GET_CONTEXT(CreateTexSampler, errCode)
 
-    logLine("%s: %s: errCode %p",
+    traceLine("%s: %s: errCode %p",
         context->name, __func__,
         errCode);
 
     NOVA_CALL_RESULT(sampler, CreateTexSampler, errCode)
 
-    logLine("%s: %s: <- errCode %d (%s). Texture sampler address %p",
+    traceLine("%s: %s: <- errCode %d (%s). Texture sampler address %p",
         context->name, __func__,
         mapNovaErrorPointerToCode(errCode),
         mapNovaErrorPointerToString(errCode),
@@ -1795,9 +1417,9 @@ static W3DN_Texture* W3DN_CreateTexture(struct W3DN_Context_s *self, W3DN_ErrorC
 {
     W3DN_Texture* texture = NULL;
 
-    GET_CONTEXT
+    GET_CONTEXT(CreateTexture, errCode, texType, pixelFormat, elementFormat, width, height, depth, mipmapped, usage)
 
-    logLine("%s: %s: errCode %p, texType %u (%s), pixelFormat %u (%s), elementFormat %u (%s), width %lu, height %lu, depth %lu, "
+    traceLine("%s: %s: errCode %p, texType %u (%s), pixelFormat %u (%s), elementFormat %u (%s), width %lu, height %lu, depth %lu, "
         "mipmapped %d, usage %u (%s)",
         context->name, __func__,
         errCode,
@@ -1813,7 +1435,7 @@ static W3DN_Texture* W3DN_CreateTexture(struct W3DN_Context_s *self, W3DN_ErrorC
     NOVA_CALL_RESULT(texture, CreateTexture, errCode, texType, pixelFormat, elementFormat,
         width, height, depth, mipmapped, usage)
 
-    logLine("%s: %s: <- errCode %d (%s). Texture address %p",
+    traceLine("%s: %s: <- errCode %d (%s). Texture address %p",
         context->name, __func__,
         mapNovaErrorPointerToCode(errCode),
         mapNovaErrorPointerToString(errCode),
@@ -1831,9 +1453,9 @@ static W3DN_Texture* W3DN_CreateTextureExtRMB(struct W3DN_Context_s *self, W3DN_
 {
     W3DN_Texture* texture = NULL;
 
-    GET_CONTEXT
+    GET_CONTEXT(CreateTextureExtRMB, errCode, rmBuffer, layout, texType, pixelFormat, elementFormat, width, height, depth, mipmapped)
 
-    logLine("%s: %s: errCode %p, rmBuffer %p, layout %p, texType %d (%s), pixelFormat %d (%s), elementFormat %d (%s), "
+    traceLine("%s: %s: errCode %p, rmBuffer %p, layout %p, texType %d (%s), pixelFormat %d (%s), elementFormat %d (%s), "
         "width %lu, height %lu, depth %lu, mipmapped %d",
         context->name, __func__,
         errCode,
@@ -1850,7 +1472,7 @@ static W3DN_Texture* W3DN_CreateTextureExtRMB(struct W3DN_Context_s *self, W3DN_
     NOVA_CALL_RESULT(texture, CreateTextureExtRMB, errCode, rmBuffer, layout, texType, pixelFormat, elementFormat,
         width, height, depth, mipmapped)
 
-    logLine("%s: %s: <- errCode %d (%s). Texture address %p",
+    traceLine("%s: %s: <- errCode %d (%s). Texture address %p",
         context->name, __func__,
         mapNovaErrorPointerToCode(errCode),
         mapNovaErrorPointerToString(errCode),
@@ -1867,9 +1489,9 @@ static W3DN_VertexBuffer* W3DN_CreateVertexBufferObject(struct W3DN_Context_s *s
 {
     W3DN_VertexBuffer* result = NULL;
 
-    GET_CONTEXT
+    GET_CONTEXT(CreateVertexBufferObject, errCode, size, usage, maxArrays, tags)
 
-    logLine("%s: %s: errCode %p, size %llu, usage %u (%s), maxArrays %lu, tags %p (%s)",
+    traceLine("%s: %s: errCode %p, size %llu, usage %u (%s), maxArrays %lu, tags %p (%s)",
         context->name, __func__,
         errCode, size,
         usage, decodeBufferUsage(usage),
@@ -1878,7 +1500,7 @@ static W3DN_VertexBuffer* W3DN_CreateVertexBufferObject(struct W3DN_Context_s *s
 
     NOVA_CALL_RESULT(result, CreateVertexBufferObject, errCode, size, usage, maxArrays, tags)
 
-    logLine("%s: %s: <- errCode %d (%s). Buffer address %p",
+    traceLine("%s: %s: <- errCode %d (%s). Buffer address %p",
         context->name, __func__,
         mapNovaErrorPointerToCode(errCode),
         mapNovaErrorPointerToString(errCode),
@@ -1894,16 +1516,16 @@ static uint64 W3DN_DBOGetAttr(struct W3DN_Context_s *self, W3DN_DataBuffer *data
 {
     uint64 result = 0;
 
-    GET_CONTEXT
+    GET_CONTEXT(DBOGetAttr, dataBuffer, attr)
 
-    logLine("%s: %s: dataBuffer %p, attr %u (%s)",
+    traceLine("%s: %s: dataBuffer %p, attr %u (%s)",
         context->name, __func__,
         dataBuffer,
         attr, decodeBufferAttribute(attr));
 
     NOVA_CALL_RESULT(result, DBOGetAttr, dataBuffer, attr)
 
-    logLine("%s: %s: <- Result %llu",
+    traceLine("%s: %s: <- Result %llu",
         context->name, __func__,
         result);
 
@@ -1915,16 +1537,16 @@ static W3DN_ErrorCode W3DN_DBOGetBuffer(struct W3DN_Context_s *self, W3DN_DataBu
 {
     W3DN_ErrorCode result = W3DNEC_SUCCESS;
 
-    GET_CONTEXT
+    GET_CONTEXT(DBOGetBuffer, dataBuffer, bufferIdx, offset, size, targetShader, tags)
 
-    logLine("%s: %s: dataBuffer %p, bufferIdx %lu, offset %p, size %p, targetShader %p, tags %p (%s)",
+    traceLine("%s: %s: dataBuffer %p, bufferIdx %lu, offset %p, size %p, targetShader %p, tags %p (%s)",
         context->name, __func__,
         dataBuffer, bufferIdx, offset, size, targetShader,
         tags, decodeTags(tags, context));
 
     NOVA_CALL_RESULT(result, DBOGetBuffer, dataBuffer, bufferIdx, offset, size, targetShader, tags)
 
-    logLine("%s: %s: <- offset %llu, size %llu, targetShader %p. Result %d (%s)",
+    traceLine("%s: %s: <- offset %llu, size %llu, targetShader %p. Result %d (%s)",
         context->name, __func__,
         *offset, *size, *targetShader,
         result, mapNovaError(result));
@@ -1938,15 +1560,15 @@ static W3DN_BufferLock* W3DN_DBOLock(struct W3DN_Context_s *self, W3DN_ErrorCode
 {
     W3DN_BufferLock* lock = NULL;
 
-    GET_CONTEXT
+    GET_CONTEXT(DBOLock, errCode, buffer, readOffset, readSize)
 
-    logLine("%s: %s: errCode %p, buffer %p, readOffset %llu, readSize %llu",
+    traceLine("%s: %s: errCode %p, buffer %p, readOffset %llu, readSize %llu",
         context->name, __func__,
         errCode, buffer, readOffset, readSize);
 
     NOVA_CALL_RESULT(lock, DBOLock, errCode, buffer, readOffset, readSize)
 
-    logLine("%s: %s: <- errCode %d (%s). Buffer lock address %p",
+    traceLine("%s: %s: <- errCode %d (%s). Buffer lock address %p",
         context->name, __func__,
         mapNovaErrorPointerToCode(errCode),
         mapNovaErrorPointerToString(errCode),
@@ -1963,16 +1585,16 @@ static W3DN_ErrorCode W3DN_DBOSetBuffer(struct W3DN_Context_s *self, W3DN_DataBu
 {
     W3DN_ErrorCode result = W3DNEC_SUCCESS;
 
-    GET_CONTEXT
+    GET_CONTEXT(DBOSetBuffer, dataBuffer, bufferIdx, offset, size, targetShader, tags)
 
-    logLine("%s: %s: dataBuffer %p, bufferIdx %lu, offset %llu. size %llu, targetShader %p, tags %p (%s)",
+    traceLine("%s: %s: dataBuffer %p, bufferIdx %lu, offset %llu. size %llu, targetShader %p, tags %p (%s)",
         context->name, __func__,
         dataBuffer, bufferIdx, offset, size, targetShader,
         tags, decodeTags(tags, context));
 
     NOVA_CALL_RESULT(result, DBOSetBuffer, dataBuffer, bufferIdx, offset, size, targetShader, tags)
 
-    logLine("%s: %s: <- Result %d (%s)",
+    traceLine("%s: %s: <- Result %d (%s)",
         context->name, __func__,
         result, mapNovaError(result));
 
@@ -1981,29 +1603,44 @@ static W3DN_ErrorCode W3DN_DBOSetBuffer(struct W3DN_Context_s *self, W3DN_DataBu
     return result;
 }
 
+// Logs the results and keeps only a summary of the context. Needs the mutex.
+static void closeContext(struct NovaContext* const nova)
+{
+    profileResults(nova);
+
+    log_forget_task(nova->task);
+    recorder_close(nova->trace);
+    flight_close(nova->flight);
+    ITimer->ReadEClock(&nova->closed.clockVal);
+
+    ClientSummary* const summary = summarizeClient(nova->name, nova->id, nova->task,
+        nova->closed.ticks - nova->start.ticks, nova->ticks, nova->profiling, NovaFunctionCount);
+
+    if (!client_table_remove(&clientTable, nova->context, summary)) {
+        logAlways("%s: cannot archive client data", nova->name);
+        IExec->FreeVec(summary);
+    }
+
+    IExec->FreeVec(nova);
+}
+
 static void W3DN_Destroy(struct W3DN_Context_s *self)
 {
-    GET_CONTEXT
+    GET_CONTEXT(Destroy)
 
-    logLine("%s: %s",
+    traceLine("%s: %s",
         context->name, __func__);
 
     NOVA_CALL(Destroy)
 
-    size_t i;
-
     IExec->MutexObtain(mutex);
 
-    for (i = 0; i < MAX_CLIENTS; i++) {
-        if (contexts[i] && contexts[i]->context == self) {
-            profileResults(contexts[i]);
+    struct NovaContext* nova = client_table_find(&clientTable, self);
 
-            logLine("%s: freeing patched Nova context %p", contexts[i]->name, self);
+    if (nova) {
+        traceLine("%s: freeing patched Nova context %p [%lu]", nova->name, self, nova->id);
 
-            IExec->FreeVec(contexts[i]);
-            contexts[i] = NULL;
-            break;
-        }
+        closeContext(nova);
     }
 
     IExec->MutexRelease(mutex);
@@ -2011,9 +1648,9 @@ static void W3DN_Destroy(struct W3DN_Context_s *self)
 
 static void W3DN_DestroyDataBufferObject(struct W3DN_Context_s *self, W3DN_DataBuffer *dataBuffer)
 {
-    GET_CONTEXT
+    GET_CONTEXT(DestroyDataBufferObject, dataBuffer)
 
-    logLine("%s: %s: dataBuffer %p",
+    traceLine("%s: %s: dataBuffer %p",
         context->name, __func__,
         dataBuffer);
 
@@ -2022,9 +1659,9 @@ static void W3DN_DestroyDataBufferObject(struct W3DN_Context_s *self, W3DN_DataB
 
 static void W3DN_DestroyFrameBuffer(struct W3DN_Context_s *self, W3DN_FrameBuffer *frameBuffer)
 {
-    GET_CONTEXT
+    GET_CONTEXT(DestroyFrameBuffer, frameBuffer)
 
-    logLine("%s: %s: frameBuffer %p",
+    traceLine("%s: %s: frameBuffer %p",
         context->name, __func__,
         frameBuffer);
 
@@ -2033,9 +1670,9 @@ static void W3DN_DestroyFrameBuffer(struct W3DN_Context_s *self, W3DN_FrameBuffe
 
 static void W3DN_DestroyRenderStateObject(struct W3DN_Context_s *self, W3DN_RenderState *renderState)
 {
-    GET_CONTEXT
+    GET_CONTEXT(DestroyRenderStateObject, renderState)
 
-    logLine("%s: %s: renderState %p",
+    traceLine("%s: %s: renderState %p",
         context->name, __func__,
         renderState);
 
@@ -2044,9 +1681,9 @@ static void W3DN_DestroyRenderStateObject(struct W3DN_Context_s *self, W3DN_Rend
 
 static void W3DN_DestroyShader(struct W3DN_Context_s *self, W3DN_Shader *shader)
 {
-    GET_CONTEXT
+    GET_CONTEXT(DestroyShader, shader)
 
-    logLine("%s: %s: shader %p",
+    traceLine("%s: %s: shader %p",
         context->name, __func__,
         shader);
 
@@ -2055,9 +1692,9 @@ static void W3DN_DestroyShader(struct W3DN_Context_s *self, W3DN_Shader *shader)
 
 static void W3DN_DestroyShaderLog(struct W3DN_Context_s *self, const char *shaderLog)
 {
-    GET_CONTEXT
+    GET_CONTEXT(DestroyShaderLog, shaderLog)
 
-    logLine("%s: %s: shaderLog %p",
+    traceLine("%s: %s: shaderLog %p",
         context->name, __func__,
         shaderLog);
 
@@ -2066,9 +1703,9 @@ static void W3DN_DestroyShaderLog(struct W3DN_Context_s *self, const char *shade
 
 static void W3DN_DestroyShaderPipeline(struct W3DN_Context_s *self, W3DN_ShaderPipeline *shaderPipeline)
 {
-    GET_CONTEXT
+    GET_CONTEXT(DestroyShaderPipeline, shaderPipeline)
 
-    logLine("%s: %s: shaderPipeline %p",
+    traceLine("%s: %s: shaderPipeline %p",
         context->name, __func__,
         shaderPipeline);
 
@@ -2077,9 +1714,9 @@ static void W3DN_DestroyShaderPipeline(struct W3DN_Context_s *self, W3DN_ShaderP
 
 static void W3DN_DestroyTexSampler(struct W3DN_Context_s *self, W3DN_TextureSampler *texSampler)
 {
-    GET_CONTEXT
+    GET_CONTEXT(DestroyTexSampler, texSampler)
 
-    logLine("%s: %s: texSampler %p",
+    traceLine("%s: %s: texSampler %p",
         context->name, __func__,
         texSampler);
 
@@ -2088,9 +1725,9 @@ static void W3DN_DestroyTexSampler(struct W3DN_Context_s *self, W3DN_TextureSamp
 
 static void W3DN_DestroyTexture(struct W3DN_Context_s *self, W3DN_Texture *texture)
 {
-    GET_CONTEXT
+    GET_CONTEXT(DestroyTexture, texture)
 
-    logLine("%s: %s: texture %p",
+    traceLine("%s: %s: texture %p",
         context->name, __func__,
         texture);
 
@@ -2099,9 +1736,9 @@ static void W3DN_DestroyTexture(struct W3DN_Context_s *self, W3DN_Texture *textu
 
 static void W3DN_DestroyVertexBufferObject(struct W3DN_Context_s *self, W3DN_VertexBuffer *vertexBuffer)
 {
-    GET_CONTEXT
+    GET_CONTEXT(DestroyVertexBufferObject, vertexBuffer)
 
-    logLine("%s: %s: vertexBuffer %p", context->name, __func__,
+    traceLine("%s: %s: vertexBuffer %p", context->name, __func__,
         vertexBuffer);
 
     NOVA_CALL(DestroyVertexBufferObject, vertexBuffer)
@@ -2142,16 +1779,16 @@ static W3DN_ErrorCode W3DN_DrawArrays(struct W3DN_Context_s *self,
 {
     W3DN_ErrorCode result = W3DNEC_SUCCESS;
 
-    GET_CONTEXT
+    GET_CONTEXT(DrawArrays, renderState, primitive, base, count)
 
-    logLine("%s: %s: renderState %p, primitive %u (%s), base %lu, count %lu", context->name, __func__,
+    traceLine("%s: %s: renderState %p, primitive %u (%s), base %lu, count %lu", context->name, __func__,
         renderState,
         primitive, decodePrimitive(primitive),
         base, count);
 
     NOVA_CALL_RESULT(result, DrawArrays, renderState, primitive, base, count)
 
-    logLine("%s: %s: <- Result %d (%s)", context->name, __func__,
+    traceLine("%s: %s: <- Result %d (%s)", context->name, __func__,
         result, mapNovaError(result));
 
     countPrimitive(&context->counter, primitive, count);
@@ -2166,9 +1803,9 @@ static W3DN_ErrorCode W3DN_DrawElements(struct W3DN_Context_s *self,
 {
     W3DN_ErrorCode result = W3DNEC_SUCCESS;
 
-    GET_CONTEXT
+    GET_CONTEXT(DrawElements, renderState, primitive, baseVertex, count, indexBuffer, arrayIdx)
 
-    logLine("%s: %s: renderState %p, primitive %u (%s), baseVertex %lu, count %lu, indexBuffer %p, arrayIdx %lu",
+    traceLine("%s: %s: renderState %p, primitive %u (%s), baseVertex %lu, count %lu, indexBuffer %p, arrayIdx %lu",
         context->name, __func__,
         renderState,
         primitive, decodePrimitive(primitive),
@@ -2176,7 +1813,7 @@ static W3DN_ErrorCode W3DN_DrawElements(struct W3DN_Context_s *self,
 
     NOVA_CALL_RESULT(result, DrawElements, renderState, primitive, baseVertex, count, indexBuffer, arrayIdx)
 
-    logLine("%s: %s: <- Result %d (%s)",
+    traceLine("%s: %s: <- Result %d (%s)",
         context->name, __func__,
         result, mapNovaError(result));
 
@@ -2191,16 +1828,16 @@ static W3DN_ErrorCode W3DN_FBBindBuffer(struct W3DN_Context_s *self,
 {
     W3DN_ErrorCode result = W3DNEC_SUCCESS;
 
-    GET_CONTEXT
+    GET_CONTEXT(FBBindBuffer, frameBuffer, attachmentPt, tags)
 
-    logLine("%s: %s: frameBuffer %p, attachmentPt %d, tags %p (%s)",
+    traceLine("%s: %s: frameBuffer %p, attachmentPt %d, tags %p (%s)",
         context->name, __func__,
         frameBuffer, (int)attachmentPt,
         tags, decodeTags(tags, context));
 
     NOVA_CALL_RESULT(result, FBBindBuffer, frameBuffer, attachmentPt, tags);
 
-    logLine("%s: %s: <- Result %d (%s)",
+    traceLine("%s: %s: <- Result %d (%s)",
         context->name, __func__,
         result, mapNovaError(result));
 
@@ -2214,16 +1851,16 @@ static uint64 W3DN_FBGetAttr(struct W3DN_Context_s *self,
 {
     uint64 result = 0;
 
-    GET_CONTEXT
+    GET_CONTEXT(FBGetAttr, frameBuffer, attrib)
 
-    logLine("%s: %s: frameBuffer %p, attrib %u (%s)",
+    traceLine("%s: %s: frameBuffer %p, attrib %u (%s)",
         context->name, __func__,
         frameBuffer,
         attrib, decodeFrameBufferAttribute(attrib));
 
     NOVA_CALL_RESULT(result, FBGetAttr, frameBuffer, attrib)
 
-    logLine("%s: %s: <- Result %llu",
+    traceLine("%s: %s: <- Result %llu",
         context->name, __func__,
         result);
 
@@ -2235,15 +1872,15 @@ static struct BitMap* W3DN_FBGetBufferBM(struct W3DN_Context_s *self,
 {
     struct BitMap* bitmap = NULL;
 
-    GET_CONTEXT
+    GET_CONTEXT(FBGetBufferBM, frameBuffer, attachmentPt, errCode)
 
-    logLine("%s: %s: frameBuffer %p, attachmentPt %lu, errCode %p",
+    traceLine("%s: %s: frameBuffer %p, attachmentPt %lu, errCode %p",
         context->name, __func__,
         frameBuffer, attachmentPt, errCode);
 
     NOVA_CALL_RESULT(bitmap, FBGetBufferBM, frameBuffer, attachmentPt, errCode)
 
-    logLine("%s: %s: <- Bitmap address %p. Result %d (%s)",
+    traceLine("%s: %s: <- Bitmap address %p. Result %d (%s)",
         context->name, __func__,
         bitmap,
         mapNovaErrorPointerToCode(errCode),
@@ -2260,15 +1897,15 @@ static W3DN_Texture*  W3DN_FBGetBufferTex(struct W3DN_Context_s *self,
 {
     W3DN_Texture * texture = NULL;
 
-    GET_CONTEXT
+    GET_CONTEXT(FBGetBufferTex, frameBuffer, attachmentPt, errCode)
 
-    logLine("%s: %s: frameBuffer %p, attachmentPt %lu, errCode %p",
+    traceLine("%s: %s: frameBuffer %p, attachmentPt %lu, errCode %p",
         context->name, __func__,
         frameBuffer, attachmentPt, errCode);
 
     NOVA_CALL_RESULT(texture, FBGetBufferTex, frameBuffer, attachmentPt, errCode)
 
-    logLine("%s: %s: <- Texture address %p. Result %d (%s)",
+    traceLine("%s: %s: <- Texture address %p. Result %d (%s)",
         context->name, __func__,
         texture,
         mapNovaErrorPointerToCode(errCode),
@@ -2284,15 +1921,15 @@ static W3DN_ErrorCode W3DN_FBGetStatus(struct W3DN_Context_s *self, W3DN_FrameBu
 {
     W3DN_ErrorCode result = W3DNEC_SUCCESS;
 
-    GET_CONTEXT
+    GET_CONTEXT(FBGetStatus, frameBuffer)
 
-    logLine("%s: %s: frameBuffer %p",
+    traceLine("%s: %s: frameBuffer %p",
         context->name, __func__,
         frameBuffer);
 
     NOVA_CALL_RESULT(result, FBGetStatus, frameBuffer)
 
-    logLine("%s: %s: <- Result %d (%s)",
+    traceLine("%s: %s: <- Result %d (%s)",
         context->name, __func__,
         result,
         mapNovaError(result));
@@ -2306,15 +1943,15 @@ static struct BitMap* W3DN_GetBitMapTexture(struct W3DN_Context_s *self, W3DN_Re
 {
     struct BitMap* bitmap = NULL;
 
-    GET_CONTEXT
+    GET_CONTEXT(GetBitMapTexture, renderState, texUnit)
 
-    logLine("%s: %s: renderState %p, texUnit %lu",
+    traceLine("%s: %s: renderState %p, texUnit %lu",
         context->name, __func__,
         renderState, texUnit);
 
     NOVA_CALL_RESULT(bitmap, GetBitMapTexture, renderState, texUnit)
 
-    logLine("%s: %s: <- Bitmap address %p",
+    traceLine("%s: %s: <- Bitmap address %p",
         context->name, __func__,
         bitmap);
 
@@ -2328,15 +1965,15 @@ static W3DN_ErrorCode W3DN_GetBlendColour(struct W3DN_Context_s *self, W3DN_Rend
 {
     W3DN_ErrorCode result = W3DNEC_SUCCESS;
 
-    GET_CONTEXT
+    GET_CONTEXT(GetBlendColour, renderState, red, green, blue, alpha)
 
-    logLine("%s: %s: renderState %p, red %p, green %p, blue %p, alpha %p",
+    traceLine("%s: %s: renderState %p, red %p, green %p, blue %p, alpha %p",
         context->name, __func__,
         renderState, red, green, blue, alpha);
 
     NOVA_CALL_RESULT(result, GetBlendColour, renderState, red, green, blue, alpha);
 
-    logLine("%s: %s: <- red %f, green %f, blue %f, alpha %f. Result %d (%s)",
+    traceLine("%s: %s: <- red %f, green %f, blue %f, alpha %f. Result %d (%s)",
         context->name, __func__,
         *red, *green, *blue, *alpha,
         result,
@@ -2352,15 +1989,15 @@ static W3DN_ErrorCode W3DN_GetBlendEquation(struct W3DN_Context_s *self, W3DN_Re
 {
     W3DN_ErrorCode result = W3DNEC_SUCCESS;
 
-    GET_CONTEXT
+    GET_CONTEXT(GetBlendEquation, renderState, buffIdx, colEquation, alphaEquation)
 
-    logLine("%s: %s: renderState %p, buffIdx %lu, colEquation %p, alphaEquation %p",
+    traceLine("%s: %s: renderState %p, buffIdx %lu, colEquation %p, alphaEquation %p",
         context->name, __func__,
         renderState, buffIdx, colEquation, alphaEquation);
 
     NOVA_CALL_RESULT(result, GetBlendEquation, renderState, buffIdx, colEquation, alphaEquation);
 
-    logLine("%s: %s: <- colEquation %u (%s), alphaEquation %u (%s). Result %d (%s)",
+    traceLine("%s: %s: <- colEquation %u (%s), alphaEquation %u (%s). Result %d (%s)",
         context->name, __func__,
         *colEquation, decodeBlendEquation(*colEquation),
         *alphaEquation, decodeBlendEquation(*alphaEquation),
@@ -2377,15 +2014,15 @@ static W3DN_ErrorCode W3DN_GetBlendMode(struct W3DN_Context_s *self, W3DN_Render
 {
     W3DN_ErrorCode result = W3DNEC_SUCCESS;
 
-    GET_CONTEXT
+    GET_CONTEXT(GetBlendMode, renderState, buffIdx, colSrc, colDst, alphaSrc, alphaDst)
 
-    logLine("%s: %s: renderState %p, buffIdx %lu, colSrc %p, colDst %p, alphaSrc %p, alphaDst %p",
+    traceLine("%s: %s: renderState %p, buffIdx %lu, colSrc %p, colDst %p, alphaSrc %p, alphaDst %p",
         context->name, __func__,
         renderState, buffIdx, colSrc, colDst, alphaSrc, alphaDst);
 
     NOVA_CALL_RESULT(result, GetBlendMode, renderState, buffIdx, colSrc, colDst, alphaSrc, alphaDst)
 
-    logLine("%s: %s: <- colSrc %u (%s), colDst %u (%s), alphaSrc %u (%s), alphaDst %u (%s). Result %d (%s)",
+    traceLine("%s: %s: <- colSrc %u (%s), colDst %u (%s), alphaSrc %u (%s), alphaDst %u (%s). Result %d (%s)",
         context->name, __func__,
         *colSrc, decodeBlendMode(*colSrc),
         *colDst, decodeBlendMode(*colDst),
@@ -2403,15 +2040,15 @@ static uint8 W3DN_GetColourMask(struct W3DN_Context_s *self, W3DN_RenderState *r
 {
     uint8 mask = 0;
 
-    GET_CONTEXT
+    GET_CONTEXT(GetColourMask, renderState, index)
 
-    logLine("%s: %s: renderState %p, index %lu",
+    traceLine("%s: %s: renderState %p, index %lu",
         context->name, __func__,
         renderState, index);
 
     NOVA_CALL_RESULT(mask, GetColourMask, renderState, index)
 
-    logLine("%s: %s: <- Mask value 0x%x",
+    traceLine("%s: %s: <- Mask value 0x%x",
         context->name, __func__,
         mask);
 
@@ -2422,15 +2059,15 @@ static W3DN_CompareFunc W3DN_GetDepthCompareFunc(struct W3DN_Context_s *self, W3
 {
     W3DN_CompareFunc function = 0;
 
-    GET_CONTEXT
+    GET_CONTEXT(GetDepthCompareFunc, renderState)
 
-    logLine("%s: %s: renderState %p",
+    traceLine("%s: %s: renderState %p",
         context->name, __func__,
         renderState);
 
     NOVA_CALL_RESULT(function, GetDepthCompareFunc, renderState)
 
-    logLine("%s: %s: <- Compare function %u (%s)",
+    traceLine("%s: %s: <- Compare function %u (%s)",
         context->name, __func__,
         function, decodeCompareFunc(function));
 
@@ -2441,15 +2078,15 @@ static W3DN_Face W3DN_GetFrontFace(struct W3DN_Context_s *self, W3DN_RenderState
 {
     W3DN_Face face = 0;
 
-    GET_CONTEXT
+    GET_CONTEXT(GetFrontFace, renderState)
 
-    logLine("%s: %s: renderState %p",
+    traceLine("%s: %s: renderState %p",
         context->name, __func__,
         renderState);
 
     NOVA_CALL_RESULT(face, GetFrontFace, renderState)
 
-    logLine("%s: %s: <- Front face %u (%s)",
+    traceLine("%s: %s: <- Front face %u (%s)",
         context->name, __func__,
         face, decodeFace(face));
 
@@ -2460,15 +2097,15 @@ static float W3DN_GetLineWidth(struct W3DN_Context_s *self, W3DN_RenderState *re
 {
     float width = 0.0f;
 
-    GET_CONTEXT
+    GET_CONTEXT(GetLineWidth, renderState)
 
-    logLine("%s: %s: renderState %p",
+    traceLine("%s: %s: renderState %p",
         context->name, __func__,
         renderState);
 
     NOVA_CALL_RESULT(width, GetLineWidth, renderState);
 
-    logLine("%s: %s: <- Line width %f",
+    traceLine("%s: %s: <- Line width %f",
         context->name, __func__,
         width);
 
@@ -2480,15 +2117,15 @@ static W3DN_FrameBuffer* W3DN_GetRenderTarget(
 {
     W3DN_FrameBuffer* buffer = NULL;
 
-    GET_CONTEXT
+    GET_CONTEXT(GetRenderTarget, renderState)
 
-    logLine("%s: %s: renderState %p",
+    traceLine("%s: %s: renderState %p",
         context->name, __func__,
         renderState);
 
     NOVA_CALL_RESULT(buffer, GetRenderTarget, renderState)
 
-    logLine("%s: %s: <- Frame buffer address %p",
+    traceLine("%s: %s: <- Frame buffer address %p",
         context->name, __func__,
         buffer);
 
@@ -2502,16 +2139,16 @@ static W3DN_PolygonMode W3DN_GetPolygonMode(struct W3DN_Context_s *self, W3DN_Re
 {
     W3DN_PolygonMode mode = 0;
 
-    GET_CONTEXT
+    GET_CONTEXT(GetPolygonMode, renderState, face)
 
-    logLine("%s: %s: renderState %p, face %u (%s)",
+    traceLine("%s: %s: renderState %p, face %u (%s)",
         context->name, __func__,
         renderState,
         face, decodeFaceSelect(face));
 
     NOVA_CALL_RESULT(mode, GetPolygonMode, renderState, face)
 
-    logLine("%s: %s: <- Polygon mode %u (%s)",
+    traceLine("%s: %s: <- Polygon mode %u (%s)",
         context->name, __func__,
         mode, decodePolygonMode(mode));
 
@@ -2523,15 +2160,15 @@ static W3DN_ErrorCode W3DN_GetPolygonOffset(struct W3DN_Context_s *self, W3DN_Re
 {
     W3DN_ErrorCode result = W3DNEC_SUCCESS;
 
-    GET_CONTEXT
+    GET_CONTEXT(GetPolygonOffset, renderState, factor, units, clamp)
 
-    logLine("%s: %s: renderState %p, factor %p, units %p, clamp %p",
+    traceLine("%s: %s: renderState %p, factor %p, units %p, clamp %p",
         context->name, __func__,
         renderState, factor, units, clamp);
 
     NOVA_CALL_RESULT(result, GetPolygonOffset, renderState, factor, units, clamp);
 
-    logLine("%s: %s: <- factor %f, units %f, clamp %f. Result %d (%s)",
+    traceLine("%s: %s: <- factor %f, units %f, clamp %f. Result %d (%s)",
         context->name, __func__,
         *factor,
         *units,
@@ -2547,15 +2184,15 @@ static W3DN_ProvokingVertexMode W3DN_GetProvokingVertex(struct W3DN_Context_s *s
 {
     W3DN_ProvokingVertexMode mode = 0;
 
-    GET_CONTEXT
+    GET_CONTEXT(GetProvokingVertex, renderState)
 
-    logLine("%s: %s: renderState %p",
+    traceLine("%s: %s: renderState %p",
         context->name, __func__,
         renderState);
 
     NOVA_CALL_RESULT(mode, GetProvokingVertex, renderState)
 
-    logLine("%s: %s: <- Vertex mode %u (%s)",
+    traceLine("%s: %s: <- Vertex mode %u (%s)",
         context->name, __func__,
         mode, decodeProvokingVertexMode(mode));
 
@@ -2567,15 +2204,15 @@ static W3DN_ErrorCode W3DN_GetScissor(struct W3DN_Context_s *self, W3DN_RenderSt
 {
     W3DN_ErrorCode result = W3DNEC_SUCCESS;
 
-    GET_CONTEXT
+    GET_CONTEXT(GetScissor, renderState, x, y, width, height)
 
-    logLine("%s: %s: renderState %p, x %p, y %p, width %p, height %p",
+    traceLine("%s: %s: renderState %p, x %p, y %p, width %p, height %p",
         context->name, __func__,
         renderState, x, y, width, height);
 
     NOVA_CALL_RESULT(result, GetScissor, renderState, x, y, width, height);
 
-    logLine("%s: %s: <- x %lu, y %lu, width %lu, height %lu. Result %d (%s)",
+    traceLine("%s: %s: <- x %lu, y %lu, width %lu, height %lu. Result %d (%s)",
         context->name, __func__,
         *x,
         *y,
@@ -2593,9 +2230,9 @@ static W3DN_ErrorCode W3DN_GetShaderDataBuffer(struct W3DN_Context_s *self, W3DN
 {
     W3DN_ErrorCode result = W3DNEC_SUCCESS;
 
-    GET_CONTEXT
+    GET_CONTEXT(GetShaderDataBuffer, renderState, shaderType, buffer, bufferIdx)
 
-    logLine("%s: %s: renderState %p, shaderType %u (%s), buffer %p, bufferIdx %p",
+    traceLine("%s: %s: renderState %p, shaderType %u (%s), buffer %p, bufferIdx %p",
         context->name, __func__,
         renderState,
         shaderType, decodeShaderType(shaderType),
@@ -2604,7 +2241,7 @@ static W3DN_ErrorCode W3DN_GetShaderDataBuffer(struct W3DN_Context_s *self, W3DN
 
     NOVA_CALL_RESULT(result, GetShaderDataBuffer, renderState, shaderType, buffer, bufferIdx)
 
-    logLine("%s: %s: <- buffer %p, bufferIdx %lu. Result %d (%s)",
+    traceLine("%s: %s: <- buffer %p, bufferIdx %lu. Result %d (%s)",
         context->name, __func__,
         *buffer,
         *bufferIdx,
@@ -2619,15 +2256,15 @@ static W3DN_ShaderPipeline* W3DN_GetShaderPipeline(struct W3DN_Context_s *self,
 {
     W3DN_ShaderPipeline* pipeline = NULL;
 
-    GET_CONTEXT
+    GET_CONTEXT(GetShaderPipeline, renderState)
 
-    logLine("%s: %s: renderState %p",
+    traceLine("%s: %s: renderState %p",
         context->name, __func__,
         renderState);
 
     NOVA_CALL_RESULT(pipeline, GetShaderPipeline, renderState)
 
-    logLine("%s: %s: <- Shader pipeline address %p",
+    traceLine("%s: %s: <- Shader pipeline address %p",
         context->name, __func__,
         pipeline);
 
@@ -2640,16 +2277,16 @@ static W3DN_State W3DN_GetState(struct W3DN_Context_s *self, W3DN_RenderState *r
 {
     W3DN_State state = 0;
 
-    GET_CONTEXT
+    GET_CONTEXT(GetState, renderState, stateFlag)
 
-    logLine("%s: %s: renderState %p, stateFlag %u (%s)",
+    traceLine("%s: %s: renderState %p, stateFlag %u (%s)",
         context->name, __func__,
         renderState,
         stateFlag, decodeStateFlag(stateFlag));
 
     NOVA_CALL_RESULT(state, GetState, renderState, stateFlag)
 
-    logLine("%s: %s: <- State %u (%s)",
+    traceLine("%s: %s: <- State %u (%s)",
         context->name, __func__,
         state, decodeState(state));
 
@@ -2661,9 +2298,9 @@ static W3DN_ErrorCode W3DN_GetStencilFunc(struct W3DN_Context_s *self, W3DN_Rend
 {
     W3DN_ErrorCode result = W3DNEC_SUCCESS;
 
-    GET_CONTEXT
+    GET_CONTEXT(GetStencilFunc, renderState, face, func, ref, mask)
 
-    logLine("%s: %s: renderState %p, face %u (%s), func %p, ref %p, mask %p",
+    traceLine("%s: %s: renderState %p, face %u (%s), func %p, ref %p, mask %p",
         context->name, __func__,
         renderState,
         face, decodeFaceSelect(face),
@@ -2671,7 +2308,7 @@ static W3DN_ErrorCode W3DN_GetStencilFunc(struct W3DN_Context_s *self, W3DN_Rend
 
     NOVA_CALL_RESULT(result, GetStencilFunc, renderState, face, func, ref, mask);
 
-    logLine("%s: %s: <- func %u (%s), ref %lu, mask 0x%lx. Result %d (%s)",
+    traceLine("%s: %s: <- func %u (%s), ref %lu, mask 0x%lx. Result %d (%s)",
         context->name, __func__,
         func ? *func : 0,
         func ? decodeCompareFunc(*func) : "",
@@ -2689,9 +2326,9 @@ static W3DN_ErrorCode W3DN_GetStencilOp(struct W3DN_Context_s *self, W3DN_Render
 {
     W3DN_ErrorCode result = W3DNEC_SUCCESS;
 
-    GET_CONTEXT
+    GET_CONTEXT(GetStencilOp, renderState, face, sFail, dpFail, dpPass)
 
-    logLine("%s: %s: renderState %p, face %u (%s), sFail %p, dpFail %p, dpPass %p",
+    traceLine("%s: %s: renderState %p, face %u (%s), sFail %p, dpFail %p, dpPass %p",
         context->name, __func__,
         renderState,
         face, decodeFaceSelect(face),
@@ -2699,7 +2336,7 @@ static W3DN_ErrorCode W3DN_GetStencilOp(struct W3DN_Context_s *self, W3DN_Render
 
     NOVA_CALL_RESULT(result, GetStencilOp, renderState, face, sFail, dpFail, dpPass);
 
-    logLine("%s: %s: <- sFail %u (%s), dpFail %u (%s), dpPass %u (%s). Result %d (%s)",
+    traceLine("%s: %s: <- sFail %u (%s), dpFail %u (%s), dpPass %u (%s). Result %d (%s)",
         context->name, __func__,
         *sFail, decodeStencilOp(*sFail),
         *dpFail, decodeStencilOp(*dpFail),
@@ -2716,16 +2353,16 @@ static uint32 W3DN_GetStencilWriteMask(struct W3DN_Context_s *self, W3DN_RenderS
 {
     uint32 mask = 0;
 
-    GET_CONTEXT
+    GET_CONTEXT(GetStencilWriteMask, renderState, face, errCode)
 
-    logLine("%s: %s: renderState %p, face %u (%s), errCode %p",
+    traceLine("%s: %s: renderState %p, face %u (%s), errCode %p",
         context->name, __func__,
         renderState,
         face, decodeFaceSelect(face), errCode);
 
     NOVA_CALL_RESULT(mask, GetStencilWriteMask, renderState, face, errCode)
 
-    logLine("%s: %s: <- errCode %d (%s). Stencil write mask 0x%lx",
+    traceLine("%s: %s: <- errCode %d (%s). Stencil write mask 0x%lx",
         context->name, __func__,
         mapNovaErrorPointerToCode(errCode),
         mapNovaErrorPointerToString(errCode),
@@ -2740,16 +2377,16 @@ static W3DN_TextureSampler* W3DN_GetTexSampler(struct W3DN_Context_s *self, W3DN
 {
     W3DN_TextureSampler* sampler = NULL;
 
-    GET_CONTEXT
+    GET_CONTEXT(GetTexSampler, renderState, texUnit)
 
-    logLine("%s: %s: renderState %p, texUnit %lu",
+    traceLine("%s: %s: renderState %p, texUnit %lu",
         context->name, __func__,
         renderState,
         texUnit);
 
     NOVA_CALL_RESULT(sampler, GetTexSampler, renderState, texUnit)
 
-    logLine("%s: %s: <- Texture sampler address %p",
+    traceLine("%s: %s: <- Texture sampler address %p",
         context->name, __func__,
         sampler);
 
@@ -2762,15 +2399,15 @@ static W3DN_Texture* W3DN_GetTexture(struct W3DN_Context_s *self, W3DN_RenderSta
 {
     W3DN_Texture* texture = NULL;
 
-    GET_CONTEXT
+    GET_CONTEXT(GetTexture, renderState, texUnit)
 
-    logLine("%s: %s: renderState %p, texUnit %lu",
+    traceLine("%s: %s: renderState %p, texUnit %lu",
         context->name, __func__,
         renderState, texUnit);
 
     NOVA_CALL_RESULT(texture, GetTexture, renderState, texUnit)
 
-    logLine("%s: %s: <- Texture address %p",
+    traceLine("%s: %s: <- Texture address %p",
         context->name, __func__,
         texture);
 
@@ -2784,15 +2421,15 @@ static W3DN_ErrorCode W3DN_GetVertexAttribArray(struct W3DN_Context_s *self, W3D
 {
     W3DN_ErrorCode result = W3DNEC_SUCCESS;
 
-    GET_CONTEXT
+    GET_CONTEXT(GetVertexAttribArray, renderState, attribNum, buffer, arrayIdx)
 
-    logLine("%s: %s: renderState %p, attribNum %lu, buffer %p, arrayIdx %p",
+    traceLine("%s: %s: renderState %p, attribNum %lu, buffer %p, arrayIdx %p",
         context->name, __func__,
         renderState, attribNum, buffer, arrayIdx);
 
     NOVA_CALL_RESULT(result, GetVertexAttribArray, renderState, attribNum, buffer, arrayIdx);
 
-    logLine("%s: %s: <- buffer %p, arrayIdx %lu. Result %d (%s)",
+    traceLine("%s: %s: <- buffer %p, arrayIdx %lu. Result %d (%s)",
         context->name, __func__,
         *buffer,
         *arrayIdx,
@@ -2808,15 +2445,15 @@ static W3DN_ErrorCode W3DN_GetViewport(struct W3DN_Context_s *self, W3DN_RenderS
 {
     W3DN_ErrorCode result = W3DNEC_SUCCESS;
 
-    GET_CONTEXT
+    GET_CONTEXT(GetViewport, renderState, x, y, width, height, zNear, zFar)
 
-    logLine("%s: %s: renderState %p, x %p, y %p, width %p, height %p, zNear %p, zFar %p",
+    traceLine("%s: %s: renderState %p, x %p, y %p, width %p, height %p, zNear %p, zFar %p",
         context->name, __func__,
         renderState, x, y, width, height, zNear, zFar);
 
     NOVA_CALL_RESULT(result, GetViewport, renderState, x, y, width, height, zNear, zFar);
 
-    logLine("%s: %s: <- x %f, y %f, width %f, height %f, zNear %f, zFar %f. Result %d (%s)",
+    traceLine("%s: %s: <- x %f, y %f, width %f, height %f, zNear %f, zFar %f. Result %d (%s)",
         context->name, __func__,
         *x,
         *y,
@@ -2836,15 +2473,15 @@ static BOOL W3DN_IsDone(struct W3DN_Context_s *self, uint32 submitID)
 {
     BOOL result = TRUE;
 
-    GET_CONTEXT
+    GET_CONTEXT(IsDone, submitID)
 
-    logLine("%s: %s: submitID %lu",
+    traceLine("%s: %s: submitID %lu",
         context->name, __func__,
         submitID);
 
     NOVA_CALL_RESULT(result, IsDone, submitID)
 
-    logLine("%s: %s: <- Result %d",
+    traceLine("%s: %s: <- Result %d",
         context->name, __func__,
         result);
 
@@ -2855,15 +2492,15 @@ static uint32 W3DN_Query(struct W3DN_Context_s *self, W3DN_CapQuery query)
 {
     uint32 result = 0;
 
-    GET_CONTEXT
+    GET_CONTEXT(Query, query)
 
-    logLine("%s: %s: query %u (%s)",
+    traceLine("%s: %s: query %u (%s)",
         context->name, __func__,
         query, decodeCapQuery(query));
 
     NOVA_CALL_RESULT(result, Query, query)
 
-    logLine("%s: %s: <- Result %lu",
+    traceLine("%s: %s: <- Result %lu",
         context->name, __func__,
         result);
 
@@ -2874,15 +2511,15 @@ static W3DN_ErrorCode W3DN_RSOCopy(struct W3DN_Context_s *self, W3DN_RenderState
 {
     W3DN_ErrorCode result = W3DNEC_SUCCESS;
 
-    GET_CONTEXT
+    GET_CONTEXT(RSOCopy, dest, src)
 
-    logLine("%s: %s: dest %p, src %p",
+    traceLine("%s: %s: dest %p, src %p",
         context->name, __func__,
         dest, src);
 
     NOVA_CALL_RESULT(result, RSOCopy, dest, src)
 
-    logLine("%s: %s: <- Result %d (%s)",
+    traceLine("%s: %s: <- Result %d (%s)",
         context->name, __func__,
         result, mapNovaError(result));
 
@@ -2895,15 +2532,15 @@ static W3DN_ErrorCode W3DN_RSOSetMaster(struct W3DN_Context_s *self, W3DN_Render
 {
     W3DN_ErrorCode result = W3DNEC_SUCCESS;
 
-    GET_CONTEXT
+    GET_CONTEXT(RSOSetMaster, renderState, master)
 
-    logLine("%s: %s: renderState %p, master %p",
+    traceLine("%s: %s: renderState %p, master %p",
         context->name, __func__,
         renderState, master);
 
     NOVA_CALL_RESULT(result, RSOSetMaster, renderState, master)
 
-    logLine("%s: %s: <- Result %d (%s)",
+    traceLine("%s: %s: <- Result %d (%s)",
         context->name, __func__,
         result, mapNovaError(result));
 
@@ -2916,15 +2553,15 @@ static W3DN_ErrorCode W3DN_SetBlendColour(struct W3DN_Context_s *self, W3DN_Rend
 {
     W3DN_ErrorCode result = W3DNEC_SUCCESS;
 
-    GET_CONTEXT
+    GET_CONTEXT(SetBlendColour, renderState, red, green, blue, alpha)
 
-    logLine("%s: %s: renderState %p, red %f, green %f, blue %f, alpha %f",
+    traceLine("%s: %s: renderState %p, red %f, green %f, blue %f, alpha %f",
         context->name, __func__,
         renderState, red, green, blue, alpha);
 
     NOVA_CALL_RESULT(result, SetBlendColour, renderState, red, green, blue, alpha)
 
-    logLine("%s: %s: <- Result %d (%s)",
+    traceLine("%s: %s: <- Result %d (%s)",
         context->name, __func__,
         result, mapNovaError(result));
 
@@ -2937,16 +2574,16 @@ static W3DN_ErrorCode W3DN_SetBlendEquation(struct W3DN_Context_s *self, W3DN_Re
 {
     W3DN_ErrorCode result = W3DNEC_SUCCESS;
 
-    GET_CONTEXT
+    GET_CONTEXT(SetBlendEquation, renderState, buffIdx, equation)
 
-    logLine("%s: %s: renderState %p, buffIdx %lu, equation %u (%s)",
+    traceLine("%s: %s: renderState %p, buffIdx %lu, equation %u (%s)",
         context->name, __func__,
         renderState, buffIdx,
         equation, decodeBlendEquation(equation));
 
     NOVA_CALL_RESULT(result, SetBlendEquation, renderState, buffIdx, equation)
 
-    logLine("%s: %s: <- Result %d (%s)",
+    traceLine("%s: %s: <- Result %d (%s)",
         context->name, __func__,
         result, mapNovaError(result));
 
@@ -2960,9 +2597,9 @@ static W3DN_ErrorCode W3DN_SetBlendEquationSeparate(struct W3DN_Context_s *self,
 {
     W3DN_ErrorCode result = W3DNEC_SUCCESS;
 
-    GET_CONTEXT
+    GET_CONTEXT(SetBlendEquationSeparate, renderState, buffIdx, colEquation, alphaEquation)
 
-    logLine("%s: %s: renderState %p, buffIdx %lu, colEquation %u (%s), alphaEquation %u (%s)",
+    traceLine("%s: %s: renderState %p, buffIdx %lu, colEquation %u (%s), alphaEquation %u (%s)",
         context->name, __func__,
         renderState, buffIdx,
         colEquation, decodeBlendEquation(colEquation),
@@ -2970,7 +2607,7 @@ static W3DN_ErrorCode W3DN_SetBlendEquationSeparate(struct W3DN_Context_s *self,
 
     NOVA_CALL_RESULT(result, SetBlendEquationSeparate, renderState, buffIdx, colEquation, alphaEquation)
 
-    logLine("%s: %s: <- Result %d (%s)",
+    traceLine("%s: %s: <- Result %d (%s)",
         context->name, __func__,
         result, mapNovaError(result));
 
@@ -2983,9 +2620,9 @@ static W3DN_ErrorCode W3DN_SetBlendMode(struct W3DN_Context_s *self, W3DN_Render
 {
     W3DN_ErrorCode result = W3DNEC_SUCCESS;
 
-    GET_CONTEXT
+    GET_CONTEXT(SetBlendMode, renderState, buffIdx, src, dst)
 
-    logLine("%s: %s: renderState %p, buffIdx %lu, src %u (%s), dst %u (%s)",
+    traceLine("%s: %s: renderState %p, buffIdx %lu, src %u (%s), dst %u (%s)",
         context->name, __func__,
         renderState, buffIdx,
         src, decodeBlendMode(src),
@@ -2993,7 +2630,7 @@ static W3DN_ErrorCode W3DN_SetBlendMode(struct W3DN_Context_s *self, W3DN_Render
 
     NOVA_CALL_RESULT(result, SetBlendMode, renderState, buffIdx, src, dst)
 
-    logLine("%s: %s: <- Result %d (%s)",
+    traceLine("%s: %s: <- Result %d (%s)",
         context->name, __func__,
         result, mapNovaError(result));
 
@@ -3007,9 +2644,9 @@ static W3DN_ErrorCode W3DN_SetBlendModeSeparate(struct W3DN_Context_s *self, W3D
 {
     W3DN_ErrorCode result = W3DNEC_SUCCESS;
 
-    GET_CONTEXT
+    GET_CONTEXT(SetBlendModeSeparate, renderState, buffIdx, colSrc, colDst, alphaSrc, alphaDst)
 
-    logLine("%s: %s: renderState %p, buffIdx %lu, colSrc %u (%s), colDst %u (%s), alphaSrc %u (%s), alphaDst %u (%s)",
+    traceLine("%s: %s: renderState %p, buffIdx %lu, colSrc %u (%s), colDst %u (%s), alphaSrc %u (%s), alphaDst %u (%s)",
         context->name, __func__,
         renderState, buffIdx,
         colSrc, decodeBlendMode(colSrc),
@@ -3019,7 +2656,7 @@ static W3DN_ErrorCode W3DN_SetBlendModeSeparate(struct W3DN_Context_s *self, W3D
 
     NOVA_CALL_RESULT(result, SetBlendModeSeparate, renderState, buffIdx, colSrc, colDst, alphaSrc, alphaDst)
 
-    logLine("%s: %s: <- Result %d (%s)",
+    traceLine("%s: %s: <- Result %d (%s)",
         context->name, __func__,
         result, mapNovaError(result));
 
@@ -3032,15 +2669,15 @@ static W3DN_ErrorCode W3DN_SetColourMask(struct W3DN_Context_s *self, W3DN_Rende
 {
     W3DN_ErrorCode result = W3DNEC_SUCCESS;
 
-    GET_CONTEXT
+    GET_CONTEXT(SetColourMask, renderState, index, mask)
 
-    logLine("%s: %s: renderState %p, index %lu, mask 0x%x",
+    traceLine("%s: %s: renderState %p, index %lu, mask 0x%x",
         context->name, __func__,
         renderState, index, mask);
 
     NOVA_CALL_RESULT(result, SetColourMask, renderState, index, mask)
 
-    logLine("%s: %s: <- Result %d (%s)",
+    traceLine("%s: %s: <- Result %d (%s)",
         context->name, __func__,
         result, mapNovaError(result));
 
@@ -3053,16 +2690,16 @@ static W3DN_ErrorCode W3DN_SetDepthCompareFunc(struct W3DN_Context_s *self, W3DN
 {
     W3DN_ErrorCode result = W3DNEC_SUCCESS;
 
-    GET_CONTEXT
+    GET_CONTEXT(SetDepthCompareFunc, renderState, func)
 
-    logLine("%s: %s: renderState %p, func %u (%s)",
+    traceLine("%s: %s: renderState %p, func %u (%s)",
         context->name, __func__,
         renderState,
         func, decodeCompareFunc(func));
 
     NOVA_CALL_RESULT(result, SetDepthCompareFunc, renderState, func)
 
-    logLine("%s: %s: <- Result %d (%s)",
+    traceLine("%s: %s: <- Result %d (%s)",
         context->name, __func__,
         result, mapNovaError(result));
 
@@ -3075,16 +2712,16 @@ static W3DN_ErrorCode W3DN_SetFrontFace(struct W3DN_Context_s *self, W3DN_Render
 {
     W3DN_ErrorCode result = W3DNEC_SUCCESS;
 
-    GET_CONTEXT
+    GET_CONTEXT(SetFrontFace, renderState, face)
 
-    logLine("%s: %s: renderState %p, face %u (%s)",
+    traceLine("%s: %s: renderState %p, face %u (%s)",
         context->name, __func__,
         renderState,
         face, decodeFace(face));
 
     NOVA_CALL_RESULT(result, SetFrontFace, renderState, face)
 
-    logLine("%s: %s: <- Result %d (%s)",
+    traceLine("%s: %s: <- Result %d (%s)",
         context->name, __func__,
         result, mapNovaError(result));
 
@@ -3097,15 +2734,15 @@ static W3DN_ErrorCode W3DN_SetLineWidth(struct W3DN_Context_s *self, W3DN_Render
 {
     W3DN_ErrorCode result = W3DNEC_SUCCESS;
 
-    GET_CONTEXT
+    GET_CONTEXT(SetLineWidth, renderState, width)
 
-    logLine("%s: %s: renderState %p, width %f",
+    traceLine("%s: %s: renderState %p, width %f",
         context->name, __func__,
         renderState, width);
 
     NOVA_CALL_RESULT(result, SetLineWidth, renderState, width)
 
-    logLine("%s: %s: <- Result %d (%s)",
+    traceLine("%s: %s: <- Result %d (%s)",
         context->name, __func__,
         result, mapNovaError(result));
 
@@ -3118,9 +2755,9 @@ static W3DN_ErrorCode W3DN_SetPolygonMode(struct W3DN_Context_s *self, W3DN_Rend
 {
     W3DN_ErrorCode result = W3DNEC_SUCCESS;
 
-    GET_CONTEXT
+    GET_CONTEXT(SetPolygonMode, renderState, face, mode)
 
-    logLine("%s: %s: renderState %p, face %u (%s), mode %u (%s)",
+    traceLine("%s: %s: renderState %p, face %u (%s), mode %u (%s)",
         context->name, __func__,
         renderState,
         face, decodeFaceSelect(face),
@@ -3128,7 +2765,7 @@ static W3DN_ErrorCode W3DN_SetPolygonMode(struct W3DN_Context_s *self, W3DN_Rend
 
     NOVA_CALL_RESULT(result, SetPolygonMode, renderState, face, mode)
 
-    logLine("%s: %s: <- Result %d (%s)",
+    traceLine("%s: %s: <- Result %d (%s)",
         context->name, __func__,
         result, mapNovaError(result));
 
@@ -3141,15 +2778,15 @@ static W3DN_ErrorCode W3DN_SetPolygonOffset(struct W3DN_Context_s *self, W3DN_Re
 {
     W3DN_ErrorCode result = W3DNEC_SUCCESS;
 
-    GET_CONTEXT
+    GET_CONTEXT(SetPolygonOffset, renderState, factor, units, clamp)
 
-    logLine("%s: %s: renderState %p, factor %f, units %f, clamp %f",
+    traceLine("%s: %s: renderState %p, factor %f, units %f, clamp %f",
         context->name, __func__,
         renderState, factor, units, clamp);
 
     NOVA_CALL_RESULT(result, SetPolygonOffset, renderState, factor, units, clamp)
 
-    logLine("%s: %s: <- Result %d (%s)",
+    traceLine("%s: %s: <- Result %d (%s)",
         context->name, __func__,
         result, mapNovaError(result));
 
@@ -3162,16 +2799,16 @@ static W3DN_ErrorCode W3DN_SetProvokingVertex(struct W3DN_Context_s *self, W3DN_
 {
     W3DN_ErrorCode result = W3DNEC_SUCCESS;
 
-    GET_CONTEXT
+    GET_CONTEXT(SetProvokingVertex, renderState, mode)
 
-    logLine("%s: %s: renderState %p, mode %u (%s)",
+    traceLine("%s: %s: renderState %p, mode %u (%s)",
         context->name, __func__,
         renderState,
         mode, decodeProvokingVertexMode(mode));
 
     NOVA_CALL_RESULT(result, SetProvokingVertex, renderState, mode)
 
-    logLine("%s: %s: <- Result %d (%s)",
+    traceLine("%s: %s: <- Result %d (%s)",
         context->name, __func__,
         result, mapNovaError(result));
 
@@ -3185,15 +2822,15 @@ static W3DN_ErrorCode W3DN_SetRenderTarget(struct W3DN_Context_s *self,
 {
     W3DN_ErrorCode result = W3DNEC_SUCCESS;
 
-    GET_CONTEXT
+    GET_CONTEXT(SetRenderTarget, renderState, frameBuffer)
 
-    logLine("%s: %s: renderState %p, frameBuffer %p",
+    traceLine("%s: %s: renderState %p, frameBuffer %p",
         context->name, __func__,
         renderState, frameBuffer);
 
     NOVA_CALL_RESULT(result, SetRenderTarget, renderState, frameBuffer)
 
-    logLine("%s: %s: <- Result %d (%s)",
+    traceLine("%s: %s: <- Result %d (%s)",
         context->name, __func__,
         result, mapNovaError(result));
 
@@ -3207,15 +2844,15 @@ static W3DN_ErrorCode W3DN_SetScissor(struct W3DN_Context_s *self, W3DN_RenderSt
 {
     W3DN_ErrorCode result = W3DNEC_SUCCESS;
 
-    GET_CONTEXT
+    GET_CONTEXT(SetScissor, renderState, x, y, width, height)
 
-    logLine("%s: %s: renderState %p, x %lu, y %lu, width %lu, height %lu",
+    traceLine("%s: %s: renderState %p, x %lu, y %lu, width %lu, height %lu",
         context->name, __func__,
         renderState, x, y, width, height);
 
     NOVA_CALL_RESULT(result, SetScissor, renderState, x, y, width, height)
 
-    logLine("%s: %s: <- Result %d (%s)",
+    traceLine("%s: %s: <- Result %d (%s)",
         context->name, __func__,
         result, mapNovaError(result));
 
@@ -3229,15 +2866,15 @@ static W3DN_ErrorCode W3DN_SetShaderPipeline(struct W3DN_Context_s *self, W3DN_R
 {
     W3DN_ErrorCode result = W3DNEC_SUCCESS;
 
-    GET_CONTEXT
+    GET_CONTEXT(SetShaderPipeline, renderState, shaderPipeline)
 
-    logLine("%s: %s: renderState %p, shaderPipeline %p",
+    traceLine("%s: %s: renderState %p, shaderPipeline %p",
         context->name, __func__,
         renderState, shaderPipeline);
 
     NOVA_CALL_RESULT(result, SetShaderPipeline, renderState, shaderPipeline)
 
-    logLine("%s: %s: <- Result %d (%s)",
+    traceLine("%s: %s: <- Result %d (%s)",
         context->name, __func__,
         result, mapNovaError(result));
 
@@ -3251,9 +2888,9 @@ static W3DN_ErrorCode W3DN_SetState(struct W3DN_Context_s *self, W3DN_RenderStat
 {
     W3DN_ErrorCode result = W3DNEC_SUCCESS;
 
-    GET_CONTEXT
+    GET_CONTEXT(SetState, renderState, stateFlag, value)
 
-    logLine("%s: %s: renderState %p, stateFlag %u (%s), value %u (%s)",
+    traceLine("%s: %s: renderState %p, stateFlag %u (%s), value %u (%s)",
         context->name, __func__,
         renderState,
         stateFlag, decodeStateFlag(stateFlag),
@@ -3261,7 +2898,7 @@ static W3DN_ErrorCode W3DN_SetState(struct W3DN_Context_s *self, W3DN_RenderStat
 
     NOVA_CALL_RESULT(result, SetState, renderState, stateFlag, value)
 
-    logLine("%s: %s: <- Result %d (%s)",
+    traceLine("%s: %s: <- Result %d (%s)",
         context->name, __func__,
         result, mapNovaError(result));
 
@@ -3275,9 +2912,9 @@ static W3DN_ErrorCode W3DN_SetStencilFunc(struct W3DN_Context_s *self, W3DN_Rend
 {
     W3DN_ErrorCode result = W3DNEC_SUCCESS;
 
-    GET_CONTEXT
+    GET_CONTEXT(SetStencilFunc, renderState, func, ref, mask)
 
-    logLine("%s: %s: renderState %p, func %u (%s), ref %lu, mask 0x%lx",
+    traceLine("%s: %s: renderState %p, func %u (%s), ref %lu, mask 0x%lx",
         context->name, __func__,
         renderState,
         func, decodeCompareFunc(func),
@@ -3285,7 +2922,7 @@ static W3DN_ErrorCode W3DN_SetStencilFunc(struct W3DN_Context_s *self, W3DN_Rend
 
     NOVA_CALL_RESULT(result, SetStencilFunc, renderState, func, ref, mask)
 
-    logLine("%s: %s: <- Result %d (%s)",
+    traceLine("%s: %s: <- Result %d (%s)",
         context->name, __func__,
         result, mapNovaError(result));
 
@@ -3299,9 +2936,9 @@ static W3DN_ErrorCode W3DN_SetStencilFuncSeparate(struct W3DN_Context_s *self, W
 {
     W3DN_ErrorCode result = W3DNEC_SUCCESS;
 
-    GET_CONTEXT
+    GET_CONTEXT(SetStencilFuncSeparate, renderState, face, func, ref, mask)
 
-    logLine("%s: %s: renderState %p, face %u (%s), func %u (%s), ref %lu, mask 0x%lx",
+    traceLine("%s: %s: renderState %p, face %u (%s), func %u (%s), ref %lu, mask 0x%lx",
         context->name, __func__,
         renderState,
         face, decodeFaceSelect(face),
@@ -3310,7 +2947,7 @@ static W3DN_ErrorCode W3DN_SetStencilFuncSeparate(struct W3DN_Context_s *self, W
 
     NOVA_CALL_RESULT(result, SetStencilFuncSeparate, renderState, face, func, ref, mask)
 
-    logLine("%s: %s: <- Result %d (%s)",
+    traceLine("%s: %s: <- Result %d (%s)",
         context->name, __func__,
         result, mapNovaError(result));
 
@@ -3324,9 +2961,9 @@ static W3DN_ErrorCode W3DN_SetStencilOp(struct W3DN_Context_s *self, W3DN_Render
 {
     W3DN_ErrorCode result = W3DNEC_SUCCESS;
 
-    GET_CONTEXT
+    GET_CONTEXT(SetStencilOp, renderState, sFail, dpFail, dpPass)
 
-    logLine("%s: %s: renderState %p, sFail %u (%s), dpFail %u (%s), dpPass %u (%s)",
+    traceLine("%s: %s: renderState %p, sFail %u (%s), dpFail %u (%s), dpPass %u (%s)",
         context->name, __func__,
         renderState,
         sFail, decodeStencilOp(sFail),
@@ -3335,7 +2972,7 @@ static W3DN_ErrorCode W3DN_SetStencilOp(struct W3DN_Context_s *self, W3DN_Render
 
     NOVA_CALL_RESULT(result, SetStencilOp, renderState, sFail, dpFail, dpPass)
 
-    logLine("%s: %s: <- Result %d (%s)",
+    traceLine("%s: %s: <- Result %d (%s)",
         context->name, __func__,
         result, mapNovaError(result));
 
@@ -3349,9 +2986,9 @@ static W3DN_ErrorCode W3DN_SetStencilOpSeparate(struct W3DN_Context_s *self, W3D
 {
     W3DN_ErrorCode result = W3DNEC_SUCCESS;
 
-    GET_CONTEXT
+    GET_CONTEXT(SetStencilOpSeparate, renderState, face, sFail, dpFail, dpPass)
 
-    logLine("%s: %s: renderState %p, face %u (%s), sFail %u (%s), dpFail %u (%s), dpPass %u (%s)",
+    traceLine("%s: %s: renderState %p, face %u (%s), sFail %u (%s), dpFail %u (%s), dpPass %u (%s)",
         context->name, __func__,
         renderState,
         face, decodeFaceSelect(face),
@@ -3361,7 +2998,7 @@ static W3DN_ErrorCode W3DN_SetStencilOpSeparate(struct W3DN_Context_s *self, W3D
 
     NOVA_CALL_RESULT(result, SetStencilOpSeparate, renderState, face, sFail, dpFail, dpPass)
 
-    logLine("%s: %s: <- Result %d (%s)",
+    traceLine("%s: %s: <- Result %d (%s)",
         context->name, __func__,
         result, mapNovaError(result));
 
@@ -3374,15 +3011,15 @@ static W3DN_ErrorCode W3DN_SetStencilWriteMask(struct W3DN_Context_s *self, W3DN
 {
     W3DN_ErrorCode result = W3DNEC_SUCCESS;
 
-    GET_CONTEXT
+    GET_CONTEXT(SetStencilWriteMask, renderState, mask)
 
-    logLine("%s: %s: renderState %p, mask 0x%lx",
+    traceLine("%s: %s: renderState %p, mask 0x%lx",
         context->name, __func__,
         renderState, mask);
 
     NOVA_CALL_RESULT(result, SetStencilWriteMask, renderState, mask)
 
-    logLine("%s: %s: <- Result %d (%s)",
+    traceLine("%s: %s: <- Result %d (%s)",
         context->name, __func__,
         result, mapNovaError(result));
 
@@ -3396,9 +3033,9 @@ static W3DN_ErrorCode W3DN_SetStencilWriteMaskSeparate(struct W3DN_Context_s *se
 {
     W3DN_ErrorCode result = W3DNEC_SUCCESS;
 
-    GET_CONTEXT
+    GET_CONTEXT(SetStencilWriteMaskSeparate, renderState, face, mask)
 
-    logLine("%s: %s: renderState %p, face %u (%s), mask 0x%lx",
+    traceLine("%s: %s: renderState %p, face %u (%s), mask 0x%lx",
         context->name, __func__,
         renderState,
         face, decodeFaceSelect(face),
@@ -3406,7 +3043,7 @@ static W3DN_ErrorCode W3DN_SetStencilWriteMaskSeparate(struct W3DN_Context_s *se
 
     NOVA_CALL_RESULT(result, SetStencilWriteMaskSeparate, renderState, face, mask)
 
-    logLine("%s: %s: <- Result %d (%s)",
+    traceLine("%s: %s: <- Result %d (%s)",
         context->name, __func__,
         result, mapNovaError(result));
 
@@ -3420,15 +3057,15 @@ static W3DN_ErrorCode W3DN_SetViewport(struct W3DN_Context_s *self, W3DN_RenderS
 {
     W3DN_ErrorCode result = W3DNEC_SUCCESS;
 
-    GET_CONTEXT
+    GET_CONTEXT(SetViewport, renderState, x, y, width, height, zNear, zFar)
 
-    logLine("%s: %s: renderState %p, x %f, y %f, width %f, height %f, zNear %f, zFar %f",
+    traceLine("%s: %s: renderState %p, x %f, y %f, width %f, height %f, zNear %f, zFar %f",
         context->name, __func__,
         renderState, x, y, width, height, zNear, zFar);
 
     NOVA_CALL_RESULT(result, SetViewport, renderState, x, y, width, height, zNear, zFar);
 
-    logLine("%s: %s: <- Result %d (%s)",
+    traceLine("%s: %s: <- Result %d (%s)",
         context->name, __func__,
         result, mapNovaError(result));
 
@@ -3442,16 +3079,16 @@ static uint32 W3DN_ShaderGetCount(struct W3DN_Context_s *self, W3DN_ErrorCode *e
 {
     uint32 count = 0;
 
-    GET_CONTEXT
+    GET_CONTEXT(ShaderGetCount, errCode, shader, objectType)
 
-    logLine("%s: %s: errCode %p, shader %p, objectType %u (%s)",
+    traceLine("%s: %s: errCode %p, shader %p, objectType %u (%s)",
         context->name, __func__,
         errCode, shader,
         objectType, decodeShaderObjectType(objectType));
 
     NOVA_CALL_RESULT(count, ShaderGetCount, errCode, shader, objectType)
 
-    logLine("%s: %s: <- errCode %d (%s). Shader count %lu",
+    traceLine("%s: %s: <- errCode %d (%s). Shader count %lu",
         context->name, __func__,
         mapNovaErrorPointerToCode(errCode),
         mapNovaErrorPointerToString(errCode),
@@ -3467,9 +3104,9 @@ static W3DN_ErrorCode W3DN_ShaderGetObjectInfo(struct W3DN_Context_s *self, W3DN
 {
     W3DN_ErrorCode result = W3DNEC_SUCCESS;
 
-    GET_CONTEXT
+    GET_CONTEXT(ShaderGetObjectInfo, shader, objectType, index, tags)
 
-    logLine("%s: %s: shader %p, objectType %u (%s), index %lu, tags %p",
+    traceLine("%s: %s: shader %p, objectType %u (%s), index %lu, tags %p",
         context->name, __func__,
         shader,
         objectType, decodeShaderObjectType(objectType),
@@ -3478,7 +3115,7 @@ static W3DN_ErrorCode W3DN_ShaderGetObjectInfo(struct W3DN_Context_s *self, W3DN
 
     NOVA_CALL_RESULT(result, ShaderGetObjectInfo, shader, objectType, index, tags)
 
-    logLine("%s: %s: <- tags (%s). Result %d (%s)",
+    traceLine("%s: %s: <- tags (%s). Result %d (%s)",
         context->name, __func__,
         decodeShaderGetObjectInfoTags(tags, context),
         result, mapNovaError(result));
@@ -3493,9 +3130,9 @@ static uint32 W3DN_ShaderGetOffset(struct W3DN_Context_s *self, W3DN_ErrorCode *
 {
     uint32 offset = 0;
 
-    GET_CONTEXT
+    GET_CONTEXT(ShaderGetOffset, errCode, shader, objectType, name)
 
-    logLine("%s: %s: errCode %p, shader %p, objectType %u (%s), name '%s'",
+    traceLine("%s: %s: errCode %p, shader %p, objectType %u (%s), name '%s'",
         context->name, __func__,
         errCode, shader,
         objectType, decodeShaderObjectType(objectType),
@@ -3503,7 +3140,7 @@ static uint32 W3DN_ShaderGetOffset(struct W3DN_Context_s *self, W3DN_ErrorCode *
 
     NOVA_CALL_RESULT(offset, ShaderGetOffset, errCode, shader, objectType, name)
 
-    logLine("%s: %s: <- errCode %d (%s). Offset %lu",
+    traceLine("%s: %s: <- errCode %d (%s). Offset %lu",
         context->name, __func__,
         mapNovaErrorPointerToCode(errCode),
         mapNovaErrorPointerToString(errCode),
@@ -3520,15 +3157,15 @@ static uint64 W3DN_ShaderGetTotalStorage(struct W3DN_Context_s *self, W3DN_Shade
 {
     uint64 size = 0;
 
-    GET_CONTEXT
+    GET_CONTEXT(ShaderGetTotalStorage, shader)
 
-    logLine("%s: %s: shader %p",
+    traceLine("%s: %s: shader %p",
         context->name, __func__,
         shader);
 
     NOVA_CALL_RESULT(size, ShaderGetTotalStorage, shader)
 
-    logLine("%s: %s: <- Size %llu",
+    traceLine("%s: %s: <- Size %llu",
         context->name, __func__,
         size);
 
@@ -3539,15 +3176,15 @@ static W3DN_ShaderType W3DN_ShaderGetType(struct W3DN_Context_s *self, W3DN_Shad
 {
     W3DN_ShaderType type = 0;
 
-    GET_CONTEXT
+    GET_CONTEXT(ShaderGetType, shader)
 
-    logLine("%s: %s: shader %p",
+    traceLine("%s: %s: shader %p",
         context->name, __func__,
         shader);
 
     NOVA_CALL_RESULT(type, ShaderGetType, shader)
 
-    logLine("%s: %s: <- Type %u (%s)",
+    traceLine("%s: %s: <- Type %u (%s)",
         context->name, __func__,
         type, decodeShaderType(type));
 
@@ -3559,16 +3196,16 @@ static W3DN_Shader* W3DN_ShaderPipelineGetShader(struct W3DN_Context_s *self, W3
 {
     W3DN_Shader* shader = NULL;
 
-    GET_CONTEXT
+    GET_CONTEXT(ShaderPipelineGetShader, shaderPipeline, shaderType)
 
-    logLine("%s: %s: shaderPipeline %p, shaderType %u (%s)",
+    traceLine("%s: %s: shaderPipeline %p, shaderType %u (%s)",
         context->name, __func__,
         shaderPipeline,
         shaderType, decodeShaderType(shaderType));
 
     NOVA_CALL_RESULT(shader, ShaderPipelineGetShader, shaderPipeline, shaderType)
 
-    logLine("%s: %s: <- Shader %p",
+    traceLine("%s: %s: <- Shader %p",
         context->name, __func__,
         shader);
 
@@ -3582,25 +3219,40 @@ static uint32 W3DN_Submit(struct W3DN_Context_s *self, W3DN_ErrorCode *errCode)
     W3DN_ErrorCode myErrCode = 0;
     uint32 result = 0;
 
-    GET_CONTEXT
+    GET_CONTEXT(Submit, errCode)
 
-    logLine("%s: %s: errCode %p",
+    traceLine("%s: %s: errCode %p",
         context->name, __func__,
         errCode);
 
     NOVA_CALL_RESULT(result, Submit, &myErrCode)
 
-    logLine("%s: %s: <- errCode %d (%s). Submit ID %lu",
+    traceLine("%s: %s: <- errCode %d (%s). Submit ID %lu",
         context->name, __func__,
         myErrCode, mapNovaError(myErrCode),
         result);
 
     if (result == 0 && myErrCode != W3DNEC_QUEUEEMPTY) {
-        logLine("%s: Warning: W3DN_Submit() returned zero", context->name);
+        traceLine("%s: Warning: W3DN_Submit() returned zero", context->name);
         context->profiling[Submit].errors++;
         errorCount++;
     }
 
+    frametime_add(&context->frameTimes, timer_get_ticks());
+
+    if (context->flight) {
+        flight_frame(context->flight);
+    }
+
+    if (context->trace) {
+        recorder_frame(context->trace);
+    }
+
+    if (frameSummaryMode) {
+        frameSummary(&context->frame, context->name, mapNovaTraceFunction, context->profiling,
+            context->frameProfiling, NovaFunctionCount, &context->counter);
+    }
+
     if (errCode) {
         *errCode = myErrCode;
     }
@@ -3612,15 +3264,15 @@ static W3DN_ErrorCode W3DN_TexGenMipMaps(struct W3DN_Context_s *self, W3DN_Textu
 {
     W3DN_ErrorCode result = W3DNEC_SUCCESS;
 
-    GET_CONTEXT
+    GET_CONTEXT(TexGenMipMaps, texture, base, last)
 
-    logLine("%s: %s: texture %p, base %lu, last %lu",
+    traceLine("%s: %s: texture %p, base %lu, last %lu",
         context->name, __func__,
         texture, base, last);
 
     NOVA_CALL_RESULT(result, TexGenMipMaps, texture, base, last)
 
-    logLine("%s: %s: <- Result %d (%s)",
+    traceLine("%s: %s: <- Result %d (%s)",
         context->name, __func__,
         result, mapNovaError(result));
 
@@ -3633,15 +3285,15 @@ static W3DN_ErrorCode W3DN_TexGetParameters(struct W3DN_Context_s *self, W3DN_Te
 {
     W3DN_ErrorCode result = W3DNEC_SUCCESS;
 
-    GET_CONTEXT
+    GET_CONTEXT(TexGetParameters, texture, tags)
 
-    logLine("%s: %s: texture %p, tags %p",
+    traceLine("%s: %s: texture %p, tags %p",
         context->name, __func__,
         texture, tags);
 
     NOVA_CALL_RESULT(result, TexGetParameters, texture, tags)
 
-    logLine("%s: %s: <- tags (%s). Result %d (%s)",
+    traceLine("%s: %s: <- tags (%s). Result %d (%s)",
         context->name, __func__,
         decodeTextureParameterTags(tags, context),
         result, mapNovaError(result));
@@ -3655,9 +3307,9 @@ static W3DN_ErrorCode W3DN_TexGetProperty(struct W3DN_Context_s *self, W3DN_Text
 {
     W3DN_ErrorCode result = W3DNEC_SUCCESS;
 
-    GET_CONTEXT
+    GET_CONTEXT(TexGetProperty, texture, texProp, buffer)
 
-    logLine("%s: %s: texture %p, texProp %u (%s), buffer %p",
+    traceLine("%s: %s: texture %p, texProp %u (%s), buffer %p",
         context->name, __func__,
         texture,
         texProp, decodeTextureProperty(texProp),
@@ -3665,7 +3317,7 @@ static W3DN_ErrorCode W3DN_TexGetProperty(struct W3DN_Context_s *self, W3DN_Text
 
     NOVA_CALL_RESULT(result, TexGetProperty, texture, texProp, buffer)
 
-    logLine("%s: %s: <- Result %d (%s)",
+    traceLine("%s: %s: <- Result %d (%s)",
         context->name, __func__,
         result, mapNovaError(result));
 
@@ -3680,15 +3332,15 @@ static void* W3DN_TexGetRMBuffer(struct W3DN_Context_s *self, W3DN_Texture *text
 {
     void* result = NULL;
 
-    GET_CONTEXT
+    GET_CONTEXT(TexGetRMBuffer, texture)
 
-    logLine("%s: %s: texture %p",
+    traceLine("%s: %s: texture %p",
         context->name, __func__,
         texture);
 
     NOVA_CALL_RESULT(result, TexGetRMBuffer, texture)
 
-    logLine("%s: %s: <- Result %p",
+    traceLine("%s: %s: <- Result %p",
         context->name, __func__,
         result);
 
@@ -3702,9 +3354,9 @@ static W3DN_ErrorCode W3DN_TexGetSubResourceLayout(struct W3DN_Context_s *self,
 {
     W3DN_ErrorCode result = W3DNEC_SUCCESS;
 
-    GET_CONTEXT
+    GET_CONTEXT(TexGetSubResourceLayout, texture, aspect, mipLevel, arrayIdx, layout)
 
-    logLine("%s: %s: texture %p, aspect %d (%s), mipLevel %lu, arrayIdx %lu, layout %p",
+    traceLine("%s: %s: texture %p, aspect %d (%s), mipLevel %lu, arrayIdx %lu, layout %p",
         context->name, __func__,
         texture,
         aspect, decodeTexAspect(aspect),
@@ -3712,7 +3364,7 @@ static W3DN_ErrorCode W3DN_TexGetSubResourceLayout(struct W3DN_Context_s *self,
 
     NOVA_CALL_RESULT(result, TexGetSubResourceLayout, texture, aspect, mipLevel, arrayIdx, layout)
 
-    logLine("%s: %s: <- Result %d (%s)",
+    traceLine("%s: %s: <- Result %d (%s)",
         context->name, __func__,
         result, mapNovaError(result));
 
@@ -3727,16 +3379,16 @@ static W3DN_ErrorCode W3DN_TexSetParameters(struct W3DN_Context_s *self, W3DN_Te
 {
     W3DN_ErrorCode result = W3DNEC_SUCCESS;
 
-    GET_CONTEXT
+    GET_CONTEXT(TexSetParameters, texture, tags)
 
-    logLine("%s: %s: texture %p, tags %p (%s)",
+    traceLine("%s: %s: texture %p, tags %p (%s)",
         context->name, __func__,
         texture,
         tags, decodeTextureParameterTags(tags, context));
 
     NOVA_CALL_RESULT(result, TexSetParameters, texture, tags)
 
-    logLine("%s: %s: <- Result %d (%s)",
+    traceLine("%s: %s: <- Result %d (%s)",
         context->name, __func__,
         result, mapNovaError(result));
 
@@ -3750,15 +3402,15 @@ static W3DN_ErrorCode W3DN_TexUpdateImage(struct W3DN_Context_s *self, W3DN_Text
 {
     W3DN_ErrorCode result = W3DNEC_SUCCESS;
 
-    GET_CONTEXT
+    GET_CONTEXT(TexUpdateImage, texture, source, level, arrayIdx, srcBytesPerRow, srcRowsPerLayer)
 
-    logLine("%s: %s: texture %p, source %p, level %lu, arrayIdx %lu, srcBytesPerRow %lu, srcRowsPerLayer %lu",
+    traceLine("%s: %s: texture %p, source %p, level %lu, arrayIdx %lu, srcBytesPerRow %lu, srcRowsPerLayer %lu",
         context->name, __func__,
         texture, source, level, arrayIdx, srcBytesPerRow, srcRowsPerLayer);
 
     NOVA_CALL_RESULT(result, TexUpdateImage, texture, source, level, arrayIdx, srcBytesPerRow, srcRowsPerLayer)
 
-    logLine("%s: %s: <- Result %d (%s)",
+    traceLine("%s: %s: <- Result %d (%s)",
         context->name, __func__,
         result, mapNovaError(result));
 
@@ -3773,9 +3425,9 @@ static W3DN_ErrorCode W3DN_TexUpdateSubImage(struct W3DN_Context_s *self, W3DN_T
 {
     W3DN_ErrorCode result = W3DNEC_SUCCESS;
 
-    GET_CONTEXT
+    GET_CONTEXT(TexUpdateSubImage, texture, source, level, arrayIdx, srcBytesPerRow, srcRowsPerLayer, dstX, dstY, dstLayer, width, height, depth)
 
-    logLine("%s: %s: texture %p, source %p, level %lu, arrayIdx %lu, srcBytesPerRow %lu, srcRowsPerLayer %lu, "
+    traceLine("%s: %s: texture %p, source %p, level %lu, arrayIdx %lu, srcBytesPerRow %lu, srcRowsPerLayer %lu, "
         "dstX %lu, dstY %lu, dstLayer %lu, width %lu, height %lu, depth %lu",
         context->name, __func__,
         texture, source,
@@ -3787,7 +3439,7 @@ static W3DN_ErrorCode W3DN_TexUpdateSubImage(struct W3DN_Context_s *self, W3DN_T
     NOVA_CALL_RESULT(result, TexUpdateSubImage, texture, source,
         level, arrayIdx, srcBytesPerRow, srcRowsPerLayer, dstX, dstY, dstLayer, width, height, depth)
 
-    logLine("%s: %s: <- Result %d (%s)",
+    traceLine("%s: %s: <- Result %d (%s)",
         context->name, __func__,
         result, mapNovaError(result));
 
@@ -3800,15 +3452,15 @@ static W3DN_ErrorCode W3DN_TSGetParameters(struct W3DN_Context_s *self, W3DN_Tex
 {
     W3DN_ErrorCode result = W3DNEC_SUCCESS;
 
-    GET_CONTEXT
+    GET_CONTEXT(TSGetParameters, texSampler, tags)
 
-    logLine("%s: %s: texSampler %p, tags %p",
+    traceLine("%s: %s: texSampler %p, tags %p",
         context->name, __func__,
         texSampler, tags);
 
     NOVA_CALL_RESULT(result, TSGetParameters, texSampler, tags)
 
-    logLine("%s: %s: <- tags (%s). Result %d (%s)",
+    traceLine("%s: %s: <- tags (%s). Result %d (%s)",
         context->name, __func__,
         decodeTextureSamplerParameterTags(tags, context),
         result, mapNovaError(result));
@@ -3822,16 +3474,16 @@ static W3DN_ErrorCode W3DN_TSSetParameters(struct W3DN_Context_s *self, W3DN_Tex
 {
     W3DN_ErrorCode result = W3DNEC_SUCCESS;
 
-    GET_CONTEXT
+    GET_CONTEXT(TSSetParameters, texSampler, tags)
 
-    logLine("%s: %s: texSampler %p, tags %p (%s)",
+    traceLine("%s: %s: texSampler %p, tags %p (%s)",
         context->name, __func__,
         texSampler,
         tags, decodeTextureSamplerParameterTags(tags, context));
 
     NOVA_CALL_RESULT(result, TSSetParameters, texSampler, tags)
 
-    logLine("%s: %s: <- Result %d (%s)",
+    traceLine("%s: %s: <- Result %d (%s)",
         context->name, __func__,
         result, mapNovaError(result));
 
@@ -3846,16 +3498,16 @@ static W3DN_ErrorCode W3DN_VBOGetArray(struct W3DN_Context_s *self, W3DN_VertexB
 {
     W3DN_ErrorCode result = W3DNEC_SUCCESS;
 
-    GET_CONTEXT
+    GET_CONTEXT(VBOGetArray, buffer, arrayIdx, elementType, normalized, numElements, stride, offset, count)
 
-    logLine("%s: %s: buffer %p, arrayIdx %lu, elementType %p, normalized %p, numElements %p, stride %p, offset %p, count %p",
+    traceLine("%s: %s: buffer %p, arrayIdx %lu, elementType %p, normalized %p, numElements %p, stride %p, offset %p, count %p",
         context->name, __func__,
         buffer, arrayIdx, elementType,
         normalized, numElements, stride, offset, count);
 
     NOVA_CALL_RESULT(result, VBOGetArray, buffer, arrayIdx, elementType, normalized, numElements, stride, offset, count)
 
-    logLine("%s: %s: <- elementType %u (%s), normalized %d, numElements %llu, stride %llu, offset %llu, count %llu. Result %d (%s)",
+    traceLine("%s: %s: <- elementType %u (%s), normalized %d, numElements %llu, stride %llu, offset %llu, count %llu. Result %d (%s)",
         context->name, __func__,
         *elementType, decodeElementFormat(*elementType),
         *normalized, *numElements, *stride, *offset, *count,
@@ -3870,15 +3522,15 @@ static uint64 W3DN_VBOGetAttr(struct W3DN_Context_s *self, W3DN_VertexBuffer *ve
 {
     uint64 result = 0;
 
-    GET_CONTEXT
+    GET_CONTEXT(VBOGetAttr, vertexBuffer, attr)
 
-    logLine("%s: %s: vertexBuffer %p, attr %u (%s)", context->name, __func__,
+    traceLine("%s: %s: vertexBuffer %p, attr %u (%s)", context->name, __func__,
         vertexBuffer,
         attr, decodeBufferAttribute(attr));
 
     NOVA_CALL_RESULT(result, VBOGetAttr, vertexBuffer, attr)
 
-    logLine("%s: %s: <- Result %llu", context->name, __func__,
+    traceLine("%s: %s: <- Result %llu", context->name, __func__,
         result);
 
     return result;
@@ -3889,14 +3541,14 @@ static W3DN_BufferLock* W3DN_VBOLock(struct W3DN_Context_s *self, W3DN_ErrorCode
 {
     W3DN_BufferLock* result = NULL;
 
-    GET_CONTEXT
+    GET_CONTEXT(VBOLock, errCode, buffer, readOffset, readSize)
 
-    logLine("%s: %s: buffer %p, readOffset %llu, readSize %llu. Lock address %p, errCode %p", context->name, __func__,
+    traceLine("%s: %s: buffer %p, readOffset %llu, readSize %llu. Lock address %p, errCode %p", context->name, __func__,
         buffer, readOffset, readSize, result, errCode);
 
     NOVA_CALL_RESULT(result, VBOLock, errCode, buffer, readOffset, readSize)
 
-    logLine("%s: %s: <- errCode %u (%s). Lock address %p", context->name, __func__,
+    traceLine("%s: %s: <- errCode %u (%s). Lock address %p", context->name, __func__,
         mapNovaErrorPointerToCode(errCode),
         mapNovaErrorPointerToString(errCode),
         result);
@@ -3913,9 +3565,9 @@ static W3DN_ErrorCode W3DN_VBOSetArray(struct W3DN_Context_s *self, W3DN_VertexB
 {
     W3DN_ErrorCode result = W3DNEC_SUCCESS;
 
-    GET_CONTEXT
+    GET_CONTEXT(VBOSetArray, buffer, arrayIdx, elementType, normalized, numElements, stride, offset, count)
 
-    logLine("%s: %s: buffer %p, arrayIdx %lu, elementType %u (%s), normalized %d, numElements %llu, stride %llu, offset %llu, count %llu",
+    traceLine("%s: %s: buffer %p, arrayIdx %lu, elementType %u (%s), normalized %d, numElements %llu, stride %llu, offset %llu, count %llu",
         context->name, __func__,
         buffer, arrayIdx,
         elementType, decodeElementFormat(elementType),
@@ -3923,7 +3575,7 @@ static W3DN_ErrorCode W3DN_VBOSetArray(struct W3DN_Context_s *self, W3DN_VertexB
 
     NOVA_CALL_RESULT(result, VBOSetArray, buffer, arrayIdx, elementType, normalized, numElements, stride, offset, count)
 
-    logLine("%s: %s: <- Result %d (%s)",
+    traceLine("%s: %s: <- Result %d (%s)",
         context->name, __func__,
         result, mapNovaError(result));
 
@@ -3936,15 +3588,15 @@ static W3DN_ErrorCode W3DN_WaitDone(struct W3DN_Context_s *self, uint32 submitID
 {
     W3DN_ErrorCode result = W3DNEC_SUCCESS;
 
-    GET_CONTEXT
+    GET_CONTEXT(WaitDone, submitID, timeout)
 
-    logLine("%s: %s: submitID %lu, timeout %lu",
+    traceLine("%s: %s: submitID %lu, timeout %lu",
         context->name, __func__,
         submitID, timeout);
 
     NOVA_CALL_RESULT(result, WaitDone, submitID, timeout)
 
-    logLine("%s: %s: <- Result %d (%s)",
+    traceLine("%s: %s: <- Result %d (%s)",
         context->name, __func__,
         result, mapNovaError(result));
 
@@ -3957,15 +3609,15 @@ static W3DN_ErrorCode W3DN_WaitIdle(struct W3DN_Context_s *self, uint32 timeout)
 {
     W3DN_ErrorCode result = W3DNEC_SUCCESS;
 
-    GET_CONTEXT
+    GET_CONTEXT(WaitIdle, timeout)
 
-    logLine("%s: %s: timeout %lu",
+    traceLine("%s: %s: timeout %lu",
         context->name, __func__,
         timeout);
 
     NOVA_CALL_RESULT(result, WaitIdle, timeout)
 
-    logLine("%s: %s: <- Result %d (%s)",
+    traceLine("%s: %s: <- Result %d (%s)",
         context->name, __func__,
         result, mapNovaError(result));
 
@@ -3974,246 +3626,44 @@ static W3DN_ErrorCode W3DN_WaitIdle(struct W3DN_Context_s *self, uint32 timeout)
     return result;
 }
 
+// See GENERATE_FILTERED_PATCH
 #define GENERATE_NOVA_PATCH(function) \
 static void patch_##function(BOOL patching, struct NovaContext* nova) \
 { \
-    if (patching) { \
-        if (match("W3DN_" #function)) { \
-            nova->old_##function = nova->context->function; \
-            nova->context->function = W3DN_##function; \
-            logDebug("Patched W3DN context function " #function); \
-        } \
+    const BOOL wanted = patching && filter_test(patchFilter, function); \
+    \
+    if (wanted == filter_test(nova->patched, function)) { \
+        return; \
+    } \
+    \
+    IExec->Forbid(); \
+    if (wanted) { \
+        nova->old_##function = nova->context->function; \
+        nova->context->function = W3DN_##function; \
     } else { \
-        IExec->Forbid(); \
-        if (nova->old_##function) { \
-            nova->context->function = nova->old_##function; \
+        nova->context->function = nova->old_##function; \
+        if (!patching) { \
             nova->old_##function = NULL; \
         } \
-        IExec->Permit(); \
+    } \
+    filter_set(nova->patched, function, wanted); \
+    IExec->Permit(); \
+    \
+    if (wanted) { \
+        logDebug("Patched W3DN context function " #function); \
+    } else { \
         logDebug("Restored W3DN context function " #function); \
     } \
 }
 
-GENERATE_NOVA_PATCH(BindBitMapAsTexture)
-GENERATE_NOVA_PATCH(BindShaderDataBuffer)
-GENERATE_NOVA_PATCH(BindTexture)
-GENERATE_NOVA_PATCH(BindVertexAttribArray)
-GENERATE_NOVA_PATCH(BufferUnlock)
-GENERATE_NOVA_PATCH(Clear)
-GENERATE_NOVA_PATCH(CompileShader)
-GENERATE_NOVA_PATCH(CreateDataBufferObject)
-GENERATE_NOVA_PATCH(CreateFrameBuffer)
-GENERATE_NOVA_PATCH(CreateRenderStateObject)
-GENERATE_NOVA_PATCH(CreateShaderPipeline)
-GENERATE_NOVA_PATCH(CreateTexSampler)
-GENERATE_NOVA_PATCH(CreateTexture)
-GENERATE_NOVA_PATCH(CreateTextureExtRMB)
-GENERATE_NOVA_PATCH(CreateVertexBufferObject)
-GENERATE_NOVA_PATCH(DBOGetAttr)
-GENERATE_NOVA_PATCH(DBOGetBuffer)
-GENERATE_NOVA_PATCH(DBOLock)
-GENERATE_NOVA_PATCH(DBOSetBuffer)
-GENERATE_NOVA_PATCH(Destroy)
-GENERATE_NOVA_PATCH(DestroyDataBufferObject)
-GENERATE_NOVA_PATCH(DestroyFrameBuffer)
-GENERATE_NOVA_PATCH(DestroyRenderStateObject)
-GENERATE_NOVA_PATCH(DestroyShader)
-GENERATE_NOVA_PATCH(DestroyShaderLog)
-GENERATE_NOVA_PATCH(DestroyShaderPipeline)
-GENERATE_NOVA_PATCH(DestroyTexSampler)
-GENERATE_NOVA_PATCH(DestroyTexture)
-GENERATE_NOVA_PATCH(DestroyVertexBufferObject)
-GENERATE_NOVA_PATCH(DrawArrays)
-GENERATE_NOVA_PATCH(DrawElements)
-GENERATE_NOVA_PATCH(FBBindBuffer)
-GENERATE_NOVA_PATCH(FBGetAttr)
-GENERATE_NOVA_PATCH(FBGetBufferBM)
-GENERATE_NOVA_PATCH(FBGetBufferTex)
-GENERATE_NOVA_PATCH(FBGetStatus)
-GENERATE_NOVA_PATCH(GetBitMapTexture)
-GENERATE_NOVA_PATCH(GetBlendColour)
-GENERATE_NOVA_PATCH(GetBlendEquation)
-GENERATE_NOVA_PATCH(GetBlendMode)
-GENERATE_NOVA_PATCH(GetColourMask)
-GENERATE_NOVA_PATCH(GetDepthCompareFunc)
-GENERATE_NOVA_PATCH(GetFrontFace)
-GENERATE_NOVA_PATCH(GetLineWidth)
-GENERATE_NOVA_PATCH(GetPolygonMode)
-GENERATE_NOVA_PATCH(GetPolygonOffset)
-GENERATE_NOVA_PATCH(GetProvokingVertex)
-GENERATE_NOVA_PATCH(GetRenderTarget)
-GENERATE_NOVA_PATCH(GetScissor)
-GENERATE_NOVA_PATCH(GetShaderDataBuffer)
-GENERATE_NOVA_PATCH(GetShaderPipeline)
-GENERATE_NOVA_PATCH(GetState)
-GENERATE_NOVA_PATCH(GetStencilFunc)
-GENERATE_NOVA_PATCH(GetStencilOp)
-GENERATE_NOVA_PATCH(GetStencilWriteMask)
-GENERATE_NOVA_PATCH(GetTexSampler)
-GENERATE_NOVA_PATCH(GetTexture)
-GENERATE_NOVA_PATCH(GetVertexAttribArray)
-GENERATE_NOVA_PATCH(GetViewport)
-GENERATE_NOVA_PATCH(IsDone)
-GENERATE_NOVA_PATCH(Query)
-GENERATE_NOVA_PATCH(RSOCopy)
-GENERATE_NOVA_PATCH(RSOSetMaster)
-GENERATE_NOVA_PATCH(SetBlendColour)
-GENERATE_NOVA_PATCH(SetBlendEquation)
-GENERATE_NOVA_PATCH(SetBlendEquationSeparate)
-GENERATE_NOVA_PATCH(SetBlendMode)
-GENERATE_NOVA_PATCH(SetBlendModeSeparate)
-GENERATE_NOVA_PATCH(SetColourMask)
-GENERATE_NOVA_PATCH(SetDepthCompareFunc)
-GENERATE_NOVA_PATCH(SetFrontFace)
-GENERATE_NOVA_PATCH(SetLineWidth)
-GENERATE_NOVA_PATCH(SetPolygonMode)
-GENERATE_NOVA_PATCH(SetPolygonOffset)
-GENERATE_NOVA_PATCH(SetProvokingVertex)
-GENERATE_NOVA_PATCH(SetRenderTarget)
-GENERATE_NOVA_PATCH(SetScissor)
-GENERATE_NOVA_PATCH(SetShaderPipeline)
-GENERATE_NOVA_PATCH(SetState)
-GENERATE_NOVA_PATCH(SetStencilFunc)
-GENERATE_NOVA_PATCH(SetStencilFuncSeparate)
-GENERATE_NOVA_PATCH(SetStencilOp)
-GENERATE_NOVA_PATCH(SetStencilOpSeparate)
-GENERATE_NOVA_PATCH(SetStencilWriteMask)
-GENERATE_NOVA_PATCH(SetStencilWriteMaskSeparate)
-GENERATE_NOVA_PATCH(SetViewport)
-GENERATE_NOVA_PATCH(ShaderGetCount)
-GENERATE_NOVA_PATCH(ShaderGetObjectInfo)
-GENERATE_NOVA_PATCH(ShaderGetOffset)
-GENERATE_NOVA_PATCH(ShaderGetTotalStorage)
-GENERATE_NOVA_PATCH(ShaderGetType)
-GENERATE_NOVA_PATCH(ShaderPipelineGetShader)
-GENERATE_NOVA_PATCH(Submit)
-GENERATE_NOVA_PATCH(TexGenMipMaps)
-GENERATE_NOVA_PATCH(TexGetParameters)
-GENERATE_NOVA_PATCH(TexGetProperty)
-GENERATE_NOVA_PATCH(TexGetRMBuffer)
-GENERATE_NOVA_PATCH(TexGetSubResourceLayout)
-GENERATE_NOVA_PATCH(TexSetParameters)
-GENERATE_NOVA_PATCH(TexUpdateImage)
-GENERATE_NOVA_PATCH(TexUpdateSubImage)
-GENERATE_NOVA_PATCH(TSGetParameters)
-GENERATE_NOVA_PATCH(TSSetParameters)
-GENERATE_NOVA_PATCH(VBOGetArray)
-GENERATE_NOVA_PATCH(VBOGetAttr)
-GENERATE_NOVA_PATCH(VBOLock)
-GENERATE_NOVA_PATCH(VBOSetArray)
-GENERATE_NOVA_PATCH(WaitDone)
-GENERATE_NOVA_PATCH(WaitIdle)
+#define NOVA_PATCH(name, returnType, parameters, categories) GENERATE_NOVA_PATCH(name)
+NOVA_FUNCTIONS(NOVA_PATCH)
+#undef NOVA_PATCH
 
 static void (*patches[])(BOOL, struct NovaContext *) = {
-    patch_BindBitMapAsTexture,
-    patch_BindShaderDataBuffer,
-    patch_BindTexture,
-    patch_BindVertexAttribArray,
-    patch_BufferUnlock,
-    patch_Clear,
-    patch_CompileShader,
-    patch_CreateDataBufferObject,
-    patch_CreateFrameBuffer,
-    patch_CreateRenderStateObject,
-    patch_CreateShaderPipeline,
-    patch_CreateTexSampler,
-    patch_CreateTexture,
-    patch_CreateTextureExtRMB,
-    patch_CreateVertexBufferObject,
-    patch_DBOGetAttr,
-    patch_DBOGetBuffer,
-    patch_DBOLock,
-    patch_DBOSetBuffer,
-    patch_Destroy,
-    patch_DestroyDataBufferObject,
-    patch_DestroyFrameBuffer,
-    patch_DestroyRenderStateObject,
-    patch_DestroyShader,
-    patch_DestroyShaderLog,
-    patch_DestroyShaderPipeline,
-    patch_DestroyTexSampler,
-    patch_DestroyTexture,
-    patch_DestroyVertexBufferObject,
-    patch_DrawArrays,
-    patch_DrawElements,
-    patch_FBBindBuffer,
-    patch_FBGetAttr,
-    patch_FBGetBufferBM,
-    patch_FBGetBufferTex,
-    patch_FBGetStatus,
-    patch_GetBitMapTexture,
-    patch_GetBlendColour,
-    patch_GetBlendEquation,
-    patch_GetBlendMode,
-    patch_GetColourMask,
-    patch_GetDepthCompareFunc,
-    patch_GetFrontFace,
-    patch_GetLineWidth,
-    patch_GetPolygonMode,
-    patch_GetPolygonOffset,
-    patch_GetProvokingVertex,
-    patch_GetRenderTarget,
-    patch_GetScissor,
-    patch_GetShaderDataBuffer,
-    patch_GetShaderPipeline,
-    patch_GetState,
-    patch_GetStencilFunc,
-    patch_GetStencilOp,
-    patch_GetStencilWriteMask,
-    patch_GetTexSampler,
-    patch_GetTexture,
-    patch_GetVertexAttribArray,
-    patch_GetViewport,
-    patch_IsDone,
-    patch_Query,
-    patch_RSOCopy,
-    patch_RSOSetMaster,
-    patch_SetBlendColour,
-    patch_SetBlendEquation,
-    patch_SetBlendEquationSeparate,
-    patch_SetBlendMode,
-    patch_SetBlendModeSeparate,
-    patch_SetColourMask,
-    patch_SetDepthCompareFunc,
-    patch_SetFrontFace,
-    patch_SetLineWidth,
-    patch_SetPolygonMode,
-    patch_SetPolygonOffset,
-    patch_SetProvokingVertex,
-    patch_SetRenderTarget,
-    patch_SetScissor,
-    patch_SetShaderPipeline,
-    patch_SetState,
-    patch_SetStencilFunc,
-    patch_SetStencilFuncSeparate,
-    patch_SetStencilOp,
-    patch_SetStencilOpSeparate,
-    patch_SetStencilWriteMask,
-    patch_SetStencilWriteMaskSeparate,
-    patch_SetViewport,
-    patch_ShaderGetCount,
-    patch_ShaderGetObjectInfo,
-    patch_ShaderGetOffset,
-    patch_ShaderGetTotalStorage,
-    patch_ShaderGetType,
-    patch_ShaderPipelineGetShader,
-    patch_Submit,
-    patch_TexGenMipMaps,
-    patch_TexGetParameters,
-    patch_TexGetProperty,
-    patch_TexGetRMBuffer,
-    patch_TexGetSubResourceLayout,
-    patch_TexSetParameters,
-    patch_TexUpdateImage,
-    patch_TexUpdateSubImage,
-    patch_TSGetParameters,
-    patch_TSSetParameters,
-    patch_VBOGetArray,
-    patch_VBOGetAttr,
-    patch_VBOLock,
-    patch_VBOSetArray,
-    patch_WaitDone,
-    patch_WaitIdle
+    #define NOVA_PATCH_ENTRY(name, returnType, parameters, categories) patch_ ## name,
+    NOVA_FUNCTIONS(NOVA_PATCH_ENTRY)
+    #undef NOVA_PATCH_ENTRY
 };
 
 static void patch_context_functions(struct NovaContext* nova)
@@ -4224,6 +3674,33 @@ static void patch_context_functions(struct NovaContext* nova)
     }
 }
 
+void warp3dnova_reload_filter(void)
+{
+    if (!mutex) {
+        return;
+    }
+
+    // Wrappers read the trace set and the conditions without locking. The trace
+    // set is published word by word, the conditions as a new set.
+    filter_compile(FilterSet_Trace, traceFilter, &novaFilterTable);
+    filter_compile_predicates(&predicates, &novaFilterTable);
+
+    IExec->MutexObtain(mutex);
+
+    filter_compile(FilterSet_Profile, patchFilter, &novaFilterTable);
+
+    size_t position = 0;
+    struct NovaContext* nova;
+
+    while ((nova = client_table_next(&clientTable, &position))) {
+        patch_context_functions(nova);
+        logAlways("%s: %lu Nova functions patched after filter reload", nova->name,
+            (ULONG)filter_count(nova->patched, NovaFunctionCount));
+    }
+
+    IExec->MutexRelease(mutex);
+}
+
 static void restore_context_functions(struct NovaContext* nova)
 {
     size_t i;
@@ -4246,7 +3723,12 @@ static W3DN_Context* my_W3DN_CreateContext(struct Warp3DNovaIFace *Self, W3DN_Er
     if (creation.old_W3DN_CreateContext) {
         context = creation.old_W3DN_CreateContext(Self, errCode, tags);
 
-        if (context) {
+        char taskName[NAME_LEN];
+        find_process_name2((struct Node *)IExec->FindTask(NULL), taskName);
+
+        if (context && !task_filter_match(taskName)) {
+            logAlways("Task %s doesn't match the TASK pattern, NOVA context %p not patched", taskName, context);
+        } else if (context) {
             struct NovaContext * nova = IExec->AllocVecTags(sizeof(struct NovaContext), AVT_ClearValue, 0, TAG_DONE);
 
             if (nova) {
@@ -4260,21 +3742,31 @@ static W3DN_Context* my_W3DN_CreateContext(struct Warp3DNovaIFace *Self, W3DN_Er
 
                 IExec->MutexObtain(mutex);
 
-                size_t i;
-                for (i = 0; i < MAX_CLIENTS; i++) {
-                    if (contexts[i] == NULL) {
-                        contexts[i] = nova;
-                        logAlways("[%u] Patching task %s NOVA context %p", i, nova->name, context);
-                        break;
-                    }
+                struct NovaContext* const stale = client_table_find(&clientTable, context);
+
+                if (stale) {
+                    logAlways("%s: NOVA context %p was not destroyed", stale->name, context);
+                    closeContext(stale);
                 }
 
+                nova->id = client_table_add(&clientTable, context, nova);
+
                 IExec->MutexRelease(mutex);
 
-                if (i == MAX_CLIENTS) {
-                    logAlways("glSnoop: too many clients, cannot patch");
+                if (!nova->id) {
+                    logAlways("Cannot allocate memory for client registry: cannot patch");
                     IExec->FreeVec(nova);
                 } else {
+                    logAlways("[%lu] Patching task %s NOVA context %p", nova->id, nova->name, context);
+
+                    if (recorder_enabled()) {
+                        nova->trace = recorder_open(nova->name, mapNovaTraceFunction);
+                    }
+
+                    if (flight_enabled()) {
+                        nova->flight = flight_open(nova->name, mapNovaTraceFunction);
+                    }
+
                     patch_context_functions(nova);
                     PROF_INIT(nova, NovaFunctionCount)
 
@@ -4301,10 +3793,15 @@ static W3DN_Context* my_W3DN_CreateContext(struct Warp3DNovaIFace *Self, W3DN_Er
 
 GENERATE_PATCH(Warp3DNovaIFace, W3DN_CreateContext, my, ContextCreation)
 
-void warp3dnova_install_patches(ULONG startTimeInSeconds, ULONG durationTimeInSeconds)
+void warp3dnova_install_patches(ULONG startTimeInSeconds, ULONG durationTimeInSeconds, LONG frameSummaryEnabled)
 {
     profilerStartTime = startTimeInSeconds;
     profilerDuration = durationTimeInSeconds;
+    frameSummaryMode = frameSummaryEnabled != 0;
+
+    filter_compile(FilterSet_Profile, patchFilter, &novaFilterTable);
+    filter_compile(FilterSet_Trace, traceFilter, &novaFilterTable);
+    filter_compile_predicates(&predicates, &novaFilterTable);
 
     mutex = IExec->AllocSysObject(ASOT_MUTEX, TAG_DONE);
 
@@ -4327,18 +3824,21 @@ void warp3dnova_remove_patches(void)
     }
 
     if (mutex) {
-        size_t i;
+        size_t position = 0;
+        struct NovaContext* nova;
 
         // Remove patches
         IExec->MutexObtain(mutex);
 
-        for (i = 0; i < MAX_CLIENTS; i++) {
-            if (contexts[i]) {
-                profileResults(contexts[i]);
-                restore_context_functions(contexts[i]);
-            }
+        while ((nova = client_table_next(&clientTable, &position))) {
+            profileResults(nova);
+            restore_context_functions(nova);
         }
 
+        // Full results of the destroyed contexts were logged when they were destroyed
+        summaryResults("Destroyed Nova contexts:", clientTable.archive, clientTable.archiveCount,
+            mapNovaTraceFunction);
+
         IExec->MutexRelease(mutex);
     }
 
@@ -4350,18 +3850,25 @@ void warp3dnova_free(void)
     logLine("%s", __func__);
 
     if (mutex) {
-        size_t i;
+        size_t position = 0;
+        struct NovaContext* nova;
 
         // Remove context data
         IExec->MutexObtain(mutex);
 
-        for (i = 0; i < MAX_CLIENTS; i++) {
-            if (contexts[i]) {
-                IExec->FreeVec(contexts[i]);
-                contexts[i] = NULL;
-            }
+        while ((nova = client_table_next(&clientTable, &position))) {
+            recorder_close(nova->trace);
+            flight_close(nova->flight);
+            IExec->FreeVec(nova);
         }
 
+        for (size_t i = 0; i < clientTable.archiveCount; i++) {
+            IExec->FreeVec(clientTable.archive[i]);
+        }
+
+        client_table_free(&clientTable);
+        filter_free_predicates(&predicates);
+
         IExec->MutexRelease(mutex);
 
         IExec->FreeSysObject(ASOT_MUTEX, mutex);
@@ -3,15 +3,22 @@
 
 #include <exec/types.h>
 
-void warp3dnova_install_patches(ULONG startTimeInSeconds, ULONG durationTimeInSeconds);
+void warp3dnova_install_patches(ULONG startTimeInSeconds, ULONG durationTimeInSeconds, LONG frameSummaryEnabled);
 void warp3dnova_remove_patches(void);
+
+// Applies a reloaded filter to the live contexts
+void warp3dnova_reload_filter(void);
 void warp3dnova_free(void);
 
 const char* warp3dnova_version_string(void);
 const char* warp3dnova_errors_string(void);
+const char* warp3dnova_function_name(const uint16 function);
 
 void warp3dnova_start_profiling(void);
 void warp3dnova_finish_profiling(void);
 
+// Logs the work done by each client since the previous snapshot
+void warp3dnova_snapshot(void);
+
 #endif
 
@@ -0,0 +1,20 @@
+// Host microbenchmarks of the tracer's hot paths. Build and run with "make bench".
+// An optional argument names a file of recorded GLenum values for bench_enums.
+
+#include "host.h"
+
+volatile uint64_t benchSink;
+
+int main(int argc, char* argv[])
+{
+    puts("glSnoop host benchmarks, time per operation");
+
+    bench_logline();
+    bench_trace();
+    bench_clients();
+    bench_filter();
+    bench_predicates();
+    bench_enums(argc > 1 ? argv[1] : NULL);
+
+    return 0;
+}
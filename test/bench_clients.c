@@ -0,0 +1,116 @@
+// Per call client lookup. Wrappers used to take the module mutex and scan the
+// fixed array of MAX_CLIENTS contexts; the client table is probed without a lock.
+
+#include "host.h"
+#include "clients.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+
+#define LOOKUPS 10000000UL
+#define MAX_CLIENTS 5
+#define MANY_CLIENTS 64
+
+typedef struct Context {
+    const void* interface;
+} Context;
+
+static pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+static Context* contexts[MAX_CLIENTS];
+
+__attribute__((noinline)) static Context* find_context_locked(const void* const interface)
+{
+    Context* result = NULL;
+
+    pthread_mutex_lock(&mutex);
+
+    for (size_t i = 0; i < MAX_CLIENTS; i++) {
+        if (contexts[i] && contexts[i]->interface == interface) {
+            result = contexts[i];
+            break;
+        }
+    }
+
+    pthread_mutex_unlock(&mutex);
+
+    return result;
+}
+
+__attribute__((noinline)) static void* find_client(const ClientTable* const table, const void* const key)
+{
+    return client_table_find(table, key);
+}
+
+static double measure_locked(const void* const* keys, const size_t keyCount)
+{
+    double best = 0.0;
+
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        const double start = bench_seconds();
+
+        for (unsigned long i = 0; i < LOOKUPS; i++) {
+            benchSink += (uintptr_t)find_context_locked(keys[i % keyCount]);
+        }
+
+        best = bench_best(best, bench_seconds() - start);
+    }
+
+    return best;
+}
+
+static double measure_table(const ClientTable* const table, const void* const* keys, const size_t keyCount)
+{
+    double best = 0.0;
+
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        const double start = bench_seconds();
+
+        for (unsigned long i = 0; i < LOOKUPS; i++) {
+            benchSink += (uintptr_t)find_client(table, keys[i % keyCount]);
+        }
+
+        best = bench_best(best, bench_seconds() - start);
+    }
+
+    return best;
+}
+
+void bench_clients(void)
+{
+    puts("\nClient lookup per wrapper call:");
+
+    // Interfaces and contexts are allocated, so keys are aligned like on the target
+    const void* keys[MANY_CLIENTS];
+    Context clients[MANY_CLIENTS];
+
+    for (size_t i = 0; i < MANY_CLIENTS; i++) {
+        keys[i] = aligned_alloc(64, 64);
+        clients[i].interface = keys[i];
+    }
+
+    for (size_t i = 0; i < MAX_CLIENTS; i++) {
+        contexts[i] = &clients[i];
+    }
+
+    ClientTable table = { 0 };
+
+    for (size_t i = 0; i < MAX_CLIENTS; i++) {
+        client_table_add(&table, keys[i], &clients[i]);
+    }
+
+    bench_report("mutex and scan of 5 contexts, first one", measure_locked(keys, 1), LOOKUPS);
+    bench_report("mutex and scan of 5 contexts, all of them", measure_locked(keys, MAX_CLIENTS), LOOKUPS);
+    bench_report("client_table_find, 5 clients", measure_table(&table, keys, MAX_CLIENTS), LOOKUPS);
+
+    for (size_t i = MAX_CLIENTS; i < MANY_CLIENTS; i++) {
+        client_table_add(&table, keys[i], &clients[i]);
+    }
+
+    bench_report("client_table_find, 64 clients", measure_table(&table, keys, MANY_CLIENTS), LOOKUPS);
+
+    client_table_free(&table);
+
+    for (size_t i = 0; i < MANY_CLIENTS; i++) {
+        free((void *)keys[i]);
+    }
+}
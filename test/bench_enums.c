@@ -0,0 +1,149 @@
+// GLenum decoding: the previous switch statement against the sorted EnumTable
+// and its binary search. The switch is generated from the OGLES2_VALUE_NAMES
+// list that the wrappers' table is built from.
+//
+// Values are drawn from a file of recorded values when one is given to
+// test/bench, one decimal or 0x hexadecimal value per line. Otherwise a
+// synthetic distribution is used, where a few targets and types dominate like
+// in a frame's worth of calls, followed by uniform draws over the table.
+
+#include "host.h"
+#include "ogles2_enums.h"
+
+#include <exec/types.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define LOOKUPS 20000000UL
+#define MAX_VALUES 65536
+
+__attribute__((noinline)) static const char* decode_switch(const uint32_t value)
+{
+    #define SWITCH_CASE(name, value) case value: return #name;
+
+    switch (value) {
+        OGLES2_VALUE_NAMES(SWITCH_CASE)
+    }
+
+    #undef SWITCH_CASE
+
+    return NULL;
+}
+
+__attribute__((noinline)) static const char* decode_table(const uint32_t value)
+{
+    return enum_table_find(&ogles2ValueTable, value);
+}
+
+static const uint32_t tableValues[] = {
+    #define TABLE_VALUE(name, value) value,
+    OGLES2_VALUE_NAMES(TABLE_VALUE)
+    #undef TABLE_VALUE
+};
+
+#define TABLE_VALUE_COUNT (sizeof(tableValues) / sizeof(tableValues[0]))
+
+// GL_TEXTURE_2D, GL_ARRAY_BUFFER, GL_ELEMENT_ARRAY_BUFFER, GL_FLOAT, GL_UNSIGNED_BYTE,
+// GL_UNSIGNED_SHORT, GL_TEXTURE_MIN_FILTER, GL_TEXTURE_MAG_FILTER, GL_RGBA, GL_TEXTURE0
+static const uint32_t hotValues[] = { 0x0DE1, 0x8892, 0x8893, 0x1406, 0x1401, 0x1403, 0x2801, 0x2800, 0x1908, 0x84C0 };
+
+#define HOT_VALUE_COUNT (sizeof(hotValues) / sizeof(hotValues[0]))
+
+static uint32_t values[MAX_VALUES];
+
+static size_t load_values(const char* const fileName)
+{
+    FILE* file = fopen(fileName, "r");
+
+    if (!file) {
+        printf("  Failed to open '%s'\n", fileName);
+        return 0;
+    }
+
+    size_t count = 0;
+    char line[64];
+
+    while (count < MAX_VALUES && fgets(line, sizeof(line), file)) {
+        char* end;
+        const unsigned long value = strtoul(line, &end, 0);
+
+        if (end != line) {
+            values[count++] = (uint32_t)value;
+        }
+    }
+
+    fclose(file);
+
+    return count;
+}
+
+static size_t synthetic_values(const BOOL skewed)
+{
+    uint32_t random = 12345;
+
+    for (size_t i = 0; i < MAX_VALUES; i++) {
+        random = random * 1103515245 + 12345;
+
+        const uint32_t r = random >> 8;
+
+        if (skewed && r % 10 != 0) {
+            values[i] = hotValues[(r / 10) % HOT_VALUE_COUNT];
+        } else {
+            values[i] = tableValues[(r / 10) % TABLE_VALUE_COUNT];
+        }
+    }
+
+    return MAX_VALUES;
+}
+
+static double measure(const char* (*decode)(uint32_t), const size_t count)
+{
+    double best = 0.0;
+
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        const double start = bench_seconds();
+
+        for (unsigned long i = 0; i < LOOKUPS; i++) {
+            benchSink += (uintptr_t)decode(values[i % count]);
+        }
+
+        best = bench_best(best, bench_seconds() - start);
+    }
+
+    return best;
+}
+
+static void compare(const char* const title, const size_t count)
+{
+    size_t mismatches = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        const char* const fromSwitch = decode_switch(values[i]);
+        const char* const fromTable = decode_table(values[i]);
+
+        if ((fromSwitch == NULL) != (fromTable == NULL) || (fromSwitch && strcmp(fromSwitch, fromTable) != 0)) {
+            mismatches++;
+        }
+    }
+
+    printf("  %s, %zu values%s\n", title, count, mismatches ? ", MISMATCH" : "");
+
+    bench_report("switch statement", measure(decode_switch, count), LOOKUPS);
+    bench_report("enum_table_find", measure(decode_table, count), LOOKUPS);
+}
+
+void bench_enums(const char* const valueFile)
+{
+    printf("\nGLenum decoding, %zu names, per lookup:\n", TABLE_VALUE_COUNT);
+
+    if (valueFile) {
+        const size_t count = load_values(valueFile);
+
+        if (count) {
+            compare(valueFile, count);
+        }
+    }
+
+    compare("synthetic: 90% from 10 common values", synthetic_values(TRUE));
+    compare("uniform over the table", synthetic_values(FALSE));
+}
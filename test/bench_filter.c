@@ -0,0 +1,268 @@
+// Filter decisions for a full patch pass over the OGLES2 functions. Each patch
+// used to search the filter names with strcmp; now the filter file is compiled
+// once into a bitset and each patch tests its bit.
+
+#include "host.h"
+#include "filter.h"
+#include "ogles2_functions.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define PASSES 20000UL
+#define CALLS 20000000UL
+#define FILTER_EVERY 4 // Every fourth function goes into the filter file
+
+typedef enum BenchFunction {
+    #define BENCH_ENUM(prefix, name, returnType, parameters, categories) name,
+    OGLES2_FUNCTIONS(BENCH_ENUM)
+    #undef BENCH_ENUM
+    BenchFunctionCount
+} BenchFunction;
+
+static const char* const libraryNames[BenchFunctionCount] = {
+    #define BENCH_NAME(prefix, name, returnType, parameters, categories) #prefix #name,
+    OGLES2_FUNCTIONS(BENCH_NAME)
+    #undef BENCH_NAME
+};
+
+static const uint8 categories[BenchFunctionCount] = {
+    #define BENCH_CATEGORIES(prefix, name, returnType, parameters, categories) categories,
+    OGLES2_FUNCTIONS(BENCH_CATEGORIES)
+    #undef BENCH_CATEGORIES
+};
+
+static const char* const signatures[BenchFunctionCount] = {
+    #define BENCH_SIGNATURE(prefix, name, returnType, parameters, categories) #parameters,
+    OGLES2_FUNCTIONS(BENCH_SIGNATURE)
+    #undef BENCH_SIGNATURE
+};
+
+static const FilterTable benchOgles2Table = {
+    BenchFunctionCount,
+    libraryNames,
+    categories,
+    signatures
+};
+
+// The filter of the previous version: a list of names searched one by one
+static const char* oldFilters[BenchFunctionCount];
+static size_t oldCount;
+
+__attribute__((noinline)) static BOOL match(const char* const name)
+{
+    if (oldCount == 0) {
+        return TRUE;
+    }
+
+    for (size_t i = 0; i < oldCount; i++) {
+        if (oldFilters[i] && strcmp(name, oldFilters[i]) == 0) {
+            return TRUE;
+        }
+    }
+
+    return FALSE;
+}
+
+// Writes a temporary filter file, the caller removes it
+static BOOL write_filter_file(char* const fileName, const char* const text)
+{
+    const int fd = mkstemp(fileName);
+
+    if (fd < 0) {
+        return FALSE;
+    }
+
+    FILE* file = fdopen(fd, "w");
+    fputs(text, file);
+    fclose(file);
+
+    return TRUE;
+}
+
+void bench_filter(void)
+{
+    printf("\nFilter decisions, per patch pass over %d functions with %d names in the filter:\n",
+        BenchFunctionCount, (BenchFunctionCount + FILTER_EVERY - 1) / FILTER_EVERY);
+
+    char text[BenchFunctionCount * 32] = "";
+
+    for (size_t i = 0; i < BenchFunctionCount; i += FILTER_EVERY) {
+        strcat(text, libraryNames[i]);
+        strcat(text, "\n");
+        oldFilters[oldCount++] = libraryNames[i];
+    }
+
+    char fileName[] = "/tmp/glsnoop_filterXXXXXX";
+
+    if (!write_filter_file(fileName, text) || !load_filters(FilterSet_Profile, fileName)) {
+        puts("  Failed to create the filter file");
+        return;
+    }
+
+    double best = 0.0;
+
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        const double start = bench_seconds();
+
+        for (unsigned long pass = 0; pass < PASSES; pass++) {
+            for (size_t id = 0; id < BenchFunctionCount; id++) {
+                benchSink += match(libraryNames[id]);
+            }
+        }
+
+        best = bench_best(best, bench_seconds() - start);
+    }
+
+    bench_report("strcmp search of the filter names (old match)", best, PASSES);
+
+    uint32 bits[FILTER_WORDS(BenchFunctionCount)];
+
+    best = 0.0;
+
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        const double start = bench_seconds();
+
+        for (unsigned long pass = 0; pass < PASSES / 10; pass++) {
+            filter_compile(FilterSet_Profile, bits, &benchOgles2Table);
+            benchSink += bits[0];
+        }
+
+        best = bench_best(best, bench_seconds() - start);
+    }
+
+    bench_report("filter_compile, once per load or reload", best, PASSES / 10);
+
+    best = 0.0;
+
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        const double start = bench_seconds();
+
+        for (unsigned long pass = 0; pass < PASSES; pass++) {
+            for (size_t id = 0; id < BenchFunctionCount; id++) {
+                benchSink += filter_test(bits, id);
+            }
+        }
+
+        best = bench_best(best, bench_seconds() - start);
+    }
+
+    bench_report("filter_test of the compiled bits", best, PASSES);
+
+    const size_t enabled = filter_count(bits, BenchFunctionCount);
+
+    if (enabled != oldCount) {
+        printf("  Mismatch: %zu functions enabled, expected %zu\n", enabled, oldCount);
+    }
+
+    free_filters();
+    unlink(fileName);
+}
+
+// The wrappers evaluate PREDICATE_MATCH after the trace filter bit. The
+// arguments are packed only for functions that have conditions.
+
+typedef struct TexImage2DArgs {
+    unsigned target;
+    int level;
+    int internalformat;
+    int width;
+    int height;
+    int border;
+    unsigned format;
+    unsigned type;
+    const void* pixels;
+} TexImage2DArgs;
+
+static PredicateSet* conditions;
+
+__attribute__((noinline)) static BOOL tex_image_unchecked(const TexImage2DArgs* const a)
+{
+    (void)a;
+    return TRUE;
+}
+
+__attribute__((noinline)) static BOOL tex_image_checked(const TexImage2DArgs* const a)
+{
+    const Predicate* const predicate = predicate_find(&conditions, TexImage2D);
+
+    return PREDICATE_MATCH(predicate,
+        a->target, a->level, a->internalformat, a->width, a->height, a->border, a->format, a->type, a->pixels);
+}
+
+// Same arguments, but looked up under a function that has no conditions
+__attribute__((noinline)) static BOOL tex_image_unconditioned(const TexImage2DArgs* const a)
+{
+    const Predicate* const predicate = predicate_find(&conditions, TexSubImage2D);
+
+    return PREDICATE_MATCH(predicate,
+        a->target, a->level, a->internalformat, a->width, a->height, a->border, a->format, a->type, a->pixels);
+}
+
+__attribute__((noinline)) static BOOL clear_color_checked(const float red, const float green, const float blue, const float alpha)
+{
+    const Predicate* const predicate = predicate_find(&conditions, ClearColor);
+
+    return PREDICATE_MATCH(predicate, red, green, blue, alpha);
+}
+
+static double measure_tex_image(BOOL (*check)(const TexImage2DArgs*))
+{
+    const TexImage2DArgs args = { 0x0DE1, 0, 0x1908, 256, 256, 0, 0x1908, 0x1401, NULL };
+    double best = 0.0;
+
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        const double start = bench_seconds();
+
+        for (unsigned long i = 0; i < CALLS; i++) {
+            benchSink += check(&args);
+        }
+
+        best = bench_best(best, bench_seconds() - start);
+    }
+
+    return best;
+}
+
+void bench_predicates(void)
+{
+    puts("\nArgument conditions per wrapper call, the conditions are false:");
+
+    char fileName[] = "/tmp/glsnoop_filterXXXXXX";
+
+    if (!write_filter_file(fileName, "glTexImage2D width>=1024 height>=1024\nglClearColor alpha<1.0\n") ||
+        !load_filters(FilterSet_Trace, fileName)) {
+        puts("  Failed to create the filter file");
+        return;
+    }
+
+    bench_report("no condition check", measure_tex_image(tex_image_unchecked), CALLS);
+
+    filter_compile_predicates(&conditions, &benchOgles2Table);
+
+    bench_report("glTexSubImage2D without conditions, lookup only", measure_tex_image(tex_image_unconditioned), CALLS);
+    bench_report("glTexImage2D width>=1024 height>=1024", measure_tex_image(tex_image_checked), CALLS);
+
+    double best = 0.0;
+
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        const double start = bench_seconds();
+
+        for (unsigned long i = 0; i < CALLS; i++) {
+            benchSink += clear_color_checked(0.0f, 0.0f, 0.0f, 1.0f);
+        }
+
+        best = bench_best(best, bench_seconds() - start);
+    }
+
+    bench_report("glClearColor alpha<1.0", best, CALLS);
+
+    if (!conditions || predicate_match(&conditions->predicates[TexImage2D], (const uint32_t[]){ 0, 0, 0, 1024, 1024 }) != TRUE) {
+        puts("  Mismatch: the conditions didn't compile");
+    }
+
+    filter_free_predicates(&conditions);
+    free_filters();
+    unlink(fileName);
+}
@@ -0,0 +1,73 @@
+// Cost of a wrapper's log statement in PROFILE mode, where logging is paused.
+// logLine tests the pause flag before the arguments are evaluated; before
+// that the decoders ran for every call and the line was dropped afterwards.
+
+#include "host.h"
+#include "logger.h"
+
+#define CALLS 10000000UL
+
+__attribute__((noinline)) static const char* decode(const unsigned value)
+{
+    switch (value) {
+        case 0x0DE1: return "GL_TEXTURE_2D";
+        case 0x2800: return "GL_TEXTURE_MAG_FILTER";
+        case 0x2801: return "GL_TEXTURE_MIN_FILTER";
+        case 0x2802: return "GL_TEXTURE_WRAP_S";
+        case 0x2803: return "GL_TEXTURE_WRAP_T";
+        case 0x2601: return "GL_LINEAR";
+        default: return "unknown";
+    }
+}
+
+__attribute__((noinline)) static void original(const unsigned target, const unsigned pname, const int param)
+{
+    benchSink += target + pname + (unsigned)param;
+}
+
+__attribute__((noinline)) static void pass_through(const unsigned target, const unsigned pname, const int param)
+{
+    original(target, pname, param);
+}
+
+__attribute__((noinline)) static void gated(const unsigned target, const unsigned pname, const int param)
+{
+    logLine("%s: %s: target %s, pname %s, param %d", "task", __func__, decode(target), decode(pname), param);
+    original(target, pname, param);
+}
+
+__attribute__((noinline)) static void ungated(const unsigned target, const unsigned pname, const int param)
+{
+    logLineFunction("%s: %s: target %s, pname %s, param %d", "task", __func__, decode(target), decode(pname), param);
+    original(target, pname, param);
+}
+
+static double run(void (*wrapper)(unsigned, unsigned, int))
+{
+    double best = 0.0;
+
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        const double start = bench_seconds();
+
+        for (unsigned long i = 0; i < CALLS; i++) {
+            wrapper(0x0DE1, 0x2801 + (unsigned)(i & 1), 0x2601);
+        }
+
+        best = bench_best(best, bench_seconds() - start);
+    }
+
+    return best;
+}
+
+void bench_logline(void)
+{
+    puts("\nlogLine call site, logging paused (PROFILE mode), per call:");
+
+    logPaused = TRUE;
+
+    bench_report("pass-through wrapper without logging", run(pass_through), CALLS);
+    bench_report("logLine, pause tested before the arguments", run(gated), CALLS);
+    bench_report("logLineFunction, arguments always decoded", run(ungated), CALLS);
+
+    logPaused = FALSE;
+}
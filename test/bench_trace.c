@@ -0,0 +1,117 @@
+// Throughput of the binary trace path: ring slot reservation, the portable
+// encoder and decoder, and the text formatting it replaces in the caller.
+
+#include "host.h"
+#include "trace.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define RECORDS 5000000UL
+#define CAPACITY 4096
+
+static TraceRecord sample_record(const unsigned long i)
+{
+    TraceRecord record;
+
+    memset(&record, 0, sizeof(record));
+    record.ticks = 0x123456789ULL + i;
+    record.task = 0x6FF01230;
+    record.function = (uint16_t)(i % 200);
+    record.module = TraceModule_Ogles2;
+    record.argCount = 5;
+
+    for (uint8_t a = 0; a < record.argCount; a++) {
+        record.args[a] = (uint32_t)(i * 31 + a);
+    }
+
+    return record;
+}
+
+void bench_trace(void)
+{
+    puts("\nBinary trace records (5 arguments), per record:");
+
+    TraceRecord record = sample_record(1);
+    uint8_t buffer[TRACE_ENCODED_MAX_SIZE];
+
+    double best = 0.0;
+
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        const double start = bench_seconds();
+
+        for (unsigned long i = 0; i < RECORDS; i++) {
+            record.ticks = i;
+            benchSink += trace_encode(&record, buffer);
+        }
+
+        best = bench_best(best, bench_seconds() - start);
+    }
+
+    bench_report("trace_encode", best, RECORDS);
+
+    const size_t length = trace_encode(&record, buffer);
+    TraceRecord decoded;
+
+    best = 0.0;
+
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        const double start = bench_seconds();
+
+        for (unsigned long i = 0; i < RECORDS; i++) {
+            buffer[0] = (uint8_t)i;
+            benchSink += trace_decode(buffer, length, &decoded);
+        }
+
+        best = bench_best(best, bench_seconds() - start);
+    }
+
+    bench_report("trace_decode", best, RECORDS);
+
+    void* memory = malloc(trace_ring_memory_size(sizeof(TraceRecord), CAPACITY));
+    TraceRing ring;
+    trace_ring_init(&ring, memory, sizeof(TraceRecord), CAPACITY);
+
+    best = 0.0;
+
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        const double start = bench_seconds();
+
+        for (unsigned long i = 0; i < RECORDS; i++) {
+            uint32_t position;
+            TraceRecord* slot = trace_ring_reserve(&ring, &position);
+
+            record.ticks = i;
+            memcpy(slot, &record, offsetof(TraceRecord, args) + record.argCount * sizeof(uint32_t));
+            trace_ring_commit(&ring, position);
+
+            const TraceRecord* read = trace_ring_peek(&ring);
+            benchSink += read->ticks;
+            trace_ring_release(&ring);
+        }
+
+        best = bench_best(best, bench_seconds() - start);
+    }
+
+    bench_report("ring reserve, copy, commit and drain", best, RECORDS);
+
+    free(memory);
+
+    char text[256];
+    const unsigned long lines = RECORDS / 10;
+
+    best = 0.0;
+
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        const double start = bench_seconds();
+
+        for (unsigned long i = 0; i < lines; i++) {
+            record.ticks = i;
+            benchSink += (uint64_t)trace_format(&record, "task", "glDrawElements", 1.5, text, sizeof(text));
+        }
+
+        best = bench_best(best, bench_seconds() - start);
+    }
+
+    bench_report("trace_format, text line for comparison", best, lines);
+}
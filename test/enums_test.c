@@ -0,0 +1,65 @@
+// Checks the GLenum tables of ogles2_enums.h: values in strictly increasing
+// order, and every listed value decodes to its own name. Run with "make test",
+// the exit status is nonzero on failure.
+
+#include "ogles2_enums.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct ListEntry {
+    uint32_t value;
+    const char* name;
+} ListEntry;
+
+#define LIST_ENTRY(name, value) { value, #name },
+
+static const ListEntry valueList[] = { OGLES2_VALUE_NAMES(LIST_ENTRY) };
+static const ListEntry capabilityList[] = { OGLES2_CAPABILITY_NAMES(LIST_ENTRY) };
+static const ListEntry primitiveList[] = { OGLES2_PRIMITIVE_NAMES(LIST_ENTRY) };
+
+#undef LIST_ENTRY
+
+static int test_table(const char* const title, const EnumTable* const table, const ListEntry* const list, const size_t count)
+{
+    int failures = 0;
+
+    if (!enum_table_sorted(table)) {
+        printf("FAIL: %s values are not strictly increasing\n", title);
+        failures++;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        const char* const name = enum_table_find(table, list[i].value);
+
+        if (!name || strcmp(name, list[i].name) != 0) {
+            printf("FAIL: %s 0x%04X decodes to %s, expected %s\n", title, (unsigned)list[i].value,
+                name ? name : "NULL", list[i].name);
+            failures++;
+        }
+
+        // A value between two entries isn't found
+        if (i + 1 < count && list[i].value + 1 < list[i + 1].value && enum_table_find(table, list[i].value + 1)) {
+            printf("FAIL: %s 0x%04X isn't listed but was found\n", title, (unsigned)(list[i].value + 1));
+            failures++;
+        }
+    }
+
+    printf("%-12s %3u names%s\n", title, (unsigned)count, failures ? " FAIL" : "");
+
+    return failures;
+}
+
+int main(void)
+{
+    int failures = 0;
+
+    failures += test_table("value", &ogles2ValueTable, valueList, sizeof(valueList) / sizeof(valueList[0]));
+    failures += test_table("capability", &ogles2CapabilityTable, capabilityList, sizeof(capabilityList) / sizeof(capabilityList[0]));
+    failures += test_table("primitive", &ogles2PrimitiveTable, primitiveList, sizeof(primitiveList) / sizeof(primitiveList[0]));
+
+    printf("%s\n", failures ? "FAILED" : "OK");
+
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,132 @@
+// Percentile accuracy of histogram.c against the exact percentiles of sorted
+// samples. Run with "make test", the exit status is nonzero on failure.
+
+#include "histogram.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define SAMPLES 200000
+// A bucket spans 1/HISTOGRAM_SUB_COUNT of its power of two range, the estimate is its highest value
+#define MAX_ERROR (1.0 / HISTOGRAM_SUB_COUNT)
+
+typedef enum Distribution {
+    Distribution_Uniform,
+    Distribution_Exponential,
+    Distribution_Bimodal,
+    Distribution_Count // KEEP LAST
+} Distribution;
+
+static const char* const distributionNames[Distribution_Count] = { "uniform", "exponential", "bimodal" };
+
+static const double percentiles[] = { 50.0, 90.0, 95.0, 99.0, 99.9 };
+
+static Histogram histogram;
+static uint64_t samples[SAMPLES];
+
+// xorshift64, the same samples on every host
+static uint64_t state = 88172645463325252ULL;
+
+static double next_uniform(void)
+{
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+
+    return ((double)(state >> 11) + 0.5) / 9007199254740992.0; // (0, 1)
+}
+
+static uint64_t next_sample(const Distribution distribution, const size_t i)
+{
+    const double u = next_uniform();
+
+    switch (distribution) {
+        case Distribution_Uniform:
+            return 1000 + (uint64_t)(u * 9000.0);
+        case Distribution_Exponential:
+            return (uint64_t)(-log(u) * 3000.0);
+        case Distribution_Bimodal:
+            // Mostly short calls with a few long stalls, like buffer swaps waiting for the display
+            return (i % 100 == 0) ? 2000000 + (uint64_t)(u * 1000000.0) : 3000 + (uint64_t)(u * 300.0);
+        default:
+            return 0;
+    }
+}
+
+static int compare_samples(const void* a, const void* b)
+{
+    const uint64_t x = *(const uint64_t *)a;
+    const uint64_t y = *(const uint64_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+static int test_buckets(void)
+{
+    for (uint64_t value = 1; value < (1ULL << 20); value++) {
+        const unsigned bucket = histogram_bucket(value);
+        const unsigned previous = histogram_bucket(value - 1);
+
+        if (bucket != previous && bucket != previous + 1) {
+            printf("FAIL: value %llu skips from bucket %u to %u\n", (unsigned long long)value, previous, bucket);
+            return 1;
+        }
+    }
+
+    if (histogram_bucket(UINT64_MAX) != HISTOGRAM_BUCKETS - 1) {
+        printf("FAIL: the largest value isn't in the last bucket\n");
+        return 1;
+    }
+
+    return 0;
+}
+
+static int test_distribution(const Distribution distribution)
+{
+    int failures = 0;
+
+    histogram_reset(&histogram);
+
+    for (size_t i = 0; i < SAMPLES; i++) {
+        samples[i] = next_sample(distribution, i);
+        histogram_add(&histogram, samples[i]);
+    }
+
+    qsort(samples, SAMPLES, sizeof(samples[0]), compare_samples);
+
+    for (size_t p = 0; p < sizeof(percentiles) / sizeof(percentiles[0]); p++) {
+        const uint64_t exact = samples[(size_t)ceil(percentiles[p] / 100.0 * SAMPLES) - 1];
+        const uint64_t estimate = histogram_percentile(&histogram, percentiles[p]);
+        const double error = exact ? ((double)estimate - (double)exact) / (double)exact : (double)estimate;
+
+        // The estimate is the top of the bucket, it may only be above the exact value
+        const int failed = estimate < exact || error > MAX_ERROR;
+
+        printf("%-12s p%-5.1f exact %8llu estimate %8llu error %+6.2f%%%s\n", distributionNames[distribution],
+            percentiles[p], (unsigned long long)exact, (unsigned long long)estimate, error * 100.0, failed ? " FAIL" : "");
+
+        failures += failed;
+    }
+
+    if (histogram.max != samples[SAMPLES - 1]) {
+        printf("FAIL: %s max %llu, expected %llu\n", distributionNames[distribution],
+            (unsigned long long)histogram.max, (unsigned long long)samples[SAMPLES - 1]);
+        failures++;
+    }
+
+    return failures;
+}
+
+int main(void)
+{
+    int failures = test_buckets();
+
+    for (int d = 0; d < Distribution_Count; d++) {
+        failures += test_distribution((Distribution)d);
+    }
+
+    printf("%s\n", failures ? "FAILED" : "OK");
+
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
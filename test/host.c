@@ -0,0 +1,67 @@
+// Host implementations of the few AmigaOS and logger functions used by the
+// sources under test
+
+#define _GNU_SOURCE // FNM_CASEFOLD
+
+#include "host.h"
+#include "logger.h"
+
+#include <proto/exec.h>
+#include <proto/dos.h>
+
+#include <fnmatch.h>
+#include <stdlib.h>
+#include <string.h>
+
+static APTR host_alloc(ULONG size, ...)
+{
+    return calloc(1, size);
+}
+
+static void host_free(APTR memory)
+{
+    free(memory);
+}
+
+// AmigaDOS patterns are not translated, "#?" is close enough to "*" for the tests
+static LONG host_parse(const char* pattern, char* buffer, LONG size)
+{
+    strncpy(buffer, pattern, (size_t)size - 1);
+    buffer[size - 1] = '\0';
+    return 1;
+}
+
+static LONG host_match(const char* pattern, STRPTR name)
+{
+    return fnmatch(pattern, name, FNM_CASEFOLD) == 0;
+}
+
+static struct ExecIFace execIFace = { host_alloc, host_free };
+static struct DOSIFace dosIFace = { host_parse, host_match };
+
+struct ExecIFace* IExec = &execIFace;
+struct DOSIFace* IDOS = &dosIFace;
+
+volatile BOOL logPaused = FALSE;
+unsigned long hostLogLines;
+
+// Log lines are only counted, the benchmarks print their own results
+void logLineFunction(const char * fmt, ...)
+{
+    (void)fmt;
+
+    if (!logPaused) {
+        hostLogLines++;
+    }
+}
+
+void logAlways(const char * fmt, ...)
+{
+    (void)fmt;
+    hostLogLines++;
+}
+
+void logDebug(const char * fmt, ...)
+{
+    (void)fmt;
+}
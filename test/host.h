@@ -0,0 +1,41 @@
+#ifndef HOST_H
+#define HOST_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+// Lines passed to the logger stubs in host.c
+extern unsigned long hostLogLines;
+
+// Keeps the compiler from removing the measured work
+extern volatile uint64_t benchSink;
+
+static inline double bench_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// Benchmarks report the best of a few rounds, the others include scheduling noise
+#define BENCH_ROUNDS 5
+
+static inline double bench_best(const double best, const double seconds)
+{
+    return best > 0.0 && best < seconds ? best : seconds;
+}
+
+static inline void bench_report(const char* const name, const double seconds, const unsigned long operations)
+{
+    printf("  %-52s %10.2f ns\n", name, seconds * 1e9 / (double)operations);
+}
+
+void bench_logline(void);
+void bench_trace(void);
+void bench_clients(void);
+void bench_filter(void);
+void bench_predicates(void);
+void bench_enums(const char* const valueFile);
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef EXEC_TYPES_H
+#define EXEC_TYPES_H
+
+// Just enough of the AmigaOS types to build the host independent parts of
+// glSnoop with the host compiler. Widths follow the AmigaOS SDK where the
+// sources depend on them.
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef short BOOL;
+typedef long LONG;
+typedef unsigned long ULONG;
+typedef unsigned char UBYTE;
+typedef void* APTR;
+typedef char* STRPTR;
+typedef long BPTR;
+
+typedef int8_t int8;
+typedef uint8_t uint8;
+typedef int16_t int16;
+typedef uint16_t uint16;
+typedef long int32;
+typedef unsigned long uint32;
+typedef long long int64;
+typedef unsigned long long uint64;
+
+#define TRUE 1
+#define FALSE 0
+#define ZERO 0
+
+struct Node {
+    struct Node* ln_Succ;
+    struct Node* ln_Pred;
+    UBYTE ln_Type;
+    char* ln_Name;
+};
+
+struct Task {
+    struct Node tc_Node;
+};
+
+#endif
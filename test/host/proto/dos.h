@@ -0,0 +1,13 @@
+#ifndef PROTO_DOS_H
+#define PROTO_DOS_H
+
+#include <exec/types.h>
+
+struct DOSIFace {
+    LONG (*ParsePatternNoCase)(const char* pattern, char* buffer, LONG size);
+    LONG (*MatchPatternNoCase)(const char* pattern, STRPTR name);
+};
+
+extern struct DOSIFace* IDOS;
+
+#endif
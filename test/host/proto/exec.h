@@ -0,0 +1,20 @@
+#ifndef PROTO_EXEC_H
+#define PROTO_EXEC_H
+
+#include <exec/types.h>
+
+enum {
+    TAG_DONE,
+    AVT_Type,
+    AVT_ClearValue,
+    MEMF_SHARED
+};
+
+struct ExecIFace {
+    APTR (*AllocVecTags)(ULONG size, ...);
+    void (*FreeVec)(APTR memory);
+};
+
+extern struct ExecIFace* IExec;
+
+#endif